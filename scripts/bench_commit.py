@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+"""
+Benchmark build flag: prints -DBENCH_COMMIT="<short hash>[-dirty]" for the
+build_flags of env:benchmark and env:benchmark_native, so every JSON line
+the suite prints says which commit it measured.
+"""
+
+import subprocess
+
+
+def git(*args):
+    return subprocess.run(['git'] + list(args), capture_output=True, text=True)
+
+
+def main():
+    rev = git('rev-parse', '--short', 'HEAD')
+    commit = rev.stdout.strip() if rev.returncode == 0 else 'unknown'
+    if commit != 'unknown' and git('diff', '--quiet', 'HEAD').returncode != 0:
+        commit += '-dirty'
+    print("'-DBENCH_COMMIT=\"%s\"'" % commit)
+
+
+if __name__ == '__main__':
+    main()
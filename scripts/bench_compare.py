@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+Benchmark Comparison for ESP32-S3 Geek
+Reads two captures of the benchmark suite (serial logs or files holding its
+JSON lines; anything else on a line is ignored) and prints the mean time of
+every benchmark in both (or the fastest run, less noisy on a busy host),
+with the change. Exits 1 when any benchmark got slower than the
+threshold, so it can gate a commit.
+
+  python3 scripts/bench_compare.py before.jsonl after.jsonl [--threshold 5] [--stat min_us]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """(target, bench, variant) -> result, from the lines that are JSON objects"""
+    results = {}
+    commit = None
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            start = line.find('{"target"')
+            if start < 0:
+                continue
+            try:
+                r = json.loads(line[start:])
+            except ValueError:
+                continue
+            results[(r['target'], r['bench'], r['variant'])] = r
+            commit = r.get('commit', commit)
+    return results, commit
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two benchmark runs")
+    parser.add_argument('before')
+    parser.add_argument('after')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help="percent slower that counts as a regression (default: 5)")
+    parser.add_argument('--stat', choices=['mean_us', 'min_us'], default='mean_us',
+                        help="time to compare (default: mean_us)")
+    args = parser.parse_args()
+
+    before, old = load(args.before)
+    after, new = load(args.after)
+    if not before or not after:
+        print("❌ No benchmark lines in " + (args.before if not before else args.after))
+        return 2
+
+    print(f"# {old} -> {new}")
+    print(f"# {args.stat}")
+    print(f"{'benchmark':40s} {'before_us':>11s} {'after_us':>11s} {'change':>8s}  {'rate':>12s}")
+    regressions = 0
+    for key in sorted(set(before) | set(after)):
+        name = '/'.join(key)
+        if key not in before or key not in after:
+            print(f"{name:40s} {'only in ' + ('after' if key in after else 'before'):>32s}")
+            continue
+        b, a = before[key][args.stat], after[key][args.stat]
+        change = (a - b) * 100.0 / b if b > 0 else 0.0
+        flag = ''
+        if change > args.threshold:
+            flag = '  ⚠️ slower'
+            regressions += 1
+        elif change < -args.threshold:
+            flag = '  ✅ faster'
+        print(f"{name:40s} {b:11.1f} {a:11.1f} {change:+7.1f}%  {after[key]['rate']:8.2f} {after[key]['unit']}{flag}")
+    print(f"# {regressions} slower by more than {args.threshold:g}%")
+    return 1 if regressions else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
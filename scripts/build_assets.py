@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""
+Asset Builder for ESP32-S3 Geek
+Turns the status screen PNGs into RLE565 blobs under assets/ that the linker
+embeds into the firmware (board_build.embed_files in platformio.ini), and
+generates the registry that names them: src/Asset_Registry.h/.cpp with each
+asset's pointer, size, dimensions and format. No source file carries the
+pixel bytes, so nothing is recompiled when an image changes and no
+translation unit can end up with its own copy.
+
+The same blobs can also go into the 'assets' flash partition (partitions.csv)
+as a pack that src/Asset_Pack.cpp maps at boot; images there replace the
+linked-in ones by name and are updated without reflashing the app.
+
+    python scripts/build_assets.py           # rebuild blobs, registry and embed list
+    python scripts/build_assets.py --check   # verify blobs, registry and embed list
+    python scripts/build_assets.py --partition assets.bin   # pack for the partition
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+import rle565
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+PROJECT_DIR = os.path.dirname(SCRIPT_DIR)
+ASSET_DIR = 'assets/status'
+
+PACK_MAGIC = b'APAK'         # src/Asset_Pack.h
+PACK_VERSION = 1
+PACK_NAME_LEN = 24
+PACK_HEADER_SIZE = 16
+PACK_ENTRY_SIZE = 40
+PACK_MAX_ENTRIES = 32
+FORMAT_RLE565 = 0
+
+# (name, source image in scripts/); the order fixes the ASSET_ID values
+ASSETS = [
+    ('no_sd_card', 'no_sd_card.png'),
+    ('no_images_found', 'no_images_found.png'),
+    ('scanning', 'scanning.png'),
+    ('manual_mode', 'manual_mode.png'),
+    ('slideshow_mode', 'slideshow_mode.png'),
+]
+
+HEADER = """/*****************************************************************************
+* | File        :   Asset_Registry.h
+* | Function    :   Images linked into the firmware
+* | Info        :
+*   Generated by scripts/build_assets.py - do not edit.
+*   Each asset is a file under assets/ that board_build.embed_files links
+*   into flash as-is; the registry gives its address, size, dimensions and
+*   format. RLE565 assets are drawn with RLE565_DrawImage.
+******************************************************************************/
+#ifndef __ASSET_REGISTRY_H
+#define __ASSET_REGISTRY_H
+
+#include <stdint.h>
+
+typedef enum {{
+    ASSET_FORMAT_RLE565 = 0,    // src/RLE565.h packets, big-endian pixels
+}} ASSET_FORMAT;
+
+typedef enum {{
+{ids}
+    ASSET_COUNT
+}} ASSET_ID;
+
+typedef struct {{
+    const char *Name;
+    const uint8_t *Data;
+    uint32_t Size;
+    uint16_t Width;
+    uint16_t Height;
+    uint8_t Format;             // ASSET_FORMAT
+}} ASSET;
+
+const ASSET *Asset_Get(ASSET_ID id);
+const ASSET *Asset_Find(const char *name);
+
+#endif
+"""
+
+SOURCE = """/*****************************************************************************
+* | File        :   Asset_Registry.cpp
+* | Function    :   Images linked into the firmware
+* | Info        :
+*   Generated by scripts/build_assets.py - do not edit.
+******************************************************************************/
+#include "Asset_Registry.h"
+#include <string.h>
+
+#ifdef ARDUINO
+// objcopy names each embedded file after its path in the project
+{externs}
+#define LINKED(_data, _size) _data, _size
+#else
+// Host builds have no embed_files step: names and dimensions stay, data is absent
+#define LINKED(_data, _size) NULL, 0
+#endif
+
+static const ASSET assets[ASSET_COUNT] = {{
+{entries}
+}};
+
+const ASSET *Asset_Get(ASSET_ID id)
+{{
+    return (unsigned)id < ASSET_COUNT ? &assets[id] : NULL;
+}}
+
+const ASSET *Asset_Find(const char *name)
+{{
+    for (int i = 0; i < ASSET_COUNT; i++) {{
+        if (strcmp(assets[i].Name, name) == 0) {{
+            return &assets[i];
+        }}
+    }}
+    return NULL;
+}}
+"""
+
+
+def blob_path(name):
+    return f"{ASSET_DIR}/{name}.rle565"
+
+
+def symbol(path):
+    """Symbol objcopy -I binary gives a file: every non-alphanumeric becomes '_'"""
+    return '_binary_' + re.sub(r'[^A-Za-z0-9]', '_', path) + '_start'
+
+
+def write_registry(assets):
+    """assets: list of (name, size, width, height)"""
+    ids = "\n".join(f"    ASSET_{name.upper()}{' = 0' if i == 0 else ''},"
+                    for i, (name, _, _, _) in enumerate(assets))
+    externs = "\n".join(f'extern const uint8_t {name}_start[] asm("{symbol(blob_path(name))}");'
+                        for name, _, _, _ in assets)
+    entries = "\n".join(f'    {{"{name}", LINKED({name}_start, {size}), {width}, {height}, ASSET_FORMAT_RLE565}},'
+                        for name, size, width, height in assets)
+    files = {
+        'src/Asset_Registry.h': HEADER.format(ids=ids),
+        'src/Asset_Registry.cpp': SOURCE.format(externs=externs, entries=entries),
+    }
+    for path, text in files.items():
+        with open(os.path.join(PROJECT_DIR, path), 'w') as f:
+            f.write(text)
+    return files
+
+
+def embed_block(names):
+    return "board_build.embed_files = \n" + "".join(f"\t{blob_path(n)}\n" for n in names)
+
+
+def update_platformio(names, check=False):
+    """Keep board_build.embed_files in step with the registry"""
+    path = os.path.join(PROJECT_DIR, 'platformio.ini')
+    with open(path) as f:
+        text = f.read()
+    block = embed_block(names)
+    pattern = re.compile(r'board_build\.embed_files *=.*\n(?:[ \t]+\S.*\n)*')
+    if pattern.search(text):
+        updated = pattern.sub(lambda m: block, text, count=1)
+    else:
+        updated = re.sub(r'(board_build\.filesystem *=.*\n)', lambda m: m.group(1) + block, text, count=1)
+    if check:
+        return updated == text
+    with open(path, 'w') as f:
+        f.write(updated)
+    return True
+
+
+def build():
+    from convert_images import load_display_pixels
+
+    os.makedirs(os.path.join(PROJECT_DIR, ASSET_DIR), exist_ok=True)
+    assets = []
+    for name, source in ASSETS:
+        pixels, width, height, _ = load_display_pixels(os.path.join(SCRIPT_DIR, source))
+        data = rle565.encode(pixels)
+        if rle565.decode(data, len(pixels)) != pixels:
+            raise ValueError(f"{name}: round trip mismatch")
+        with open(os.path.join(PROJECT_DIR, blob_path(name)), 'wb') as f:
+            f.write(data)
+        assets.append((name, len(data), width, height))
+        print(f"✅ {blob_path(name)}: {width}x{height}, {len(data)} bytes ({width * height * 2} raw)")
+    write_registry(assets)
+    update_platformio([name for name, _ in ASSETS])
+    total = sum(size for _, size, _, _ in assets)
+    print(f"📦 {len(assets)} assets, {total} bytes of flash; registry in src/Asset_Registry.h/.cpp")
+    return 0
+
+
+def registered_assets():
+    """(name, size, width, height) for each asset as the generated registry has it"""
+    with open(os.path.join(PROJECT_DIR, 'src/Asset_Registry.cpp')) as f:
+        registry = f.read()
+    found = []
+    for name, _ in ASSETS:
+        entry = re.search(rf'\{{"{name}", LINKED\(\w+, (\d+)\), (\d+), (\d+),', registry)
+        found.append((name,) + (tuple(int(v) for v in entry.groups()) if entry else (None, None, None)))
+    return found
+
+
+def check():
+    """Blobs decode to their registered size, the registry and embed list are current"""
+    failed = 0
+    for name, size, width, height in registered_assets():
+        path = os.path.join(PROJECT_DIR, blob_path(name))
+        if size is None or not os.path.exists(path):
+            print(f"❌ {name}: missing from the registry or {ASSET_DIR}")
+            failed += 1
+            continue
+        with open(path, 'rb') as f:
+            data = f.read()
+        try:
+            ok = len(data) == size and len(rle565.decode(data, width * height)) == width * height
+        except Exception:
+            ok = False
+        print(f"{'✅' if ok else '❌'} {blob_path(name)}: {len(data)} bytes, {width}x{height}")
+        failed += 0 if ok else 1
+    if not update_platformio([name for name, _ in ASSETS], check=True):
+        print("❌ platformio.ini: board_build.embed_files does not match the registry")
+        failed += 1
+    return 1 if failed else 0
+
+
+def partition_slot():
+    """(offset, size) of the 'assets' partition in partitions.csv"""
+    with open(os.path.join(PROJECT_DIR, 'partitions.csv')) as f:
+        for line in f:
+            fields = [v.strip() for v in line.split('#')[0].split(',')]
+            if len(fields) >= 5 and fields[0] == 'assets':
+                return int(fields[3], 0), int(fields[4], 0)
+    raise ValueError("no 'assets' partition in partitions.csv")
+
+
+def write_partition(output):
+    """Header, directory, then each blob 4-byte aligned (layout in src/Asset_Pack.h)"""
+    assets = [a for a in registered_assets() if a[1] is not None]
+    if len(assets) > PACK_MAX_ENTRIES:
+        raise ValueError(f"{len(assets)} assets, a pack holds {PACK_MAX_ENTRIES}")
+    offset = PACK_HEADER_SIZE + len(assets) * PACK_ENTRY_SIZE
+    directory = b''
+    payload = b''
+    for name, size, width, height in assets:
+        if len(name) >= PACK_NAME_LEN:
+            raise ValueError(f"{name}: names are at most {PACK_NAME_LEN - 1} characters")
+        with open(os.path.join(PROJECT_DIR, blob_path(name)), 'rb') as f:
+            data = f.read()
+        start = offset + len(payload)
+        directory += struct.pack('<24sIIHHB3x', name.encode(), start, len(data), width, height, FORMAT_RLE565)
+        payload += data + b'\x00' * (-len(data) & 3)
+    total = offset + len(payload)
+    pack = struct.pack('<4sHHII', PACK_MAGIC, PACK_VERSION, len(assets), total, 0) + directory + payload
+
+    address, capacity = partition_slot()
+    if len(pack) > capacity:
+        raise ValueError(f"pack is {len(pack)} bytes, the partition {capacity}")
+    with open(output, 'wb') as f:
+        f.write(pack)
+    print(f"📦 {output}: {len(assets)} assets, {len(pack)} of {capacity} bytes")
+    print(f"   esptool.py --chip esp32s3 write_flash 0x{address:X} {output}")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the linked-in status screen assets")
+    parser.add_argument('--check', action='store_true', help="verify instead of rebuilding")
+    parser.add_argument('--partition', metavar='FILE', help="write an 'assets' partition image from the current blobs")
+    args = parser.parse_args()
+    if args.partition:
+        return write_partition(args.partition)
+    return check() if args.check else build()
+
+
+if __name__ == '__main__':
+    sys.exit(main())
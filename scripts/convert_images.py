@@ -7,60 +7,78 @@ Handles any input size with smart resizing and aspect ratio preservation
 
 from PIL import Image
 import os
+import sys
 import glob
 
-def convert_image_to_rgb565_header(image_path, output_path, var_name):
-    """Convert any supported image format to RGB565 C header file"""
+import rle565
+
+def load_display_pixels(image_path):
+    """Fit, letterbox and rotate an image for the panel: returns (pixels, width, height, original_size)"""
+    # Open image and convert to RGB (handles transparency in PNG/GIF)
+    print(f"Processing: {os.path.basename(image_path)}")
+    img = Image.open(image_path)
     
-    try:
-        # Open image and convert to RGB (handles transparency in PNG/GIF)
-        print(f"Processing: {os.path.basename(image_path)}")
-        img = Image.open(image_path)
-        
-        # Handle animated GIFs - take first frame
-        if hasattr(img, 'is_animated') and img.is_animated:
-            img.seek(0)  # Go to first frame
-            
-        # Convert to RGB (removes alpha channel if present)
-        if img.mode in ('RGBA', 'LA', 'P'):
-            # Create white background for transparent images
-            background = Image.new('RGB', img.size, (255, 255, 255))
-            if img.mode == 'P':
-                img = img.convert('RGBA')
-            background.paste(img, mask=img.split()[-1] if img.mode in ('RGBA', 'LA') else None)
-            img = background
-        else:
-            img = img.convert('RGB')
+    # Handle animated GIFs - take first frame
+    if hasattr(img, 'is_animated') and img.is_animated:
+        img.seek(0)  # Go to first frame
         
-        print(f"Original size: {img.size[0]}x{img.size[1]}")
-        
-        # Smart resize with aspect ratio preservation
-        img = smart_resize_for_display(img, 240, 135)
-        print(f"Resized to: {img.size[0]}x{img.size[1]}")
-        
-        # Rotate 90 degrees clockwise to get 135x240 for display
-        img = img.rotate(-90, expand=True)
-        
-        # Final dimensions after rotation
-        width, height = img.size
-        print(f"Final display size: {width}x{height}")
+    # Convert to RGB (removes alpha channel if present)
+    if img.mode in ('RGBA', 'LA', 'P'):
+        # Create white background for transparent images
+        background = Image.new('RGB', img.size, (255, 255, 255))
+        if img.mode == 'P':
+            img = img.convert('RGBA')
+        background.paste(img, mask=img.split()[-1] if img.mode in ('RGBA', 'LA') else None)
+        img = background
+    else:
+        img = img.convert('RGB')
+    
+    original_size = img.size
+    print(f"Original size: {img.size[0]}x{img.size[1]}")
+    
+    # Smart resize with aspect ratio preservation
+    img = smart_resize_for_display(img, 240, 135)
+    print(f"Resized to: {img.size[0]}x{img.size[1]}")
+    
+    # Rotate 90 degrees clockwise to get 135x240 for display
+    img = img.rotate(-90, expand=True)
+    
+    # Final dimensions after rotation
+    width, height = img.size
+    print(f"Final display size: {width}x{height}")
+    
+    # Convert to RGB565 format
+    pixels = []
+    for y in range(height):
+        for x in range(width):
+            r, g, b = img.getpixel((x, y))
+            # Convert to RGB565 (5-6-5 bits)
+            r565 = (r >> 3) << 11
+            g565 = (g >> 2) << 5
+            b565 = b >> 3
+            rgb565 = r565 | g565 | b565
+            pixels.append(rgb565)
+    return pixels, width, height, original_size
+
+
+def convert_image_to_rgb565_header(image_path, output_path, var_name, rle=False):
+    """Convert any supported image format to RGB565 (or RLE565) C header file"""
+    
+    try:
+        pixels, width, height, original_size = load_display_pixels(image_path)
         
-        # Convert to RGB565 format
-        pixels = []
-        for y in range(height):
-            for x in range(width):
-                r, g, b = img.getpixel((x, y))
-                # Convert to RGB565 (5-6-5 bits)
-                r565 = (r >> 3) << 11
-                g565 = (g >> 2) << 5
-                b565 = b >> 3
-                rgb565 = r565 | g565 | b565
-                pixels.append(rgb565)
+        # Compressed header for RLE565_DrawImage (round trip checked by the encoder)
+        if rle:
+            size = rle565.write_rle_header(output_path, var_name, pixels, width, height,
+                                           os.path.basename(image_path))
+            print(f"✅ Successfully converted: {os.path.basename(image_path)} -> {os.path.basename(output_path)} "
+                  f"(RLE565, {size} of {width * height * 2} bytes)")
+            return True
         
         # Generate C header file
         with open(output_path, 'w') as f:
             f.write(f"// Auto-generated from {os.path.basename(image_path)}\n")
-            f.write(f"// Original size: {img.size[0]}x{img.size[1]} -> Display size: {width}x{height} pixels\n")
+            f.write(f"// Original size: {original_size[0]}x{original_size[1]} -> Display size: {width}x{height} pixels\n")
             f.write(f"// Format: RGB565, rotated for ESP32-S3 Geek display\n\n")
             f.write(f"#ifndef {var_name.upper()}_H\n")
             f.write(f"#define {var_name.upper()}_H\n\n")
@@ -194,7 +212,8 @@ def get_supported_images(directory):
     print(f"Converted {png_path} -> {output_path}")
 
 def main():
-    """Convert all supported image files in project directory"""
+    """Convert all supported image files in project directory (--rle: RLE565 headers)"""
+    rle = '--rle' in sys.argv[1:]
     script_dir = os.path.dirname(os.path.abspath(__file__))
     project_root = os.path.dirname(script_dir)
     
@@ -234,7 +253,7 @@ def main():
         header_path = os.path.join(script_dir, f"{var_name}.h")
         
         # Convert the image
-        if convert_image_to_rgb565_header(image_path, header_path, var_name):
+        if convert_image_to_rgb565_header(image_path, header_path, var_name, rle):
             success_count += 1
             print(f"   📄 Generated: {os.path.basename(header_path)}")
         print()
@@ -245,7 +264,11 @@ def main():
     print()
     print("💡 Usage in your code:")
     print('   #include "your_image_data.h"')
-    print('   Paint_DrawImage(your_image_data, 0, 0, your_image_data_width, your_image_data_height);')
+    if rle:
+        print('   RLE565_DrawImage(your_image_data_rle, your_image_data_rle_size, 0, 0,')
+        print('                    your_image_data_width, your_image_data_height);')
+    else:
+        print('   Paint_DrawImage(your_image_data, 0, 0, your_image_data_width, your_image_data_height);')
     print()
     print("🔧 To use in src/ directory:")
     print("   Copy the .h files from scripts/ to src/ folder")
@@ -150,7 +150,7 @@ def main():
         print(f"✅ Created: {filename}")
     
     print("\n🎉 All FlipperZero-style images generated!")
-    print("🔄 Run convert_images.py next to create header files")
+    print("🔄 Run build_assets.py next to rebuild the linked-in assets")
 
 if __name__ == "__main__":
     main()
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*****************************************************************************
+* | File        :   latency_replay.cpp
+* | Function    :   Host replay of recorded button edges through the latency path
+* | Info        :
+*   Reads the 'e' (edges) and 'l' (latency) serial dumps, feeds the edges
+*   through the firmware's gesture recognizer (src/Button_Gesture.cpp) with
+*   the same timings as main.cpp, and reports the same histograms
+*   (src/Latency_Trace.cpp). Frame costs after the decision come from the
+*   recorded samples (medians) when the dump has any, or from the options.
+*
+*   g++ -O2 -Isrc scripts/latency_replay.cpp src/Button_Gesture.cpp \
+*       src/Latency_Trace.cpp -o latency_replay
+*   ./latency_replay capture.txt [--slideshow] [--decode-ms N] [--present-ms N]
+*                                [--loop-ms N] [--double-click-ms N]
+******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "Button_Gesture.h"
+#include "Latency_Trace.h"
+
+// Gesture timings from src/main.cpp
+#define BUTTON_DEBOUNCE_TIME 20
+#define DOUBLE_CLICK_TIME    1200
+#define BUTTON_HOLD_TIME     2000
+#define ALBUM_HOLD_TIME      5000
+
+struct Edge {
+    uint32_t TimeUs;
+    bool Pressed;
+};
+
+static uint32_t median(std::vector<uint32_t> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: latency_replay FILE|- [--slideshow] [--decode-ms N] [--present-ms N]\n"
+                    "                      [--loop-ms N] [--double-click-ms N]\n");
+    exit(2);
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    bool slideshow = false;             // main.cpp starts in manual mode
+    double decodeMs = -1, presentMs = -1, loopMs = 0;
+    uint32_t doubleClickMs = DOUBLE_CLICK_TIME;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--slideshow") == 0) {
+            slideshow = true;
+        } else if (strcmp(argv[i], "--decode-ms") == 0 && i + 1 < argc) {
+            decodeMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--present-ms") == 0 && i + 1 < argc) {
+            presentMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--loop-ms") == 0 && i + 1 < argc) {
+            loopMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--double-click-ms") == 0 && i + 1 < argc) {
+            doubleClickMs = atoi(argv[++i]);
+        } else if (argv[i][0] != '-' || strcmp(argv[i], "-") == 0) {
+            path = argv[i];
+        } else {
+            usage();
+        }
+    }
+    if (path == NULL) {
+        usage();
+    }
+    FILE *in = strcmp(path, "-") == 0 ? stdin : fopen(path, "r");
+    if (in == NULL) {
+        perror(path);
+        return 1;
+    }
+
+    // "edge <us> <0|1>" and "sample <gesture> <edge> <decision> <action> <ready> <first> <last>"
+    std::vector<Edge> edges;
+    std::vector<uint32_t> toReady, toFirst, toLast;
+    char line[256];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        unsigned t, level, g, e, d, a, r, f, l;
+        if (sscanf(line, "edge %u %u", &t, &level) == 2) {
+            edges.push_back({t, level != 0});
+        } else if (sscanf(line, "sample %u %u %u %u %u %u %u", &g, &e, &d, &a, &r, &f, &l) == 7) {
+            toReady.push_back(r - a);
+            toFirst.push_back(f - r);
+            toLast.push_back(l - f);
+        }
+    }
+    if (in != stdin) {
+        fclose(in);
+    }
+    if (edges.empty()) {
+        fprintf(stderr, "%s: no 'edge' lines\n", path);
+        return 1;
+    }
+
+    uint32_t readyUs = decodeMs >= 0 ? (uint32_t)(decodeMs * 1000) : toReady.empty() ? 40000 : median(toReady);
+    uint32_t firstUs = toFirst.empty() ? 0 : median(toFirst);
+    uint32_t lastUs = presentMs >= 0 ? (uint32_t)(presentMs * 1000) : toLast.empty() ? 13000 : median(toLast);
+    uint32_t loopUs = (uint32_t)(loopMs * 1000);
+    printf("# replay: %u edges, %s mode, action +%.1f ms, ready +%.1f ms, first +%.1f ms, last +%.1f ms%s\n",
+           (unsigned)edges.size(), slideshow ? "slideshow" : "manual", loopUs / 1000.0, readyUs / 1000.0,
+           firstUs / 1000.0, lastUs / 1000.0, toReady.empty() ? "" : " (costs from recorded samples)");
+
+    BUTTON_GESTURE gesture;
+    Gesture_Init(&gesture, BUTTON_DEBOUNCE_TIME, doubleClickMs, BUTTON_HOLD_TIME, ALBUM_HOLD_TIME);
+    Latency_Reset();
+
+    // Deliver each edge, then run out the timers past the last one
+    uint32_t end = edges.back().TimeUs + (ALBUM_HOLD_TIME + doubleClickMs) * 1000;
+    for (size_t i = 0; i <= edges.size(); i++) {
+        Gesture_SetDoubleClick(&gesture, slideshow);
+        if (i < edges.size()) {
+            Gesture_Edge(&gesture, edges[i].TimeUs, edges[i].Pressed);
+        } else {
+            Gesture_Poll(&gesture, end);
+        }
+        GESTURE_EVENT event;
+        while (Gesture_Next(&gesture, &event)) {
+            printf("%-12s edge %10u  decided %10u\n", Gesture_Name(event.Type),
+                   (unsigned)event.EdgeUs, (unsigned)event.TimeUs);
+            if (event.Type == GESTURE_HOLD) {
+                continue; // LED only, nothing reaches the panel
+            }
+            if (event.Type == GESTURE_HOLD_RELEASE) {
+                slideshow = !slideshow;
+            }
+            LATENCY_SAMPLE sample;
+            sample.Gesture = event.Type;
+            sample.EdgeUs = event.EdgeUs;
+            sample.DecisionUs = event.TimeUs;
+            sample.ActionUs = event.TimeUs + loopUs;
+            sample.ReadyUs = sample.ActionUs + readyUs;
+            sample.FirstPixelUs = sample.ReadyUs + firstUs;
+            sample.LastPixelUs = sample.FirstPixelUs + lastUs;
+            Latency_AddSample(&sample);
+        }
+    }
+    Latency_Print();
+    return 0;
+}
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+Benchmark Corpus Generator for ESP32-S3 Geek
+Writes the fixed synthetic corpus the benchmark suite (src/Bench_Suite.cpp)
+reads: baseline JPEGs at three sizes, a PNG and its interlaced (Adam7)
+twin, a 24-bit BMP, a panel-ready
+.565 and a 2 MiB file for SD throughput. Everything is drawn from a fixed
+seed, and MANIFEST lists a SHA-256 per file so two runs can check they
+measured the same bytes (JPEG output can change with the Pillow version).
+
+Copy the folder to /bench on the SD card for env:benchmark, or pass it to
+the env:benchmark_native program.
+"""
+
+import argparse
+import hashlib
+import os
+import random
+import struct
+import sys
+import zlib
+
+from PIL import Image, ImageDraw
+
+from pack_565 import image_to_panel_pixels, write_565
+
+SEED = 565
+JPEG_SIZES = [(320, 240), (1280, 720), (1920, 1080)]
+JPEG_QUALITY = 85
+SD_READ_BYTES = 2 * 1024 * 1024
+
+# Adam7 passes: (x start, y start, x step, y step)
+ADAM7 = [(0, 0, 8, 8), (4, 0, 8, 8), (0, 4, 4, 8), (2, 0, 4, 4), (0, 2, 2, 4), (1, 0, 2, 2), (0, 1, 1, 2)]
+
+
+def synthetic_image(width, height, seed):
+    """Photo-like test card: smooth gradients, hard-edged shapes and a noisy band"""
+    rng = random.Random(seed)
+    img = Image.new('RGB', (width, height))
+    pixels = img.load()
+    for y in range(height):
+        for x in range(width):
+            pixels[x, y] = (x * 255 // width, y * 255 // height, (x + y) * 255 // (width + height))
+
+    draw = ImageDraw.Draw(img)
+    for _ in range(24):
+        x0, y0 = rng.randrange(width), rng.randrange(height)
+        x1, y1 = x0 + rng.randrange(width // 4 + 1), y0 + rng.randrange(height // 4 + 1)
+        color = (rng.randrange(256), rng.randrange(256), rng.randrange(256))
+        if rng.random() < 0.5:
+            draw.rectangle([x0, y0, x1, y1], fill=color)
+        else:
+            draw.ellipse([x0, y0, x1, y1], outline=color, width=3)
+
+    # High-frequency detail, the expensive case for a JPEG decoder
+    for y in range(height * 3 // 4, height):
+        for x in range(width):
+            v = rng.randrange(256)
+            pixels[x, y] = (v, 255 - v, (v * 7) & 255)
+    return img
+
+
+def png_chunk(kind, data):
+    return struct.pack('>I', len(data)) + kind + data + struct.pack('>I', zlib.crc32(kind + data))
+
+
+def write_png_adam7(path, img):
+    """8-bit RGB, interlaced: Pillow only writes non-interlaced PNGs"""
+    width, height = img.size
+    pixels = img.convert('RGB').load()
+    raw = bytearray()
+    for x0, y0, dx, dy in ADAM7:
+        xs = range(x0, width, dx)
+        if not xs:
+            continue
+        for y in range(y0, height, dy):
+            raw.append(0)  # Filter: none
+            for x in xs:
+                raw += bytes(pixels[x, y])
+    header = struct.pack('>IIBBBBB', width, height, 8, 2, 0, 0, 1)
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n' + png_chunk(b'IHDR', header) +
+                png_chunk(b'IDAT', zlib.compress(bytes(raw), 9)) + png_chunk(b'IEND', b''))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Write the benchmark corpus")
+    parser.add_argument('output', nargs='?', default='bench_corpus', help="output folder (default: bench_corpus)")
+    args = parser.parse_args()
+    os.makedirs(args.output, exist_ok=True)
+
+    files = []
+    for i, (w, h) in enumerate(JPEG_SIZES):
+        name = f"photo_{w}x{h}.jpg"
+        synthetic_image(w, h, SEED + i).save(os.path.join(args.output, name), 'JPEG',
+                                             quality=JPEG_QUALITY, progressive=False)
+        files.append(name)
+
+    small = synthetic_image(320, 240, SEED)
+    small.save(os.path.join(args.output, 'photo_320x240.png'), 'PNG')
+    write_png_adam7(os.path.join(args.output, 'photo_320x240_adam7.png'), small)
+    small.save(os.path.join(args.output, 'photo_320x240.bmp'), 'BMP')
+    files += ['photo_320x240.png', 'photo_320x240_adam7.png', 'photo_320x240.bmp']
+
+    pixels = image_to_panel_pixels(os.path.join(args.output, 'photo_320x240.png'))
+    write_565(os.path.join(args.output, 'panel.565'), pixels, rle=False, big_endian=True)
+    files.append('panel.565')
+
+    with open(os.path.join(args.output, 'sd_read.bin'), 'wb') as f:
+        f.write(random.Random(SEED).randbytes(SD_READ_BYTES))
+    files.append('sd_read.bin')
+
+    with open(os.path.join(args.output, 'MANIFEST'), 'w') as manifest:
+        for name in files:
+            with open(os.path.join(args.output, name), 'rb') as f:
+                data = f.read()
+            manifest.write(f"{hashlib.sha256(data).hexdigest()}  {len(data):8d}  {name}\n")
+            print(f"✅ {name} ({len(data)} bytes)")
+    print(f"📦 Benchmark corpus in {args.output}: copy it to /bench on the SD card")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+MJPEG Clip Builder for ESP32-S3 Geek
+Writes short MJPEG clips the firmware plays from the SD card
+(src/MJPEG_Clip.cpp): an AVI with one MJPEG video stream, or JPEG frames
+back to back (.mjpg). Frames come from a folder of images (sorted by name)
+or, without one, from a synthetic test pattern: a moving bar and the frame
+number, so dropped frames and pacing are visible on the panel.
+"""
+
+import argparse
+import glob
+import io
+import os
+import struct
+import sys
+
+from PIL import Image, ImageDraw
+
+
+def synthetic_frames(count, width, height):
+    """Test pattern: a bar sweeping across and the frame number"""
+    for n in range(count):
+        img = Image.new('RGB', (width, height), (0, 0, 0))
+        draw = ImageDraw.Draw(img)
+        x = (n * width // count)
+        draw.rectangle([x, 0, x + width // 10, height - 1], fill=(255, 140, 0))
+        draw.rectangle([2, 2, width - 3, height - 3], outline=(255, 140, 0))
+        draw.text((width // 2 - 10, height // 2 - 5), f"{n:03d}", fill=(255, 255, 255))
+        yield img
+
+
+def folder_frames(folder, width, height):
+    """Every image in a folder, sorted by name, resized to the clip size"""
+    paths = []
+    for ext in ('*.png', '*.jpg', '*.jpeg', '*.bmp'):
+        paths += glob.glob(os.path.join(folder, ext))
+    for path in sorted(paths):
+        yield Image.open(path).convert('RGB').resize((width, height), Image.Resampling.LANCZOS)
+
+
+def encode_jpeg(img, quality):
+    """Baseline JPEG bytes (progressive JPEGs are not decoded by JPEGDEC)"""
+    out = io.BytesIO()
+    img.save(out, 'JPEG', quality=quality, progressive=False, optimize=False)
+    return out.getvalue()
+
+
+def chunk(fourcc, data):
+    """RIFF chunk, padded to an even length"""
+    return fourcc + struct.pack('<I', len(data)) + data + (b'\x00' if len(data) & 1 else b'')
+
+
+def riff_list(list_type, data):
+    return b'LIST' + struct.pack('<I', len(data) + 4) + list_type + data
+
+
+def write_avi(path, jpegs, width, height, fps):
+    """Minimal AVI 1.0: hdrl (avih, one vids strl), movi with 00dc chunks, idx1"""
+    us_per_frame = int(round(1000000 / fps))
+    max_frame = max(len(j) for j in jpegs)
+    avih = struct.pack('<10I', us_per_frame, max_frame * fps, 0, 0x10, len(jpegs),
+                       0, 1, max_frame, width, height) + b'\x00' * 16
+    strh = (b'vids' + b'MJPG' + struct.pack('<IHHI', 0, 0, 0, 0) +
+            struct.pack('<7I', 1, fps, 0, len(jpegs), max_frame, 0xFFFFFFFF, 0) +
+            struct.pack('<4h', 0, 0, width, height))
+    strf = struct.pack('<IiiHH4sIiiII', 40, width, height, 1, 24, b'MJPG', width * height * 3, 0, 0, 0, 0)
+    hdrl = riff_list(b'hdrl', chunk(b'avih', avih) +
+                     riff_list(b'strl', chunk(b'strh', strh) + chunk(b'strf', strf)))
+
+    movi = b''
+    index = b''
+    for jpeg in jpegs:
+        index += b'00dc' + struct.pack('<III', 0x10, len(movi) + 4, len(jpeg))
+        movi += chunk(b'00dc', jpeg)
+    body = b'AVI ' + hdrl + riff_list(b'movi', movi) + chunk(b'idx1', index)
+    with open(path, 'wb') as f:
+        f.write(b'RIFF' + struct.pack('<I', len(body)) + body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build an MJPEG clip (.avi or .mjpg)")
+    parser.add_argument('output', help="output file, .avi or .mjpg")
+    parser.add_argument('--frames-from', help="folder of images to use as frames")
+    parser.add_argument('--count', type=int, default=60, help="synthetic frames (default 60)")
+    parser.add_argument('--size', default='240x135', help="frame size WxH (default 240x135)")
+    parser.add_argument('--fps', type=int, default=15, help="frame rate stored in the AVI (default 15)")
+    parser.add_argument('--quality', type=int, default=75, help="JPEG quality (default 75)")
+    args = parser.parse_args()
+
+    width, height = (int(v) for v in args.size.lower().split('x'))
+    if args.frames_from:
+        frames = folder_frames(args.frames_from, width, height)
+    else:
+        frames = synthetic_frames(args.count, width, height)
+    jpegs = [encode_jpeg(img, args.quality) for img in frames]
+    if not jpegs:
+        print("❌ No frames")
+        return 1
+
+    if args.output.lower().endswith('.avi'):
+        write_avi(args.output, jpegs, width, height, args.fps)
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(b''.join(jpegs))
+    total = os.path.getsize(args.output)
+    print(f"🎬 {args.output}: {len(jpegs)} frames {width}x{height}, {total} bytes "
+          f"({total // len(jpegs)} bytes/frame)")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
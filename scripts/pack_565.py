@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Panel-ready .565 Packer for ESP32-S3 Geek
+Fits, letterboxes and rotates JPEG/PNG/... images exactly like the firmware
+and writes them as .565 files (see src/Raw565_Loader.h): a 16-byte header
+followed by a 135x240 RGB565 frame in panel write order, so the firmware can
+stream the file from the SD card straight to the LCD with no decode.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from PIL import Image
+
+import rle565
+from convert_images import smart_resize_for_display, get_supported_images
+
+PANEL_WIDTH = 135
+PANEL_HEIGHT = 240
+VERSION = 1
+HEADER_SIZE = 16
+FLAG_BIG_ENDIAN = 0x01
+FLAG_RLE = 0x02
+
+
+def image_to_panel_pixels(image_path):
+    """Load an image and return the 135x240 display frame as RGB565 values"""
+    img = Image.open(image_path)
+    if hasattr(img, 'is_animated') and img.is_animated:
+        img.seek(0)
+    if img.mode in ('RGBA', 'LA', 'P'):
+        # Alpha over black, like the on-device PNG path
+        img = img.convert('RGBA')
+        background = Image.new('RGB', img.size, (0, 0, 0))
+        background.paste(img, mask=img.split()[-1])
+        img = background
+    else:
+        img = img.convert('RGB')
+
+    img = smart_resize_for_display(img, PANEL_HEIGHT, PANEL_WIDTH)
+    img = img.rotate(-90, expand=True)
+
+    pixels = []
+    for r, g, b in img.getdata():
+        pixels.append(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3))
+    return pixels
+
+
+def encode_pixels(pixels, rle, big_endian):
+    """Pixel payload bytes for the .565 container"""
+    if rle:
+        return rle565.encode(pixels, big_endian)
+    fmt = '>H' if big_endian else '<H'
+    return b''.join(struct.pack(fmt, p) for p in pixels)
+
+
+def decode_pixels(data, rle, big_endian, count):
+    """Inverse of encode_pixels, used by --verify"""
+    if rle:
+        return rle565.decode(data, count, big_endian)
+    fmt = '>H' if big_endian else '<H'
+    return [struct.unpack_from(fmt, data, i * 2)[0] for i in range(count)]
+
+
+def write_565(path, pixels, rle, big_endian):
+    """Write a .565 file; returns its size in bytes"""
+    payload = encode_pixels(pixels, rle, big_endian)
+    flags = (FLAG_BIG_ENDIAN if big_endian else 0) | (FLAG_RLE if rle else 0)
+    header = b'R565' + struct.pack('<BBHHHI', VERSION, flags, PANEL_WIDTH, PANEL_HEIGHT,
+                                   HEADER_SIZE, len(payload))
+    with open(path, 'wb') as f:
+        f.write(header)
+        f.write(payload)
+    return len(header) + len(payload)
+
+
+def pack_file(image_path, output_dir, rle, big_endian, verify):
+    """Pack one image; returns True on success"""
+    name = os.path.splitext(os.path.basename(image_path))[0] + '.565'
+    output_path = os.path.join(output_dir, name)
+    try:
+        pixels = image_to_panel_pixels(image_path)
+        size = write_565(output_path, pixels, rle, big_endian)
+        if verify:
+            with open(output_path, 'rb') as f:
+                data = f.read()[HEADER_SIZE:]
+            if decode_pixels(data, rle, big_endian, len(pixels)) != pixels:
+                print(f"❌ Verify failed: {name}")
+                return False
+        raw = PANEL_WIDTH * PANEL_HEIGHT * 2 + HEADER_SIZE
+        print(f"✅ {os.path.basename(image_path)} -> {name} ({size} bytes, {size * 100 // raw}% of raw)")
+        return True
+    except Exception as e:
+        print(f"❌ Error processing {os.path.basename(image_path)}: {str(e)}")
+        return False
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Pack images into panel-ready .565 files")
+    parser.add_argument('inputs', nargs='+', help="image files or folders")
+    parser.add_argument('-o', '--output', default='.', help="output folder (default: current)")
+    parser.add_argument('--rle', action='store_true', help="run-length pack the pixels")
+    parser.add_argument('--little-endian', action='store_true',
+                        help="store pixels little-endian (the firmware then swaps every pixel)")
+    parser.add_argument('--verify', action='store_true', help="decode each file again and compare")
+    args = parser.parse_args()
+
+    images = []
+    for item in args.inputs:
+        images += get_supported_images(item) if os.path.isdir(item) else [item]
+    if not images:
+        print("❌ No images found")
+        return 1
+
+    os.makedirs(args.output, exist_ok=True)
+    print(f"📦 Packing {len(images)} images ({'RLE' if args.rle else 'raw'}, "
+          f"{'little' if args.little_endian else 'big'}-endian)")
+    ok = sum(pack_file(p, args.output, args.rle, not args.little_endian, args.verify) for p in images)
+    print(f"📦 {ok}/{len(images)} packed into {args.output}")
+    return 0 if ok == len(images) else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
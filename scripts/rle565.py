@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+"""
+RLE565 Codec for ESP32-S3 Geek
+Run-length RGB565 packets as decoded by src/RLE565.cpp: a control byte c,
+then either one pixel repeated (c & 0x7F) + 1 times (c & 0x80 set) or c + 1
+literal pixels. Used for the linked-in status screens (build_assets.py),
+.565 files and compressed image headers.
+
+Run directly to recompress existing RGB565 headers (as written by
+convert_images.py) into RLE565 headers in place, with a round-trip check:
+    python scripts/rle565.py src/my_photo_data.h src/icon_data.h ...
+"""
+
+import os
+import re
+import struct
+import sys
+
+MAX_PACKET = 128
+
+
+def pack_rle(pixels):
+    """Split RGB565 values into (is_run, pixels) packets of at most MAX_PACKET"""
+    packets = []
+    literals = []
+    i = 0
+    while i < len(pixels):
+        run = 1
+        while i + run < len(pixels) and run < MAX_PACKET and pixels[i + run] == pixels[i]:
+            run += 1
+        if run >= 2:
+            if literals:
+                packets.append((False, literals))
+                literals = []
+            packets.append((True, [pixels[i]] * run))
+            i += run
+        else:
+            literals.append(pixels[i])
+            if len(literals) == MAX_PACKET:
+                packets.append((False, literals))
+                literals = []
+            i += 1
+    if literals:
+        packets.append((False, literals))
+    return packets
+
+
+def encode(pixels, big_endian=True):
+    """RLE565 stream for a list of RGB565 values"""
+    fmt = '>H' if big_endian else '<H'
+    out = bytearray()
+    for is_run, values in pack_rle(pixels):
+        if is_run:
+            out.append(0x80 | (len(values) - 1))
+            out += struct.pack(fmt, values[0])
+        else:
+            out.append(len(values) - 1)
+            for p in values:
+                out += struct.pack(fmt, p)
+    return bytes(out)
+
+
+def decode(data, count, big_endian=True):
+    """Inverse of encode; raises ValueError on a malformed stream"""
+    fmt = '>H' if big_endian else '<H'
+    pixels = []
+    pos = 0
+    while len(pixels) < count:
+        if pos >= len(data):
+            raise ValueError("stream ends before the last pixel")
+        control = data[pos]
+        pos += 1
+        n = (control & 0x7F) + 1
+        if len(pixels) + n > count:
+            raise ValueError("packet overruns the image")
+        if control & 0x80:
+            pixels += [struct.unpack_from(fmt, data, pos)[0]] * n
+            pos += 2
+        else:
+            pixels += [struct.unpack_from(fmt, data, pos + k * 2)[0] for k in range(n)]
+            pos += n * 2
+    return pixels
+
+
+def write_rle_header(output_path, var_name, pixels, width, height, source):
+    """Write a PROGMEM RLE565 header (var_name_rle / _rle_size / _width / _height)"""
+    data = encode(pixels)
+    if decode(data, len(pixels)) != pixels:
+        raise ValueError("round trip mismatch")
+
+    with open(output_path, 'w') as f:
+        f.write(f"// Auto-generated from {source}\n")
+        f.write(f"// Display size: {width}x{height} pixels\n")
+        f.write(f"// Format: RLE565 (see src/RLE565.h), {len(data)} bytes, {width * height * 2} bytes raw\n\n")
+        f.write(f"#ifndef {var_name.upper()}_H\n")
+        f.write(f"#define {var_name.upper()}_H\n\n")
+        f.write(f"#include <Arduino.h>\n\n")
+        f.write(f"const uint16_t {var_name}_width = {width};\n")
+        f.write(f"const uint16_t {var_name}_height = {height};\n")
+        f.write(f"const uint32_t {var_name}_rle_size = {len(data)};\n\n")
+        f.write(f"const uint8_t {var_name}_rle[] PROGMEM = {{\n")
+        for i in range(0, len(data), 16):
+            row = data[i:i + 16]
+            f.write("    " + ", ".join(f"0x{b:02X}" for b in row))
+            if i + 16 < len(data):
+                f.write(",")
+            f.write("\n")
+        f.write(f"}};\n\n")
+        f.write(f"#endif // {var_name.upper()}_H\n")
+    return len(data)
+
+
+def read_rgb565_header(path):
+    """Parse a convert_images.py header: returns (var_name, width, height, pixels, source)"""
+    with open(path) as f:
+        text = f.read()
+    array = re.search(r'const uint16_t (\w+)\[\] PROGMEM = \{(.*?)\};', text, re.S)
+    if array is None:
+        raise ValueError("no RGB565 PROGMEM array")
+    var_name = array.group(1)
+    width = int(re.search(rf'{var_name}_width = (\d+)', text).group(1))
+    height = int(re.search(rf'{var_name}_height = (\d+)', text).group(1))
+    pixels = [int(v, 16) for v in re.findall(r'0x[0-9A-Fa-f]+', array.group(2))]
+    if len(pixels) != width * height:
+        raise ValueError(f"{len(pixels)} pixels for {width}x{height}")
+    source = re.search(r'// Auto-generated from (\S+)', text)
+    return var_name, width, height, pixels, source.group(1) if source else os.path.basename(path)
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        return 1
+    failed = 0
+    for path in sys.argv[1:]:
+        try:
+            var_name, width, height, pixels, source = read_rgb565_header(path)
+            size = write_rle_header(path, var_name, pixels, width, height, source)
+            print(f"✅ {os.path.basename(path)}: {width * height * 2} -> {size} bytes "
+                  f"({width * height * 2 / size:.1f}x smaller)")
+        except Exception as e:
+            print(f"❌ {os.path.basename(path)}: {str(e)}")
+            failed += 1
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
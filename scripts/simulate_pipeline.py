@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+"""
+SD/LCD Pipeline Simulator for ESP32-S3 Geek
+Models the SD bus (sdSPI, HSPI) and the LCD bus (SPI, FSPI) with simple
+latency models and compares sequential image switching with the
+double-buffered pipeline in src/Frame_Pipeline.cpp, where image N+1 is read
+and decoded while frame N is pushed to the panel.
+This is a what-if model only; the pipeline code itself is run against the
+virtual panel by test/test_frame_pipeline (pio test -e native).
+"""
+
+import argparse
+
+LCD_FRAME_BYTES = 135 * 240 * 2   # One RGB565 frame
+LCD_ROW_BYTES = 135 * 2
+
+
+def sd_read_time_ms(file_bytes, chunk_bytes, mbps, per_read_ms):
+    """Time to stream a file in chunk-sized card reads"""
+    reads = -(-file_bytes // chunk_bytes)
+    return reads * per_read_ms + file_bytes / (mbps * 1000.0)
+
+
+def lcd_push_time_ms(spi_mhz, burst_rows, per_burst_overhead_us):
+    """Time to push one frame in row bursts (CS/DC toggled per burst)"""
+    bits = LCD_FRAME_BYTES * 8
+    bursts = -(-LCD_FRAME_BYTES // (burst_rows * LCD_ROW_BYTES))
+    return bits / (spi_mhz * 1000.0) + bursts * per_burst_overhead_us / 1000.0
+
+
+def simulate(frames, read_ms, decode_ms, present_ms, pipelined):
+    """
+    Run both buses as timelines. Each bus is owned by one stage at a time.
+    Returns (per-frame display times, trace of (stage, bus, frame, start, end)).
+    """
+    sd_free = 0.0      # SD bus (and the decode core) free from this time
+    lcd_free = 0.0     # LCD bus free from this time
+    shown = []
+    trace = []
+
+    for n in range(frames):
+        # Read + decode image n into the back frame
+        start = sd_free if pipelined else max(sd_free, lcd_free)
+        decoded = start + read_ms + decode_ms
+        trace.append(("decode", "sd", n, start, decoded))
+        sd_free = decoded
+
+        # Present needs the decoded frame and an idle LCD
+        p_start = max(decoded, lcd_free)
+        p_end = p_start + present_ms
+        trace.append(("present", "lcd", n, p_start, p_end))
+        lcd_free = p_end
+        if not pipelined:
+            sd_free = p_end
+        else:
+            # The back frame is reused only after the previous swap
+            sd_free = max(sd_free, p_start)
+        shown.append(p_end)
+
+    return shown, trace
+
+
+def overlap_ms(trace):
+    """Total time during which an SD stage and an LCD stage ran together"""
+    total = 0.0
+    for i, a in enumerate(trace):
+        for b in trace[:i]:
+            if a[1] != b[1]:
+                total += max(0.0, min(a[4], b[4]) - max(a[3], b[3]))
+    return total
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Simulate SD/LCD overlap")
+    parser.add_argument("--frames", type=int, default=10)
+    parser.add_argument("--file-kb", type=int, default=120, help="JPEG size on card")
+    parser.add_argument("--chunk-kb", type=int, default=16, help="SD_READER_CHUNK_SIZE")
+    parser.add_argument("--sd-mbps", type=float, default=4.0, help="Sustained SD throughput")
+    parser.add_argument("--sd-latency-ms", type=float, default=0.4, help="Per card read")
+    parser.add_argument("--decode-ms", type=float, default=90.0, help="Decode + transform CPU time")
+    parser.add_argument("--lcd-mhz", type=float, default=40.0, help="LCD SPI clock")
+    parser.add_argument("--lcd-burst-rows", type=int, default=16, help="Rows per byte-swapped burst")
+    parser.add_argument("--lcd-burst-us", type=float, default=5.0, help="Per-burst CS/DC and setup overhead")
+    parser.add_argument("--trace", action="store_true", help="Print the stage trace")
+    args = parser.parse_args()
+
+    read_ms = sd_read_time_ms(args.file_kb * 1024, args.chunk_kb * 1024,
+                              args.sd_mbps, args.sd_latency_ms)
+    present_ms = lcd_push_time_ms(args.lcd_mhz, args.lcd_burst_rows, args.lcd_burst_us)
+
+    print("🔄 SD/LCD Pipeline Simulator")
+    print("=" * 60)
+    print(f"SD read:  {read_ms:7.1f} ms per image ({args.file_kb} KB)")
+    print(f"Decode:   {args.decode_ms:7.1f} ms per image")
+    print(f"Present:  {present_ms:7.1f} ms per frame ({LCD_FRAME_BYTES} bytes)")
+    print("=" * 60)
+
+    results = {}
+    for name, pipelined in (("sequential", False), ("pipelined", True)):
+        shown, trace = simulate(args.frames, read_ms, args.decode_ms, present_ms, pipelined)
+        period = (shown[-1] - shown[0]) / max(1, len(shown) - 1)
+        results[name] = period
+        print(f"{name:>10}: {period:7.1f} ms per image, "
+              f"{1000.0 / period:5.2f} images/s, overlap {overlap_ms(trace):8.1f} ms")
+        if args.trace:
+            for stage, bus, frame, start, end in trace:
+                print(f"    {stage:<8} {bus:<4} {frame:3d} {start:9.1f} {end - start:8.1f}")
+
+    saved = results["sequential"] - results["pipelined"]
+    print("=" * 60)
+    if saved > 0:
+        print(f"✅ Pipeline saves {saved:.1f} ms per image "
+              f"(bound by {'SD + decode' if read_ms + args.decode_ms >= present_ms else 'LCD push'})")
+    else:
+        print("❌ No overlap gained with these parameters")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,368 @@
+/*****************************************************************************
+* | File        :   Album_Index.cpp
+* | Function    :   SD card album discovery and per-folder lazy indexing
+******************************************************************************/
+#include "Album_Index.h"
+#include "Heap_Telemetry.h"
+#include <Arduino.h>
+#include <SD.h>
+#include <FS.h>
+
+static ALBUM albums[ALBUM_MAX_ALBUMS];
+static int albumCount = 0;
+static int currentAlbum = -1;
+
+// File names of indexed albums, packed back to back in one pool
+static char *namePool = NULL;
+static uint32_t namePoolUsed = 0;
+static uint32_t *entryOffsets = NULL;
+static uint16_t entryCount = 0;
+
+// Discovery state: the directories from the root down to the one being read,
+// each with its iterator open
+#define SCAN_NO_ALBUM  -1       // No image seen in the folder yet
+#define SCAN_SKIPPED   -2       // Has images, but the album table was full
+
+typedef struct {
+    File Dir;
+    char Path[ALBUM_MAX_PATH];
+    int Album;                  // Its albums[] slot, or SCAN_NO_ALBUM / SCAN_SKIPPED
+} SCAN_DIR;
+
+static SCAN_DIR scanStack[ALBUM_MAX_DEPTH];
+static int scanDepth = 0;
+static bool scanRootPending = false; // Root path in scanStack[0], opened by the first step
+static uint16_t skippedDirs = 0;
+static SCAN_STATE scanState = SCAN_IDLE;
+
+static const char *IMAGE_EXTENSIONS[] = {".jpg", ".jpeg", ".bmp", ".png", ".gif", ".565", ".avi", ".mjpg", ".mjpeg"};
+
+bool Album_IsImageFile(const char *name)
+{
+    const char *dot = strrchr(name, '.');
+    if (dot == NULL || name[0] == '.') {
+        return false; // No extension, or a hidden/resource-fork file
+    }
+    for (size_t i = 0; i < sizeof(IMAGE_EXTENSIONS) / sizeof(IMAGE_EXTENSIONS[0]); i++) {
+        if (strcasecmp(dot, IMAGE_EXTENSIONS[i]) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const char *baseName(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+static bool joinPath(char *out, int len, const char *dir, const char *name)
+{
+    int n;
+    if (strcmp(dir, "/") == 0) {
+        n = snprintf(out, len, "/%s", name);
+    } else {
+        n = snprintf(out, len, "%s/%s", dir, name);
+    }
+    return n > 0 && n < len;
+}
+
+bool Album_Init(void)
+{
+    if (namePool == NULL) {
+        namePool = (char *)Heap_Alloc(HEAP_CATALOGUE, ALBUM_NAME_POOL_SIZE, HEAP_CAP_DEFAULT);
+        entryOffsets = (uint32_t *)Heap_Alloc(HEAP_CATALOGUE, ALBUM_MAX_FILES * sizeof(uint32_t), HEAP_CAP_DEFAULT);
+        if (namePool == NULL || entryOffsets == NULL) {
+            Heap_Free(namePool);
+            Heap_Free(entryOffsets);
+            namePool = NULL;
+            entryOffsets = NULL;
+            return false;
+        }
+    }
+    Album_Reset();
+    return true;
+}
+
+void Album_Reset(void)
+{
+    Album_ScanCancel();
+    scanState = SCAN_IDLE;
+    albumCount = 0;
+    currentAlbum = -1;
+    namePoolUsed = 0;
+    entryCount = 0;
+}
+
+/******************************************************************************
+function: Discovery
+info:
+    Album_ScanBegin records the root; each Album_ScanStep then visits at most
+    `budget` directory entries, so the caller decides how long it may block.
+    A sub-folder is descended into as soon as it is listed, reusing its
+    entry as the iterator, and its parent carries on where it stopped once
+    it is done. Folders deeper than ALBUM_MAX_DEPTH or with too long a path,
+    and albums past ALBUM_MAX_ALBUMS, are counted in Album_SkippedDirs().
+******************************************************************************/
+void Album_ScanBegin(const char *root)
+{
+    Album_ScanCancel();
+    albumCount = 0;
+    currentAlbum = -1;
+    namePoolUsed = 0;
+    entryCount = 0;
+    skippedDirs = 0;
+
+    strncpy(scanStack[0].Path, root, ALBUM_MAX_PATH - 1);
+    scanStack[0].Path[ALBUM_MAX_PATH - 1] = '\0';
+    scanDepth = 0;
+    scanRootPending = true;
+    scanState = SCAN_RUNNING;
+}
+
+// Make `dir` (already open) the folder being read
+static void pushScanDir(File &dir)
+{
+    SCAN_DIR &top = scanStack[scanDepth++];
+    top.Dir = dir;
+    top.Album = SCAN_NO_ALBUM;
+}
+
+// An image in the folder being read: its first one makes the folder an album
+static void countImage(SCAN_DIR &dir)
+{
+    if (dir.Album == SCAN_NO_ALBUM) {
+        if (albumCount >= ALBUM_MAX_ALBUMS) {
+            dir.Album = SCAN_SKIPPED;
+            skippedDirs++;
+            return;
+        }
+        dir.Album = albumCount;
+        ALBUM &album = albums[albumCount++];
+        strcpy(album.Path, dir.Path);
+        album.ImageCount = 0;
+        album.Indexed = false;
+        album.FirstEntry = 0;
+        album.EntryCount = 0;
+    }
+    if (dir.Album >= 0 && albums[dir.Album].ImageCount < UINT16_MAX) {
+        albums[dir.Album].ImageCount++;
+    }
+}
+
+SCAN_STATE Album_ScanStep(int budget)
+{
+    while (scanState == SCAN_RUNNING && budget > 0) {
+        if (scanRootPending) {
+            scanRootPending = false;
+            File root = SD.open(scanStack[0].Path);
+            if (!root || !root.isDirectory()) {
+                if (root) root.close();
+                scanState = SCAN_DONE;
+                break;
+            }
+            pushScanDir(root);
+            continue;
+        }
+        if (scanDepth == 0) {
+            scanState = SCAN_DONE;
+            break;
+        }
+
+        SCAN_DIR &dir = scanStack[scanDepth - 1];
+        File entry = dir.Dir.openNextFile();
+        budget--;
+        if (!entry) {
+            dir.Dir.close();
+            scanDepth--;
+            continue;
+        }
+
+        const char *name = baseName(entry.name());
+        if (entry.isDirectory()) {
+            if (name[0] == '.') {
+                entry.close();
+            } else if (scanDepth < ALBUM_MAX_DEPTH &&
+                       joinPath(scanStack[scanDepth].Path, ALBUM_MAX_PATH, dir.Path, name)) {
+                pushScanDir(entry);
+            } else {
+                skippedDirs++;
+                entry.close();
+            }
+            continue;
+        }
+        if (Album_IsImageFile(name)) {
+            countImage(dir);
+        }
+        entry.close();
+    }
+    return scanState;
+}
+
+void Album_ScanPause(void)
+{
+    if (scanState == SCAN_RUNNING) {
+        scanState = SCAN_PAUSED;
+    }
+}
+
+void Album_ScanResume(void)
+{
+    if (scanState == SCAN_PAUSED) {
+        scanState = SCAN_RUNNING;
+    }
+}
+
+void Album_ScanCancel(void)
+{
+    while (scanDepth > 0) {
+        scanStack[--scanDepth].Dir.close();
+    }
+    scanRootPending = false;
+    if (scanState == SCAN_RUNNING || scanState == SCAN_PAUSED) {
+        scanState = SCAN_CANCELLED;
+    }
+}
+
+SCAN_STATE Album_ScanState(void)
+{
+    return scanState;
+}
+
+uint16_t Album_SkippedDirs(void)
+{
+    return skippedDirs;
+}
+
+/******************************************************************************
+function: Albums
+******************************************************************************/
+int Album_Count(void)
+{
+    return albumCount;
+}
+
+const ALBUM *Album_Get(int album)
+{
+    if (album < 0 || album >= albumCount) {
+        return NULL;
+    }
+    return &albums[album];
+}
+
+int Album_Current(void)
+{
+    return currentAlbum;
+}
+
+static int compareEntries(const void *a, const void *b)
+{
+    return strcasecmp(namePool + *(const uint32_t *)a, namePool + *(const uint32_t *)b);
+}
+
+static void dropIndexes(void)
+{
+    for (int i = 0; i < albumCount; i++) {
+        albums[i].Indexed = false;
+    }
+    namePoolUsed = 0;
+    entryCount = 0;
+}
+
+// Append the image names of one folder to the pool; false when it ran out
+static bool indexAlbum(ALBUM &album, bool *truncated)
+{
+    File dir = SD.open(album.Path);
+    if (!dir || !dir.isDirectory()) {
+        if (dir) dir.close();
+        return false;
+    }
+
+    album.FirstEntry = entryCount;
+    album.EntryCount = 0;
+    *truncated = false;
+
+    File entry = dir.openNextFile();
+    while (entry) {
+        const char *name = baseName(entry.name());
+        if (!entry.isDirectory() && Album_IsImageFile(name)) {
+            uint32_t len = strlen(name) + 1;
+            if (entryCount >= ALBUM_MAX_FILES || namePoolUsed + len > ALBUM_NAME_POOL_SIZE) {
+                *truncated = true;
+                entry.close();
+                break;
+            }
+            memcpy(namePool + namePoolUsed, name, len);
+            entryOffsets[entryCount++] = namePoolUsed;
+            namePoolUsed += len;
+            album.EntryCount++;
+        }
+        entry.close();
+        entry = dir.openNextFile();
+    }
+    dir.close();
+
+    qsort(&entryOffsets[album.FirstEntry], album.EntryCount, sizeof(uint32_t), compareEntries);
+    album.Indexed = true;
+    return true;
+}
+
+/******************************************************************************
+function: Make an album current, indexing it on first entry
+info:
+    Indexes stay cached in the shared pool until it fills up; then all cached
+    indexes are dropped and the pool is rebuilt for the album being entered.
+    Discovery is paused meanwhile so only one directory walk hits the card.
+******************************************************************************/
+bool Album_Enter(int album)
+{
+    if (album < 0 || album >= albumCount || namePool == NULL) {
+        return false;
+    }
+    ALBUM &target = albums[album];
+    if (target.Indexed) {
+        currentAlbum = album;
+        return true;
+    }
+
+    bool wasRunning = (scanState == SCAN_RUNNING);
+    Album_ScanPause();
+
+    bool truncated = false;
+    bool ok = indexAlbum(target, &truncated);
+    if (ok && truncated && target.FirstEntry > 0) {
+        // Evict the other cached albums and try again from an empty pool
+        dropIndexes();
+        ok = indexAlbum(target, &truncated);
+    }
+
+    if (wasRunning) {
+        Album_ScanResume();
+    }
+    if (!ok) {
+        return false;
+    }
+    currentAlbum = album;
+    return true;
+}
+
+/******************************************************************************
+function: Files of the current album
+******************************************************************************/
+int Album_FileCount(void)
+{
+    if (currentAlbum < 0) {
+        return 0;
+    }
+    return albums[currentAlbum].EntryCount;
+}
+
+bool Album_FilePath(int file, char *path, int len)
+{
+    if (currentAlbum < 0 || file < 0 || file >= albums[currentAlbum].EntryCount) {
+        return false;
+    }
+    const ALBUM &album = albums[currentAlbum];
+    return joinPath(path, len, album.Path, namePool + entryOffsets[album.FirstEntry + file]);
+}
@@ -0,0 +1,64 @@
+/*****************************************************************************
+* | File        :   Album_Index.h
+* | Function    :   SD card album discovery and per-folder lazy indexing
+* | Info        :
+*   Every folder on the card that holds at least one image is an album.
+*   Discovery walks the tree depth-first with a stack of open directory
+*   iterators (no recursion, memory bound by depth, never by how many
+*   siblings a folder has) and can be paused, resumed and cancelled.
+*   Albums are numbered in the order their first image is found.
+*   The file list of an album is only built the first time it is entered.
+******************************************************************************/
+#ifndef __ALBUM_INDEX_H
+#define __ALBUM_INDEX_H
+
+#include <stdint.h>
+
+#define ALBUM_MAX_ALBUMS     64      // Albums remembered by discovery
+#define ALBUM_MAX_PATH       96      // Longest folder/file path handled
+#define ALBUM_MAX_DEPTH      8       // Folder levels open at once, the root included
+#define ALBUM_MAX_FILES      4096    // Files indexed across cached albums
+#define ALBUM_NAME_POOL_SIZE (64 * 1024) // Bytes of file names across cached albums
+#define ALBUM_SCAN_BUDGET    16      // Directory entries visited per scan step
+
+typedef enum {
+    SCAN_IDLE = 0,
+    SCAN_RUNNING,
+    SCAN_PAUSED,
+    SCAN_DONE,
+    SCAN_CANCELLED,
+} SCAN_STATE;
+
+typedef struct {
+    char Path[ALBUM_MAX_PATH];  // Folder path, "/" for the card root
+    uint16_t ImageCount;        // Images seen during discovery
+    bool Indexed;               // File list present in the name pool
+    uint16_t FirstEntry;        // First slot in the entry table
+    uint16_t EntryCount;        // Indexed files (sorted by name)
+} ALBUM;
+
+bool Album_Init(void);
+void Album_Reset(void);
+
+// Discovery
+void Album_ScanBegin(const char *root);
+SCAN_STATE Album_ScanStep(int budget);
+void Album_ScanPause(void);
+void Album_ScanResume(void);
+void Album_ScanCancel(void);
+SCAN_STATE Album_ScanState(void);
+uint16_t Album_SkippedDirs(void);
+
+// Albums
+int Album_Count(void);
+const ALBUM *Album_Get(int album);
+int Album_Current(void);
+bool Album_Enter(int album);
+
+// Files of the current album
+int Album_FileCount(void);
+bool Album_FilePath(int file, char *path, int len);
+
+bool Album_IsImageFile(const char *name);
+
+#endif
@@ -0,0 +1,202 @@
+/*****************************************************************************
+* | File        :   Asset_Pack.cpp
+* | Function    :   Status and fallback images mapped from a flash partition
+******************************************************************************/
+#include "Asset_Pack.h"
+#include "LCD_Scroll.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#include <esp_spi_flash.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const uint8_t *packBase = NULL;
+static uint32_t packSize = 0;
+static ASSET entries[ASSET_PACK_MAX_ENTRIES];
+static int entryCount = 0;
+
+#ifdef ARDUINO
+static spi_flash_mmap_handle_t mapHandle;
+static bool mapped = false;
+#else
+static void *fileMap = NULL;
+static size_t fileMapSize = 0;
+#endif
+
+/******************************************************************************
+function: Index a pack that is already in the address space
+info:
+    Every entry is bounds-checked against the pack, so a half-written or
+    foreign partition is rejected rather than read past its end, and its
+    dimensions against the panel, since status screens are drawn at its
+    origin.
+******************************************************************************/
+bool AssetPack_Attach(const uint8_t *base, uint32_t size)
+{
+    ASSET_PACK_HEADER header;
+
+    entryCount = 0;
+    packBase = NULL;
+    packSize = 0;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.Magic, ASSET_PACK_MAGIC, 4) != 0 || header.Version != ASSET_PACK_VERSION ||
+        header.DataSize > size || header.Count > ASSET_PACK_MAX_ENTRIES ||
+        sizeof(header) + header.Count * sizeof(ASSET_PACK_ENTRY) > header.DataSize) {
+        return false;
+    }
+
+    for (int i = 0; i < header.Count; i++) {
+        ASSET_PACK_ENTRY entry;
+        memcpy(&entry, base + sizeof(header) + i * sizeof(entry), sizeof(entry));
+        if (entry.Name[ASSET_PACK_NAME_LEN - 1] != '\0' || entry.Offset > header.DataSize ||
+            entry.Size > header.DataSize - entry.Offset || entry.Format != ASSET_FORMAT_RLE565 ||
+            entry.Width < 1 || entry.Width > LCD_WIDTH || entry.Height < 1 || entry.Height > LCD_HEIGHT) {
+            entryCount = 0;
+            return false;
+        }
+        // Names point into the directory itself; nothing is copied but the index
+        ASSET *asset = &entries[entryCount++];
+        asset->Name = (const char *)(base + sizeof(header) + i * sizeof(entry));
+        asset->Data = base + entry.Offset;
+        asset->Size = entry.Size;
+        asset->Width = entry.Width;
+        asset->Height = entry.Height;
+        asset->Format = entry.Format;
+    }
+    packBase = base;
+    packSize = header.DataSize;
+    return true;
+}
+
+/******************************************************************************
+function: Map the 'assets' partition
+info:
+    Only the header is read through the flash driver; if it is valid, the
+    bytes it says are in use are mapped into the data cache address space.
+******************************************************************************/
+bool AssetPack_Mount(void)
+{
+    AssetPack_Unmount();
+#ifdef ARDUINO
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)ASSET_PACK_SUBTYPE, ASSET_PACK_LABEL);
+    ASSET_PACK_HEADER header;
+    if (partition == NULL || esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK ||
+        memcmp(header.Magic, ASSET_PACK_MAGIC, 4) != 0 || header.DataSize > partition->size) {
+        return false; // Missing, erased (all 0xFF) or not a pack
+    }
+
+    const void *base = NULL;
+    if (esp_partition_mmap(partition, 0, header.DataSize, SPI_FLASH_MMAP_DATA, &base, &mapHandle) != ESP_OK) {
+        return false;
+    }
+    mapped = true;
+    if (!AssetPack_Attach((const uint8_t *)base, header.DataSize)) {
+        AssetPack_Unmount();
+        return false;
+    }
+    return true;
+#else
+    return false; // No partitions on the host: AssetPack_MountFile()
+#endif
+}
+
+#ifndef ARDUINO
+// Map a partition image file (build_assets.py --partition) read-only
+bool AssetPack_MountFile(const char *path)
+{
+    AssetPack_Unmount();
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    fileMap = base;
+    fileMapSize = st.st_size;
+    if (!AssetPack_Attach((const uint8_t *)base, (uint32_t)st.st_size)) {
+        AssetPack_Unmount();
+        return false;
+    }
+    return true;
+}
+#endif
+
+void AssetPack_Unmount(void)
+{
+    entryCount = 0;
+    packBase = NULL;
+    packSize = 0;
+#ifdef ARDUINO
+    if (mapped) {
+        spi_flash_munmap(mapHandle);
+        mapped = false;
+    }
+#else
+    if (fileMap != NULL) {
+        munmap(fileMap, fileMapSize);
+        fileMap = NULL;
+        fileMapSize = 0;
+    }
+#endif
+}
+
+bool AssetPack_IsMounted(void)
+{
+    return packBase != NULL;
+}
+
+uint32_t AssetPack_Size(void)
+{
+    return packSize;
+}
+
+int AssetPack_Count(void)
+{
+    return entryCount;
+}
+
+const ASSET *AssetPack_Get(int index)
+{
+    return index >= 0 && index < entryCount ? &entries[index] : NULL;
+}
+
+const ASSET *AssetPack_Find(const char *name)
+{
+    for (int i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].Name, name) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/******************************************************************************
+function: The image to show for a registry id
+info:
+    The partition's copy when one is mounted and carries that name, so
+    updated artwork wins; otherwise the one linked into the app.
+******************************************************************************/
+const ASSET *Asset_Resolve(ASSET_ID id)
+{
+    const ASSET *linked = Asset_Get(id);
+    const ASSET *packed = linked != NULL ? AssetPack_Find(linked->Name) : NULL;
+    return packed != NULL ? packed : linked;
+}
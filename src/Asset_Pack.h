@@ -0,0 +1,60 @@
+/*****************************************************************************
+* | File        :   Asset_Pack.h
+* | Function    :   Status and fallback images mapped from a flash partition
+* | Info        :
+*   The 'assets' data partition (partitions.csv) holds a pack written by
+*   scripts/build_assets.py --partition: a directory of named images
+*   followed by their data. The partition is memory-mapped, so images are
+*   read in place through the flash cache with no copy into RAM, and they
+*   can be replaced with esptool without reflashing the app.
+*   An erased or invalid partition is simply not mounted: callers fall back
+*   to the images linked into the app (Asset_Registry.h).
+*   Without ARDUINO, AssetPack_MountFile() maps a partition image file.
+******************************************************************************/
+#ifndef __ASSET_PACK_H
+#define __ASSET_PACK_H
+
+#include <stdint.h>
+#include "Asset_Registry.h"
+
+#define ASSET_PACK_MAGIC       "APAK"
+#define ASSET_PACK_VERSION     1
+#define ASSET_PACK_NAME_LEN    24
+#define ASSET_PACK_MAX_ENTRIES 32
+#define ASSET_PACK_SUBTYPE     0x40     // Data partition subtype in partitions.csv
+#define ASSET_PACK_LABEL       "assets"
+
+// Little-endian, 16 bytes, at the start of the partition
+typedef struct {
+    char Magic[4];          // "APAK"
+    uint16_t Version;
+    uint16_t Count;         // Directory entries that follow
+    uint32_t DataSize;      // Bytes used, header included
+    uint32_t Reserved;
+} ASSET_PACK_HEADER;
+
+// 40 bytes each, right after the header
+typedef struct {
+    char Name[ASSET_PACK_NAME_LEN]; // NUL-terminated
+    uint32_t Offset;        // From the start of the partition, 4-byte aligned
+    uint32_t Size;
+    uint16_t Width;
+    uint16_t Height;
+    uint8_t Format;         // ASSET_FORMAT
+    uint8_t Reserved[3];
+} ASSET_PACK_ENTRY;
+
+bool AssetPack_Mount(void);
+#ifndef ARDUINO
+bool AssetPack_MountFile(const char *path);
+#endif
+bool AssetPack_Attach(const uint8_t *base, uint32_t size);
+void AssetPack_Unmount(void);
+bool AssetPack_IsMounted(void);
+uint32_t AssetPack_Size(void);
+int AssetPack_Count(void);
+const ASSET *AssetPack_Get(int index);
+const ASSET *AssetPack_Find(const char *name);
+const ASSET *Asset_Resolve(ASSET_ID id);
+
+#endif
@@ -0,0 +1,44 @@
+/*****************************************************************************
+* | File        :   Asset_Registry.cpp
+* | Function    :   Images linked into the firmware
+* | Info        :
+*   Generated by scripts/build_assets.py - do not edit.
+******************************************************************************/
+#include "Asset_Registry.h"
+#include <string.h>
+
+#ifdef ARDUINO
+// objcopy names each embedded file after its path in the project
+extern const uint8_t no_sd_card_start[] asm("_binary_assets_status_no_sd_card_rle565_start");
+extern const uint8_t no_images_found_start[] asm("_binary_assets_status_no_images_found_rle565_start");
+extern const uint8_t scanning_start[] asm("_binary_assets_status_scanning_rle565_start");
+extern const uint8_t manual_mode_start[] asm("_binary_assets_status_manual_mode_rle565_start");
+extern const uint8_t slideshow_mode_start[] asm("_binary_assets_status_slideshow_mode_rle565_start");
+#define LINKED(_data, _size) _data, _size
+#else
+// Host builds have no embed_files step: names and dimensions stay, data is absent
+#define LINKED(_data, _size) NULL, 0
+#endif
+
+static const ASSET assets[ASSET_COUNT] = {
+    {"no_sd_card", LINKED(no_sd_card_start, 5972), 135, 240, ASSET_FORMAT_RLE565},
+    {"no_images_found", LINKED(no_images_found_start, 5949), 135, 240, ASSET_FORMAT_RLE565},
+    {"scanning", LINKED(scanning_start, 5105), 135, 240, ASSET_FORMAT_RLE565},
+    {"manual_mode", LINKED(manual_mode_start, 5520), 135, 240, ASSET_FORMAT_RLE565},
+    {"slideshow_mode", LINKED(slideshow_mode_start, 8725), 135, 240, ASSET_FORMAT_RLE565},
+};
+
+const ASSET *Asset_Get(ASSET_ID id)
+{
+    return (unsigned)id < ASSET_COUNT ? &assets[id] : NULL;
+}
+
+const ASSET *Asset_Find(const char *name)
+{
+    for (int i = 0; i < ASSET_COUNT; i++) {
+        if (strcmp(assets[i].Name, name) == 0) {
+            return &assets[i];
+        }
+    }
+    return NULL;
+}
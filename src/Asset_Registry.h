@@ -0,0 +1,40 @@
+/*****************************************************************************
+* | File        :   Asset_Registry.h
+* | Function    :   Images linked into the firmware
+* | Info        :
+*   Generated by scripts/build_assets.py - do not edit.
+*   Each asset is a file under assets/ that board_build.embed_files links
+*   into flash as-is; the registry gives its address, size, dimensions and
+*   format. RLE565 assets are drawn with RLE565_DrawImage.
+******************************************************************************/
+#ifndef __ASSET_REGISTRY_H
+#define __ASSET_REGISTRY_H
+
+#include <stdint.h>
+
+typedef enum {
+    ASSET_FORMAT_RLE565 = 0,    // src/RLE565.h packets, big-endian pixels
+} ASSET_FORMAT;
+
+typedef enum {
+    ASSET_NO_SD_CARD = 0,
+    ASSET_NO_IMAGES_FOUND,
+    ASSET_SCANNING,
+    ASSET_MANUAL_MODE,
+    ASSET_SLIDESHOW_MODE,
+    ASSET_COUNT
+} ASSET_ID;
+
+typedef struct {
+    const char *Name;
+    const uint8_t *Data;
+    uint32_t Size;
+    uint16_t Width;
+    uint16_t Height;
+    uint8_t Format;             // ASSET_FORMAT
+} ASSET;
+
+const ASSET *Asset_Get(ASSET_ID id);
+const ASSET *Asset_Find(const char *name);
+
+#endif
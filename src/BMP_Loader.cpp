@@ -0,0 +1,218 @@
+/*****************************************************************************
+* | File        :   BMP_Loader.cpp
+* | Function    :   Streaming BMP loader (16-bit RGB565/RGB555 and 24-bit BGR)
+******************************************************************************/
+#include "BMP_Loader.h"
+#include "LCD_Driver.h"
+#include "Frame_Transform.h"
+#include "Heap_Telemetry.h"
+#include <string.h>
+#include <stdlib.h>
+
+#define BI_RGB       0
+#define BI_BITFIELDS 3
+
+static uint16_t le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool BMP_ReadHeader(SD_READER *reader, BMP_INFO *info)
+{
+    uint8_t header[66];
+    memset(header, 0, sizeof(header));
+    SDReader_Seek(reader, 0);
+    if (SDReader_Read(reader, header, sizeof(header)) < 54) {
+        return false;
+    }
+    if (header[0] != 'B' || header[1] != 'M') {
+        return false;
+    }
+
+    uint32_t headerSize = le32(&header[14]);
+    int32_t width = (int32_t)le32(&header[18]);
+    int32_t height = (int32_t)le32(&header[22]);
+    uint16_t bpp = le16(&header[28]);
+    uint32_t compression = le32(&header[30]);
+
+    if (headerSize < 40 || width <= 0 || width > BMP_MAX_WIDTH || height == 0) {
+        return false;
+    }
+    if (!((bpp == 24 && compression == BI_RGB) ||
+          (bpp == 16 && (compression == BI_RGB || compression == BI_BITFIELDS)))) {
+        return false; // Palette, RLE and 32-bit images are not handled
+    }
+
+    info->Width = width;
+    info->TopDown = height < 0;
+    info->Height = height < 0 ? -height : height;
+    info->BitsPerPixel = bpp;
+    info->DataOffset = le32(&header[10]);
+    info->RowStride = ((uint32_t)width * bpp / 8 + 3) & ~3u;
+
+    if (bpp == 16 && compression == BI_BITFIELDS) {
+        // Masks follow a 40-byte header and sit at the same offset inside V4/V5 headers
+        info->Masks[0] = le32(&header[54]);
+        info->Masks[1] = le32(&header[58]);
+        info->Masks[2] = le32(&header[62]);
+    } else {
+        info->Masks[0] = 0x7C00; // BI_RGB 16-bit is X1R5G5B5
+        info->Masks[1] = 0x03E0;
+        info->Masks[2] = 0x001F;
+    }
+    info->Is565 = (bpp == 16 && info->Masks[0] == 0xF800 &&
+                   info->Masks[1] == 0x07E0 && info->Masks[2] == 0x001F);
+
+    return info->DataOffset + info->RowStride * info->Height <= SDReader_Size(reader);
+}
+
+bool BMP_IsPanelNative(const BMP_INFO *info)
+{
+    // Landscape 240x135 rotates onto the 135x240 panel one row per column
+    return info->Is565 && info->Width == LCD_HEIGHT && info->Height == LCD_WIDTH;
+}
+
+/******************************************************************************
+function: 16-bit mask conversion
+******************************************************************************/
+typedef struct {
+    uint8_t Shift[3];
+    uint8_t Bits[3];
+} MASK_SHIFTS;
+
+static void maskShifts(const BMP_INFO *info, MASK_SHIFTS *shifts)
+{
+    for (int c = 0; c < 3; c++) {
+        uint32_t mask = info->Masks[c];
+        uint8_t shift = 0, bits = 0;
+        while (mask != 0 && (mask & 1) == 0) {
+            mask >>= 1;
+            shift++;
+        }
+        while (mask & 1) {
+            mask >>= 1;
+            bits++;
+        }
+        shifts->Shift[c] = shift;
+        shifts->Bits[c] = bits;
+    }
+}
+
+// Rescale one channel from `bits` to `to` bits
+static uint16_t channel(uint16_t pixel, uint32_t mask, uint8_t shift, uint8_t bits, uint8_t to)
+{
+    if (bits == 0) {
+        return 0;
+    }
+    uint32_t v = (pixel & mask) >> shift;
+    if (bits >= to) {
+        return v >> (bits - to);
+    }
+    uint32_t out = v << (to - bits);
+    if (2 * bits >= to) {
+        out |= v >> (2 * bits - to); // Replicate the top bits into the gap
+    }
+    return out;
+}
+
+// Convert one stored row to native RGB565
+static void convertRow(const uint8_t *src, uint16_t *dst, const BMP_INFO *info, const MASK_SHIFTS *shifts)
+{
+    if (info->BitsPerPixel == 24) {
+        for (int x = 0; x < info->Width; x++, src += 3) { // Stored as B, G, R
+            dst[x] = ((src[2] & 0xF8) << 8) | ((src[1] & 0xFC) << 3) | (src[0] >> 3);
+        }
+    } else if (info->Is565) {
+        memcpy(dst, src, info->Width * 2);
+    } else {
+        for (int x = 0; x < info->Width; x++, src += 2) {
+            uint16_t pixel = le16(src);
+            dst[x] = (channel(pixel, info->Masks[0], shifts->Shift[0], shifts->Bits[0], 5) << 11) |
+                     (channel(pixel, info->Masks[1], shifts->Shift[1], shifts->Bits[1], 6) << 5) |
+                     channel(pixel, info->Masks[2], shifts->Shift[2], shifts->Bits[2], 5);
+        }
+    }
+}
+
+/******************************************************************************
+function: Decode into a 135x240 display frame
+info:
+    Rows are visited in file order; those no display column samples are
+    seeked past. Peak memory is the stored row plus its RGB565 copy.
+******************************************************************************/
+bool BMP_DecodeToFrame(SD_READER *reader, const BMP_INFO *info, uint16_t *frame)
+{
+    static FRAME_TRANSFORM transform;
+    const uint32_t rowBytes = (uint32_t)info->Width * info->BitsPerPixel / 8;
+
+    uint8_t *row = (uint8_t *)Heap_Alloc(HEAP_LINES, rowBytes, HEAP_CAP_DEFAULT);
+    uint16_t *line = (uint16_t *)Heap_Alloc(HEAP_LINES, info->Width * sizeof(uint16_t), HEAP_CAP_DEFAULT);
+    if (row == NULL || line == NULL) {
+        Heap_Free(row);
+        Heap_Free(line);
+        return false;
+    }
+    Transform_Init(&transform, info->Width, info->Height);
+    MASK_SHIFTS shifts;
+    maskShifts(info, &shifts);
+    memset(frame, 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+
+    bool ok = true;
+    for (int i = 0; i < info->Height; i++) {
+        int sy = info->TopDown ? i : info->Height - 1 - i;
+        if (!Transform_RowUsed(&transform, sy)) {
+            continue;
+        }
+
+        SDReader_Seek(reader, info->DataOffset + (uint32_t)i * info->RowStride);
+        if (SDReader_Read(reader, row, rowBytes) != (int32_t)rowBytes) {
+            ok = false;
+            break;
+        }
+        convertRow(row, line, info, &shifts);
+        Transform_PutRow(&transform, frame, sy, line);
+    }
+
+    Heap_Free(row);
+    Heap_Free(line);
+    return ok;
+}
+
+/******************************************************************************
+function: Zero-conversion path for panel-native BMPs
+info:
+    File row i of a 240x135 RGB565 image is display column 134 - sy, top to
+    bottom, already in the panel's pixel format. Rows go from the card to
+    the LCD with no frame buffer and no per-pixel conversion.
+    The caller owns both the SD and the LCD bus.
+******************************************************************************/
+bool BMP_StreamToPanel(SD_READER *reader, const BMP_INFO *info)
+{
+    if (!BMP_IsPanelNative(info)) {
+        return false;
+    }
+    static uint8_t row[LCD_HEIGHT * 2];
+
+    SDReader_Seek(reader, info->DataOffset);
+    for (int i = 0; i < info->Height; i++) {
+        int sy = info->TopDown ? i : info->Height - 1 - i;
+        if (SDReader_Read(reader, row, sizeof(row)) != (int32_t)sizeof(row)) {
+            return false;
+        }
+        // Little-endian in the file, big-endian on the wire: swap in place, one burst per row
+        for (uint32_t b = 0; b < sizeof(row); b += 2) {
+            uint8_t low = row[b];
+            row[b] = row[b + 1];
+            row[b + 1] = low;
+        }
+        UWORD x = LCD_WIDTH - 1 - sy;
+        LCD_SetCursor(x, 0, x, LCD_HEIGHT - 1);
+        LCD_WriteData_Buffer(row, sizeof(row));
+    }
+    return true;
+}
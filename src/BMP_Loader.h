@@ -0,0 +1,36 @@
+/*****************************************************************************
+* | File        :   BMP_Loader.h
+* | Function    :   Streaming BMP loader (16-bit RGB565/RGB555 and 24-bit BGR)
+* | Info        :
+*   Rows are read one at a time through an SD_READER, in file order, and
+*   placed straight into the display frame by Frame_Transform (same fit,
+*   letterbox and 270° rotation as the JPEG path). Rows no display column
+*   needs are skipped with a seek; peak memory is about two source rows.
+*   A 240x135 RGB565 BMP is already panel-native: each file row becomes one
+*   display column, streamed to the LCD without touching a frame buffer.
+******************************************************************************/
+#ifndef __BMP_LOADER_H
+#define __BMP_LOADER_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define BMP_MAX_WIDTH 8192  // Widest row accepted (bounds the row buffer)
+
+typedef struct {
+    int32_t Width;
+    int32_t Height;         // Always positive, see TopDown
+    bool TopDown;           // Negative height in the header
+    uint16_t BitsPerPixel;  // 16 or 24
+    uint32_t DataOffset;    // File offset of the first stored row
+    uint32_t RowStride;     // Bytes per stored row, padded to 4
+    uint32_t Masks[3];      // R, G, B masks for 16-bit images
+    bool Is565;             // 16-bit with RGB565 masks: rows need no conversion
+} BMP_INFO;
+
+bool BMP_ReadHeader(SD_READER *reader, BMP_INFO *info);
+bool BMP_IsPanelNative(const BMP_INFO *info);
+bool BMP_DecodeToFrame(SD_READER *reader, const BMP_INFO *info, uint16_t *frame);
+bool BMP_StreamToPanel(SD_READER *reader, const BMP_INFO *info);
+
+#endif
@@ -0,0 +1,18 @@
+/*****************************************************************************
+* | File        :   Bench_Native.cpp
+* | Function    :   Host entry point of the benchmark suite (env:benchmark_native)
+* | Info        :
+*   pio run -e benchmark_native
+*   .pio/build/benchmark_native/program bench_corpus > native.jsonl
+*   Empty in firmware builds, where main.cpp runs the suite.
+******************************************************************************/
+#ifndef ARDUINO
+#include "Bench_Suite.h"
+#include <stddef.h>
+
+int main(int argc, char **argv)
+{
+    Bench_RunAll(argc > 1 ? argv[1] : "bench_corpus", NULL);
+    return 0;
+}
+#endif
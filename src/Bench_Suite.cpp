@@ -0,0 +1,455 @@
+/*****************************************************************************
+* | File        :   Bench_Suite.cpp
+* | Function    :   Benchmarks over a fixed synthetic corpus, as JSON lines
+******************************************************************************/
+#include "Bench_Suite.h"
+#include "Frame_Transform.h"
+#include "Frame_Blend.h"
+#include "SD_Reader.h"
+#include "PNG_Loader.h"
+#include <JPEGDEC.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "LCD_Driver.h"
+#include "GUI_Paint.h"
+#include "Frame_Pipeline.h"
+#define BENCH_TARGET        "esp32s3"
+#define BENCH_PRINTF        Serial.printf
+#define BENCH_MICROS()      micros()
+#else
+#include <chrono>
+#define BENCH_TARGET        "native"
+#define BENCH_PRINTF        printf
+#define BENCH_MICROS()      ((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>( \
+                                std::chrono::steady_clock::now().time_since_epoch()).count())
+#endif
+
+#define FRAME_PIXELS        (LCD_WIDTH * LCD_HEIGHT)
+#define FRAME_RUNS          20
+#define KERNEL_SRC_WIDTH    1280    // Source image the transform kernels place
+#define KERNEL_SRC_HEIGHT   720
+#define JPEG_RUNS           10
+#define PNG_RUNS            5
+#define SD_RUNS             3
+#define SD_READ_PIECE       4096    // What a decoder asks for at a time
+#define SWITCH_RUNS         5
+#define TEXT_RUNS           50
+#define BENCH_TEXT          "Slideshow 2.5s"
+
+// The fixed corpus (scripts/make_bench_corpus.py)
+static const char *JPEG_FILES[] = {"photo_320x240.jpg", "photo_1280x720.jpg", "photo_1920x1080.jpg"};
+static const int JPEG_SCALES[] = {0, JPEG_SCALE_HALF, JPEG_SCALE_QUARTER, JPEG_SCALE_EIGHTH};
+static const struct {
+    const char *File;
+    const char *Variant;
+    uint32_t Pixels;
+} PNG_FILES[] = {
+    {"photo_320x240.png", "320x240", 320 * 240},
+    {"photo_320x240_adam7.png", "320x240/adam7", 320 * 240},
+};
+static const char *SWITCH_FILES[] = {"photo_1280x720.jpg", "photo_320x240.png", "photo_320x240.bmp", "panel.565"};
+#define SD_READ_FILE        "sd_read.bin"
+
+static SD_READER benchReader;
+static uint16_t *frameA = NULL;     // Synthetic display frames
+static uint16_t *frameB = NULL;
+static uint8_t *panelBytes = NULL;  // frameB in wire order
+static uint16_t srcRow[KERNEL_SRC_WIDTH];
+static uint16_t srcBlock[16 * 16];
+
+// PSRAM when there is some, like the pipeline frames
+static void *benchAlloc(uint32_t bytes)
+{
+#ifdef ARDUINO
+    void *p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    return p != NULL ? p : heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+#else
+    return malloc(bytes);
+#endif
+}
+
+static void benchFree(void *p)
+{
+#ifdef ARDUINO
+    heap_caps_free(p);
+#else
+    free(p);
+#endif
+}
+
+static void begin(BENCH_RESULT *result, const char *bench, const char *variant, double unitsPerRun,
+                  double unitScale, const char *unit)
+{
+    memset(result, 0, sizeof(*result));
+    result->Bench = bench;
+    snprintf(result->Variant, sizeof(result->Variant), "%s", variant);
+    result->MinUs = UINT32_MAX;
+    result->UnitsPerRun = unitsPerRun;
+    result->UnitScale = unitScale;
+    result->Unit = unit;
+}
+
+static void add(BENCH_RESULT *result, uint32_t us)
+{
+    result->Count++;
+    result->TotalUs += us;
+    if (us < result->MinUs) {
+        result->MinUs = us;
+    }
+    if (us > result->MaxUs) {
+        result->MaxUs = us;
+    }
+}
+
+/******************************************************************************
+function: One JSON line; rate is units per second over the mean run
+******************************************************************************/
+void Bench_Emit(const BENCH_RESULT *result)
+{
+    if (result->Count == 0) {
+        return;
+    }
+    double meanUs = (double)result->TotalUs / result->Count;
+    double rate = meanUs > 0 ? result->UnitsPerRun * 1e6 / meanUs / result->UnitScale : 0;
+    BENCH_PRINTF("{\"target\":\"%s\",\"commit\":\"%s\",\"bench\":\"%s\",\"variant\":\"%s\",\"n\":%u,"
+                 "\"mean_us\":%.1f,\"min_us\":%u,\"max_us\":%u,\"rate\":%.3f,\"unit\":\"%s\"",
+                 BENCH_TARGET, BENCH_COMMIT, result->Bench, result->Variant, (unsigned)result->Count, meanUs,
+                 (unsigned)result->MinUs, (unsigned)result->MaxUs, rate, result->Unit);
+    if (result->PeakBytes > 0) {
+        BENCH_PRINTF(",\"peak_bytes\":%u", (unsigned)result->PeakBytes);
+    }
+    BENCH_PRINTF("}\n");
+}
+
+// Run fn runs + 1 times (the first one warms up) and emit the result
+static void measure(BENCH_RESULT *result, uint32_t runs, void (*fn)(uint32_t run))
+{
+    for (uint32_t i = 0; i <= runs; i++) {
+        uint32_t t0 = BENCH_MICROS();
+        fn(i);
+        uint32_t us = BENCH_MICROS() - t0;
+        if (i > 0) {
+            add(result, us);
+        }
+    }
+    Bench_Emit(result);
+}
+
+// Gradients with some detail, so blends and transforms see varied pixels
+static void fillSynthetic(void)
+{
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            frameA[y * LCD_WIDTH + x] = ((x * 31 / LCD_WIDTH) << 11) | ((y * 63 / LCD_HEIGHT) << 5) | ((x ^ y) & 31);
+            uint16_t b = ((y * 31 / LCD_HEIGHT) << 11) | (((x * y) >> 4) & 63) << 5 | (x * 31 / LCD_WIDTH);
+            frameB[y * LCD_WIDTH + x] = b;
+            panelBytes[2 * (y * LCD_WIDTH + x)] = b >> 8;
+            panelBytes[2 * (y * LCD_WIDTH + x) + 1] = b & 0xFF;
+        }
+    }
+    for (int x = 0; x < KERNEL_SRC_WIDTH; x++) {
+        srcRow[x] = (uint16_t)(x * 0x9E37);
+    }
+    memcpy(srcBlock, srcRow, sizeof(srcBlock));
+}
+
+// Kernels: memory only, both targets
+static FRAME_TRANSFORM kernelTransform;
+static uint8_t blendOut[LCD_WIDTH * 2];
+
+static void transformRows(uint32_t run)
+{
+    for (int y = 0; y < KERNEL_SRC_HEIGHT; y++) {
+        if (Transform_RowUsed(&kernelTransform, y)) {
+            Transform_PutRow(&kernelTransform, frameA, y, srcRow);
+        }
+    }
+}
+
+// 16x16 MCUs, the way JPEGDEC hands them to the MJPEG player
+static void transformBlocks(uint32_t run)
+{
+    for (int y = 0; y < KERNEL_SRC_HEIGHT; y += 16) {
+        for (int x = 0; x < KERNEL_SRC_WIDTH; x += 16) {
+            Transform_PutBlock(&kernelTransform, frameA, x, y, 16, 16, srcBlock, 16);
+        }
+    }
+}
+
+static void blendFrame(uint32_t run)
+{
+    uint16_t level = (run * 37) % BLEND_LEVELS;
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        Blend_Row565(&frameA[y * LCD_WIDTH], &frameB[y * LCD_WIDTH], LCD_WIDTH, level, blendOut);
+    }
+}
+
+static void dissolveFrame(uint32_t run)
+{
+    uint16_t level = (run * 37) % BLEND_LEVELS;
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        Blend_DissolveRow565(&frameA[y * LCD_WIDTH], &frameB[y * LCD_WIDTH], LCD_WIDTH, y, level, blendOut);
+    }
+}
+
+static void runKernels(void)
+{
+    BENCH_RESULT result;
+    double srcPixels = (double)KERNEL_SRC_WIDTH * KERNEL_SRC_HEIGHT;
+    Transform_Init(&kernelTransform, KERNEL_SRC_WIDTH, KERNEL_SRC_HEIGHT);
+
+    begin(&result, "transform", "rows_1280x720", srcPixels, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, transformRows);
+    begin(&result, "transform", "blocks_1280x720", srcPixels, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, transformBlocks);
+    begin(&result, "blend", "crossfade", FRAME_PIXELS, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, blendFrame);
+    begin(&result, "blend", "dissolve", FRAME_PIXELS, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, dissolveFrame);
+}
+
+// JPEG decode from RAM, so only the decoder is timed
+static int jpegDrawNothing(JPEGDRAW *draw)
+{
+    return 1;
+}
+
+// Whole file into RAM through SD_Reader; NULL if missing
+static uint8_t *loadFile(const char *path, uint32_t *size)
+{
+    if (!SDReader_Open(&benchReader, path)) {
+        return NULL;
+    }
+    *size = SDReader_Size(&benchReader);
+    uint8_t *data = (uint8_t *)benchAlloc(*size);
+    if (data != NULL && SDReader_Read(&benchReader, data, *size) != (int32_t)*size) {
+        benchFree(data);
+        data = NULL;
+    }
+    SDReader_Close(&benchReader);
+    return data;
+}
+
+static void runJpegDecode(const char *corpusDir)
+{
+    JPEGDEC *jpeg = new (std::nothrow) JPEGDEC();
+    if (jpeg == NULL) {
+        BENCH_PRINTF("# bench: no memory for the JPEG decoder\n");
+        return;
+    }
+    for (unsigned f = 0; f < sizeof(JPEG_FILES) / sizeof(JPEG_FILES[0]); f++) {
+        char path[128];
+        snprintf(path, sizeof(path), "%s/%s", corpusDir, JPEG_FILES[f]);
+        uint32_t size;
+        uint8_t *data = loadFile(path, &size);
+        if (data == NULL || !jpeg->openRAM(data, size, jpegDrawNothing)) {
+            BENCH_PRINTF("# bench: skipped %s (missing or not a JPEG)\n", path);
+            if (data != NULL) {
+                benchFree(data);
+            }
+            continue;
+        }
+        int width = jpeg->getWidth();
+        int height = jpeg->getHeight();
+        jpeg->close();
+
+        for (unsigned s = 0; s < sizeof(JPEG_SCALES) / sizeof(JPEG_SCALES[0]); s++) {
+            int divisor = JPEG_SCALES[s] == 0 ? 1 : JPEG_SCALES[s];
+            char variant[24];
+            snprintf(variant, sizeof(variant), "%dx%d/%d", width, height, divisor);
+            BENCH_RESULT result;
+            begin(&result, "jpeg_decode", variant, (double)(width / divisor) * (height / divisor), 1e6, "Mpx/s");
+            for (uint32_t i = 0; i <= JPEG_RUNS; i++) {
+                uint32_t t0 = BENCH_MICROS();
+                bool ok = jpeg->openRAM(data, size, jpegDrawNothing);
+                if (ok) {
+                    jpeg->setPixelType(RGB565_LITTLE_ENDIAN);
+                    ok = jpeg->decode(0, 0, JPEG_SCALES[s]);
+                    jpeg->close();
+                }
+                uint32_t us = BENCH_MICROS() - t0;
+                if (!ok) {
+                    break;
+                }
+                if (i > 0) {
+                    add(&result, us);
+                }
+            }
+            Bench_Emit(&result);
+        }
+        benchFree(data);
+    }
+    delete jpeg;
+}
+
+/******************************************************************************
+function: PNG card to frame through SD_Reader, as the slideshow loads it
+info:
+    Rates are source pixels per second, so the interlaced file, decoded
+    pass by pass without a preview, compares directly with its plain twin.
+    peak_bytes is what the loader holds afterwards.
+******************************************************************************/
+static void runPngDecode(const char *corpusDir)
+{
+    for (unsigned f = 0; f < sizeof(PNG_FILES) / sizeof(PNG_FILES[0]); f++) {
+        char path[128];
+        snprintf(path, sizeof(path), "%s/%s", corpusDir, PNG_FILES[f].File);
+        BENCH_RESULT result;
+        begin(&result, "png_decode", PNG_FILES[f].Variant, PNG_FILES[f].Pixels, 1e6, "Mpx/s");
+        for (uint32_t i = 0; i <= PNG_RUNS; i++) {
+            uint32_t t0 = BENCH_MICROS();
+            bool ok = PNG_LoadToFrame(&benchReader, path, frameA);
+            uint32_t us = BENCH_MICROS() - t0;
+            if (!ok) {
+                BENCH_PRINTF("# bench: skipped %s (%s)\n", path, PNG_LastError());
+                break;
+            }
+            if (i > 0) {
+                add(&result, us);
+            }
+        }
+        result.PeakBytes = PNG_WorkingMemory();
+        Bench_Emit(&result);
+    }
+}
+
+// Sequential reads through the read-ahead reader, in decoder-sized pieces
+static void runSdRead(const char *corpusDir)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "%s/%s", corpusDir, SD_READ_FILE);
+    uint8_t *piece = (uint8_t *)benchAlloc(SD_READ_PIECE);
+    if (piece == NULL) {
+        return;
+    }
+    BENCH_RESULT result;
+    begin(&result, "sd_read", "4k_pieces", 0, 1e6, "MB/s");
+    for (uint32_t i = 0; i <= SD_RUNS; i++) {
+        uint32_t t0 = BENCH_MICROS();
+        if (!SDReader_Open(&benchReader, path)) {
+            BENCH_PRINTF("# bench: skipped %s (missing)\n", path);
+            break;
+        }
+        uint32_t total = 0;
+        int32_t got;
+        while ((got = SDReader_Read(&benchReader, piece, SD_READ_PIECE)) > 0) {
+            total += got;
+        }
+        SDReader_Close(&benchReader);
+        uint32_t us = BENCH_MICROS() - t0;
+        result.UnitsPerRun = total;
+        if (i > 0) {
+            add(&result, us);
+        }
+    }
+    Bench_Emit(&result);
+    benchFree(piece);
+}
+
+#ifdef ARDUINO
+// Panel benchmarks: the LCD bus is held for the whole run of each
+static void lcdFill(uint32_t run)
+{
+    LCD_Clear(run & 1 ? WHITE : BLACK);
+}
+
+static void lcdBlitWords(uint32_t run)
+{
+    Paint_DrawImage(frameB, 0, 0, LCD_WIDTH, LCD_HEIGHT);
+}
+
+static void lcdBlitBurst(uint32_t run)
+{
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    LCD_WriteData_Buffer(panelBytes, FRAME_PIXELS * 2);
+}
+
+static const BENCH_HOOKS *activeHooks = NULL;
+
+static void drawText(uint32_t run)
+{
+    activeHooks->DrawText(BENCH_TEXT);
+}
+
+static void runPanel(const char *corpusDir, const BENCH_HOOKS *hooks)
+{
+    BENCH_RESULT result;
+    Pipeline_WaitPresent();
+    Bus_Acquire(BUS_LCD, STAGE_UI);
+    begin(&result, "lcd_fill", "full_frame", FRAME_PIXELS, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, lcdFill);
+    begin(&result, "lcd_blit", "words", FRAME_PIXELS, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, lcdBlitWords);
+    begin(&result, "lcd_blit", "burst", FRAME_PIXELS, 1e6, "Mpx/s");
+    measure(&result, FRAME_RUNS, lcdBlitBurst);
+    Bus_Release(BUS_LCD);
+
+    if (hooks == NULL) {
+        return;
+    }
+    activeHooks = hooks;
+    if (hooks->DrawText != NULL) {
+        begin(&result, "text", "overlay_line", strlen(BENCH_TEXT), 1, "chars/s");
+        measure(&result, TEXT_RUNS, drawText);
+    }
+    if (hooks->ShowImage == NULL) {
+        return;
+    }
+    for (unsigned f = 0; f < sizeof(SWITCH_FILES) / sizeof(SWITCH_FILES[0]); f++) {
+        char path[128];
+        snprintf(path, sizeof(path), "%s/%s", corpusDir, SWITCH_FILES[f]);
+        begin(&result, "image_switch", SWITCH_FILES[f], 1, 1, "switch/s");
+        for (uint32_t i = 0; i <= SWITCH_RUNS; i++) {
+            uint32_t t0 = BENCH_MICROS();
+            if (!hooks->ShowImage(path)) {
+                BENCH_PRINTF("# bench: skipped %s (missing or failed)\n", path);
+                break;
+            }
+            uint32_t us = BENCH_MICROS() - t0;
+            if (i > 0) {
+                add(&result, us);
+            }
+        }
+        Bench_Emit(&result);
+    }
+}
+#endif
+
+/******************************************************************************
+function: Run every benchmark this target supports, one JSON line each
+info:
+    hooks may be NULL (native, or a device build without a UI): text and
+    image switch are then skipped.
+******************************************************************************/
+void Bench_RunAll(const char *corpusDir, const BENCH_HOOKS *hooks)
+{
+    frameA = (uint16_t *)benchAlloc(FRAME_PIXELS * 2);
+    frameB = (uint16_t *)benchAlloc(FRAME_PIXELS * 2);
+    panelBytes = (uint8_t *)benchAlloc(FRAME_PIXELS * 2);
+    if (frameA == NULL || frameB == NULL || panelBytes == NULL) {
+        BENCH_PRINTF("# bench: no memory for the benchmark frames\n");
+    } else {
+        BENCH_PRINTF("# bench: target %s, commit %s, corpus %s\n", BENCH_TARGET, BENCH_COMMIT, corpusDir);
+        fillSynthetic();
+        runKernels();
+        runJpegDecode(corpusDir);
+        runPngDecode(corpusDir);
+        runSdRead(corpusDir);
+#ifdef ARDUINO
+        runPanel(corpusDir, hooks);
+#endif
+        BENCH_PRINTF("# bench: done\n");
+    }
+    SDReader_Free(&benchReader);
+    benchFree(frameA);
+    benchFree(frameB);
+    benchFree(panelBytes);
+    frameA = frameB = NULL;
+    panelBytes = NULL;
+}
@@ -0,0 +1,53 @@
+/*****************************************************************************
+* | File        :   Bench_Suite.h
+* | Function    :   Benchmarks over a fixed synthetic corpus, as JSON lines
+* | Info        :
+*   Every result is one JSON object on its own line:
+*     {"target":"esp32s3","commit":"1a2b3c4","bench":"jpeg_decode",
+*      "variant":"1920x1080/4","n":10,"mean_us":15234.2,"min_us":15101,
+*      "max_us":15530,"rate":34.027,"unit":"Mpx/s"}
+*   with "peak_bytes" added where the working memory of the code under test
+*   is part of the result (PNG decode).
+*   so runs from two commits can be compared (scripts/bench_compare.py).
+*   The corpus is written by scripts/make_bench_corpus.py: copy it to
+*   /bench on the card, or pass its folder to the native build.
+*   Kernels that only need memory (transform, blend, JPEG decode from RAM,
+*   PNG decode and SD_Reader throughput) run on both targets. LCD fill and blit, text and
+*   the card-to-glass image switch need the panel and run on the device
+*   only, text and image switch through hooks from main.cpp.
+*   The first pass of each benchmark is a warm-up and is not counted.
+******************************************************************************/
+#ifndef __BENCH_SUITE_H
+#define __BENCH_SUITE_H
+
+#include <stdint.h>
+
+#define BENCH_CORPUS_DIR    "/bench"
+
+// Set by scripts/bench_commit.py in the benchmark environments
+#ifndef BENCH_COMMIT
+#define BENCH_COMMIT        "unknown"
+#endif
+
+typedef struct {
+    void (*DrawText)(const char *text);     // One overlay line to the panel
+    bool (*ShowImage)(const char *path);    // Card to glass, nothing prefetched
+} BENCH_HOOKS;
+
+typedef struct {
+    const char *Bench;
+    char Variant[24];
+    uint32_t Count;
+    uint64_t TotalUs;
+    uint32_t MinUs;
+    uint32_t MaxUs;
+    double UnitsPerRun;     // Pixels, bytes, characters... per timed run
+    double UnitScale;       // Divides units per second into the reported rate
+    const char *Unit;
+    uint32_t PeakBytes;     // Working memory of the code measured, 0 = not reported
+} BENCH_RESULT;
+
+void Bench_RunAll(const char *corpusDir, const BENCH_HOOKS *hooks);
+void Bench_Emit(const BENCH_RESULT *result);
+
+#endif
@@ -0,0 +1,60 @@
+/*****************************************************************************
+* | File        :   Boot_Profile.cpp
+* | Function    :   Boot phase timestamps checked against a time budget
+******************************************************************************/
+#include "Boot_Profile.h"
+#include <Arduino.h>
+
+static BOOT_PHASE phases[BOOT_MAX_PHASES];
+static int phaseCount = 0;
+static uint32_t firstImageUs = 0;
+
+void Boot_Mark(const char *phase)
+{
+    if (phaseCount < BOOT_MAX_PHASES) {
+        phases[phaseCount].Name = phase;
+        phases[phaseCount].TimeUs = micros();
+        phaseCount++;
+    }
+}
+
+// The first image (or status screen) has been pushed to the panel
+void Boot_MarkFirstImage(void)
+{
+    Boot_Mark("first image");
+    firstImageUs = micros();
+}
+
+uint32_t Boot_FirstImageUs(void)
+{
+    return firstImageUs;
+}
+
+bool Boot_WithinBudget(void)
+{
+    return firstImageUs != 0 && firstImageUs <= BOOT_BUDGET_MS * 1000UL;
+}
+
+/******************************************************************************
+function: Print each phase with its duration, then the budget verdict
+******************************************************************************/
+void Boot_Print(void)
+{
+    Serial.println("# boot phase        end_ms  dur_ms");
+    uint32_t previous = 0;
+    for (int i = 0; i < phaseCount; i++) {
+        Serial.printf("%-18s %7.1f %7.1f\n", phases[i].Name, phases[i].TimeUs / 1000.0,
+                      (phases[i].TimeUs - previous) / 1000.0);
+        previous = phases[i].TimeUs;
+    }
+    if (firstImageUs == 0) {
+        Serial.printf("⚠️  Boot: no image shown yet (budget %u ms)\n", (unsigned)BOOT_BUDGET_MS);
+    } else if (Boot_WithinBudget()) {
+        Serial.printf("✅ Boot: first image at %.1f ms (budget %u ms)\n", firstImageUs / 1000.0,
+                      (unsigned)BOOT_BUDGET_MS);
+    } else {
+        Serial.printf("⚠️  Boot regression: first image at %.1f ms, %.1f ms over the %u ms budget\n",
+                      firstImageUs / 1000.0, (firstImageUs - BOOT_BUDGET_MS * 1000UL) / 1000.0,
+                      (unsigned)BOOT_BUDGET_MS);
+    }
+}
@@ -0,0 +1,34 @@
+/*****************************************************************************
+* | File        :   Boot_Profile.h
+* | Function    :   Boot phase timestamps checked against a time budget
+* | Info        :
+*   setup() marks the end of each phase; the phases, their durations and
+*   the time to the first image are printed at the end of setup and on
+*   the 'o' serial command. The first image arriving later than
+*   BOOT_BUDGET_MS is reported as a regression.
+*   Times are micros() values: esp_timer starts with the app, so the ROM
+*   and second-stage bootloader time before it is not included.
+******************************************************************************/
+#ifndef __BOOT_PROFILE_H
+#define __BOOT_PROFILE_H
+
+#include <stdint.h>
+
+#define BOOT_MAX_PHASES 16
+
+#ifndef BOOT_BUDGET_MS
+#define BOOT_BUDGET_MS 400      // App start to the first image on the panel
+#endif
+
+typedef struct {
+    const char *Name;
+    uint32_t TimeUs;            // When the phase ended, from app start
+} BOOT_PHASE;
+
+void Boot_Mark(const char *phase);
+void Boot_MarkFirstImage(void);
+uint32_t Boot_FirstImageUs(void);
+bool Boot_WithinBudget(void);
+void Boot_Print(void);
+
+#endif
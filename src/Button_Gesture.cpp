@@ -0,0 +1,200 @@
+/*****************************************************************************
+* | File        :   Button_Gesture.cpp
+* | Function    :   Click / double-click / hold recognition from edge timestamps
+******************************************************************************/
+#include "Button_Gesture.h"
+#include <string.h>
+
+// a is at or after b, across the 32-bit microsecond wrap
+static bool reached(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) >= 0;
+}
+
+static void emit(BUTTON_GESTURE *g, uint8_t type, uint32_t timeUs, uint32_t edgeUs)
+{
+    if (g->Count == GESTURE_QUEUE_SIZE) {
+        g->Overflows++;
+        return;
+    }
+    GESTURE_EVENT *event = &g->Queue[(g->Head + g->Count) % GESTURE_QUEUE_SIZE];
+    event->Type = type;
+    event->TimeUs = timeUs;
+    event->EdgeUs = edgeUs;
+    g->Count++;
+}
+
+/******************************************************************************
+function: Emit every time-driven gesture whose moment is at or before nowUs
+info:
+    Called before each settled edge with the edge's time, so a hold that
+    ran out before a late-seen release is still reported first.
+******************************************************************************/
+static void advance(BUTTON_GESTURE *g, uint32_t nowUs)
+{
+    if (g->ClickPending && reached(nowUs, g->ClickUs + g->DoubleClickUs)) {
+        g->ClickPending = false;
+        emit(g, GESTURE_CLICK, g->ClickUs + g->DoubleClickUs, g->ClickUs);
+    }
+    if (!g->Pressed) {
+        return;
+    }
+    if (g->HoldLevel == 0 && reached(nowUs, g->PressUs + g->HoldUs)) {
+        g->HoldLevel = 1;
+        g->ClickPending = false; // A hold cancels a click still waiting for its pair
+        emit(g, GESTURE_HOLD, g->PressUs + g->HoldUs, g->PressUs);
+    }
+    if (g->HoldLevel == 1 && reached(nowUs, g->PressUs + g->LongHoldUs)) {
+        g->HoldLevel = 2;
+        emit(g, GESTURE_LONG_HOLD, g->PressUs + g->LongHoldUs, g->PressUs);
+    }
+}
+
+// A level change that survived the debounce
+static void settle(BUTTON_GESTURE *g, uint32_t timeUs, bool pressed)
+{
+    advance(g, timeUs);
+    g->Pressed = pressed;
+    g->SettledUs = timeUs;
+    if (pressed) {
+        g->PressUs = timeUs;
+        g->HoldLevel = 0;
+        return;
+    }
+
+    if (g->HoldLevel == 1) {
+        emit(g, GESTURE_HOLD_RELEASE, timeUs, g->PressUs);
+    } else if (g->HoldLevel == 0) {
+        if (!g->DoubleClick) {
+            emit(g, GESTURE_CLICK, timeUs, g->PressUs);
+        } else if (g->ClickPending) {
+            g->ClickPending = false;
+            emit(g, GESTURE_DOUBLE_CLICK, timeUs, g->ClickUs);
+        } else {
+            g->ClickPending = true;
+            g->ClickUs = timeUs;
+        }
+    }
+    g->HoldLevel = 0;
+}
+
+/******************************************************************************
+function: Set up a recognizer, button released
+******************************************************************************/
+void Gesture_Init(BUTTON_GESTURE *gesture, uint32_t debounceMs, uint32_t doubleClickMs,
+                  uint32_t holdMs, uint32_t longHoldMs)
+{
+    memset(gesture, 0, sizeof(*gesture));
+    gesture->DebounceUs = debounceMs * 1000;
+    gesture->DoubleClickUs = doubleClickMs * 1000;
+    gesture->HoldUs = holdMs * 1000;
+    gesture->LongHoldUs = longHoldMs * 1000;
+    gesture->DoubleClick = true;
+    gesture->SettledUs = 0 - gesture->DebounceUs; // First edge is never a bounce
+}
+
+// Without double-click, a click is reported at its release with no wait
+void Gesture_SetDoubleClick(BUTTON_GESTURE *gesture, bool enabled)
+{
+    gesture->DoubleClick = enabled;
+}
+
+/******************************************************************************
+function: One raw edge: the new level and when the interrupt saw it
+info:
+    An edge closer than DebounceUs to the last settled change is held
+    back; if nothing follows it for DebounceUs, Gesture_Poll settles it
+    at its own timestamp.
+******************************************************************************/
+void Gesture_Edge(BUTTON_GESTURE *gesture, uint32_t timeUs, bool pressed)
+{
+    if (gesture->RawPending && reached(timeUs, gesture->RawUs + gesture->DebounceUs)) {
+        settle(gesture, gesture->RawUs, gesture->RawPressed);  // Earlier edge had settled
+        gesture->RawPending = false;
+    }
+    if (gesture->RawPending) {
+        gesture->Bounces++;  // The held-back edge did not last DebounceUs
+    }
+    gesture->RawPressed = pressed;
+    gesture->RawUs = timeUs;
+
+    if (pressed == gesture->Pressed) {
+        gesture->RawPending = false;  // Bounced back to the settled level
+    } else if (reached(timeUs, gesture->SettledUs + gesture->DebounceUs)) {
+        gesture->RawPending = false;
+        settle(gesture, timeUs, pressed);
+    } else {
+        gesture->RawPending = true;
+    }
+}
+
+/******************************************************************************
+function: Let time-driven gestures and settling edges catch up to nowUs
+******************************************************************************/
+void Gesture_Poll(BUTTON_GESTURE *gesture, uint32_t nowUs)
+{
+    if (gesture->RawPending && reached(nowUs, gesture->RawUs + gesture->DebounceUs)) {
+        gesture->RawPending = false;
+        settle(gesture, gesture->RawUs, gesture->RawPressed);
+    }
+    if (!gesture->RawPending && reached(nowUs, gesture->SettledUs + gesture->DebounceUs)) {
+        gesture->SettledUs = nowUs - gesture->DebounceUs; // Keep it in signed range while idle
+    }
+    advance(gesture, nowUs);
+}
+
+bool Gesture_Next(BUTTON_GESTURE *gesture, GESTURE_EVENT *event)
+{
+    if (gesture->Count == 0) {
+        return false;
+    }
+    *event = gesture->Queue[gesture->Head];
+    gesture->Head = (gesture->Head + 1) % GESTURE_QUEUE_SIZE;
+    gesture->Count--;
+    return true;
+}
+
+/******************************************************************************
+function: Earliest time Gesture_Poll could produce something new
+info:
+    Returns false when nothing is pending: only a new edge can.
+******************************************************************************/
+bool Gesture_NextDeadline(const BUTTON_GESTURE *gesture, uint32_t *deadlineUs)
+{
+    bool found = false;
+    uint32_t best = 0;
+    uint32_t candidates[4];
+    int n = 0;
+
+    if (gesture->RawPending) {
+        candidates[n++] = gesture->RawUs + gesture->DebounceUs;
+    }
+    if (gesture->ClickPending) {
+        candidates[n++] = gesture->ClickUs + gesture->DoubleClickUs;
+    }
+    if (gesture->Pressed && gesture->HoldLevel == 0) {
+        candidates[n++] = gesture->PressUs + gesture->HoldUs;
+    } else if (gesture->Pressed && gesture->HoldLevel == 1) {
+        candidates[n++] = gesture->PressUs + gesture->LongHoldUs;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!found || !reached(candidates[i], best)) {
+            best = candidates[i];
+            found = true;
+        }
+    }
+    *deadlineUs = best;
+    return found;
+}
+
+const char *Gesture_Name(uint8_t type)
+{
+    switch (type) {
+    case GESTURE_CLICK:        return "click";
+    case GESTURE_DOUBLE_CLICK: return "double-click";
+    case GESTURE_HOLD:         return "hold";
+    case GESTURE_HOLD_RELEASE: return "hold-release";
+    case GESTURE_LONG_HOLD:    return "long-hold";
+    default:                   return "none";
+    }
+}
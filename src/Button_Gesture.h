@@ -0,0 +1,72 @@
+/*****************************************************************************
+* | File        :   Button_Gesture.h
+* | Function    :   Click / double-click / hold recognition from edge timestamps
+* | Info        :
+*   Fed with debounced-or-not button edges and the time they happened, the
+*   recognizer decides gestures from those timestamps alone: a hold fires
+*   at press + HoldUs even if it is noticed later, and a click waiting for
+*   its second half fires at release + DoubleClickUs. How often it is
+*   polled changes when an event is seen, never what it is or its time.
+*   Bounces shorter than DebounceUs are dropped; a level that stays put
+*   for DebounceUs after the last raw edge is taken as settled.
+*   No Arduino dependency: runs on the host against recorded edges.
+******************************************************************************/
+#ifndef __BUTTON_GESTURE_H
+#define __BUTTON_GESTURE_H
+
+#include <stdint.h>
+
+#define GESTURE_QUEUE_SIZE 8
+
+typedef enum {
+    GESTURE_NONE = 0,
+    GESTURE_CLICK,          // Single click (after the double-click window when enabled)
+    GESTURE_DOUBLE_CLICK,
+    GESTURE_HOLD,           // Still pressed at HoldUs
+    GESTURE_HOLD_RELEASE,   // Released after a hold, before the long hold
+    GESTURE_LONG_HOLD,      // Still pressed at LongHoldUs (no release event follows)
+} GESTURE_TYPE;
+
+typedef struct {
+    uint8_t Type;           // GESTURE_TYPE
+    uint32_t TimeUs;        // When the gesture was decided, from edge times
+    uint32_t EdgeUs;        // The press (or first release) it started from
+} GESTURE_EVENT;
+
+typedef struct {
+    uint32_t DebounceUs;
+    uint32_t DoubleClickUs;
+    uint32_t HoldUs;
+    uint32_t LongHoldUs;
+    bool DoubleClick;       // false: a release is a click at once
+
+    // Debounce
+    bool Pressed;           // Settled level
+    bool RawPressed;        // Level of the last raw edge
+    uint32_t RawUs;
+    uint32_t SettledUs;
+    bool RawPending;        // Last raw edge not accepted yet
+
+    // Gesture state
+    uint32_t PressUs;
+    uint8_t HoldLevel;      // 0, 1 = hold sent, 2 = long hold sent
+    bool ClickPending;
+    uint32_t ClickUs;       // Release time of the pending click
+
+    GESTURE_EVENT Queue[GESTURE_QUEUE_SIZE];
+    uint8_t Head;
+    uint8_t Count;
+    uint32_t Bounces;       // Edges dropped as bounce
+    uint32_t Overflows;     // Events lost to a full queue
+} BUTTON_GESTURE;
+
+void Gesture_Init(BUTTON_GESTURE *gesture, uint32_t debounceMs, uint32_t doubleClickMs,
+                  uint32_t holdMs, uint32_t longHoldMs);
+void Gesture_SetDoubleClick(BUTTON_GESTURE *gesture, bool enabled);
+void Gesture_Edge(BUTTON_GESTURE *gesture, uint32_t timeUs, bool pressed);
+void Gesture_Poll(BUTTON_GESTURE *gesture, uint32_t nowUs);
+bool Gesture_Next(BUTTON_GESTURE *gesture, GESTURE_EVENT *event);
+bool Gesture_NextDeadline(const BUTTON_GESTURE *gesture, uint32_t *deadlineUs);
+const char *Gesture_Name(uint8_t type);
+
+#endif
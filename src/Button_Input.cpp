@@ -0,0 +1,81 @@
+/*****************************************************************************
+* | File        :   Button_Input.cpp
+* | Function    :   Interrupt-timestamped button edges in a lock-free queue
+******************************************************************************/
+#include "Button_Input.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static uint8_t buttonPin = 0;
+static BUTTON_EDGE edges[BUTTON_EDGE_QUEUE];
+static volatile uint32_t head = 0;      // Written by the ISR only
+static volatile uint32_t tail = 0;      // Written by loop() only
+static volatile uint32_t dropped = 0;
+static TaskHandle_t wakeTask = NULL;
+
+// Active low (pull-up, button to ground)
+static void IRAM_ATTR buttonISR(void)
+{
+    uint32_t now = micros();
+    uint32_t h = head;
+    if (h - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) >= BUTTON_EDGE_QUEUE) {
+        dropped = dropped + 1;
+        return;
+    }
+    edges[h % BUTTON_EDGE_QUEUE].TimeUs = now;
+    edges[h % BUTTON_EDGE_QUEUE].Pressed = digitalRead(buttonPin) == LOW;
+    __atomic_store_n(&head, h + 1, __ATOMIC_RELEASE); // Publish after the slot is written
+
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(wakeTask, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/******************************************************************************
+function: Configure the pin and start timestamping its edges
+******************************************************************************/
+void Button_Begin(uint8_t pin)
+{
+    buttonPin = pin;
+    wakeTask = xTaskGetCurrentTaskHandle();
+    pinMode(pin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(pin), buttonISR, CHANGE);
+}
+
+bool Button_PopEdge(BUTTON_EDGE *edge)
+{
+    uint32_t t = tail;
+    if (t == __atomic_load_n(&head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *edge = edges[t % BUTTON_EDGE_QUEUE];
+    __atomic_store_n(&tail, t + 1, __ATOMIC_RELEASE); // Slot is free once copied out
+    return true;
+}
+
+/******************************************************************************
+function: Block the calling (loop) task for up to timeoutMs or until an edge
+info:
+    Returns true if an edge arrived. Edges queued before the call wake it
+    at once, since the notification count is kept until taken.
+******************************************************************************/
+bool Button_WaitEdge(uint32_t timeoutMs)
+{
+    if (timeoutMs == 0) {
+        return false;
+    }
+    return ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeoutMs)) > 0;
+}
+
+bool Button_IsPressed(void)
+{
+    return digitalRead(buttonPin) == LOW;
+}
+
+uint32_t Button_DroppedEdges(void)
+{
+    return dropped;
+}
@@ -0,0 +1,33 @@
+/*****************************************************************************
+* | File        :   Button_Input.h
+* | Function    :   Interrupt-timestamped button edges in a lock-free queue
+* | Info        :
+*   A CHANGE interrupt on the button pin records the level and micros() of
+*   every edge into a single-producer / single-consumer ring; loop() drains
+*   it into Button_Gesture whenever it gets round to it. A press that
+*   happens during a long draw or SD probe is therefore neither missed nor
+*   mistimed, only seen later.
+*   The ISR is the only writer of Head and loop() the only writer of Tail,
+*   so no lock is needed; a full ring drops the newest edge and counts it.
+*   Each edge also notifies the task that called Button_Begin (the loop
+*   task), so Button_WaitEdge() can block until a deadline or a press.
+******************************************************************************/
+#ifndef __BUTTON_INPUT_H
+#define __BUTTON_INPUT_H
+
+#include <stdint.h>
+
+#define BUTTON_EDGE_QUEUE 32    // Power of two; a bouncy press makes a handful of edges
+
+typedef struct {
+    uint32_t TimeUs;
+    bool Pressed;
+} BUTTON_EDGE;
+
+void Button_Begin(uint8_t pin);
+bool Button_PopEdge(BUTTON_EDGE *edge);
+bool Button_WaitEdge(uint32_t timeoutMs);
+bool Button_IsPressed(void);
+uint32_t Button_DroppedEdges(void);
+
+#endif
@@ -9,14 +9,16 @@
 * | This version:   V1.0
 * | Date        :   2018-11-22
 * | Info        :
+*   GPIO, SPI, timing and backlight PWM for the LCD go through the DEV_*
+*   macros below and nowhere else. Firmware maps them onto Arduino; host
+*   builds map them onto DEV_Native, a virtual ST7789 that counts the
+*   traffic and models its bus time (env:native).
 ******************************************************************************/
 #ifndef _DEV_CONFIG_H_
 #define _DEV_CONFIG_H_
 
 #include <stdint.h>
 #include <stdio.h>
-#include <SPI.h>
-#include <Arduino.h>
 
 #define UBYTE   uint8_t
 #define UWORD   uint16_t
@@ -30,29 +32,62 @@
 #define DEV_CS_PIN  10
 #define DEV_BL_PIN  7
 
+#ifdef ARDUINO
+#include <SPI.h>
+#include <Arduino.h>
+#include <driver/gpio.h>
+
 /**
  * GPIO read and write
 **/
-#define DEV_Digital_Write(_pin, _value) digitalWrite(_pin, _value == 0? LOW:HIGH)
+#define DEV_Digital_Write(_pin, _value) digitalWrite(_pin, (_value) == 0? LOW:HIGH)
 #define DEV_Digital_Read(_pin) digitalRead(_pin)
+#define DEV_GPIO_Hold(_pin, _on) ((_on) ? gpio_hold_en((gpio_num_t)(_pin)) : gpio_hold_dis((gpio_num_t)(_pin)))
 
 /**
  * SPI
 **/
 #define DEV_SPI_WRITE(_dat)   SPI.transfer(_dat)
+#define DEV_SPI_WRITE_BYTES(_data, _len)   SPI.writeBytes(_data, _len)
 
 /**
- * delay x ms
+ * delay x ms, x us; milliseconds since boot
 **/
 #define DEV_Delay_ms(__xms)    delay(__xms)
+#define DEV_Delay_us(__xus)    delayMicroseconds(__xus)
+#define DEV_Millis()           millis()
 
 /**
  * PWM_BL
 **/
  #define  DEV_Set_BL(_Pin, _Value)  analogWrite(_Pin, _Value)
+#define DEV_PWM_Setup(_channel, _freq, _bits)   ledcSetup(_channel, _freq, _bits)
+#define DEV_PWM_Attach(_pin, _channel)          ledcAttachPin(_pin, _channel)
+#define DEV_PWM_Detach(_pin)                    ledcDetachPin(_pin)
+#define DEV_PWM_Write(_channel, _duty)          ledcWrite(_channel, _duty)
+#else
+#include "DEV_Native.h"
+
+#define DEV_Digital_Write(_pin, _value) Native_DigitalWrite(_pin, (_value) != 0)
+#define DEV_Digital_Read(_pin) Native_DigitalRead(_pin)
+#define DEV_GPIO_Hold(_pin, _on) Native_GpioHold(_pin, _on)
+
+#define DEV_SPI_WRITE(_dat)   Native_SpiWrite(_dat)
+#define DEV_SPI_WRITE_BYTES(_data, _len)   Native_SpiWriteBytes(_data, _len)
+
+#define DEV_Delay_ms(__xms)    Native_DelayUs((uint64_t)(__xms) * 1000)
+#define DEV_Delay_us(__xus)    Native_DelayUs(__xus)
+#define DEV_Millis()           ((uint32_t)(Native_Micros() / 1000))
+
+#define DEV_Set_BL(_Pin, _Value)                Native_DigitalWrite(_Pin, (_Value) != 0)
+#define DEV_PWM_Setup(_channel, _freq, _bits)   Native_PwmSetup(_channel, _freq, _bits)
+#define DEV_PWM_Attach(_pin, _channel)          Native_PwmAttach(_pin, _channel)
+#define DEV_PWM_Detach(_pin)                    Native_PwmAttach(_pin, -1)
+#define DEV_PWM_Write(_channel, _duty)          Native_PwmWrite(_channel, _duty)
+#endif
 
 /*-----------------------------------------------------------------------------*/
 void Config_Init();
 void GPIO_Init();
 
-#endif
\ No newline at end of file
+#endif
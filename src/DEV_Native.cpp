@@ -0,0 +1,561 @@
+/*****************************************************************************
+* | File        :   DEV_Native.cpp
+* | Function    :   Host backend of DEV_Config: virtual ST7789 and SPI accounting
+******************************************************************************/
+#ifndef ARDUINO
+#include "DEV_Config.h"
+#include "LCD_Scroll.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <atomic>
+
+#define NS_PER_MS           1000000ULL
+#define RESET_READY_NS      (5 * NS_PER_MS)     // Reset release to first command
+#define RESET_SLPOUT_NS     (120 * NS_PER_MS)   // Reset release to sleep out
+#define SLPOUT_READY_NS     (5 * NS_PER_MS)     // Sleep out to next command
+
+static NATIVE_TIMING timing = {NATIVE_DEFAULT_SPI_HZ, NATIVE_DEFAULT_CALL_NS, NATIVE_DEFAULT_GPIO_NS};
+static NATIVE_PACING pacing = {0, 0, 0};
+static NATIVE_STATS stats;
+static NATIVE_PANEL panel;
+static uint16_t gram[NATIVE_GRAM_ROWS][NATIVE_GRAM_COLUMNS];
+static std::atomic<uint64_t> nowNs(0);   // Read by loop() while the present thread sends
+
+static uint8_t pins[NATIVE_PINS];
+static bool held[NATIVE_PINS];
+static int8_t pinChannel[NATIVE_PINS];
+static uint8_t pwmBits[NATIVE_PWM_CHANNELS];
+static uint32_t pwmDuty[NATIVE_PWM_CHANNELS];
+
+// Command decoder
+static uint8_t command = 0;
+static uint8_t params[8];
+static uint8_t paramCount = 0;
+static bool memoryWrite = false;
+static bool haveHighByte = false;
+static uint8_t highByte = 0;
+static uint16_t columnStart = 0, columnEnd = NATIVE_GRAM_COLUMNS - 1;
+static uint16_t rowStart = 0, rowEnd = NATIVE_GRAM_ROWS - 1;
+static uint16_t cursorColumn = 0, cursorRow = 0;
+static uint16_t scrollTop = 0, scrollArea = NATIVE_GRAM_ROWS;    // VSCRDEF TFA, VSA
+
+static bool resetSeen = false;
+static uint64_t resetReleaseNs = 0;
+static bool slpoutSeen = false;
+static uint64_t slpoutNs = 0;
+
+static char storageRoot[256] = "";
+static bool boardReady = false;
+
+static void spend(uint64_t ns)
+{
+    nowNs += ns;
+    stats.BusNs += ns;
+}
+
+// Register state after a hardware or software reset; GRAM keeps its contents
+static void resetRegisters(void)
+{
+    panel.ScrollLine = 0;
+    panel.Madctl = 0;
+    panel.Colmod = 0x66;
+    panel.Sleeping = true;
+    panel.DisplayOn = false;
+    panel.Inverted = false;
+    columnStart = 0;
+    columnEnd = NATIVE_GRAM_COLUMNS - 1;
+    rowStart = 0;
+    rowEnd = NATIVE_GRAM_ROWS - 1;
+    scrollTop = 0;
+    scrollArea = NATIVE_GRAM_ROWS;
+    memoryWrite = false;
+    haveHighByte = false;
+    paramCount = 0;
+    slpoutSeen = false;
+}
+
+// The board powers up as after Native_Reset
+static void ensureReady(void)
+{
+    if (!boardReady) {
+        Native_Reset();
+    }
+}
+
+static void updateBacklight(void)
+{
+    int channel = pinChannel[DEV_BL_PIN];
+    if (channel < 0) {
+        panel.Backlight = pins[DEV_BL_PIN] ? 255 : 0;
+    } else {
+        uint32_t max = (1u << pwmBits[channel]) - 1;
+        panel.Backlight = max == 0 ? 0 : (uint8_t)(pwmDuty[channel] * 255 / max);
+    }
+}
+
+/******************************************************************************
+function: Reset the virtual board: pins, panel registers, GRAM, clock, stats
+info:
+    The SPI timing model, the pacing and the storage root are kept.
+******************************************************************************/
+void Native_Reset(void)
+{
+    memset(pins, 0, sizeof(pins));
+    pins[DEV_CS_PIN] = 1;   // Idle: deselected, out of reset
+    pins[DEV_RST_PIN] = 1;
+    memset(held, 0, sizeof(held));
+    memset(pinChannel, -1, sizeof(pinChannel));
+    memset(pwmBits, 0, sizeof(pwmBits));
+    memset(pwmDuty, 0, sizeof(pwmDuty));
+    memset(gram, 0, sizeof(gram));
+    memset(&panel, 0, sizeof(panel));
+    resetRegisters();
+    resetSeen = false;
+    nowNs = 0;
+    boardReady = true;
+    Native_ResetStats();
+}
+
+void Native_SetTiming(const NATIVE_TIMING *t)
+{
+    timing = *t;
+}
+
+void Native_SetPacing(const NATIVE_PACING *p)
+{
+    pacing = *p;
+}
+
+const NATIVE_STATS *Native_Stats(void)
+{
+    return &stats;
+}
+
+void Native_ResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+const NATIVE_PANEL *Native_Panel(void)
+{
+    return &panel;
+}
+
+/******************************************************************************
+    GPIO
+******************************************************************************/
+void Native_DigitalWrite(uint8_t pin, bool level)
+{
+    if (pin >= NATIVE_PINS) {
+        return;
+    }
+    ensureReady();
+    stats.GpioWrites++;
+    spend(timing.GpioNs);
+    if (held[pin]) {
+        return; // gpio_hold_en latches the pad
+    }
+    uint8_t before = pins[pin];
+    pins[pin] = level;
+
+    if (pin == DEV_CS_PIN && before && !level) {
+        stats.Transactions++;
+    } else if (pin == DEV_RST_PIN && before && !level) {
+        resetRegisters();
+    } else if (pin == DEV_RST_PIN && !before && level) {
+        resetSeen = true;
+        resetReleaseNs = nowNs;
+    } else if (pin == DEV_BL_PIN) {
+        updateBacklight();
+    }
+}
+
+int Native_DigitalRead(uint8_t pin)
+{
+    return pin < NATIVE_PINS ? pins[pin] : 0;
+}
+
+void Native_GpioHold(uint8_t pin, bool on)
+{
+    if (pin < NATIVE_PINS) {
+        ensureReady();
+        held[pin] = on;
+    }
+}
+
+/******************************************************************************
+    ST7789 command decoder
+******************************************************************************/
+static uint16_t paramWord(int i)
+{
+    return (uint16_t)(params[i] << 8 | params[i + 1]);
+}
+
+static void checkCommandTiming(uint8_t cmd)
+{
+    if (resetSeen && nowNs - resetReleaseNs < RESET_READY_NS) {
+        stats.Violations++;
+    } else if (cmd == 0x11 && resetSeen && nowNs - resetReleaseNs < RESET_SLPOUT_NS) {
+        stats.Violations++;
+    } else if (slpoutSeen && nowNs - slpoutNs < SLPOUT_READY_NS) {
+        stats.Violations++;
+    }
+}
+
+static void commandByte(uint8_t cmd)
+{
+    checkCommandTiming(cmd);
+    stats.CommandBytes++;
+    stats.CommandCounts[cmd]++;
+    command = cmd;
+    paramCount = 0;
+    memoryWrite = false;
+    haveHighByte = false;
+
+    switch (cmd) {
+    case 0x01: resetRegisters(); break;                     // SWRESET
+    case 0x10: panel.Sleeping = true; break;                // SLPIN
+    case 0x11:                                              // SLPOUT
+        panel.Sleeping = false;
+        slpoutSeen = true;
+        slpoutNs = nowNs;
+        break;
+    case 0x20: panel.Inverted = false; break;               // INVOFF
+    case 0x21: panel.Inverted = true; break;                // INVON
+    case 0x28: panel.DisplayOn = false; break;              // DISPOFF
+    case 0x29: panel.DisplayOn = true; break;               // DISPON
+    case 0x2C:                                              // RAMWR
+        cursorColumn = columnStart;
+        cursorRow = rowStart;
+        memoryWrite = true;
+        stats.Windows++;
+        break;
+    case 0x3C:                                              // RAMWRC
+        memoryWrite = true;
+        stats.Windows++;
+        break;
+    default:
+        break;
+    }
+}
+
+static void pixel(uint16_t color)
+{
+    if (cursorRow > rowEnd || cursorRow >= NATIVE_GRAM_ROWS || cursorColumn >= NATIVE_GRAM_COLUMNS) {
+        stats.Overflows++;
+        return;
+    }
+    gram[cursorRow][cursorColumn] = color;
+    stats.Pixels++;
+    if (++cursorColumn > columnEnd) {
+        cursorColumn = columnStart;
+        cursorRow++;
+    }
+}
+
+static void dataByte(uint8_t data)
+{
+    if (memoryWrite) {
+        // 16 bit/pixel (COLMOD 0x05), high byte first
+        if (haveHighByte) {
+            pixel((uint16_t)(highByte << 8 | data));
+        } else {
+            highByte = data;
+        }
+        haveHighByte = !haveHighByte;
+        return;
+    }
+    if (paramCount < sizeof(params)) {
+        params[paramCount] = data;
+    }
+    paramCount++;
+
+    switch (command) {
+    case 0x2A:                                              // CASET
+        if (paramCount == 4) {
+            columnStart = paramWord(0);
+            columnEnd = paramWord(2);
+        }
+        break;
+    case 0x2B:                                              // RASET
+        if (paramCount == 4) {
+            rowStart = paramWord(0);
+            rowEnd = paramWord(2);
+        }
+        break;
+    case 0x33:                                              // VSCRDEF
+        if (paramCount == 6) {
+            scrollTop = paramWord(0);
+            scrollArea = paramWord(2);
+        }
+        break;
+    case 0x36: panel.Madctl = data; break;                  // MADCTL
+    case 0x37:                                              // VSCSAD
+        if (paramCount == 2) {
+            panel.ScrollLine = paramWord(0);
+        }
+        break;
+    case 0x3A: panel.Colmod = data; break;                  // COLMOD
+    default:
+        break;
+    }
+}
+
+static void clockByte(uint8_t data)
+{
+    stats.Bytes++;
+    if (pins[DEV_CS_PIN]) {
+        stats.StrayBytes++;
+        return;
+    }
+    if (pins[DEV_DC_PIN]) {
+        dataByte(data);
+    } else {
+        commandByte(data);
+    }
+}
+
+/******************************************************************************
+    Pacing: real time slept on top of the virtual clock
+******************************************************************************/
+static void sleepNs(uint64_t ns)
+{
+    if (ns == 0) {
+        return;
+    }
+    struct timespec ts;
+    ts.tv_sec = ns / 1000000000ULL;
+    ts.tv_nsec = ns % 1000000000ULL;
+    while (nanosleep(&ts, &ts) != 0) {
+    }
+}
+
+void Native_PaceSd(uint32_t bytes)
+{
+    sleepNs(pacing.SdNsPerRead + (uint64_t)bytes * pacing.SdNsPerByte);
+}
+
+/******************************************************************************
+    SPI: every call costs CallNs plus its bits at SpiHz
+******************************************************************************/
+static uint64_t wireNs(uint32_t bytes)
+{
+    return timing.CallNs + (uint64_t)bytes * 8 * 1000000000ULL / (timing.SpiHz ? timing.SpiHz : 1);
+}
+
+uint8_t Native_SpiWrite(uint8_t data)
+{
+    ensureReady();
+    stats.SpiCalls++;
+    spend(wireNs(1));
+    clockByte(data);
+    return 0xFF;
+}
+
+void Native_SpiWriteBytes(const uint8_t *data, uint32_t len)
+{
+    ensureReady();
+    stats.SpiCalls++;
+    spend(wireNs(len));
+    sleepNs((uint64_t)len * pacing.LcdNsPerByte);
+    for (uint32_t i = 0; i < len; i++) {
+        clockByte(data[i]);
+    }
+}
+
+/******************************************************************************
+    Timing and backlight PWM
+******************************************************************************/
+void Native_DelayUs(uint64_t us)
+{
+    nowNs += us * 1000;
+}
+
+uint64_t Native_Micros(void)
+{
+    return nowNs / 1000;
+}
+
+void Native_PwmSetup(uint8_t channel, uint32_t freq, uint8_t bits)
+{
+    (void)freq;
+    ensureReady();
+    if (channel < NATIVE_PWM_CHANNELS) {
+        pwmBits[channel] = bits;
+    }
+}
+
+// channel < 0 detaches the pin, which goes back to its GPIO level
+void Native_PwmAttach(uint8_t pin, int channel)
+{
+    if (pin < NATIVE_PINS) {
+        ensureReady();
+        pinChannel[pin] = channel < NATIVE_PWM_CHANNELS ? channel : -1;
+        updateBacklight();
+    }
+}
+
+void Native_PwmWrite(uint8_t channel, uint32_t duty)
+{
+    ensureReady();
+    if (channel < NATIVE_PWM_CHANNELS) {
+        pwmDuty[channel] = duty;
+        updateBacklight();
+    }
+}
+
+/******************************************************************************
+function: What the glass shows at panel (x, y)
+info:
+    Panel row y is controller line LCD_Y_OFFSET + y; lines inside the
+    VSCRDEF scroll area are offset by VSCSAD. The IPS panel needs INVON
+    for true colors, so without it every pixel shows inverted. Asleep or
+    display off is black.
+******************************************************************************/
+uint16_t Native_GramPixel(uint16_t column, uint16_t row)
+{
+    return column < NATIVE_GRAM_COLUMNS && row < NATIVE_GRAM_ROWS ? gram[row][column] : 0;
+}
+
+uint16_t Native_PanelPixel(uint16_t x, uint16_t y)
+{
+    if (panel.Sleeping || !panel.DisplayOn) {
+        return 0;
+    }
+    int32_t line = LCD_Y_OFFSET + y;
+    int32_t row = line;
+    if (scrollArea != 0 && line >= scrollTop && line < scrollTop + scrollArea) {
+        int32_t k = (line - scrollTop) + (panel.ScrollLine - scrollTop);
+        row = scrollTop + (k % scrollArea + scrollArea) % scrollArea;
+    }
+    uint16_t color = Native_GramPixel(LCD_X_OFFSET + x, row);
+    return panel.Inverted ? color : (uint16_t)~color;
+}
+
+/******************************************************************************
+    PNG: 8-bit RGB, stored (uncompressed) deflate blocks, no zlib needed
+******************************************************************************/
+static uint32_t crcTable[256];
+
+static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len)
+{
+    if (crcTable[1] == 0) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putBE32(uint8_t *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static bool writeChunk(FILE *file, const char *type, const uint8_t *data, uint32_t len)
+{
+    uint8_t head[8];
+    putBE32(head, len);
+    memcpy(head + 4, type, 4);
+    uint8_t tail[4];
+    putBE32(tail, crc32(crc32(0, head + 4, 4), data, len));
+    return fwrite(head, 1, 8, file) == 8 && (len == 0 || fwrite(data, 1, len, file) == len) &&
+           fwrite(tail, 1, 4, file) == 4;
+}
+
+/******************************************************************************
+function: Write the panel (135x240) or the whole GRAM (240x320) as a PNG
+******************************************************************************/
+bool Native_DumpPNG(const char *path, bool wholeGram)
+{
+    const uint32_t width = wholeGram ? NATIVE_GRAM_COLUMNS : LCD_WIDTH;
+    const uint32_t height = wholeGram ? NATIVE_GRAM_ROWS : LCD_HEIGHT;
+    const uint32_t rawLen = height * (1 + width * 3);
+    const uint32_t blocks = (rawLen + 65534) / 65535;
+    const uint32_t zlen = 2 + rawLen + blocks * 5 + 4;
+
+    uint8_t *raw = (uint8_t *)malloc(rawLen);
+    uint8_t *z = (uint8_t *)malloc(zlen);
+    if (raw == NULL || z == NULL) {
+        free(raw);
+        free(z);
+        return false;
+    }
+    uint8_t *p = raw;
+    for (uint32_t y = 0; y < height; y++) {
+        *p++ = 0; // Filter: none
+        for (uint32_t x = 0; x < width; x++) {
+            uint16_t c = wholeGram ? gram[y][x] : Native_PanelPixel(x, y);
+            *p++ = ((c >> 11) & 0x1F) * 255 / 31;
+            *p++ = ((c >> 5) & 0x3F) * 255 / 63;
+            *p++ = (c & 0x1F) * 255 / 31;
+        }
+    }
+
+    uint8_t *q = z;
+    *q++ = 0x78;
+    *q++ = 0x01;
+    uint32_t a = 1, b = 0;
+    for (uint32_t done = 0; done < rawLen;) {
+        uint32_t n = rawLen - done < 65535 ? rawLen - done : 65535;
+        *q++ = done + n == rawLen ? 1 : 0;
+        *q++ = n & 0xFF;
+        *q++ = n >> 8;
+        *q++ = ~n & 0xFF;
+        *q++ = (~n >> 8) & 0xFF;
+        memcpy(q, raw + done, n);
+        for (uint32_t i = 0; i < n; i++) {
+            a = (a + raw[done + i]) % 65521;
+            b = (b + a) % 65521;
+        }
+        q += n;
+        done += n;
+    }
+    putBE32(q, b << 16 | a);
+
+    uint8_t header[13];
+    putBE32(header, width);
+    putBE32(header + 4, height);
+    header[8] = 8;  // Bit depth
+    header[9] = 2;  // Truecolor
+    header[10] = header[11] = header[12] = 0;
+
+    static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    FILE *file = fopen(path, "wb");
+    bool ok = file != NULL && fwrite(SIGNATURE, 1, 8, file) == 8 && writeChunk(file, "IHDR", header, 13) &&
+              writeChunk(file, "IDAT", z, zlen) && writeChunk(file, "IEND", NULL, 0);
+    if (file != NULL) {
+        ok = fclose(file) == 0 && ok;
+    }
+    free(raw);
+    free(z);
+    return ok;
+}
+
+/******************************************************************************
+    Storage: card paths ("/pics/a.bmp") under a host folder
+******************************************************************************/
+void Native_SetStorageRoot(const char *root)
+{
+    snprintf(storageRoot, sizeof(storageRoot), "%s", root != NULL ? root : "");
+}
+
+bool Native_StoragePath(const char *path, char *out, size_t len)
+{
+    int n = snprintf(out, len, "%s%s", storageRoot, path);
+    return n > 0 && (size_t)n < len;
+}
+#endif
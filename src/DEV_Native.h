@@ -0,0 +1,106 @@
+/*****************************************************************************
+* | File        :   DEV_Native.h
+* | Function    :   Host backend of DEV_Config: virtual ST7789 and SPI accounting
+* | Info        :
+*   The bytes LCD_Driver sends are decoded as the ST7789V would: DC low is
+*   a command, DC high its parameters or pixels, CS frames a transaction.
+*   CASET/RASET/RAMWR/RAMWRC fill a 240x320 RGB565 GRAM; VSCSAD, sleep,
+*   display on/off and inversion are tracked so Native_DumpPNG shows the
+*   135x240 panel as it would look. MADCTL is recorded but only the
+*   default orientation (0x00, the one LCD_Init sets) is emulated.
+*   Time is virtual: delays advance it, and so does every SPI call and
+*   GPIO write, by the NATIVE_TIMING model (bits at the SPI clock plus a
+*   fixed cost per call). The counters then say what a draw costs on the
+*   bus independent of how fast the host is. Datasheet waits that are cut
+*   short (commands within 5 ms of reset, SLPOUT within 120 ms of reset,
+*   commands within 5 ms of SLPOUT) are counted as timing violations.
+*   Pacing: NATIVE_PACING optionally also sleeps real time for LCD pixel
+*   bursts and SD card reads, so threaded tests (Frame_Pipeline) see the
+*   buses run side by side; it is off by default.
+*   Storage: Native_StoragePath maps card paths under a host folder.
+******************************************************************************/
+#ifndef __DEV_NATIVE_H
+#define __DEV_NATIVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NATIVE_GRAM_COLUMNS     240
+#define NATIVE_GRAM_ROWS        320
+#define NATIVE_PINS             64
+#define NATIVE_PWM_CHANNELS     8
+
+// Arduino-ESP32: SPI_CLOCK_DIV2 in Config_Init, SPI.transfer/writeBytes setup, digitalWrite
+#define NATIVE_DEFAULT_SPI_HZ   8000000
+#define NATIVE_DEFAULT_CALL_NS  1000
+#define NATIVE_DEFAULT_GPIO_NS  50
+
+#ifndef ARDUINO
+#define PROGMEM
+#define pgm_read_word(_addr)    (*(const uint16_t *)(_addr))
+#endif
+
+typedef struct {
+    uint32_t SpiHz;
+    uint32_t CallNs;        // Per DEV_SPI_WRITE / DEV_SPI_WRITE_BYTES call
+    uint32_t GpioNs;        // Per DEV_Digital_Write
+} NATIVE_TIMING;
+
+typedef struct {
+    uint32_t LcdNsPerByte;  // Slept per byte of DEV_SPI_WRITE_BYTES
+    uint32_t SdNsPerRead;   // Slept per card read (Native_PaceSd)
+    uint32_t SdNsPerByte;
+} NATIVE_PACING;
+
+typedef struct {
+    uint64_t Bytes;         // All bytes clocked out
+    uint64_t CommandBytes;  // DC low
+    uint64_t Pixels;        // RAMWR/RAMWRC pixels that landed in GRAM
+    uint32_t Transactions;  // CS low..high
+    uint32_t SpiCalls;
+    uint32_t GpioWrites;
+    uint32_t Windows;       // RAMWR/RAMWRC commands
+    uint32_t Overflows;     // Pixels past the end of the window, dropped
+    uint32_t Violations;    // Datasheet waits cut short
+    uint32_t StrayBytes;    // Clocked out with CS high, ignored by the panel
+    uint64_t BusNs;         // Modelled time on SPI and GPIO
+    uint32_t CommandCounts[256];
+} NATIVE_STATS;
+
+typedef struct {
+    uint16_t ScrollLine;    // VSCSAD
+    uint8_t Madctl;
+    uint8_t Colmod;
+    bool Sleeping;
+    bool DisplayOn;
+    bool Inverted;          // INVON
+    uint8_t Backlight;      // Duty on channel LCD_BL_CHANNEL, 0-255
+} NATIVE_PANEL;
+
+// DEV_Config backend
+void Native_DigitalWrite(uint8_t pin, bool level);
+int Native_DigitalRead(uint8_t pin);
+void Native_GpioHold(uint8_t pin, bool on);
+uint8_t Native_SpiWrite(uint8_t data);
+void Native_SpiWriteBytes(const uint8_t *data, uint32_t len);
+void Native_DelayUs(uint64_t us);
+uint64_t Native_Micros(void);
+void Native_PwmSetup(uint8_t channel, uint32_t freq, uint8_t bits);
+void Native_PwmAttach(uint8_t pin, int channel);
+void Native_PwmWrite(uint8_t channel, uint32_t duty);
+
+// Harness
+void Native_Reset(void);
+void Native_SetTiming(const NATIVE_TIMING *timing);
+void Native_SetPacing(const NATIVE_PACING *pacing);
+void Native_PaceSd(uint32_t bytes);
+const NATIVE_STATS *Native_Stats(void);
+void Native_ResetStats(void);
+const NATIVE_PANEL *Native_Panel(void);
+uint16_t Native_GramPixel(uint16_t column, uint16_t row);
+uint16_t Native_PanelPixel(uint16_t x, uint16_t y);
+bool Native_DumpPNG(const char *path, bool wholeGram);
+void Native_SetStorageRoot(const char *root);
+bool Native_StoragePath(const char *path, char *out, size_t len);
+
+#endif
@@ -0,0 +1,205 @@
+/*****************************************************************************
+* | File        :   Deadline_Scheduler.cpp
+* | Function    :   One-shot timers on a min-heap, run from loop() when due
+******************************************************************************/
+#include "Deadline_Scheduler.h"
+#include <string.h>
+
+#define SCHED_SLOT_DUE (-2)    // Taken out by Sched_RunDue, callback not run yet
+
+static SCHED_TIMER *heap[SCHED_MAX_TIMERS];
+static int heapCount = 0;
+static SCHED_STATS stats;
+
+// a is due before b, across the millis() wrap
+static bool before(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+static void place(int slot, SCHED_TIMER *timer)
+{
+    heap[slot] = timer;
+    timer->Slot = slot;
+}
+
+static void siftUp(int slot)
+{
+    SCHED_TIMER *timer = heap[slot];
+    while (slot > 0) {
+        int parent = (slot - 1) / 2;
+        if (!before(timer->Due, heap[parent]->Due)) {
+            break;
+        }
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, timer);
+}
+
+static void siftDown(int slot)
+{
+    SCHED_TIMER *timer = heap[slot];
+    for (;;) {
+        int child = 2 * slot + 1;
+        if (child >= heapCount) {
+            break;
+        }
+        if (child + 1 < heapCount && before(heap[child + 1]->Due, heap[child]->Due)) {
+            child++;
+        }
+        if (!before(heap[child]->Due, timer->Due)) {
+            break;
+        }
+        place(slot, heap[child]);
+        slot = child;
+    }
+    place(slot, timer);
+}
+
+// Take a timer out of the heap, wherever it sits
+static void removeAt(int slot)
+{
+    SCHED_TIMER *timer = heap[slot];
+    heapCount--;
+    if (slot != heapCount) {
+        place(slot, heap[heapCount]); // Last timer fills the hole, then finds its level
+        if (slot > 0 && before(heap[slot]->Due, heap[(slot - 1) / 2]->Due)) {
+            siftUp(slot);
+        } else {
+            siftDown(slot);
+        }
+    }
+    timer->Slot = -1;
+}
+
+/******************************************************************************
+function: Describe a timer; it starts disarmed
+******************************************************************************/
+void Sched_Init(SCHED_TIMER *timer, const char *name, SCHED_CALLBACK callback, void *arg)
+{
+    timer->Name = name;
+    timer->Callback = callback;
+    timer->Arg = arg;
+    timer->Due = 0;
+    timer->Slot = -1;
+}
+
+/******************************************************************************
+function: Arm (or move) a timer to fire at dueMs
+info:
+    Returns false only if every heap slot is taken by other timers.
+******************************************************************************/
+bool Sched_At(SCHED_TIMER *timer, uint32_t dueMs)
+{
+    if (timer->Slot >= 0) {
+        removeAt(timer->Slot);
+    }
+    if (heapCount == SCHED_MAX_TIMERS) {
+        return false;
+    }
+    timer->Due = dueMs;
+    heap[heapCount] = timer;
+    timer->Slot = heapCount;
+    heapCount++;
+    siftUp(timer->Slot);
+    return true;
+}
+
+bool Sched_After(SCHED_TIMER *timer, uint32_t nowMs, uint32_t delayMs)
+{
+    return Sched_At(timer, nowMs + delayMs);
+}
+
+void Sched_Cancel(SCHED_TIMER *timer)
+{
+    if (timer->Slot >= 0) {
+        removeAt(timer->Slot);
+    }
+    timer->Slot = -1;
+}
+
+bool Sched_IsArmed(const SCHED_TIMER *timer)
+{
+    return timer->Slot != -1;
+}
+
+/******************************************************************************
+function: Run the callbacks of every timer due at nowMs, earliest first
+info:
+    The due timers are taken out of the heap first and then run in order,
+    so a callback may re-arm its own timer (even in the past: it runs on
+    the next call, never spins here) or cancel one that is still waiting
+    its turn in this batch.
+******************************************************************************/
+int Sched_RunDue(uint32_t nowMs)
+{
+    SCHED_TIMER *due[SCHED_MAX_TIMERS];
+    int count = 0;
+    while (heapCount > 0 && !before(nowMs, heap[0]->Due)) {
+        due[count] = heap[0];
+        removeAt(0);
+        due[count++]->Slot = SCHED_SLOT_DUE;
+    }
+
+    int ran = 0;
+    for (int i = 0; i < count; i++) {
+        SCHED_TIMER *timer = due[i];
+        if (timer->Slot != SCHED_SLOT_DUE) {
+            continue; // Cancelled or re-armed by an earlier callback
+        }
+        timer->Slot = -1;
+        uint32_t late = nowMs - timer->Due;
+        if (late > stats.MaxLateMs) {
+            stats.MaxLateMs = late;
+        }
+        stats.Runs++;
+        ran++;
+        timer->Callback(timer->Arg);
+    }
+    return ran;
+}
+
+bool Sched_NextDeadline(uint32_t *dueMs)
+{
+    if (heapCount == 0) {
+        return false;
+    }
+    *dueMs = heap[0]->Due;
+    return true;
+}
+
+// Milliseconds until the earliest deadline, 0 if overdue, at most limitMs
+uint32_t Sched_TimeUntilNext(uint32_t nowMs, uint32_t limitMs)
+{
+    if (heapCount == 0) {
+        return limitMs;
+    }
+    if (!before(nowMs, heap[0]->Due)) {
+        return 0;
+    }
+    uint32_t wait = heap[0]->Due - nowMs;
+    return wait < limitMs ? wait : limitMs;
+}
+
+/******************************************************************************
+function: CPU time accounting
+info:
+    loop() reports how long it worked and how long it blocked waiting for
+    the next deadline or input; idle share = IdleUs / (IdleUs + BusyUs).
+******************************************************************************/
+void Sched_AccountTime(uint32_t busyUs, uint32_t idleUs)
+{
+    stats.BusyUs += busyUs;
+    stats.IdleUs += idleUs;
+}
+
+void Sched_GetStats(SCHED_STATS *out)
+{
+    *out = stats;
+}
+
+void Sched_ResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
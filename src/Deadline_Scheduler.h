@@ -0,0 +1,50 @@
+/*****************************************************************************
+* | File        :   Deadline_Scheduler.h
+* | Function    :   One-shot timers on a min-heap, run from loop() when due
+* | Info        :
+*   Each timeout in the UI (mode graphic, speed overlay, slideshow advance,
+*   SD probe, LED heartbeat) is a SCHED_TIMER the caller owns. Arming one
+*   puts it in a binary min-heap ordered by due time, so the earliest
+*   deadline is always at the top: Sched_NextDeadline() tells loop() how
+*   long it may block, and Sched_RunDue() runs whatever has come due.
+*   Periodic work re-arms its own timer from its callback.
+*   Times are millis() values compared across the 32-bit wrap; deadlines
+*   must lie within 24 days of each other. No Arduino dependency.
+******************************************************************************/
+#ifndef __DEADLINE_SCHEDULER_H
+#define __DEADLINE_SCHEDULER_H
+
+#include <stdint.h>
+
+#define SCHED_MAX_TIMERS 16
+
+typedef void (*SCHED_CALLBACK)(void *arg);
+
+typedef struct {
+    const char *Name;
+    SCHED_CALLBACK Callback;
+    void *Arg;
+    uint32_t Due;
+    int8_t Slot;            // Heap position; -1 disarmed, -2 about to run
+} SCHED_TIMER;
+
+typedef struct {
+    uint32_t Runs;          // Callbacks run
+    uint32_t MaxLateMs;     // Worst time between a deadline and its callback
+    uint64_t IdleUs;        // Time loop() reported as blocked waiting
+    uint64_t BusyUs;        // Time loop() reported as working
+} SCHED_STATS;
+
+void Sched_Init(SCHED_TIMER *timer, const char *name, SCHED_CALLBACK callback, void *arg);
+bool Sched_At(SCHED_TIMER *timer, uint32_t dueMs);
+bool Sched_After(SCHED_TIMER *timer, uint32_t nowMs, uint32_t delayMs);
+void Sched_Cancel(SCHED_TIMER *timer);
+bool Sched_IsArmed(const SCHED_TIMER *timer);
+int Sched_RunDue(uint32_t nowMs);
+bool Sched_NextDeadline(uint32_t *dueMs);
+uint32_t Sched_TimeUntilNext(uint32_t nowMs, uint32_t limitMs);
+void Sched_AccountTime(uint32_t busyUs, uint32_t idleUs);
+void Sched_GetStats(SCHED_STATS *stats);
+void Sched_ResetStats(void);
+
+#endif
@@ -0,0 +1,260 @@
+/*****************************************************************************
+* | File        :   Flipbook_Player.cpp
+* | Function    :   High-rate playback of a numbered still sequence from RAM
+******************************************************************************/
+#include "Flipbook_Player.h"
+#include "Frame_Pipeline.h"
+#include "LCD_Driver.h"
+#include "Heap_Telemetry.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#define FLIP_MICROS()   micros()
+#define FLIP_PRINTF     Serial.printf
+#else
+#include <stdio.h>
+#include <strings.h>
+#include "DEV_Config.h"
+#define FLIP_MICROS()   ((uint32_t)Native_Micros())     // The virtual board clock
+#define FLIP_PRINTF     printf
+#endif
+
+#define FRAME_BYTES (LCD_WIDTH * LCD_HEIGHT * 2)
+
+static uint8_t *cache[FLIPBOOK_MAX_FRAMES];
+static uint16_t cached = 0;         // Frames loaded so far
+static uint16_t frameCount = 0;     // Frames that fit the cache
+static bool loading = false;
+static bool playing = false;
+static FLIPBOOK_LOAD loadFrame = NULL;
+static FLIPBOOK_MODE playMode = FLIPBOOK_LOOP;
+static int flipImage = -1;
+
+static uint32_t periodUs = 0;
+static uint32_t nextDueUs = 0;
+static uint32_t position = 0;       // Step in the loop or ping-pong cycle
+static uint16_t shownFrame = 0;
+static FLIPBOOK_STATS stats;
+static const char *lastError = "";
+
+// Frames in one cycle: n for a loop, 2n - 2 for ping-pong
+static uint32_t cycleLength(void)
+{
+    return playMode == FLIPBOOK_PINGPONG && frameCount > 2 ? 2 * frameCount - 2 : frameCount;
+}
+
+static uint16_t frameAt(uint32_t step)
+{
+    return step < frameCount ? step : 2 * frameCount - 2 - step;
+}
+
+static void freeCache(void)
+{
+    for (int i = 0; i < FLIPBOOK_MAX_FRAMES; i++) {
+        Heap_Free(cache[i]);
+        cache[i] = NULL;
+    }
+    cached = 0;
+}
+
+/******************************************************************************
+function: Flipbook settings from a folder name
+info:
+    "<name>.flip" marks a flipbook folder; "_<n>fps" sets the rate and
+    "pingpong" the mode, e.g. "/clips/walk_24fps_pingpong.flip".
+******************************************************************************/
+bool Flipbook_ParseName(const char *folder, uint16_t *fps, FLIPBOOK_MODE *mode)
+{
+    const char *name = strrchr(folder, '/');
+    name = name != NULL ? name + 1 : folder;
+    size_t len = strlen(name);
+
+    *fps = FLIPBOOK_DEFAULT_FPS;
+    *mode = strstr(name, "pingpong") != NULL ? FLIPBOOK_PINGPONG : FLIPBOOK_LOOP;
+    for (const char *p = strstr(name, "fps"); p != NULL; p = strstr(p + 1, "fps")) {
+        const char *digits = p;
+        while (digits > name && digits[-1] >= '0' && digits[-1] <= '9') {
+            digits--;
+        }
+        if (digits < p && digits > name && digits[-1] == '_') {
+            int value = atoi(digits);
+            *fps = value < FLIPBOOK_MIN_FPS ? FLIPBOOK_MIN_FPS : value > FLIPBOOK_MAX_FPS ? FLIPBOOK_MAX_FPS : value;
+        }
+    }
+    return len > 5 && strcasecmp(name + len - 5, ".flip") == 0;
+}
+
+/******************************************************************************
+function: Allocate the cache and start loading the sequence
+info:
+    Slots come from PSRAM first, then internal RAM; a sequence longer than
+    the memory available is cut short rather than streamed, since SD reads
+    cannot hold 30 fps. Loading happens one file per Flipbook_Service().
+******************************************************************************/
+bool Flipbook_Start(int fileCount, uint16_t fps, FLIPBOOK_MODE mode, FLIPBOOK_LOAD load, int image)
+{
+    Flipbook_Stop();
+    if (fileCount <= 0 || load == NULL) {
+        lastError = "no frames";
+        return false;
+    }
+    frameCount = fileCount < FLIPBOOK_MAX_FRAMES ? fileCount : FLIPBOOK_MAX_FRAMES;
+    for (uint16_t i = 0; i < frameCount; i++) {
+        cache[i] = (uint8_t *)Heap_Alloc(HEAP_CACHE, FRAME_BYTES, HEAP_CAP_PSRAM);
+        if (cache[i] == NULL) {
+            frameCount = i;
+            break;
+        }
+    }
+    if (frameCount == 0) {
+        lastError = "out of memory for the frame cache";
+        return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    stats.Files = fileCount;
+    fps = fps < FLIPBOOK_MIN_FPS ? FLIPBOOK_MIN_FPS : fps > FLIPBOOK_MAX_FPS ? FLIPBOOK_MAX_FPS : fps;
+    periodUs = 1000000UL / fps;
+    playMode = mode;
+    loadFrame = load;
+    flipImage = image;
+    cached = 0;
+    position = 0;
+    loading = true;
+    playing = true;
+    return true;
+}
+
+void Flipbook_Stop(void)
+{
+    if (!playing) {
+        return;
+    }
+    Pipeline_WaitPresent(); // The present task may still be reading a slot
+    playing = false;
+    loading = false;
+    if (stats.Frames > 0) {
+        Flipbook_PrintStats();
+    }
+    freeCache();
+}
+
+bool Flipbook_IsPlaying(void)
+{
+    return playing;
+}
+
+// While loading there is always more to do
+bool Flipbook_NextDeadline(uint32_t *dueUs)
+{
+    *dueUs = loading ? FLIP_MICROS() : nextDueUs;
+    return playing;
+}
+
+/******************************************************************************
+function: Load the next file, or present the frame that is due
+info:
+    Deadlines advance by exactly one period per step, shown or skipped, so
+    the rate stays locked to the timeline no matter how loop() is woken.
+******************************************************************************/
+void Flipbook_Service(uint32_t nowUs)
+{
+    if (!playing) {
+        return;
+    }
+    if (loading) {
+        uint32_t t0 = FLIP_MICROS();
+        bool ok = loadFrame(cached, cache[cached]);
+        stats.LoadMicros += FLIP_MICROS() - t0;
+        if (!ok) {
+            // An unreadable file ends the sequence there
+            frameCount = cached;
+        } else {
+            cached++;
+        }
+        stats.Cached = cached;
+        if (cached < frameCount) {
+            return;
+        }
+        loading = false;
+        if (frameCount == 0) {
+            lastError = "no frame could be decoded";
+            Flipbook_Stop();
+            return;
+        }
+        nextDueUs = FLIP_MICROS();
+        return;
+    }
+    if ((int32_t)(nowUs - nextDueUs) < 0) {
+        return;
+    }
+
+    uint32_t late = (nowUs - nextDueUs) / periodUs;
+    if (late > 0) {
+        stats.Dropped += late;
+        position += late;
+        nextDueUs += late * periodUs;
+    }
+    uint32_t cycle = cycleLength();
+    stats.Cycles += position / cycle;
+    position %= cycle;
+    shownFrame = frameAt(position);
+
+    Pipeline_PresentPanel(cache[shownFrame], flipImage);
+    uint32_t shownUs = FLIP_MICROS();
+    if (stats.Frames > 0) {
+        uint32_t frameUs = shownUs - stats.LastUs;
+        if (stats.Frames == 1 || frameUs < stats.MinFrameUs) {
+            stats.MinFrameUs = frameUs;
+        }
+        if (frameUs > stats.MaxFrameUs) {
+            stats.MaxFrameUs = frameUs;
+        }
+        stats.SumFrameUs += frameUs;
+        stats.SumSquareFrameUs += (uint64_t)frameUs * frameUs;
+    } else {
+        stats.FirstUs = shownUs;
+    }
+    stats.LastUs = shownUs;
+    stats.Frames++;
+    position++;
+    nextDueUs += periodUs;
+}
+
+// Show the current frame again, e.g. after an overlay covered it
+void Flipbook_Redraw(void)
+{
+    if (playing && !loading) {
+        Pipeline_PresentPanel(cache[shownFrame], flipImage);
+    }
+}
+
+/******************************************************************************
+function: Playback statistics
+******************************************************************************/
+void Flipbook_GetStats(FLIPBOOK_STATS *out)
+{
+    *out = stats;
+}
+
+void Flipbook_PrintStats(void)
+{
+    uint32_t intervals = stats.Frames > 1 ? stats.Frames - 1 : 0;
+    float sustained = intervals > 0 ? intervals * 1000000.0f / (stats.LastUs - stats.FirstUs) : 0.0f;
+    double mean = intervals > 0 ? (double)stats.SumFrameUs / intervals : 0.0;
+    double variance = intervals > 0 ? (double)stats.SumSquareFrameUs / intervals - mean * mean : 0.0;
+    FLIP_PRINTF("📽️  Flipbook: %u/%u frames cached (%u ms to load), %u shown, %u dropped, %u cycles, %.1f/%.1f fps\n",
+                (unsigned)stats.Cached, (unsigned)stats.Files, (unsigned)(stats.LoadMicros / 1000),
+                (unsigned)stats.Frames, (unsigned)stats.Dropped, (unsigned)stats.Cycles, sustained,
+                periodUs > 0 ? 1000000.0f / periodUs : 0.0f);
+    FLIP_PRINTF("📽️  Frame time: mean %.2f ms, sd %.2f ms (variance %.3f ms²), min %.2f, max %.2f ms\n",
+                mean / 1000.0, variance > 0 ? sqrt(variance) / 1000.0 : 0.0,
+                variance > 0 ? variance / 1e6 : 0.0, stats.MinFrameUs / 1000.0, stats.MaxFrameUs / 1000.0);
+}
+
+const char *Flipbook_LastError(void)
+{
+    return lastError;
+}
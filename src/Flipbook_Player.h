@@ -0,0 +1,60 @@
+/*****************************************************************************
+* | File        :   Flipbook_Player.h
+* | Function    :   High-rate playback of a numbered still sequence from RAM
+* | Info        :
+*   The files of an album (sorted by name, so frame_001.jpg, frame_002.jpg
+*   ...) are decoded once into a cache of panel-ready frames in wire byte
+*   order, in PSRAM when there is any. Playback then costs no SD access
+*   and no decode: each frame is a single full-window burst pushed by the
+*   pipeline's present task on core 0 while loop() keeps time.
+*   Frames are due on absolute deadlines at a locked 10-30 fps; a frame
+*   whose slot has passed is skipped, never shown late into the next.
+*   Playback loops or ping-pongs (1..n, n-1..2, 1..n ...).
+*   A folder named like "walk_24fps_pingpong.flip" starts as a flipbook
+*   with its rate and mode taken from the name.
+******************************************************************************/
+#ifndef __FLIPBOOK_PLAYER_H
+#define __FLIPBOOK_PLAYER_H
+
+#include <stdint.h>
+
+#define FLIPBOOK_MAX_FRAMES   64      // Cache slots (64 KB each)
+#define FLIPBOOK_MIN_FPS      10
+#define FLIPBOOK_MAX_FPS      30
+#define FLIPBOOK_DEFAULT_FPS  12
+
+typedef enum {
+    FLIPBOOK_LOOP = 0,
+    FLIPBOOK_PINGPONG,
+} FLIPBOOK_MODE;
+
+// Load one file of the sequence as a panel-ready, big-endian frame
+typedef bool (*FLIPBOOK_LOAD)(int file, uint8_t *panelBytes);
+
+typedef struct {
+    uint16_t Files;         // Files in the sequence
+    uint16_t Cached;        // Frames loaded into the cache
+    uint32_t LoadMicros;
+    uint32_t Frames;        // Frames presented
+    uint32_t Dropped;       // Frames skipped to hold the rate
+    uint32_t Cycles;        // Loops, or ping-pong turns
+    uint32_t FirstUs;       // First and last presentation
+    uint32_t LastUs;
+    uint32_t MinFrameUs;    // Time between consecutive presentations
+    uint32_t MaxFrameUs;
+    uint64_t SumFrameUs;
+    uint64_t SumSquareFrameUs;
+} FLIPBOOK_STATS;
+
+bool Flipbook_ParseName(const char *folder, uint16_t *fps, FLIPBOOK_MODE *mode);
+bool Flipbook_Start(int fileCount, uint16_t fps, FLIPBOOK_MODE mode, FLIPBOOK_LOAD load, int image);
+void Flipbook_Stop(void);
+bool Flipbook_IsPlaying(void);
+bool Flipbook_NextDeadline(uint32_t *dueUs);
+void Flipbook_Service(uint32_t nowUs);
+void Flipbook_Redraw(void);
+void Flipbook_GetStats(FLIPBOOK_STATS *stats);
+void Flipbook_PrintStats(void);
+const char *Flipbook_LastError(void);
+
+#endif
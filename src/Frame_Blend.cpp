@@ -0,0 +1,111 @@
+/*****************************************************************************
+* | File        :   Frame_Blend.cpp
+* | Function    :   Crossfade and dissolve between two RGB565 frames
+******************************************************************************/
+#include "Frame_Blend.h"
+
+#define SPREAD_MASK 0x07E0F81FUL    // G in bits 21-26, R in 11-15, B in 0-4
+
+// Each channel gets 5 spare bits above it, enough for a product with 0..32
+static inline uint32_t spread(uint16_t c)
+{
+    return (c | ((uint32_t)c << 16)) & SPREAD_MASK;
+}
+
+static inline uint16_t pack(uint32_t s)
+{
+    s &= SPREAD_MASK;
+    return (uint16_t)(s | (s >> 16));
+}
+
+// Level 0..256 to the 5-bit alpha the spread channels have room for
+static inline uint32_t alphaOf(uint16_t level)
+{
+    return level >= BLEND_LEVELS ? 32 : (level + 4) >> 3;
+}
+
+uint16_t Blend_Pixel565(uint16_t from, uint16_t to, uint16_t level)
+{
+    uint32_t a = alphaOf(level);
+    return pack((spread(from) * (32 - a) + spread(to) * a) >> 5);
+}
+
+/******************************************************************************
+function: Crossfade one row into big-endian panel bytes
+info:
+    Runs of unchanged pixels (letterbox bars, flat backgrounds) skip the
+    multiply.
+******************************************************************************/
+void Blend_Row565(const uint16_t *from, const uint16_t *to, uint16_t count, uint16_t level, uint8_t *out)
+{
+    uint32_t a = alphaOf(level);
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t c = from[i];
+        if (c != to[i]) {
+            c = pack((spread(c) * (32 - a) + spread(to[i]) * a) >> 5);
+        }
+        out[2 * i] = c >> 8;
+        out[2 * i + 1] = c & 0xFF;
+    }
+}
+
+// Fixed per-pixel threshold 0..255 (integer hash, evenly spread over levels)
+uint8_t Blend_DissolveThreshold(uint16_t x, uint16_t y)
+{
+    uint32_t h = ((uint32_t)y << 16) | x;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6DUL;
+    h ^= h >> 12;
+    h *= 0x297A2D39UL;
+    h ^= h >> 15;
+    return h >> 24;
+}
+
+void Blend_DissolveRow565(const uint16_t *from, const uint16_t *to, uint16_t count, uint16_t y,
+                          uint16_t level, uint8_t *out)
+{
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t c = Blend_DissolveThreshold(i, y) < level ? to[i] : from[i];
+        out[2 * i] = c >> 8;
+        out[2 * i + 1] = c & 0xFF;
+    }
+}
+
+void Blend_Begin(BLEND_PACER *pacer, uint16_t steps, uint32_t periodUs, uint32_t startUs)
+{
+    pacer->Steps = steps > 0 ? steps : 1;
+    pacer->Step = 0;
+    pacer->Dropped = 0;
+    pacer->StartUs = startUs;
+    pacer->PeriodUs = periodUs;
+}
+
+/******************************************************************************
+function: Level of the next frame to draw
+info:
+    Frame k belongs to slot k, which ends at StartUs + k * PeriodUs. When
+    drawing has fallen into a later slot, the levels in between are
+    skipped; the last frame (the incoming image) is never skipped.
+******************************************************************************/
+bool Blend_Next(BLEND_PACER *pacer, uint32_t nowUs, uint16_t *level)
+{
+    if (pacer->Step >= pacer->Steps) {
+        return false;
+    }
+    uint32_t slot = (nowUs - pacer->StartUs) / pacer->PeriodUs + 1;
+    uint16_t next = pacer->Step + 1;
+    if (slot > next) {
+        uint16_t target = slot < pacer->Steps ? slot : pacer->Steps;
+        pacer->Dropped += target - next;
+        next = target;
+    }
+    pacer->Step = next;
+    *level = (uint32_t)next * BLEND_LEVELS / pacer->Steps;
+    return true;
+}
+
+// End of the slot the last returned frame belongs to
+uint32_t Blend_SlotEndUs(const BLEND_PACER *pacer)
+{
+    return pacer->StartUs + (uint32_t)pacer->Step * pacer->PeriodUs;
+}
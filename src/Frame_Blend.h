@@ -0,0 +1,41 @@
+/*****************************************************************************
+* | File        :   Frame_Blend.h
+* | Function    :   Crossfade and dissolve between two RGB565 frames
+* | Info        :
+*   Rows of the outgoing and incoming frames are mixed straight into the
+*   big-endian line buffer the LCD burst is sent from.
+*   Crossfade: each pixel is spread to 0b00000GGGGGG00000RRRRR000000BBBBB so
+*   all three channels are weighted by one 32-bit multiply per frame
+*   (5-bit alpha, 33 levels, exact per-channel floor).
+*   Dissolve: each pixel switches to the incoming frame once the level
+*   passes its fixed pseudo-random threshold, so pixels never switch back.
+*   A pacer spaces the frames at a fixed period and skips levels when a
+*   frame overruns its slot, so the transition keeps its duration.
+*   No Arduino dependency: the blend and pacer run in host tests.
+******************************************************************************/
+#ifndef __FRAME_BLEND_H
+#define __FRAME_BLEND_H
+
+#include <stdint.h>
+
+#define BLEND_LEVELS    256     // Level of a fully shown incoming frame
+
+typedef struct {
+    uint16_t Steps;             // Frames planned, the last one at BLEND_LEVELS
+    uint16_t Step;              // Frames taken so far, including skipped ones
+    uint16_t Dropped;           // Levels skipped because a frame ran late
+    uint32_t StartUs;
+    uint32_t PeriodUs;
+} BLEND_PACER;
+
+uint16_t Blend_Pixel565(uint16_t from, uint16_t to, uint16_t level);
+void Blend_Row565(const uint16_t *from, const uint16_t *to, uint16_t count, uint16_t level, uint8_t *out);
+uint8_t Blend_DissolveThreshold(uint16_t x, uint16_t y);
+void Blend_DissolveRow565(const uint16_t *from, const uint16_t *to, uint16_t count, uint16_t y,
+                          uint16_t level, uint8_t *out);
+
+void Blend_Begin(BLEND_PACER *pacer, uint16_t steps, uint32_t periodUs, uint32_t startUs);
+bool Blend_Next(BLEND_PACER *pacer, uint32_t nowUs, uint16_t *level);
+uint32_t Blend_SlotEndUs(const BLEND_PACER *pacer);
+
+#endif
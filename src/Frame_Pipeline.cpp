@@ -0,0 +1,600 @@
+/*****************************************************************************
+* | File        :   Frame_Pipeline.cpp
+* | Function    :   Double-buffered frame pipeline overlapping SD and LCD work
+******************************************************************************/
+#include "Frame_Pipeline.h"
+#include "LCD_Driver.h"
+#include "Latency_Trace.h"
+#include "Frame_Blend.h"
+#include "Stage_Profiler.h"
+#include "Heap_Telemetry.h"
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#define PIPE_MICROS()       micros()
+#define PIPE_SLEEP_MS(ms)   vTaskDelay(pdMS_TO_TICKS(ms))
+#define PIPE_PRINTF         Serial.printf
+#else
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+// Host: the present task is a thread and time is the host's steady clock,
+// so the SD and LCD sides really run side by side (DEV_Native pacing)
+static uint32_t hostMicros(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+#define PIPE_MICROS()       hostMicros()
+#define PIPE_SLEEP_MS(ms)   std::this_thread::sleep_for(std::chrono::milliseconds(ms))
+#define PIPE_PRINTF         printf
+#endif
+
+static const char *STAGE_NAMES[] = {"none", "scan", "decode", "present", "ui"};
+static const char *BUS_NAMES[] = {"sd", "lcd"};
+static const char *PRESENT_NAMES[] = {"cut", "push-up", "push-down", "crossfade", "dissolve"};
+
+#define TRANSITION_STEPS    15      // 250 ms at the panel's 60 Hz
+#define TRANSITION_FRAME_US 16667   // FRCTRL2 0x0F
+#define TRANSITION_ROWS     16      // Rows per byte-swapped SPI burst
+#define BLEND_MS            400     // Crossfade/dissolve duration
+#define BLEND_MAX_STEPS     12      // 30 fps; a full frame is ~13 ms at 40 MHz
+#define BLEND_MIN_STEPS     4
+
+#ifdef ARDUINO
+static SemaphoreHandle_t busMutex[BUS_COUNT] = {NULL, NULL};
+#else
+static std::mutex busMutex[BUS_COUNT];
+#endif
+static volatile PIPE_STAGE busOwner[BUS_COUNT] = {STAGE_NONE, STAGE_NONE};
+
+static uint16_t *frames[2] = {NULL, NULL};
+static int frameImage[2] = {-1, -1};
+static int front = 0;
+
+#ifdef ARDUINO
+static TaskHandle_t presentTask = NULL;
+static SemaphoreHandle_t presentDone = NULL;
+static volatile bool presenting = false;
+#else
+// Never destroyed: the detached present thread still waits on them at exit
+static bool presentStarted = false;
+static std::mutex &presentLock = *new std::mutex;
+static std::condition_variable &presentWake = *new std::condition_variable;  // Request for the present thread
+static std::condition_variable &presentDone = *new std::condition_variable;
+static uint32_t presentRequests = 0;            // Under presentLock, like a task notification count
+static std::atomic<bool> presenting(false);
+#endif
+static volatile PIPE_PRESENT presentMode = PRESENT_CUT;
+static const uint8_t *volatile presentBytes = NULL; // Panel-ready frame outside frames[] (flipbook)
+static int presentImage = -1;
+static int panelFrame = -1;     // frames[] slot last presented, -1 once anything else is drawn
+static PIPE_TRANSITION_STATS transitionStats = {0, 0, 0, 0, 0, 0, 0, 0, 0, BLEND_MAX_STEPS};
+static UBYTE rowBuffer[TRANSITION_ROWS * LCD_WIDTH * 2];
+
+static PIPE_EVENT trace[PIPELINE_TRACE_SIZE];
+static volatile uint32_t traceCount = 0;
+#ifdef ARDUINO
+static portMUX_TYPE traceLock = portMUX_INITIALIZER_UNLOCKED;
+#define TRACE_LOCK()        portENTER_CRITICAL(&traceLock)
+#define TRACE_UNLOCK()      portEXIT_CRITICAL(&traceLock)
+#else
+static std::mutex traceLock;
+#define TRACE_LOCK()        traceLock.lock()
+#define TRACE_UNLOCK()      traceLock.unlock()
+#endif
+
+/******************************************************************************
+function: Present task signalling
+info:
+    A notification wakes the present task; it clears `presenting` and gives
+    presentDone when the frame is out.
+******************************************************************************/
+#ifdef ARDUINO
+static void presentRequest(void)
+{
+    presenting = true;
+    xTaskNotifyGive(presentTask);
+}
+
+static void presentWaitRequest(void)
+{
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+static void presentFinished(void)
+{
+    presenting = false;
+    xSemaphoreGive(presentDone);
+}
+
+static void presentWaitFinished(void)
+{
+    while (presenting) {
+        xSemaphoreTake(presentDone, portMAX_DELAY);
+    }
+}
+#else
+static void presentRequest(void)
+{
+    std::lock_guard<std::mutex> lock(presentLock);
+    presenting = true;
+    presentRequests++;
+    presentWake.notify_one();
+}
+
+static void presentWaitRequest(void)
+{
+    std::unique_lock<std::mutex> lock(presentLock);
+    presentWake.wait(lock, [] { return presentRequests > 0; });
+    presentRequests = 0;
+}
+
+static void presentFinished(void)
+{
+    std::lock_guard<std::mutex> lock(presentLock);
+    presenting = false;
+    presentDone.notify_all();
+}
+
+static void presentWaitFinished(void)
+{
+    std::unique_lock<std::mutex> lock(presentLock);
+    presentDone.wait(lock, [] { return !presenting; });
+}
+#endif
+
+/******************************************************************************
+function: Bus ownership
+info:
+    Whoever drives a bus holds its mutex for the whole transfer, so an
+    overlay can never be interleaved with a frame push on the LCD.
+******************************************************************************/
+void Bus_Acquire(BUS_ID bus, PIPE_STAGE owner)
+{
+#ifdef ARDUINO
+    if (busMutex[bus] != NULL) {
+        xSemaphoreTake(busMutex[bus], portMAX_DELAY);
+    }
+#else
+    busMutex[bus].lock();
+#endif
+    busOwner[bus] = owner;
+}
+
+void Bus_Release(BUS_ID bus)
+{
+    busOwner[bus] = STAGE_NONE;
+#ifdef ARDUINO
+    if (busMutex[bus] != NULL) {
+        xSemaphoreGive(busMutex[bus]);
+    }
+#else
+    busMutex[bus].unlock();
+#endif
+}
+
+PIPE_STAGE Bus_Owner(BUS_ID bus)
+{
+    return busOwner[bus];
+}
+
+// Byte-swap `rows` image rows into rowBuffer (wire order) and burst them out
+static void sendRows(const uint16_t *src, uint16_t rows)
+{
+    for (uint32_t i = 0; i < (uint32_t)rows * LCD_WIDTH; i++) {
+        rowBuffer[2 * i] = src[i] >> 8;
+        rowBuffer[2 * i + 1] = src[i] & 0xFF;
+    }
+    LCD_WriteData_Buffer(rowBuffer, (UDOUBLE)rows * LCD_WIDTH * 2);
+}
+
+/******************************************************************************
+function: Send image rows to consecutive GRAM rows, wrapping past row 319
+******************************************************************************/
+static void writeGramRows(const uint16_t *frame, uint16_t srcRow, uint16_t gramRow, uint16_t rows)
+{
+    while (rows > 0) {
+        uint16_t run = Scroll_RowsBeforeWrap(gramRow, rows);
+        LCD_SetGramWindow(0, gramRow, LCD_WIDTH - 1, gramRow + run - 1);
+        for (uint16_t done = 0; done < run; ) {
+            uint16_t n = run - done < TRANSITION_ROWS ? run - done : TRANSITION_ROWS;
+            sendRows(frame + (uint32_t)(srcRow + done) * LCD_WIDTH, n);
+            done += n;
+        }
+        srcRow += run;
+        gramRow = (gramRow + run) % LCD_GRAM_ROWS;
+        rows -= run;
+    }
+}
+
+// Cut: one window, TRANSITION_ROWS rows per burst instead of a CS toggle per pixel
+static void presentCut(const uint16_t *frame)
+{
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    for (uint16_t y = 0; y < LCD_HEIGHT; y += TRANSITION_ROWS) {
+        uint16_t n = LCD_HEIGHT - y < TRANSITION_ROWS ? LCD_HEIGHT - y : TRANSITION_ROWS;
+        sendRows(frame + (uint32_t)y * LCD_WIDTH, n);
+    }
+}
+
+/******************************************************************************
+function: Push transition
+info:
+    Each step writes the rows about to scroll into view into off-screen
+    GRAM, then moves the scroll line at the next refresh slot. There is no
+    TE line to sync to, so slots are paced from the start of the transition;
+    a step whose rows were still being written at its slot counts as late.
+******************************************************************************/
+static void presentScrolled(const uint16_t *frame, SCROLL_DIRECTION direction)
+{
+    SCROLL_PLAN plan;
+    SCROLL_STEP step;
+    Scroll_Begin(&plan, direction, LCD_GetScroll(), TRANSITION_STEPS);
+    uint32_t start = PIPE_MICROS();
+    uint32_t slot = start;
+    while (Scroll_Next(&plan, &step)) {
+        writeGramRows(frame, step.SrcRow, step.GramRow, step.Rows);
+        transitionStats.Bytes += (uint32_t)step.Rows * LCD_WIDTH * 2;
+
+        slot += TRANSITION_FRAME_US;
+        int32_t wait = (int32_t)(slot - PIPE_MICROS());
+        if (wait < 0) {
+            transitionStats.LateSteps++;
+            slot = PIPE_MICROS();
+        } else {
+            if (wait > 2000) {
+                PIPE_SLEEP_MS(wait / 1000 - 1);
+            }
+            while ((int32_t)(slot - PIPE_MICROS()) > 0) {
+            }
+        }
+        LCD_SetScroll(step.Line);
+        transitionStats.Steps++;
+    }
+    transitionStats.Transitions++;
+    transitionStats.LastUs = PIPE_MICROS() - start;
+}
+
+/******************************************************************************
+function: Crossfade or dissolve from the frame on the panel
+info:
+    Every frame blends both frames row by row into the line buffer and
+    sends the whole panel. Levels that would land in an already passed
+    slot are skipped; when any are, the next blend plans fewer steps
+    (fewer frames per second over the same duration), and it climbs back
+    one step per transition that keeps up.
+******************************************************************************/
+static void presentBlended(const uint16_t *from, const uint16_t *to, bool dissolve)
+{
+    BLEND_PACER pacer;
+    uint16_t level;
+    uint16_t steps = transitionStats.BlendSteps;
+    uint32_t start = PIPE_MICROS();
+    uint16_t frames = 0;
+    Blend_Begin(&pacer, steps, BLEND_MS * 1000UL / steps, start);
+    while (Blend_Next(&pacer, PIPE_MICROS(), &level)) {
+        LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+        for (uint16_t y = 0; y < LCD_HEIGHT; y += TRANSITION_ROWS) {
+            uint16_t n = LCD_HEIGHT - y < TRANSITION_ROWS ? LCD_HEIGHT - y : TRANSITION_ROWS;
+            uint32_t t0 = PIPE_MICROS();
+            for (uint16_t r = 0; r < n; r++) {
+                uint32_t offset = (uint32_t)(y + r) * LCD_WIDTH;
+                if (dissolve) {
+                    Blend_DissolveRow565(from + offset, to + offset, LCD_WIDTH, y + r, level,
+                                         rowBuffer + r * LCD_WIDTH * 2);
+                } else {
+                    Blend_Row565(from + offset, to + offset, LCD_WIDTH, level, rowBuffer + r * LCD_WIDTH * 2);
+                }
+            }
+            transitionStats.BlendUs += PIPE_MICROS() - t0;
+            LCD_WriteData_Buffer(rowBuffer, (UDOUBLE)n * LCD_WIDTH * 2);
+        }
+        transitionStats.Bytes += LCD_WIDTH * LCD_HEIGHT * 2;
+        transitionStats.Steps++;
+        transitionStats.BlendFrames++;
+        frames++;
+
+        int32_t wait = (int32_t)(Blend_SlotEndUs(&pacer) - PIPE_MICROS());
+        if (wait > 2000) {
+            PIPE_SLEEP_MS(wait / 1000 - 1);
+        }
+        while (level < BLEND_LEVELS && (int32_t)(Blend_SlotEndUs(&pacer) - PIPE_MICROS()) > 0) {
+        }
+    }
+    transitionStats.Transitions++;
+    transitionStats.Dropped += pacer.Dropped;
+    transitionStats.LastUs = PIPE_MICROS() - start;
+    transitionStats.LastFrames = frames;
+    if (pacer.Dropped > 0) {
+        transitionStats.BlendSteps = frames > BLEND_MIN_STEPS ? frames : BLEND_MIN_STEPS;
+    } else if (steps < BLEND_MAX_STEPS) {
+        transitionStats.BlendSteps = steps + 1;
+    }
+}
+
+// The front frame, cut or with the requested transition
+static void drawFront(void)
+{
+    PROFILE_SCOPE(PROF_PRESENT);
+    switch (presentMode) {
+    case PRESENT_PUSH_UP:
+    case PRESENT_PUSH_DOWN:
+        presentScrolled(frames[front], presentMode == PRESENT_PUSH_UP ? SCROLL_PUSH_UP : SCROLL_PUSH_DOWN);
+        break;
+    case PRESENT_CROSSFADE:
+    case PRESENT_DISSOLVE:
+        presentBlended(frames[1 - front], frames[front], presentMode == PRESENT_DISSOLVE);
+        break;
+    default:
+        presentCut(frames[front]);
+        break;
+    }
+}
+
+// A panel-ready frame is already in wire order: the whole frame is one burst
+static void drawPanelBytes(const uint8_t *panelBytes)
+{
+    PROFILE_SCOPE(PROF_PRESENT);
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    LCD_WriteData_Buffer(panelBytes, LCD_WIDTH * LCD_HEIGHT * 2);
+}
+
+/******************************************************************************
+function: Present task
+info:
+    Runs on core 0 while loop() (core 1) decodes the next image. Completion
+    is signalled through `presenting`; waiters loop on the flag so a stale
+    semaphore give can never end a wait early. On the host it is a detached
+    thread, so native tests see the same overlap as the panel.
+******************************************************************************/
+static void presentTaskMain(void *param)
+{
+    (void)param;
+    for (;;) {
+        presentWaitRequest();
+
+        Bus_Acquire(BUS_LCD, STAGE_PRESENT);
+        uint32_t t0 = PIPE_MICROS();
+        int image;
+        if (presentBytes != NULL) {
+            drawPanelBytes(presentBytes);
+            image = presentImage;
+        } else {
+            drawFront();
+            image = frameImage[front];
+        }
+        PROFILE_FLUSH(image);
+        Pipeline_Trace(STAGE_PRESENT, BUS_LCD, image, t0, PIPE_MICROS());
+        // Pipeline_Trace forgets the panel frame; a frames[] present puts it back
+        if (presentBytes != NULL) {
+            presentBytes = NULL;
+        } else {
+            panelFrame = front;
+        }
+        Bus_Release(BUS_LCD);
+
+        presentFinished();
+    }
+}
+
+bool Pipeline_Init(void)
+{
+#ifdef ARDUINO
+    for (int i = 0; i < BUS_COUNT; i++) {
+        if (busMutex[i] == NULL) {
+            busMutex[i] = xSemaphoreCreateMutex();
+        }
+    }
+#endif
+    for (int i = 0; i < 2; i++) {
+        if (frames[i] == NULL) {
+            frames[i] = (uint16_t *)Heap_Alloc(HEAP_FRAMES, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t), HEAP_CAP_DEFAULT);
+            if (frames[i] == NULL) {
+                return false;
+            }
+        }
+    }
+#ifdef ARDUINO
+    if (presentTask == NULL) {
+        presentDone = xSemaphoreCreateBinary();
+        if (presentDone == NULL ||
+            xTaskCreatePinnedToCore(presentTaskMain, "lcd_present", 3072, NULL, 1, &presentTask, 0) != pdPASS) {
+            return false;
+        }
+    }
+#else
+    if (!presentStarted) {
+        std::thread(presentTaskMain, (void *)NULL).detach();
+        presentStarted = true;
+    }
+#endif
+    Pipeline_Invalidate();
+    return true;
+}
+
+/******************************************************************************
+function: Frames
+info:
+    The back frame may be decoded into at any time; the front frame is only
+    read by the present task, so Swap waits for a running present first.
+******************************************************************************/
+uint16_t *Pipeline_BackFrame(void)
+{
+    // A blend reads the outgoing image from the back frame
+    if (presentMode == PRESENT_CROSSFADE || presentMode == PRESENT_DISSOLVE) {
+        Pipeline_WaitPresent();
+    }
+    return frames[1 - front];
+}
+
+int Pipeline_BackImage(void)
+{
+    return frameImage[1 - front];
+}
+
+int Pipeline_FrontImage(void)
+{
+    return frameImage[front];
+}
+
+void Pipeline_SetBackImage(int image)
+{
+    frameImage[1 - front] = image;
+}
+
+void Pipeline_Swap(void)
+{
+    Pipeline_WaitPresent();
+    front = 1 - front;
+}
+
+void Pipeline_PresentFront(void)
+{
+    Pipeline_PresentFrontWith(PRESENT_CUT);
+}
+
+void Pipeline_PresentFrontWith(PIPE_PRESENT mode)
+{
+    if (frames[front] == NULL || frameImage[front] < 0) {
+        return;
+    }
+    Pipeline_WaitPresent();
+    // Blends need the outgoing image, i.e. the back frame still on the panel
+    if ((mode == PRESENT_CROSSFADE || mode == PRESENT_DISSOLVE) && panelFrame != 1 - front) {
+        mode = PRESENT_CUT;
+    }
+    presentMode = mode;
+    presentRequest();
+}
+
+// Push a panel-ready frame (LCD_WIDTH x LCD_HEIGHT, big-endian) from the present task
+void Pipeline_PresentPanel(const uint8_t *panelBytes, int image)
+{
+    Pipeline_WaitPresent();
+    presentImage = image;
+    presentBytes = panelBytes;
+    presentRequest();
+}
+
+// Push a frame still being decoded (an interlaced PNG's first pass) from the caller
+void Pipeline_PresentPreview(const uint16_t *frame, int image)
+{
+    Pipeline_WaitPresent();
+    Bus_Acquire(BUS_LCD, STAGE_PRESENT);
+    uint32_t t0 = PIPE_MICROS();
+    presentCut(frame);
+    Pipeline_Trace(STAGE_PRESENT, BUS_LCD, image, t0, PIPE_MICROS());
+    Bus_Release(BUS_LCD);
+}
+
+void Pipeline_WaitPresent(void)
+{
+    presentWaitFinished();
+}
+
+bool Pipeline_IsPresenting(void)
+{
+    return presenting;
+}
+
+void Pipeline_Invalidate(void)
+{
+    Pipeline_WaitPresent();
+    frameImage[0] = -1;
+    frameImage[1] = -1;
+}
+
+const char *Pipeline_PresentName(PIPE_PRESENT mode)
+{
+    return (unsigned)mode < PRESENT_MODE_COUNT ? PRESENT_NAMES[mode] : "?";
+}
+
+const PIPE_TRANSITION_STATS *Pipeline_TransitionStats(void)
+{
+    return &transitionStats;
+}
+
+/******************************************************************************
+function: Trace
+******************************************************************************/
+void Pipeline_Trace(PIPE_STAGE stage, BUS_ID bus, int image, uint32_t startUs, uint32_t endUs)
+{
+    TRACE_LOCK();
+    PIPE_EVENT &event = trace[traceCount % PIPELINE_TRACE_SIZE];
+    event.Stage = stage;
+    event.Bus = bus;
+    event.Image = image;
+    event.StartUs = startUs;
+    event.EndUs = endUs;
+    traceCount++;
+    TRACE_UNLOCK();
+
+    // Every LCD transfer may be the one that answers a button press
+    if (bus == BUS_LCD) {
+        panelFrame = -1; // Until the present task claims it, assume something else was drawn
+        Latency_Photons(startUs, endUs);
+    }
+}
+
+// Copy up to `max` of the newest events, oldest first
+uint32_t Pipeline_CopyTrace(PIPE_EVENT *events, uint32_t max)
+{
+    TRACE_LOCK();
+    uint32_t count = traceCount;
+    uint32_t n = count < PIPELINE_TRACE_SIZE ? count : PIPELINE_TRACE_SIZE;
+    if (n > max) {
+        n = max;
+    }
+    for (uint32_t i = 0; i < n; i++) {
+        events[i] = trace[(count - n + i) % PIPELINE_TRACE_SIZE];
+    }
+    TRACE_UNLOCK();
+    return n;
+}
+
+void Pipeline_ResetTrace(void)
+{
+    TRACE_LOCK();
+    traceCount = 0;
+    TRACE_UNLOCK();
+}
+
+/******************************************************************************
+function: Print the trace ring, oldest first
+info:
+    Also reports how long SD-side and LCD-side stages actually overlapped,
+    which is the time the pipeline saved over running them back to back.
+******************************************************************************/
+void Pipeline_DumpTrace(void)
+{
+    static PIPE_EVENT copy[PIPELINE_TRACE_SIZE];
+    uint32_t count = traceCount;
+    uint32_t n = Pipeline_CopyTrace(copy, PIPELINE_TRACE_SIZE);
+
+    PIPE_PRINTF("# pipeline trace: %u events (%u total)\n", (unsigned)n, (unsigned)count);
+    PIPE_PRINTF("# stage    bus  image   start_us    dur_us\n");
+    uint32_t busyUs[BUS_COUNT] = {0, 0};
+    uint32_t overlapUs = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        const PIPE_EVENT &e = copy[i];
+        uint32_t dur = e.EndUs - e.StartUs;
+        PIPE_PRINTF("%-8s %-4s %6d %10u %9u\n", STAGE_NAMES[e.Stage], BUS_NAMES[e.Bus],
+                    e.Image, (unsigned)e.StartUs, (unsigned)dur);
+        busyUs[e.Bus] += dur;
+        for (uint32_t j = 0; j < i; j++) {
+            const PIPE_EVENT &o = copy[j];
+            if (o.Bus == e.Bus) continue;
+            uint32_t start = e.StartUs > o.StartUs ? e.StartUs : o.StartUs;
+            uint32_t end = e.EndUs < o.EndUs ? e.EndUs : o.EndUs;
+            if (end > start) overlapUs += end - start;
+        }
+    }
+    PIPE_PRINTF("# busy: sd %u us, lcd %u us, overlapped %u us\n",
+                (unsigned)busyUs[BUS_SD], (unsigned)busyUs[BUS_LCD], (unsigned)overlapUs);
+}
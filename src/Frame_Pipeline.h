@@ -0,0 +1,95 @@
+/*****************************************************************************
+* | File        :   Frame_Pipeline.h
+* | Function    :   Double-buffered frame pipeline overlapping SD and LCD work
+* | Info        :
+*   The SD card (sdSPI, HSPI) and the LCD (SPI, FSPI) are separate SPI hosts.
+*   A present task on core 0 pushes the front frame to the panel while the
+*   main loop reads and decodes the next image into the back frame.
+*   Each bus has an explicit owner, and every stage is recorded in a small
+*   trace ring that can be dumped over serial.
+*   A present can also be a push transition: the new frame scrolls in with
+*   the ST7789 scroll registers (LCD_Scroll), one panel refresh per step,
+*   or a crossfade/dissolve from the frame on the panel (Frame_Blend).
+******************************************************************************/
+#ifndef __FRAME_PIPELINE_H
+#define __FRAME_PIPELINE_H
+
+#include <stdint.h>
+
+#define PIPELINE_TRACE_SIZE 64  // Stage events kept in the trace ring
+
+typedef enum {
+    BUS_SD = 0,
+    BUS_LCD,
+    BUS_COUNT,
+} BUS_ID;
+
+typedef enum {
+    STAGE_NONE = 0,
+    STAGE_SCAN,         // Album discovery / card probe (SD bus)
+    STAGE_DECODE,       // Read + decode into the back frame (SD bus)
+    STAGE_PRESENT,      // Front frame pushed to the panel (LCD bus)
+    STAGE_UI,           // Status screens and overlays (LCD bus)
+} PIPE_STAGE;
+
+typedef enum {
+    PRESENT_CUT = 0,    // Whole frame in row bursts
+    PRESENT_PUSH_UP,    // Scrolls in from the bottom
+    PRESENT_PUSH_DOWN,  // Scrolls in from the top
+    PRESENT_CROSSFADE,  // Blended from the frame on the panel
+    PRESENT_DISSOLVE,   // Pixels switch over in random order
+    PRESENT_MODE_COUNT,
+} PIPE_PRESENT;
+
+typedef struct {
+    uint32_t Transitions;
+    uint32_t Bytes;         // Pixel bytes sent by transitions
+    uint32_t Steps;         // Scroll line updates and blended frames sent
+    uint32_t LateSteps;     // Rows not written before their refresh slot
+    uint32_t Dropped;       // Blend levels skipped to keep the duration
+    uint32_t BlendFrames;
+    uint32_t BlendUs;       // Time spent blending rows
+    uint32_t LastUs;        // Duration of the last transition
+    uint16_t LastFrames;    // Frames the last transition sent
+    uint16_t BlendSteps;    // Frames planned for the next blend
+} PIPE_TRANSITION_STATS;
+
+typedef struct {
+    uint8_t Stage;
+    uint8_t Bus;
+    int16_t Image;
+    uint32_t StartUs;
+    uint32_t EndUs;
+} PIPE_EVENT;
+
+// Bus ownership
+void Bus_Acquire(BUS_ID bus, PIPE_STAGE owner);
+void Bus_Release(BUS_ID bus);
+PIPE_STAGE Bus_Owner(BUS_ID bus);
+
+// Frames
+bool Pipeline_Init(void);
+uint16_t *Pipeline_BackFrame(void);
+int Pipeline_BackImage(void);
+int Pipeline_FrontImage(void);
+void Pipeline_SetBackImage(int image);
+void Pipeline_Swap(void);
+void Pipeline_PresentFront(void);
+void Pipeline_PresentFrontWith(PIPE_PRESENT mode);
+void Pipeline_PresentPanel(const uint8_t *panelBytes, int image);
+void Pipeline_PresentPreview(const uint16_t *frame, int image);
+void Pipeline_WaitPresent(void);
+bool Pipeline_IsPresenting(void);
+void Pipeline_Invalidate(void);
+
+// Transitions
+const char *Pipeline_PresentName(PIPE_PRESENT mode);
+const PIPE_TRANSITION_STATS *Pipeline_TransitionStats(void);
+
+// Trace
+void Pipeline_Trace(PIPE_STAGE stage, BUS_ID bus, int image, uint32_t startUs, uint32_t endUs);
+uint32_t Pipeline_CopyTrace(PIPE_EVENT *events, uint32_t max);   // Oldest first
+void Pipeline_ResetTrace(void);
+void Pipeline_DumpTrace(void);
+
+#endif
@@ -0,0 +1,148 @@
+/*****************************************************************************
+* | File        :   Frame_Transform.cpp
+* | Function    :   Fit, letterbox and rotate source rows into a display frame
+******************************************************************************/
+#include "Frame_Transform.h"
+#include "Stage_Profiler.h"
+
+/******************************************************************************
+function: Compute the mapping for a srcWidth x srcHeight image
+info:
+    Same fit as the JPEG path: width and height are swapped for the scale
+    because of the rotation. Sampling is nearest neighbour, so scaling up
+    or down leaves no holes.
+******************************************************************************/
+void Transform_Init(FRAME_TRANSFORM *transform, int srcWidth, int srcHeight)
+{
+    float scaleX = (float)LCD_WIDTH / srcHeight;
+    float scaleY = (float)LCD_HEIGHT / srcWidth;
+    float scale = scaleX < scaleY ? scaleX : scaleY;
+
+    transform->SrcWidth = srcWidth;
+    transform->SrcHeight = srcHeight;
+    transform->FinalWidth = (int)(srcHeight * scale);
+    transform->FinalHeight = (int)(srcWidth * scale);
+    if (transform->FinalWidth < 1) transform->FinalWidth = 1;
+    if (transform->FinalHeight < 1) transform->FinalHeight = 1;
+    if (transform->FinalWidth > LCD_WIDTH) transform->FinalWidth = LCD_WIDTH;
+    if (transform->FinalHeight > LCD_HEIGHT) transform->FinalHeight = LCD_HEIGHT;
+    transform->OffsetX = (LCD_WIDTH - transform->FinalWidth) / 2;
+    transform->OffsetY = (LCD_HEIGHT - transform->FinalHeight) / 2;
+
+    for (int y = 0; y < transform->FinalHeight; y++) {
+        transform->SrcColumn[y] = (uint32_t)y * srcWidth / transform->FinalHeight;
+    }
+    for (int x = 0; x < transform->FinalWidth; x++) {
+        transform->SrcRow[x] = srcHeight - 1 - (int32_t)((uint32_t)x * srcHeight / transform->FinalWidth);
+    }
+}
+
+bool Transform_RowUsed(const FRAME_TRANSFORM *transform, int srcY)
+{
+    // SrcRow decreases with x, so stop as soon as it drops below srcY
+    for (int x = 0; x < transform->FinalWidth; x++) {
+        if (transform->SrcRow[x] == srcY) return true;
+        if (transform->SrcRow[x] < srcY) return false;
+    }
+    return false;
+}
+
+/******************************************************************************
+function: Place one decoded RGB565 source row into every column sampling it
+******************************************************************************/
+void Transform_PutRow(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcY, const uint16_t *row)
+{
+    PROFILE_SCOPE(PROF_TRANSFORM);
+    for (int x = 0; x < transform->FinalWidth; x++) {
+        int32_t sy = transform->SrcRow[x];
+        if (sy < srcY) break;
+        if (sy > srcY) continue;
+        uint16_t *dst = &frame[transform->OffsetY * LCD_WIDTH + transform->OffsetX + x];
+        for (int y = 0; y < transform->FinalHeight; y++) {
+            dst[y * LCD_WIDTH] = row[transform->SrcColumn[y]];
+        }
+    }
+}
+
+/******************************************************************************
+function: Place every step-th pixel of a source row, starting at column first
+info:
+    row[i] is source column first + i * step, as in an Adam7 pass row.
+    Display pixels sampling any other column are left as they are.
+******************************************************************************/
+void Transform_PutSpaced(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcY, const uint16_t *row, int first,
+                         int step)
+{
+    PROFILE_SCOPE(PROF_TRANSFORM);
+    for (int x = 0; x < transform->FinalWidth; x++) {
+        int32_t sy = transform->SrcRow[x];
+        if (sy < srcY) break;
+        if (sy > srcY) continue;
+        uint16_t *dst = &frame[transform->OffsetY * LCD_WIDTH + transform->OffsetX + x];
+        for (int y = 0; y < transform->FinalHeight; y++) {
+            int column = transform->SrcColumn[y] - first;
+            if (column >= 0 && column % step == 0) {
+                dst[y * LCD_WIDTH] = row[column / step];
+            }
+        }
+    }
+}
+
+/******************************************************************************
+function: Place a decoded block (e.g. a row of JPEG MCUs) into the frame
+info:
+    pixels holds width x height source pixels starting at (srcX, srcY),
+    pitch pixels per line. Only display pixels that sample the block are
+    written, so blocks may arrive in any order.
+******************************************************************************/
+void Transform_PutBlock(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcX, int srcY, int width, int height,
+                        const uint16_t *pixels, int pitch)
+{
+    PROFILE_SCOPE(PROF_TRANSFORM);
+    int x0, y0, x1, y1;
+    if (!Transform_DisplayRect(transform, srcX, srcY, width, height, &x0, &y0, &x1, &y1)) {
+        return;
+    }
+    for (int x = x0; x <= x1; x++) {
+        const uint16_t *src = &pixels[(transform->SrcRow[x - transform->OffsetX] - srcY) * pitch - srcX];
+        uint16_t *dst = &frame[x];
+        for (int y = y0; y <= y1; y++) {
+            dst[y * LCD_WIDTH] = src[transform->SrcColumn[y - transform->OffsetY]];
+        }
+    }
+}
+
+/******************************************************************************
+function: Display rectangle covered by a source rectangle
+info:
+    Returns the inclusive display bounds (frame coordinates, offsets
+    included) of every pixel that samples the source rect, or false when
+    the rect falls between sampled rows/columns and nothing on screen changes.
+******************************************************************************/
+bool Transform_DisplayRect(const FRAME_TRANSFORM *transform, int srcX, int srcY, int srcW, int srcH,
+                           int *x0, int *y0, int *x1, int *y1)
+{
+    int minX = -1, maxX = -1, minY = -1, maxY = -1;
+    for (int x = 0; x < transform->FinalWidth; x++) {
+        int32_t sy = transform->SrcRow[x];
+        if (sy >= srcY && sy < srcY + srcH) {
+            if (minX < 0) minX = x;
+            maxX = x;
+        }
+    }
+    for (int y = 0; y < transform->FinalHeight; y++) {
+        int sx = transform->SrcColumn[y];
+        if (sx >= srcX && sx < srcX + srcW) {
+            if (minY < 0) minY = y;
+            maxY = y;
+        }
+    }
+    if (minX < 0 || minY < 0) {
+        return false;
+    }
+    *x0 = transform->OffsetX + minX;
+    *x1 = transform->OffsetX + maxX;
+    *y0 = transform->OffsetY + minY;
+    *y1 = transform->OffsetY + maxY;
+    return true;
+}
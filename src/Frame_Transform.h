@@ -0,0 +1,39 @@
+/*****************************************************************************
+* | File        :   Frame_Transform.h
+* | Function    :   Fit, letterbox and rotate source rows into a display frame
+* | Info        :
+*   Shared by the row-streaming loaders (BMP, PNG), the GIF player and the
+*   MJPEG player (block-wise, as JPEGDEC emits MCUs). The source image is
+*   fitted inside the rotated display, centered on black, and turned 270°
+*   clockwise like the JPEG path: every display column samples exactly one
+*   source row, so rows can be placed as they are decoded and rows that no
+*   column uses can be skipped.
+******************************************************************************/
+#ifndef __FRAME_TRANSFORM_H
+#define __FRAME_TRANSFORM_H
+
+#include <stdint.h>
+#include "LCD_Scroll.h"     // Panel size only: no Arduino dependency
+
+typedef struct {
+    int SrcWidth;
+    int SrcHeight;
+    int FinalWidth;                 // Display columns covered by the image
+    int FinalHeight;                // Display rows covered by the image
+    int OffsetX;
+    int OffsetY;
+    uint16_t SrcColumn[LCD_HEIGHT]; // Source column sampled by each display row
+    int32_t SrcRow[LCD_WIDTH];      // Source row sampled by each display column
+} FRAME_TRANSFORM;
+
+void Transform_Init(FRAME_TRANSFORM *transform, int srcWidth, int srcHeight);
+bool Transform_RowUsed(const FRAME_TRANSFORM *transform, int srcY);
+void Transform_PutRow(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcY, const uint16_t *row);
+void Transform_PutSpaced(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcY, const uint16_t *row, int first,
+                         int step);
+void Transform_PutBlock(const FRAME_TRANSFORM *transform, uint16_t *frame, int srcX, int srcY, int width, int height,
+                        const uint16_t *pixels, int pitch);
+bool Transform_DisplayRect(const FRAME_TRANSFORM *transform, int srcX, int srcY, int srcW, int srcH,
+                           int *x0, int *y0, int *x1, int *y1);
+
+#endif
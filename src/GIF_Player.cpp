@@ -0,0 +1,367 @@
+/*****************************************************************************
+* | File        :   GIF_Player.cpp
+* | Function    :   Animated GIF playback with partial-rect LCD updates
+******************************************************************************/
+#include "GIF_Player.h"
+#include "Frame_Transform.h"
+#include "Frame_Pipeline.h"
+#include "LCD_Driver.h"
+#include "Heap_Telemetry.h"
+#include <Arduino.h>
+#include <AnimatedGIF.h>
+#include <string.h>
+#include <stdlib.h>
+#include <new>
+
+typedef struct {
+    int X;
+    int Y;
+    int W;                          // 0 when empty
+    int H;
+} GIF_RECT;
+
+// The decoder carries the LZW tables and a file buffer; keep it off the stack
+static AnimatedGIF *gif = NULL;
+static SD_READER *activeReader = NULL;
+static FRAME_TRANSFORM transform;
+static uint16_t *canvas = NULL;
+static uint32_t canvasCapacity = 0;
+static int canvasWidth = 0;
+static int canvasHeight = 0;
+
+static bool playing = false;
+static bool fullPushPending = false;
+static uint32_t nextDueUs = 0;
+static GIF_RECT frameRect;          // Area drawn by the last decoded frame
+static uint8_t frameDisposal = 0;   // How that area is disposed before the next one
+static GIF_RECT dirty;              // Canvas area changed since the last push
+static GIF_STATS stats;
+static const char *lastError = "";
+static uint8_t rowBytes[LCD_WIDTH * 2]; // One display row in wire byte order
+
+static void unionRect(GIF_RECT *a, const GIF_RECT *b)
+{
+    if (b->W <= 0 || b->H <= 0) {
+        return;
+    }
+    if (a->W <= 0 || a->H <= 0) {
+        *a = *b;
+        return;
+    }
+    int x1 = max(a->X + a->W, b->X + b->W);
+    int y1 = max(a->Y + a->H, b->Y + b->H);
+    a->X = min(a->X, b->X);
+    a->Y = min(a->Y, b->Y);
+    a->W = x1 - a->X;
+    a->H = y1 - a->Y;
+}
+
+/******************************************************************************
+function: AnimatedGIF file callbacks backed by the SD reader
+******************************************************************************/
+static void *gifOpen(const char *path, int32_t *size)
+{
+    if (!SDReader_Open(activeReader, path)) {
+        return NULL;
+    }
+    *size = SDReader_Size(activeReader);
+    return activeReader;
+}
+
+static void gifClose(void *handle)
+{
+    SDReader_Close((SD_READER *)handle);
+}
+
+static int32_t gifRead(GIFFILE *file, uint8_t *buffer, int32_t length)
+{
+    SD_READER *reader = (SD_READER *)file->fHandle;
+    int32_t got = SDReader_Read(reader, buffer, length);
+    file->iPos = SDReader_Position(reader);
+    return got;
+}
+
+static int32_t gifSeek(GIFFILE *file, int32_t position)
+{
+    SD_READER *reader = (SD_READER *)file->fHandle;
+    if (!SDReader_Seek(reader, position)) {
+        return -1;
+    }
+    file->iPos = position;
+    return position;
+}
+
+// One line of the current frame: palette lookup into the canvas, keeping
+// transparent pixels so earlier frames show through
+static void gifDraw(GIFDRAW *draw)
+{
+    int y = draw->iY + draw->y;
+    if (y >= canvasHeight || draw->iX >= canvasWidth) {
+        return;
+    }
+    frameRect.X = draw->iX;
+    frameRect.Y = draw->iY;
+    frameRect.W = min(draw->iWidth, canvasWidth - draw->iX);
+    frameRect.H = min(draw->iHeight, canvasHeight - draw->iY);
+    frameDisposal = draw->ucDisposalMethod;
+
+    const uint8_t *src = draw->pPixels;
+    const uint16_t *palette = draw->pPalette;
+    uint16_t *dst = &canvas[y * canvasWidth + draw->iX];
+    if (draw->ucHasTransparency) {
+        uint8_t transparent = draw->ucTransparent;
+        for (int x = 0; x < frameRect.W; x++) {
+            if (src[x] != transparent) {
+                dst[x] = palette[src[x]];
+            }
+        }
+    } else {
+        for (int x = 0; x < frameRect.W; x++) {
+            dst[x] = palette[src[x]];
+        }
+    }
+}
+
+/******************************************************************************
+function: Push a display rectangle from the canvas
+info:
+    x0..x1, y0..y1 are inclusive frame coordinates. Pixels outside the
+    fitted image are the black letterbox. Each row is built big-endian in
+    rowBytes and sent as one burst.
+******************************************************************************/
+static void pushRect(int x0, int y0, int x1, int y1)
+{
+    const int imageX1 = transform.OffsetX + transform.FinalWidth;
+    const int imageY1 = transform.OffsetY + transform.FinalHeight;
+
+    Pipeline_WaitPresent();
+    Bus_Acquire(BUS_LCD, STAGE_PRESENT);
+    uint32_t t0 = micros();
+    LCD_SetCursor(x0, y0, x1, y1);
+    for (int y = y0; y <= y1; y++) {
+        bool rowInImage = y >= transform.OffsetY && y < imageY1;
+        const uint16_t *src = rowInImage ? &canvas[transform.SrcColumn[y - transform.OffsetY]] : NULL;
+        uint8_t *out = rowBytes;
+        for (int x = x0; x <= x1; x++) {
+            uint16_t pixel = 0x0000;
+            if (rowInImage && x >= transform.OffsetX && x < imageX1) {
+                pixel = src[transform.SrcRow[x - transform.OffsetX] * canvasWidth];
+            }
+            *out++ = pixel >> 8;
+            *out++ = pixel & 0xFF;
+        }
+        LCD_WriteData_Buffer(rowBytes, out - rowBytes);
+    }
+    uint32_t t1 = micros();
+    Pipeline_Trace(STAGE_PRESENT, BUS_LCD, -1, t0, t1);
+    Bus_Release(BUS_LCD);
+
+    stats.PushMicros += t1 - t0;
+    stats.PushedPixels += (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+}
+
+static void pushDirty(void)
+{
+    int x0, y0, x1, y1;
+    if (fullPushPending) {
+        pushRect(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+        fullPushPending = false;
+    } else if (dirty.W > 0 &&
+               Transform_DisplayRect(&transform, dirty.X, dirty.Y, dirty.W, dirty.H, &x0, &y0, &x1, &y1)) {
+        pushRect(x0, y0, x1, y1);
+    }
+    dirty.W = 0;
+}
+
+// Disposal 2 ("restore to background") clears the last frame's area before
+// the next frame is drawn over it
+static void disposePrevious(void)
+{
+    if (frameDisposal == 2 && frameRect.W > 0) {
+        for (int y = frameRect.Y; y < frameRect.Y + frameRect.H; y++) {
+            memset(&canvas[y * canvasWidth + frameRect.X], 0, frameRect.W * sizeof(uint16_t));
+        }
+        unionRect(&dirty, &frameRect);
+    }
+    frameDisposal = 0;
+}
+
+/******************************************************************************
+function: Open a GIF and schedule its first frame
+info:
+    The canvas is kept across GIFs and only grows, so switching between
+    animations of the same size never reallocates.
+******************************************************************************/
+bool GIF_Start(SD_READER *reader, const char *path)
+{
+    GIF_Stop();
+    if (gif == NULL) {
+        void *mem = Heap_Alloc(HEAP_DECODER, sizeof(AnimatedGIF), HEAP_CAP_DEFAULT);
+        gif = mem != NULL ? new (mem) AnimatedGIF() : NULL;
+        if (gif == NULL) {
+            lastError = "out of memory for decoder";
+            return false;
+        }
+        gif->begin(GIF_PALETTE_RGB565_LE);
+    }
+    activeReader = reader;
+
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    bool opened = gif->open(path, gifOpen, gifClose, gifRead, gifSeek, gifDraw) != 0;
+    Bus_Release(BUS_SD);
+    if (!opened) {
+        lastError = "not a GIF or unreadable";
+        return false;
+    }
+
+    canvasWidth = gif->getCanvasWidth();
+    canvasHeight = gif->getCanvasHeight();
+    uint32_t pixels = (uint32_t)canvasWidth * canvasHeight;
+    if (canvasWidth <= 0 || canvasHeight <= 0 || pixels > GIF_MAX_CANVAS_PIXELS) {
+        lastError = "canvas larger than GIF_MAX_CANVAS_PIXELS";
+        gif->close();
+        return false;
+    }
+    if (pixels > canvasCapacity) {
+        Heap_Free(canvas);
+        canvas = (uint16_t *)Heap_Alloc(HEAP_DECODER, pixels * sizeof(uint16_t), HEAP_CAP_DEFAULT);
+        canvasCapacity = canvas != NULL ? pixels : 0;
+        if (canvas == NULL) {
+            lastError = "out of memory for canvas";
+            gif->close();
+            return false;
+        }
+    }
+    memset(canvas, 0, pixels * sizeof(uint16_t));
+    Transform_Init(&transform, canvasWidth, canvasHeight);
+
+    memset(&stats, 0, sizeof(stats));
+    stats.StartMs = millis();
+    nextDueUs = micros();
+    frameRect.W = 0;
+    frameDisposal = 0;
+    dirty.W = 0;
+    fullPushPending = true;
+    playing = true;
+    return true;
+}
+
+void GIF_Stop(void)
+{
+    if (!playing) {
+        return;
+    }
+    playing = false;
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    gif->close();
+    Bus_Release(BUS_SD);
+    GIF_PrintStats();
+}
+
+bool GIF_IsPlaying(void)
+{
+    return playing;
+}
+
+// When the next frame is due (micros()), for callers that sleep until then
+bool GIF_NextDeadline(uint32_t *dueUs)
+{
+    *dueUs = nextDueUs;
+    return playing;
+}
+
+/******************************************************************************
+function: Decode and present the next frame once it is due
+info:
+    Deadlines are absolute (previous deadline + frame delay), so decode
+    and push time never accumulate into drift. A frame that finishes
+    decoding after its own display slot has already ended is not pushed;
+    its area stays dirty and goes out with the next presented frame.
+    Deadlines are in micros(), like MJPEG and flipbook frames, so one
+    wait covers all three.
+******************************************************************************/
+void GIF_Service(uint32_t nowUs)
+{
+    if (!playing || (int32_t)(nowUs - nextDueUs) < 0) {
+        return;
+    }
+
+    disposePrevious();
+    int delayMs = 0;
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    uint32_t t0 = micros();
+    int rc = gif->playFrame(false, &delayMs, NULL);
+    uint32_t t1 = micros();
+    Pipeline_Trace(STAGE_DECODE, BUS_SD, -1, t0, t1);
+    Bus_Release(BUS_SD);
+    stats.DecodeMicros += t1 - t0;
+
+    if (rc < 0) {
+        lastError = "frame decode failed";
+        GIF_Stop();
+        return;
+    }
+    stats.Frames++;
+    unionRect(&dirty, &frameRect);
+    if (delayMs <= 10) {
+        delayMs = GIF_DEFAULT_DELAY_MS;
+    }
+    stats.ScheduledMs += delayMs;
+    nextDueUs += (uint32_t)delayMs * 1000;
+
+    uint32_t now = micros();
+    if ((int32_t)(now - nextDueUs) >= 0) {
+        stats.Dropped++;
+    } else {
+        pushDirty();
+        stats.Presented++;
+    }
+    if ((int32_t)(now - nextDueUs) > GIF_RESYNC_US) {
+        nextDueUs = now; // Stalled (card, overlay): restart the clock rather than race
+    }
+
+    if (rc == 0) {
+        gif->reset();
+        stats.Loops++;
+    }
+}
+
+// Full-screen push of the current canvas, e.g. after an overlay covered it
+void GIF_Redraw(void)
+{
+    if (!playing) {
+        return;
+    }
+    pushRect(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    fullPushPending = false;
+    dirty.W = 0;
+}
+
+/******************************************************************************
+function: Playback statistics
+******************************************************************************/
+void GIF_GetStats(GIF_STATS *out)
+{
+    *out = stats;
+}
+
+void GIF_PrintStats(void)
+{
+    uint32_t elapsed = millis() - stats.StartMs;
+    float achieved = elapsed > 0 ? stats.Presented * 1000.0f / elapsed : 0.0f;
+    float target = stats.ScheduledMs > 0 ? stats.Frames * 1000.0f / stats.ScheduledMs : 0.0f;
+    Serial.printf("🎞️  GIF: %u frames, %u shown, %u dropped, %u loops, %.1f/%.1f fps\n",
+                  (unsigned)stats.Frames, (unsigned)stats.Presented, (unsigned)stats.Dropped,
+                  (unsigned)stats.Loops, achieved, target);
+    if (stats.Frames > 0) {
+        Serial.printf("🎞️  GIF: decode %u us/frame, push %u us/frame, %u px/frame\n",
+                      (unsigned)(stats.DecodeMicros / stats.Frames),
+                      (unsigned)(stats.Presented ? stats.PushMicros / stats.Presented : 0),
+                      (unsigned)(stats.Presented ? stats.PushedPixels / stats.Presented : 0));
+    }
+}
+
+const char *GIF_LastError(void)
+{
+    return lastError;
+}
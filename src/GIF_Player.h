@@ -0,0 +1,47 @@
+/*****************************************************************************
+* | File        :   GIF_Player.h
+* | Function    :   Animated GIF playback with partial-rect LCD updates
+* | Info        :
+*   AnimatedGIF decodes one frame per call from an SD_READER into a
+*   persistent canvas at the GIF's own resolution. Only the rectangle a
+*   frame (or the previous frame's disposal) touched is mapped through
+*   Frame_Transform and pushed to the panel, so small animated regions cost
+*   a fraction of a full 135x240 push.
+*   Frames are scheduled on absolute deadlines: when decoding falls behind,
+*   frames are decoded but not pushed (dropped) so playback keeps the GIF's
+*   pace instead of drifting slower. Disposal "restore previous" is played
+*   as "leave in place"; it would need a second canvas.
+******************************************************************************/
+#ifndef __GIF_PLAYER_H
+#define __GIF_PLAYER_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define GIF_MAX_CANVAS_PIXELS (480 * 480) // Largest logical screen accepted
+#define GIF_DEFAULT_DELAY_MS  100         // Used for 0-10ms delays, like browsers
+#define GIF_RESYNC_US         1000000     // Further behind than this: restart the clock
+
+typedef struct {
+    uint32_t Frames;        // Frames decoded
+    uint32_t Presented;     // Frames pushed to the panel
+    uint32_t Dropped;       // Frames decoded too late to be shown
+    uint32_t Loops;
+    uint32_t DecodeMicros;
+    uint32_t PushMicros;
+    uint32_t PushedPixels;
+    uint32_t ScheduledMs;   // Sum of decoded frames' delays
+    uint32_t StartMs;
+} GIF_STATS;
+
+bool GIF_Start(SD_READER *reader, const char *path);
+void GIF_Stop(void);
+bool GIF_IsPlaying(void);
+bool GIF_NextDeadline(uint32_t *dueUs);
+void GIF_Service(uint32_t nowUs);
+void GIF_Redraw(void);
+void GIF_GetStats(GIF_STATS *stats);
+void GIF_PrintStats(void);
+const char *GIF_LastError(void);
+
+#endif
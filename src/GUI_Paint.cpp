@@ -4,7 +4,9 @@
 * | Function    : Basic paint functions for image display
 ******************************************************************************/
 #include "GUI_Paint.h"
+#ifdef ARDUINO
 #include <pgmspace.h>
+#endif
 
 volatile PAINT Paint;
 
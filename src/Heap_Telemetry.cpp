@@ -0,0 +1,349 @@
+/*****************************************************************************
+* | File        :   Heap_Telemetry.cpp
+* | Function    :   Heap/PSRAM fragmentation telemetry and per-subsystem accounting
+******************************************************************************/
+#include "Heap_Telemetry.h"
+#include "Log_Ring.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;
+#define HEAP_LOCK()         portENTER_CRITICAL(&statsLock)
+#define HEAP_UNLOCK()       portEXIT_CRITICAL(&statsLock)
+#define HEAP_PRINTF         Serial.printf
+#else
+#include <stdio.h>
+#define HEAP_LOCK()
+#define HEAP_UNLOCK()
+#define HEAP_PRINTF         printf
+#endif
+
+#define HEAP_MAGIC          0x48454150  // "HEAP"
+
+// In front of every block; 16 bytes so the caller's pointer stays aligned
+typedef struct {
+    uint32_t Bytes;
+    uint8_t Subsystem;
+    uint8_t Region;
+    uint16_t Reserved;
+    uint32_t Magic;
+    uint32_t Pad;
+} HEAP_HEADER;
+
+static const char *SUBSYSTEM_NAMES[HEAP_SUBSYSTEM_COUNT] = {"catalogue", "frames", "cache", "decoder", "lines", "io"};
+static const char *REGION_NAMES[HEAP_REGION_COUNT] = {"internal", "psram"};
+
+static HEAP_SUBSYSTEM_STATS subsystems[HEAP_SUBSYSTEM_COUNT];
+
+#ifdef ARDUINO
+static uint32_t regionCaps(HEAP_REGION region)
+{
+    return region == HEAP_PSRAM ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL;
+}
+
+static void *regionAlloc(HEAP_REGION region, uint32_t bytes, uint8_t caps)
+{
+    if (caps == HEAP_CAP_DMA) {
+        return heap_caps_malloc(bytes, MALLOC_CAP_DMA | MALLOC_CAP_32BIT);
+    }
+    return heap_caps_malloc(bytes, regionCaps(region) | MALLOC_CAP_8BIT);
+}
+
+static void regionFree(HEAP_REGION region, void *p)
+{
+    heap_caps_free(p);
+}
+
+void Heap_RegionStats(HEAP_REGION region, HEAP_REGION_STATS *stats)
+{
+    uint32_t caps = regionCaps(region);
+    stats->TotalBytes = heap_caps_get_total_size(caps);
+    stats->FreeBytes = heap_caps_get_free_size(caps);
+    stats->LargestFree = heap_caps_get_largest_free_block(caps);
+    stats->MinFree = heap_caps_get_minimum_free_size(caps);
+}
+
+void Heap_HostReset(void)
+{
+}
+#else
+/******************************************************************************
+    Host shim: each region is a static arena of blocks, each starting with
+    a HOST_BLOCK. Allocation is first fit with splitting, free coalesces
+    with both neighbours, so holes and the largest free block behave like
+    a real heap under the same sequence of calls.
+******************************************************************************/
+typedef struct {
+    uint32_t Size;          // Whole block, this header included
+    uint32_t Used;
+    uint32_t Pad[2];
+} HOST_BLOCK;
+
+#define HOST_ALIGN          16
+#define HOST_MIN_SPLIT      (2 * sizeof(HOST_BLOCK))
+
+typedef struct {
+    uint8_t *Base;
+    uint32_t Size;
+    uint32_t MinFree;
+} HOST_ARENA;
+
+alignas(HOST_ALIGN) static uint8_t internalArena[HEAP_HOST_INTERNAL_BYTES];
+alignas(HOST_ALIGN) static uint8_t psramArena[HEAP_HOST_PSRAM_BYTES];
+static HOST_ARENA arenas[HEAP_REGION_COUNT] = {
+    {internalArena, HEAP_HOST_INTERNAL_BYTES / HOST_ALIGN * HOST_ALIGN, 0},
+    {psramArena, HEAP_HOST_PSRAM_BYTES / HOST_ALIGN * HOST_ALIGN, 0},
+};
+static bool arenasReady = false;
+
+static HOST_BLOCK *blockAt(HOST_ARENA *arena, uint32_t offset)
+{
+    return (HOST_BLOCK *)(arena->Base + offset);
+}
+
+static void scanArena(HOST_ARENA *arena, uint32_t *freeBytes, uint32_t *largest)
+{
+    *freeBytes = 0;
+    *largest = 0;
+    for (uint32_t offset = 0; offset < arena->Size; offset += blockAt(arena, offset)->Size) {
+        HOST_BLOCK *block = blockAt(arena, offset);
+        if (!block->Used) {
+            uint32_t payload = block->Size - sizeof(HOST_BLOCK);
+            *freeBytes += payload;
+            if (payload > *largest) {
+                *largest = payload;
+            }
+        }
+    }
+}
+
+void Heap_HostReset(void)
+{
+    for (int r = 0; r < HEAP_REGION_COUNT; r++) {
+        HOST_BLOCK *first = blockAt(&arenas[r], 0);
+        first->Size = arenas[r].Size;
+        first->Used = 0;
+        arenas[r].MinFree = arenas[r].Size - sizeof(HOST_BLOCK);
+    }
+    memset(subsystems, 0, sizeof(subsystems));
+    arenasReady = true;
+}
+
+static void *regionAlloc(HEAP_REGION region, uint32_t bytes, uint8_t caps)
+{
+    (void)caps;
+    if (!arenasReady) {
+        Heap_HostReset();
+    }
+    HOST_ARENA *arena = &arenas[region];
+    uint32_t need = (bytes + sizeof(HOST_BLOCK) + HOST_ALIGN - 1) / HOST_ALIGN * HOST_ALIGN;
+    for (uint32_t offset = 0; offset < arena->Size; offset += blockAt(arena, offset)->Size) {
+        HOST_BLOCK *block = blockAt(arena, offset);
+        if (block->Used || block->Size < need) {
+            continue;
+        }
+        if (block->Size - need >= HOST_MIN_SPLIT) {
+            HOST_BLOCK *rest = blockAt(arena, offset + need);
+            rest->Size = block->Size - need;
+            rest->Used = 0;
+            block->Size = need;
+        }
+        block->Used = 1;
+
+        uint32_t freeBytes, largest;
+        scanArena(arena, &freeBytes, &largest);
+        if (freeBytes < arena->MinFree) {
+            arena->MinFree = freeBytes;
+        }
+        return block + 1;
+    }
+    return NULL;
+}
+
+static void regionFree(HEAP_REGION region, void *p)
+{
+    HOST_ARENA *arena = &arenas[region];
+    HOST_BLOCK *target = (HOST_BLOCK *)p - 1;
+    HOST_BLOCK *previous = NULL;
+    for (uint32_t offset = 0; offset < arena->Size; offset += blockAt(arena, offset)->Size) {
+        HOST_BLOCK *block = blockAt(arena, offset);
+        if (block != target) {
+            previous = block;
+            continue;
+        }
+        block->Used = 0;
+        uint32_t next = offset + block->Size;
+        if (next < arena->Size && !blockAt(arena, next)->Used) {
+            block->Size += blockAt(arena, next)->Size;
+        }
+        if (previous != NULL && !previous->Used) {
+            previous->Size += block->Size;
+        }
+        return;
+    }
+}
+
+void Heap_RegionStats(HEAP_REGION region, HEAP_REGION_STATS *stats)
+{
+    if (!arenasReady) {
+        Heap_HostReset();
+    }
+    HOST_ARENA *arena = &arenas[region];
+    stats->TotalBytes = arena->Size;
+    scanArena(arena, &stats->FreeBytes, &stats->LargestFree);
+    stats->MinFree = arena->MinFree;
+}
+#endif
+
+/******************************************************************************
+function: Allocate bytes for subsystem
+info:
+    HEAP_CAP_DEFAULT follows malloc(): small blocks internal first so they
+    do not pay the PSRAM cache penalty, big ones PSRAM first so they do
+    not eat the internal RAM that DMA and task stacks need. A NULL return
+    is counted as a failure of that subsystem.
+******************************************************************************/
+void *Heap_Alloc(HEAP_SUBSYSTEM subsystem, uint32_t bytes, uint8_t caps)
+{
+    HEAP_REGION order[2] = {HEAP_INTERNAL, HEAP_INTERNAL};
+    int tries = 1;
+    if (caps == HEAP_CAP_PSRAM || (caps == HEAP_CAP_DEFAULT && bytes > HEAP_INTERNAL_FIRST_MAX)) {
+        order[0] = HEAP_PSRAM;
+        tries = 2;
+    } else if (caps == HEAP_CAP_DEFAULT) {
+        order[1] = HEAP_PSRAM;
+        tries = 2;
+    }
+
+    HEAP_HEADER *header = NULL;
+    HEAP_REGION region = HEAP_INTERNAL;
+    for (int i = 0; i < tries && header == NULL; i++) {
+        region = order[i];
+        header = (HEAP_HEADER *)regionAlloc(region, bytes + sizeof(HEAP_HEADER), caps);
+    }
+
+    HEAP_SUBSYSTEM_STATS *stats = &subsystems[subsystem];
+    HEAP_LOCK();
+    stats->Allocs++;
+    if (header == NULL) {
+        stats->Failures++;
+    } else {
+        stats->Bytes += bytes;
+        stats->Blocks++;
+        if (region == HEAP_PSRAM) {
+            stats->PsramBytes += bytes;
+        }
+        if (stats->Bytes > stats->PeakBytes) {
+            stats->PeakBytes = stats->Bytes;
+        }
+    }
+    HEAP_UNLOCK();
+
+    if (header == NULL) {
+        LOG_WARN("heap: %s: %u bytes failed", SUBSYSTEM_NAMES[subsystem], (unsigned)bytes);
+        return NULL;
+    }
+    header->Bytes = bytes;
+    header->Subsystem = subsystem;
+    header->Region = region;
+    header->Magic = HEAP_MAGIC;
+    return header + 1;
+}
+
+/******************************************************************************
+function: Free a block from Heap_Alloc (NULL is ignored)
+******************************************************************************/
+void Heap_Free(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    HEAP_HEADER *header = (HEAP_HEADER *)p - 1;
+    if (header->Magic != HEAP_MAGIC || header->Subsystem >= HEAP_SUBSYSTEM_COUNT) {
+        LOG_ERROR("heap: free of %p not from Heap_Alloc", p);
+        return;
+    }
+    HEAP_SUBSYSTEM_STATS *stats = &subsystems[header->Subsystem];
+    HEAP_REGION region = (HEAP_REGION)header->Region;
+    HEAP_LOCK();
+    stats->Bytes -= header->Bytes;
+    stats->Blocks--;
+    if (region == HEAP_PSRAM) {
+        stats->PsramBytes -= header->Bytes;
+    }
+    HEAP_UNLOCK();
+    header->Magic = 0;
+    regionFree(region, header);
+}
+
+// Share of free memory outside the largest block, in percent
+uint8_t Heap_Fragmentation(const HEAP_REGION_STATS *stats)
+{
+    if (stats->FreeBytes == 0) {
+        return 0;
+    }
+    return (uint8_t)(100 - (uint64_t)stats->LargestFree * 100 / stats->FreeBytes);
+}
+
+const HEAP_SUBSYSTEM_STATS *Heap_SubsystemStats(HEAP_SUBSYSTEM subsystem)
+{
+    return &subsystems[subsystem];
+}
+
+const char *Heap_SubsystemName(HEAP_SUBSYSTEM subsystem)
+{
+    return subsystem < HEAP_SUBSYSTEM_COUNT ? SUBSYSTEM_NAMES[subsystem] : "?";
+}
+
+const char *Heap_RegionName(HEAP_REGION region)
+{
+    return region < HEAP_REGION_COUNT ? REGION_NAMES[region] : "?";
+}
+
+/******************************************************************************
+function: Print both regions and every subsystem
+info:
+    Straight to the console rather than through the log ring: the table
+    is longer than the ring and is only asked for from the serial
+    command or at a card reload.
+******************************************************************************/
+void Heap_Print(const char *reason)
+{
+    HEAP_PRINTF("\n=== Heap (%s) ===\n", reason);
+    HEAP_PRINTF("%-9s %9s %9s %9s %9s %5s\n", "region", "total", "free", "largest", "min free", "frag");
+    for (int r = 0; r < HEAP_REGION_COUNT; r++) {
+        HEAP_REGION_STATS stats;
+        Heap_RegionStats((HEAP_REGION)r, &stats);
+        HEAP_PRINTF("%-9s %9u %9u %9u %9u %4u%%\n", REGION_NAMES[r], (unsigned)stats.TotalBytes,
+                    (unsigned)stats.FreeBytes, (unsigned)stats.LargestFree, (unsigned)stats.MinFree,
+                    (unsigned)Heap_Fragmentation(&stats));
+    }
+
+    HEAP_SUBSYSTEM_STATS copy[HEAP_SUBSYSTEM_COUNT];
+    HEAP_LOCK();
+    memcpy(copy, subsystems, sizeof(copy));
+    HEAP_UNLOCK();
+    HEAP_PRINTF("%-9s %9s %9s %6s %9s %6s %5s\n", "owner", "live", "in psram", "blocks", "peak", "allocs", "fail");
+    for (int s = 0; s < HEAP_SUBSYSTEM_COUNT; s++) {
+        HEAP_PRINTF("%-9s %9u %9u %6u %9u %6u %5u\n", SUBSYSTEM_NAMES[s], (unsigned)copy[s].Bytes,
+                    (unsigned)copy[s].PsramBytes, (unsigned)copy[s].Blocks, (unsigned)copy[s].PeakBytes,
+                    (unsigned)copy[s].Allocs, (unsigned)copy[s].Failures);
+    }
+}
+
+/******************************************************************************
+function: One log line with the free, largest and lowest-ever figures
+******************************************************************************/
+void Heap_LogSummary(void)
+{
+    HEAP_REGION_STATS internal, psram;
+    Heap_RegionStats(HEAP_INTERNAL, &internal);
+    Heap_RegionStats(HEAP_PSRAM, &psram);
+    LOG_INFO("heap: int %uK free %uK big %uK min, psram %uK free %uK big %uK min",
+             (unsigned)(internal.FreeBytes / 1024), (unsigned)(internal.LargestFree / 1024),
+             (unsigned)(internal.MinFree / 1024), (unsigned)(psram.FreeBytes / 1024),
+             (unsigned)(psram.LargestFree / 1024), (unsigned)(psram.MinFree / 1024));
+}
@@ -0,0 +1,81 @@
+/*****************************************************************************
+* | File        :   Heap_Telemetry.h
+* | Function    :   Heap/PSRAM fragmentation telemetry and per-subsystem accounting
+* | Info        :
+*   Long-lived and per-image buffers are allocated through Heap_Alloc with
+*   the subsystem that owns them, so a dump shows who holds what next to
+*   free, largest free block and lowest-ever free of internal RAM and
+*   PSRAM. A shrinking largest block with plenty free is fragmentation; a
+*   subsystem whose live bytes grow across card swaps is a leak.
+*   Each block carries a 16-byte header (owner and size), which keeps the
+*   word alignment DMA buffers need.
+*   Without ARDUINO the same calls run on a host shim: two first-fit arenas
+*   standing in for internal RAM and PSRAM, with malloc's placement rule,
+*   so tests see the same metrics, fragmentation included.
+******************************************************************************/
+#ifndef __HEAP_TELEMETRY_H
+#define __HEAP_TELEMETRY_H
+
+#include <stdint.h>
+
+// Placement, like the heap_caps capabilities they map to
+#define HEAP_CAP_DEFAULT    0   // Like malloc(): up to 4 KB internal, larger blocks PSRAM first
+#define HEAP_CAP_INTERNAL   1   // Internal RAM only
+#define HEAP_CAP_PSRAM      2   // PSRAM first, internal RAM if it is full
+#define HEAP_CAP_DMA        3   // Internal, DMA capable, word aligned
+
+#define HEAP_INTERNAL_FIRST_MAX 4096    // CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL
+
+// Host shim arena sizes (ESP32-S3: ~320 KB usable internal, 8 MB PSRAM)
+#ifndef HEAP_HOST_INTERNAL_BYTES
+#define HEAP_HOST_INTERNAL_BYTES (320 * 1024)
+#endif
+#ifndef HEAP_HOST_PSRAM_BYTES
+#define HEAP_HOST_PSRAM_BYTES    (8 * 1024 * 1024)
+#endif
+
+typedef enum {
+    HEAP_CATALOGUE = 0,     // Album index: name pool and file offsets
+    HEAP_FRAMES,            // Pipeline display frames
+    HEAP_CACHE,             // Flipbook frame cache
+    HEAP_DECODER,           // Decoder objects and scratch (JPEG temp, GIF canvas, clip frames)
+    HEAP_LINES,             // Row and line buffers
+    HEAP_IO,                // SD read-ahead chunks
+    HEAP_SUBSYSTEM_COUNT
+} HEAP_SUBSYSTEM;
+
+typedef enum {
+    HEAP_INTERNAL = 0,
+    HEAP_PSRAM,
+    HEAP_REGION_COUNT
+} HEAP_REGION;
+
+typedef struct {
+    uint32_t TotalBytes;
+    uint32_t FreeBytes;
+    uint32_t LargestFree;   // Biggest block one allocation can get
+    uint32_t MinFree;       // Lowest FreeBytes since boot
+} HEAP_REGION_STATS;
+
+typedef struct {
+    uint32_t Bytes;         // Live, as requested
+    uint32_t PsramBytes;    // Of those, in PSRAM
+    uint32_t Blocks;
+    uint32_t PeakBytes;
+    uint32_t Allocs;
+    uint32_t Failures;
+} HEAP_SUBSYSTEM_STATS;
+
+void *Heap_Alloc(HEAP_SUBSYSTEM subsystem, uint32_t bytes, uint8_t caps);
+void Heap_Free(void *p);
+
+void Heap_RegionStats(HEAP_REGION region, HEAP_REGION_STATS *stats);
+uint8_t Heap_Fragmentation(const HEAP_REGION_STATS *stats);
+const HEAP_SUBSYSTEM_STATS *Heap_SubsystemStats(HEAP_SUBSYSTEM subsystem);
+const char *Heap_SubsystemName(HEAP_SUBSYSTEM subsystem);
+const char *Heap_RegionName(HEAP_REGION region);
+void Heap_Print(const char *reason);
+void Heap_LogSummary(void);
+void Heap_HostReset(void);
+
+#endif
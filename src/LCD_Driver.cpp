@@ -5,8 +5,18 @@
 ******************************************************************************/
 #include "LCD_Driver.h"
 
+static_assert(SCROLL_VIEW_ROWS == LCD_HEIGHT, "scroll geometry assumes the 240-row panel");
+
+// Hardware scroll: VSCSAD, and the rest of a window that crosses GRAM row 319
+static UWORD scrollLine = 0;
+static UDOUBLE wrapBytes = 0;       // Pixel bytes left before the wrap (0: none pending)
+static UWORD wrapX1, wrapX2, wrapRows;
+
+static void wrapWindow(void);
+
 void LCD_WriteReg(UBYTE reg)
 {
+    wrapBytes = 0; // A new command ends any memory write in progress
     DEV_Digital_Write(DEV_DC_PIN, 0);
     DEV_Digital_Write(DEV_CS_PIN, 0);
     DEV_SPI_WRITE(reg);
@@ -28,115 +38,180 @@ void LCD_WriteData_Word(UWORD data)
     DEV_SPI_WRITE((data >> 8) & 0xFF);
     DEV_SPI_WRITE(data & 0xFF);
     DEV_Digital_Write(DEV_CS_PIN, 1);
+    if (wrapBytes != 0 && (wrapBytes -= 2) == 0) {
+        wrapWindow();
+    }
 }
 
-void LCD_Init(void)
+// Burst write: bytes go out in order with CS held low for the whole buffer,
+// so RGB565 must already be in wire (big-endian) byte order
+void LCD_WriteData_Buffer(const UBYTE *data, UDOUBLE len)
+{
+    if (wrapBytes != 0 && len >= wrapBytes) {
+        UDOUBLE head = wrapBytes;
+        DEV_Digital_Write(DEV_DC_PIN, 1);
+        DEV_Digital_Write(DEV_CS_PIN, 0);
+        DEV_SPI_WRITE_BYTES(data, head);
+        DEV_Digital_Write(DEV_CS_PIN, 1);
+        wrapWindow();
+        data += head;
+        len -= head;
+    } else if (wrapBytes != 0) {
+        wrapBytes -= len;
+    }
+    if (len == 0) {
+        return;
+    }
+    DEV_Digital_Write(DEV_DC_PIN, 1);
+    DEV_Digital_Write(DEV_CS_PIN, 0);
+    DEV_SPI_WRITE_BYTES(data, len);
+    DEV_Digital_Write(DEV_CS_PIN, 1);
+}
+
+/******************************************************************************
+function: ST7789V register setup, one row per command
+info:
+    Sent between reset and sleep out; the panel accepts register and GRAM
+    writes while it is still asleep.
+******************************************************************************/
+typedef struct {
+    UBYTE Cmd;
+    UBYTE Length;
+    UBYTE Data[14];
+} LCD_INIT_CMD;
+
+static const LCD_INIT_CMD initTable[] = {
+    {0x36, 1, {0x00}},                              // MADCTL
+    {0x3A, 1, {0x05}},                              // COLMOD: 16 bit/pixel
+    {0xB2, 5, {0x0C, 0x0C, 0x00, 0x33, 0x33}},      // PORCTRL
+    {0xB7, 1, {0x35}},                              // GCTRL
+    {0xBB, 1, {0x19}},                              // VCOMS
+    {0xC0, 1, {0x2C}},                              // LCMCTRL
+    {0xC2, 1, {0x01}},                              // VDVVRHEN
+    {0xC3, 1, {0x12}},                              // VRHS
+    {0xC4, 1, {0x20}},                              // VDVS
+    {0xC6, 1, {0x0F}},                              // FRCTRL2: 60 Hz
+    {0xD0, 2, {0xA4, 0xA1}},                        // PWCTRL1
+    {0xE0, 14, {0xD0, 0x04, 0x0D, 0x11, 0x13, 0x2B, 0x3F,
+                0x54, 0x4C, 0x18, 0x0D, 0x0B, 0x1F, 0x23}}, // PVGAMCTRL
+    {0xE1, 14, {0xD0, 0x04, 0x0C, 0x11, 0x13, 0x2C, 0x3F,
+                0x44, 0x51, 0x2F, 0x1F, 0x1F, 0x20, 0x23}}, // NVGAMCTRL
+    {0x21, 0, {0}},                                 // INVON
+    {0x33, 6, {0x00, 0x00, 0x01, 0x40, 0x00, 0x00}}, // VSCRDEF: all 320 rows scroll
+    {0x37, 2, {0x00, 0x00}},                        // VSCSAD: line 0
+};
+
+static uint32_t resetReleaseMs = 0;
+
+/******************************************************************************
+function: Hardware reset and register setup, panel left asleep
+info:
+    Datasheet minimums: RESX low for 10 us, then 5 ms before commands.
+    Sleep out may only follow 120 ms after the reset is released (the
+    panel may have been awake before an ESP reset), so LCD_InitFinish()
+    waits out whatever is left of that; work done in between is free.
+******************************************************************************/
+void LCD_InitBegin(void)
 {
-    // Reset
     DEV_Digital_Write(DEV_RST_PIN, 1);
-    DEV_Delay_ms(100);
+    DEV_Delay_us(LCD_RESET_PULSE_US);
     DEV_Digital_Write(DEV_RST_PIN, 0);
-    DEV_Delay_ms(100);
+    DEV_Delay_us(LCD_RESET_PULSE_US);
     DEV_Digital_Write(DEV_RST_PIN, 1);
-    DEV_Delay_ms(100);
-
-    // ST7789V init sequence
-    LCD_WriteReg(0x36);
-    LCD_WriteData_Byte(0x00);
-
-    LCD_WriteReg(0x3A);
-    LCD_WriteData_Byte(0x05);
-
-    LCD_WriteReg(0xB2);
-    LCD_WriteData_Byte(0x0C);
-    LCD_WriteData_Byte(0x0C);
-    LCD_WriteData_Byte(0x00);
-    LCD_WriteData_Byte(0x33);
-    LCD_WriteData_Byte(0x33);
-
-    LCD_WriteReg(0xB7);
-    LCD_WriteData_Byte(0x35);
-
-    LCD_WriteReg(0xBB);
-    LCD_WriteData_Byte(0x19);
-
-    LCD_WriteReg(0xC0);
-    LCD_WriteData_Byte(0x2C);
-
-    LCD_WriteReg(0xC2);
-    LCD_WriteData_Byte(0x01);
-
-    LCD_WriteReg(0xC3);
-    LCD_WriteData_Byte(0x12);
-
-    LCD_WriteReg(0xC4);
-    LCD_WriteData_Byte(0x20);
-
-    LCD_WriteReg(0xC6);
-    LCD_WriteData_Byte(0x0F);
-
-    LCD_WriteReg(0xD0);
-    LCD_WriteData_Byte(0xA4);
-    LCD_WriteData_Byte(0xA1);
-
-    LCD_WriteReg(0xE0);
-    LCD_WriteData_Byte(0xD0);
-    LCD_WriteData_Byte(0x04);
-    LCD_WriteData_Byte(0x0D);
-    LCD_WriteData_Byte(0x11);
-    LCD_WriteData_Byte(0x13);
-    LCD_WriteData_Byte(0x2B);
-    LCD_WriteData_Byte(0x3F);
-    LCD_WriteData_Byte(0x54);
-    LCD_WriteData_Byte(0x4C);
-    LCD_WriteData_Byte(0x18);
-    LCD_WriteData_Byte(0x0D);
-    LCD_WriteData_Byte(0x0B);
-    LCD_WriteData_Byte(0x1F);
-    LCD_WriteData_Byte(0x23);
-
-    LCD_WriteReg(0xE1);
-    LCD_WriteData_Byte(0xD0);
-    LCD_WriteData_Byte(0x04);
-    LCD_WriteData_Byte(0x0C);
-    LCD_WriteData_Byte(0x11);
-    LCD_WriteData_Byte(0x13);
-    LCD_WriteData_Byte(0x2C);
-    LCD_WriteData_Byte(0x3F);
-    LCD_WriteData_Byte(0x44);
-    LCD_WriteData_Byte(0x51);
-    LCD_WriteData_Byte(0x2F);
-    LCD_WriteData_Byte(0x1F);
-    LCD_WriteData_Byte(0x1F);
-    LCD_WriteData_Byte(0x20);
-    LCD_WriteData_Byte(0x23);
-
-    LCD_WriteReg(0x21);
-    LCD_WriteReg(0x11);
-    DEV_Delay_ms(120);
-    LCD_WriteReg(0x29);
+    resetReleaseMs = DEV_Millis();
+    scrollLine = 0;
+    DEV_Delay_ms(LCD_RESET_READY_MS);
+
+    for (size_t i = 0; i < sizeof(initTable) / sizeof(initTable[0]); i++) {
+        LCD_WriteReg(initTable[i].Cmd);
+        for (UBYTE j = 0; j < initTable[i].Length; j++) {
+            LCD_WriteData_Byte(initTable[i].Data[j]);
+        }
+    }
 }
 
-void LCD_SetCursor(UWORD x1, UWORD y1, UWORD x2, UWORD y2)
+// Sleep out and display on, once 120 ms have passed since the reset
+void LCD_InitFinish(void)
+{
+    uint32_t elapsed = DEV_Millis() - resetReleaseMs;
+    if (elapsed < LCD_RESET_TO_SLPOUT_MS) {
+        DEV_Delay_ms(LCD_RESET_TO_SLPOUT_MS - elapsed);
+    }
+    LCD_WriteReg(0x11);                 // SLPOUT
+    DEV_Delay_ms(LCD_SLPOUT_READY_MS);
+    LCD_WriteReg(0x29);                 // DISPON
+}
+
+void LCD_Init(void)
+{
+    LCD_InitBegin();
+    LCD_InitFinish();
+}
+
+// Window in panel columns and raw GRAM rows, then memory write
+void LCD_SetGramWindow(UWORD x1, UWORD row1, UWORD x2, UWORD row2)
 {
-    // Waveshare official offsets for 135x240 display
     LCD_WriteReg(0x2A);
-    LCD_WriteData_Word(x1 + 52);
-    LCD_WriteData_Word(x2 + 52);
+    LCD_WriteData_Word(x1 + LCD_X_OFFSET);
+    LCD_WriteData_Word(x2 + LCD_X_OFFSET);
     LCD_WriteReg(0x2B);
-    LCD_WriteData_Word(y1 + 40);
-    LCD_WriteData_Word(y2 + 40);
+    LCD_WriteData_Word(row1);
+    LCD_WriteData_Word(row2);
 
     LCD_WriteReg(0x2C);
 }
 
+/******************************************************************************
+function: Window in panel coordinates
+info:
+    Rows go through the scroll line (Waveshare offsets 52/40 at line 0).
+    A window that runs past GRAM row 319 is opened up to 319; the pixel
+    writes reopen the rest at row 0 once that part is full.
+******************************************************************************/
+void LCD_SetCursor(UWORD x1, UWORD y1, UWORD x2, UWORD y2)
+{
+    UWORD row = Scroll_GramRow(scrollLine, y1);
+    UWORD rows = y2 - y1 + 1;
+    UWORD first = Scroll_RowsBeforeWrap(row, rows);
+
+    LCD_SetGramWindow(x1, row, x2, row + first - 1);
+    if (first < rows) {
+        wrapX1 = x1;
+        wrapX2 = x2;
+        wrapRows = rows - first;
+        wrapBytes = (UDOUBLE)first * (x2 - x1 + 1) * 2;
+    }
+}
+
+static void wrapWindow(void)
+{
+    LCD_SetGramWindow(wrapX1, 0, wrapX2, wrapRows - 1);
+}
+
+// VSCSAD: GRAM row shown on controller line 0; later windows follow it
+void LCD_SetScroll(UWORD line)
+{
+    scrollLine = line % LCD_GRAM_ROWS;
+    LCD_WriteReg(0x37);
+    LCD_WriteData_Word(scrollLine);
+}
+
+UWORD LCD_GetScroll(void)
+{
+    return scrollLine;
+}
+
+// One burst per row instead of a CS toggle per pixel
 void LCD_Clear(UWORD Color)
 {
+    UBYTE row[LCD_WIDTH * 2];
+    for (UWORD i = 0; i < LCD_WIDTH; i++) {
+        row[2 * i] = Color >> 8;
+        row[2 * i + 1] = Color & 0xFF;
+    }
     LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
-    for(UWORD i = 0; i < LCD_WIDTH; i++) {
-        for(UWORD j = 0; j < LCD_HEIGHT; j++) {
-            LCD_WriteData_Word(Color);
-        }
+    for (UWORD j = 0; j < LCD_HEIGHT; j++) {
+        LCD_WriteData_Buffer(row, sizeof(row));
     }
 }
 
@@ -146,7 +221,58 @@ void LCD_DrawPoint(UWORD X, UWORD Y, UWORD Color)
     LCD_WriteData_Word(Color);
 }
 
+/******************************************************************************
+function: Backlight PWM on a fixed LEDC channel
+info:
+    Value is 0-1023. The channel is owned here rather than picked by
+    analogWrite() so LCD_HoldForSleep() can detach and reattach the pin.
+******************************************************************************/
+static UWORD backlightDuty = 0;
+static bool backlightAttached = false;
+
 void LCD_SetBacklight(UWORD Value)
 {
-    analogWrite(DEV_BL_PIN, Value / 4); // Convert to 0-255 range
+    backlightDuty = Value / 4; // Convert to 0-255 range
+    if (!backlightAttached) {
+        DEV_PWM_Setup(LCD_BL_CHANNEL, LCD_BL_FREQUENCY, 8);
+        DEV_PWM_Attach(DEV_BL_PIN, LCD_BL_CHANNEL);
+        backlightAttached = true;
+    }
+    DEV_PWM_Write(LCD_BL_CHANNEL, backlightDuty);
+}
+
+/******************************************************************************
+function: Whether the backlight can stay as it is through light sleep
+info:
+    LEDC stops with the APB clock in light sleep, freezing the pin at
+    whichever phase it was in. Off and (near) full brightness can be held
+    as a plain GPIO level; an intermediate duty cycle cannot.
+******************************************************************************/
+bool LCD_CanHoldForSleep(void)
+{
+    return backlightDuty == 0 || backlightDuty >= LCD_BL_HOLD_MIN_DUTY;
+}
+
+// Hand the backlight to a held GPIO level for a light sleep, and back to LEDC
+bool LCD_HoldForSleep(bool hold)
+{
+    if (hold) {
+        if (!LCD_CanHoldForSleep()) {
+            return false;
+        }
+        if (backlightAttached) {
+            DEV_PWM_Detach(DEV_BL_PIN);
+        }
+        DEV_Digital_Write(DEV_BL_PIN, backlightDuty > 0);
+        DEV_GPIO_Hold(DEV_BL_PIN, true);
+        DEV_GPIO_Hold(DEV_RST_PIN, true); // A reset while asleep would blank GRAM
+        return true;
+    }
+    DEV_GPIO_Hold(DEV_RST_PIN, false);
+    DEV_GPIO_Hold(DEV_BL_PIN, false);
+    if (backlightAttached) {
+        DEV_PWM_Attach(DEV_BL_PIN, LCD_BL_CHANNEL);
+        DEV_PWM_Write(LCD_BL_CHANNEL, backlightDuty);
+    }
+    return true;
 }
\ No newline at end of file
@@ -7,9 +7,20 @@
 #define __LCD_DRIVER_H
 
 #include "DEV_Config.h"
+#include "LCD_Scroll.h"
 
-#define LCD_WIDTH   135 //LCD width
-#define LCD_HEIGHT  240 //LCD height
+// LCD_WIDTH, LCD_HEIGHT and the GRAM offsets: LCD_Scroll.h
+
+// Panel timing, ST7789V datasheet minimums
+#define LCD_RESET_PULSE_US     10   // RESX low
+#define LCD_RESET_READY_MS     5    // Reset release to first command
+#define LCD_RESET_TO_SLPOUT_MS 120  // Reset release to sleep out
+#define LCD_SLPOUT_READY_MS    5    // Sleep out to next command
+
+// Backlight PWM
+#define LCD_BL_CHANNEL       0
+#define LCD_BL_FREQUENCY     1000
+#define LCD_BL_HOLD_MIN_DUTY 240    // Of 255: close enough to full to hold high in sleep
 
 // Colors
 #define BLACK   0x0000
@@ -23,11 +34,19 @@
 
 void LCD_WriteData_Byte(UBYTE da); 
 void LCD_WriteData_Word(UWORD da);
+void LCD_WriteData_Buffer(const UBYTE *data, UDOUBLE len);
 void LCD_WriteReg(UBYTE da);
 void LCD_SetCursor(UWORD x1, UWORD y1, UWORD x2,UWORD y2);
+void LCD_SetGramWindow(UWORD x1, UWORD row1, UWORD x2, UWORD row2);
+void LCD_SetScroll(UWORD line);
+UWORD LCD_GetScroll(void);
 void LCD_SetUWORD(UWORD x, UWORD y, UWORD Color);
 void LCD_Init(void);
+void LCD_InitBegin(void);
+void LCD_InitFinish(void);
 void LCD_SetBacklight(UWORD Value);
+bool LCD_CanHoldForSleep(void);
+bool LCD_HoldForSleep(bool hold);
 void LCD_Clear(UWORD Color);
 void LCD_ClearWindow(UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend, UWORD Color);
 void LCD_DrawPoint(UWORD X,UWORD Y,UWORD Color);
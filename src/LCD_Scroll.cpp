@@ -0,0 +1,84 @@
+/*****************************************************************************
+* | File        :   LCD_Scroll.cpp
+* | Function    :   ST7789 vertical scroll geometry and push transitions
+******************************************************************************/
+#include "LCD_Scroll.h"
+
+// GRAM row shown at panel row y when VSCSAD is line
+uint16_t Scroll_GramRow(uint16_t line, uint16_t y)
+{
+    return (LCD_Y_OFFSET + line + y) % LCD_GRAM_ROWS;
+}
+
+// How many of rows starting at gramRow fit before GRAM row 319
+uint16_t Scroll_RowsBeforeWrap(uint16_t gramRow, uint16_t rows)
+{
+    uint16_t room = LCD_GRAM_ROWS - gramRow;
+    return rows < room ? rows : room;
+}
+
+void Scroll_Begin(SCROLL_PLAN *plan, SCROLL_DIRECTION direction, uint16_t startLine, uint16_t steps)
+{
+    plan->Direction = direction;
+    plan->StartLine = startLine % LCD_GRAM_ROWS;
+    plan->Steps = steps < SCROLL_MIN_STEPS ? SCROLL_MIN_STEPS : steps;
+    plan->Step = 0;
+    plan->Travel = 0;
+}
+
+/******************************************************************************
+function: Rows moved after step k of n, eased in and out
+info:
+    Smoothstep in 1/1024ths. Its steepest part moves 1.5x the average,
+    so with at least SCROLL_MIN_STEPS no step exceeds the spare rows.
+******************************************************************************/
+static uint16_t travelAt(uint16_t k, uint16_t n)
+{
+    uint32_t t = (uint32_t)k * 1024 / n;
+    uint32_t s = t * t * (3 * 1024 - 2 * t) / (1024 * 1024);
+    return (uint16_t)(SCROLL_VIEW_ROWS * s / 1024);
+}
+
+/******************************************************************************
+function: The next step: rows to write off screen, then the new scroll line
+info:
+    Push up: incoming row r belongs 240 rows below the start of the old
+    picture, at GRAM 40 + start + 240 + r, which stays off screen until
+    the line moves past it.
+    Push down: the rows revealed at the top are the incoming image's last
+    ones, at the GRAM rows just above the old picture.
+******************************************************************************/
+bool Scroll_Next(SCROLL_PLAN *plan, SCROLL_STEP *step)
+{
+    if (plan->Step >= plan->Steps) {
+        return false;
+    }
+    plan->Step++;
+    uint16_t travel = travelAt(plan->Step, plan->Steps);
+    if (travel - plan->Travel > SCROLL_SPARE_ROWS) {
+        travel = plan->Travel + SCROLL_SPARE_ROWS;
+    }
+    if (plan->Step == plan->Steps) {
+        travel = SCROLL_VIEW_ROWS;
+    }
+    step->Rows = travel - plan->Travel;
+
+    if (plan->Direction == SCROLL_PUSH_UP) {
+        step->SrcRow = plan->Travel;
+        step->GramRow = Scroll_GramRow(plan->StartLine, SCROLL_VIEW_ROWS + plan->Travel);
+        step->Line = (plan->StartLine + travel) % LCD_GRAM_ROWS;
+    } else {
+        step->SrcRow = SCROLL_VIEW_ROWS - travel;
+        step->Line = (plan->StartLine + LCD_GRAM_ROWS - travel) % LCD_GRAM_ROWS;
+        step->GramRow = Scroll_GramRow(step->Line, 0);
+    }
+    plan->Travel = travel;
+    return true;
+}
+
+// VSCSAD once the transition is complete
+uint16_t Scroll_EndLine(const SCROLL_PLAN *plan)
+{
+    uint16_t shift = plan->Direction == SCROLL_PUSH_UP ? SCROLL_VIEW_ROWS : LCD_GRAM_ROWS - SCROLL_VIEW_ROWS;
+    return (plan->StartLine + shift) % LCD_GRAM_ROWS;
+}
@@ -0,0 +1,57 @@
+/*****************************************************************************
+* | File        :   LCD_Scroll.h
+* | Function    :   ST7789 vertical scroll geometry and push transitions
+* | Info        :
+*   The ST7789 has 320 rows of GRAM; the 135x240 panel shows controller
+*   lines 40..279 and columns 52..186. With the whole GRAM as the scroll
+*   area (VSCRDEF 0/320/0), VSCSAD picks the GRAM row shown on line 0, so
+*   panel row y shows GRAM row (40 + line + y) mod 320 and the 80 rows
+*   outside the panel are always off screen.
+*   A push transition writes the incoming image's rows into those spare
+*   rows just before they scroll into view and moves VSCSAD once per panel
+*   refresh: the old image slides out while the new one slides in, and
+*   exactly one frame of pixels is sent. The picture then stays at the new
+*   scroll line; LCD_SetCursor maps (and splits) windows through it.
+*   No Arduino dependency: the geometry runs in host tests.
+******************************************************************************/
+#ifndef __LCD_SCROLL_H
+#define __LCD_SCROLL_H
+
+#include <stdint.h>
+
+#define LCD_WIDTH           135     // Panel columns
+#define LCD_HEIGHT          240     // Panel rows
+#define LCD_X_OFFSET        52      // Panel column 0 in GRAM
+#define LCD_Y_OFFSET        40      // Panel row 0 on controller line 40
+#define LCD_GRAM_ROWS       320     // TFA + VSA + BFA
+#define SCROLL_VIEW_ROWS    240     // Panel rows (LCD_HEIGHT)
+#define SCROLL_SPARE_ROWS   (LCD_GRAM_ROWS - SCROLL_VIEW_ROWS)
+#define SCROLL_MIN_STEPS    6       // Keeps every step within the spare rows
+
+typedef enum {
+    SCROLL_PUSH_UP = 0,     // New image enters from the bottom
+    SCROLL_PUSH_DOWN,       // New image enters from the top
+} SCROLL_DIRECTION;
+
+typedef struct {
+    uint16_t SrcRow;        // First incoming image row to send
+    uint16_t Rows;          // Rows to send this step (may be 0)
+    uint16_t GramRow;       // GRAM row the first one goes to; the run may wrap past 319
+    uint16_t Line;          // VSCSAD once they are written
+} SCROLL_STEP;
+
+typedef struct {
+    uint8_t Direction;      // SCROLL_DIRECTION
+    uint16_t StartLine;     // VSCSAD before the transition
+    uint16_t Steps;
+    uint16_t Step;
+    uint16_t Travel;        // Rows moved so far
+} SCROLL_PLAN;
+
+uint16_t Scroll_GramRow(uint16_t line, uint16_t y);
+uint16_t Scroll_RowsBeforeWrap(uint16_t gramRow, uint16_t rows);
+void Scroll_Begin(SCROLL_PLAN *plan, SCROLL_DIRECTION direction, uint16_t startLine, uint16_t steps);
+bool Scroll_Next(SCROLL_PLAN *plan, SCROLL_STEP *step);
+uint16_t Scroll_EndLine(const SCROLL_PLAN *plan);
+
+#endif
@@ -0,0 +1,255 @@
+/*****************************************************************************
+* | File        :   Latency_Trace.cpp
+* | Function    :   Input-to-photon latency: per-stage timestamps and histograms
+******************************************************************************/
+#include "Latency_Trace.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+// Photons arrive from the present task on core 0, everything else from loop()
+static portMUX_TYPE latencyLock = portMUX_INITIALIZER_UNLOCKED;
+#define LATENCY_LOCK()    portENTER_CRITICAL(&latencyLock)
+#define LATENCY_UNLOCK()  portEXIT_CRITICAL(&latencyLock)
+#define LATENCY_PRINTF    Serial.printf
+#else
+#include <stdio.h>
+#include <mutex>
+// Frame_Pipeline's host present thread reports photons
+static std::mutex latencyLock;
+#define LATENCY_LOCK()    latencyLock.lock()
+#define LATENCY_UNLOCK()  latencyLock.unlock()
+#define LATENCY_PRINTF    printf
+#endif
+
+#define LINEAR_BUCKETS   16      // 0-2 ms in 1/8 ms steps
+#define BUCKET_UNIT_US   125
+
+static LATENCY_HISTOGRAM histograms[LAT_SEGMENT_COUNT];
+static LATENCY_SAMPLE pending;
+static bool pendingOpen = false;
+static uint32_t superseded = 0;
+static LATENCY_SAMPLE recent[LATENCY_RECENT];
+static uint32_t recentCount = 0;
+static LATENCY_EDGE edges[LATENCY_EDGE_LOG];
+static uint32_t edgeCount = 0;
+
+// a is at or after b, across the 32-bit microsecond wrap
+static bool reached(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) >= 0;
+}
+
+/******************************************************************************
+function: Histogram bucket of a duration
+info:
+    Linear below 2 ms, then 8 buckets per power of two, like a
+    floating-point number with a 3-bit mantissa.
+******************************************************************************/
+static int bucketOf(uint32_t us)
+{
+    uint32_t units = us / BUCKET_UNIT_US;
+    if (units < LINEAR_BUCKETS) {
+        return units;
+    }
+    int exponent = 31 - __builtin_clz(units);   // >= 4
+    int mantissa = (units >> (exponent - 3)) & 7;
+    int bucket = LINEAR_BUCKETS + (exponent - 4) * 8 + mantissa;
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+// Exclusive upper edge of a bucket, in microseconds
+static uint32_t bucketLimit(int bucket)
+{
+    if (bucket < LINEAR_BUCKETS) {
+        return (bucket + 1) * BUCKET_UNIT_US;
+    }
+    int exponent = 4 + (bucket - LINEAR_BUCKETS) / 8;
+    int mantissa = (bucket - LINEAR_BUCKETS) % 8;
+    return ((uint32_t)(9 + mantissa) << (exponent - 3)) * BUCKET_UNIT_US;
+}
+
+static void record(LATENCY_HISTOGRAM *histogram, uint32_t us)
+{
+    if (histogram->Count == 0 || us < histogram->MinUs) {
+        histogram->MinUs = us;
+    }
+    if (us > histogram->MaxUs) {
+        histogram->MaxUs = us;
+    }
+    histogram->Count++;
+    histogram->SumUs += us;
+    histogram->Buckets[bucketOf(us)]++;
+}
+
+static void addSample(const LATENCY_SAMPLE *s)
+{
+    record(&histograms[LAT_EDGE_TO_DECISION], s->DecisionUs - s->EdgeUs);
+    record(&histograms[LAT_DECISION_TO_READY], s->ReadyUs - s->DecisionUs);
+    record(&histograms[LAT_READY_TO_FIRST], s->FirstPixelUs - s->ReadyUs);
+    record(&histograms[LAT_FIRST_TO_LAST], s->LastPixelUs - s->FirstPixelUs);
+    record(&histograms[LAT_EDGE_TO_LAST], s->LastPixelUs - s->EdgeUs);
+    recent[recentCount % LATENCY_RECENT] = *s;
+    recentCount++;
+}
+
+/******************************************************************************
+function: A gesture loop() is about to act on, expected to change the screen
+info:
+    Opens the sample the next frame-ready and LCD transfer complete. An
+    earlier sample that never reached the panel is counted as superseded.
+******************************************************************************/
+void Latency_Input(uint8_t gesture, uint32_t edgeUs, uint32_t decisionUs, uint32_t actionUs)
+{
+    LATENCY_LOCK();
+    if (pendingOpen) {
+        superseded++;
+    }
+    memset(&pending, 0, sizeof(pending));
+    pending.Gesture = gesture;
+    pending.EdgeUs = edgeUs;
+    pending.DecisionUs = decisionUs;
+    pending.ActionUs = actionUs;
+    pendingOpen = true;
+    LATENCY_UNLOCK();
+}
+
+// The frame for the open sample is decoded (first call wins)
+void Latency_FrameReady(uint32_t readyUs)
+{
+    LATENCY_LOCK();
+    if (pendingOpen && pending.ReadyUs == 0 && reached(readyUs, pending.ActionUs)) {
+        pending.ReadyUs = readyUs;
+    }
+    LATENCY_UNLOCK();
+}
+
+/******************************************************************************
+function: An LCD transfer finished (Pipeline_Trace, either core)
+info:
+    The first transfer that starts after the action completes the sample.
+    Overlays and status screens are drawn straight to the panel with no
+    separate decode, so for them ready is the start of the transfer.
+******************************************************************************/
+void Latency_Photons(uint32_t firstPixelUs, uint32_t lastPixelUs)
+{
+    LATENCY_LOCK();
+    if (pendingOpen && reached(firstPixelUs, pending.ActionUs)) {
+        if (pending.ReadyUs == 0 || !reached(firstPixelUs, pending.ReadyUs)) {
+            pending.ReadyUs = firstPixelUs;
+        }
+        pending.FirstPixelUs = firstPixelUs;
+        pending.LastPixelUs = lastPixelUs;
+        pendingOpen = false;
+        addSample(&pending);
+    }
+    LATENCY_UNLOCK();
+}
+
+void Latency_RecordEdge(uint32_t timeUs, bool pressed)
+{
+    edges[edgeCount % LATENCY_EDGE_LOG].TimeUs = timeUs;
+    edges[edgeCount % LATENCY_EDGE_LOG].Pressed = pressed;
+    edgeCount++;
+}
+
+// Fold in a complete sample (host replay)
+void Latency_AddSample(const LATENCY_SAMPLE *sample)
+{
+    LATENCY_LOCK();
+    addSample(sample);
+    LATENCY_UNLOCK();
+}
+
+void Latency_Reset(void)
+{
+    LATENCY_LOCK();
+    memset(histograms, 0, sizeof(histograms));
+    pendingOpen = false;
+    superseded = 0;
+    recentCount = 0;
+    LATENCY_UNLOCK();
+    edgeCount = 0;
+}
+
+const LATENCY_HISTOGRAM *Latency_Histogram(LATENCY_SEGMENT segment)
+{
+    return (unsigned)segment < LAT_SEGMENT_COUNT ? &histograms[segment] : NULL;
+}
+
+/******************************************************************************
+function: Upper edge of the bucket holding the given percentile
+info:
+    Never more than the largest value seen, so p99 of a few samples is the
+    maximum rather than a bucket boundary above it.
+******************************************************************************/
+uint32_t Latency_Percentile(const LATENCY_HISTOGRAM *histogram, uint32_t percent)
+{
+    if (histogram->Count == 0) {
+        return 0;
+    }
+    uint64_t rank = ((uint64_t)histogram->Count * percent + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < LATENCY_BUCKETS; i++) {
+        seen += histogram->Buckets[i];
+        if (seen >= rank && seen > 0) {
+            uint32_t limit = bucketLimit(i);
+            return limit < histogram->MaxUs && i < LATENCY_BUCKETS - 1 ? limit : histogram->MaxUs;
+        }
+    }
+    return histogram->MaxUs;
+}
+
+uint32_t Latency_Superseded(void)
+{
+    return superseded;
+}
+
+const char *Latency_SegmentName(LATENCY_SEGMENT segment)
+{
+    switch (segment) {
+    case LAT_EDGE_TO_DECISION:  return "edge-decision";
+    case LAT_DECISION_TO_READY: return "decision-ready";
+    case LAT_READY_TO_FIRST:    return "ready-first";
+    case LAT_FIRST_TO_LAST:     return "first-last";
+    case LAT_EDGE_TO_LAST:      return "edge-photon";
+    default:                    return "?";
+    }
+}
+
+/******************************************************************************
+function: Percentiles per stage, then the most recent samples
+******************************************************************************/
+void Latency_Print(void)
+{
+    LATENCY_PRINTF("# latency: %u samples, %u superseded before reaching the panel\n",
+                   (unsigned)histograms[LAT_EDGE_TO_LAST].Count, (unsigned)superseded);
+    LATENCY_PRINTF("# stage             p50_ms   p95_ms   p99_ms   max_ms  mean_ms\n");
+    for (int i = 0; i < LAT_SEGMENT_COUNT; i++) {
+        const LATENCY_HISTOGRAM *h = &histograms[i];
+        LATENCY_PRINTF("%-16s %8.1f %8.1f %8.1f %8.1f %8.1f\n", Latency_SegmentName((LATENCY_SEGMENT)i),
+                       Latency_Percentile(h, 50) / 1000.0, Latency_Percentile(h, 95) / 1000.0,
+                       Latency_Percentile(h, 99) / 1000.0, h->MaxUs / 1000.0,
+                       h->Count > 0 ? h->SumUs / 1000.0 / h->Count : 0.0);
+    }
+    uint32_t n = recentCount < LATENCY_RECENT ? recentCount : LATENCY_RECENT;
+    LATENCY_PRINTF("# sample gesture edge_us decision_us action_us ready_us first_us last_us\n");
+    for (uint32_t i = 0; i < n; i++) {
+        const LATENCY_SAMPLE *s = &recent[(recentCount - n + i) % LATENCY_RECENT];
+        LATENCY_PRINTF("sample %u %u %u %u %u %u %u\n", (unsigned)s->Gesture, (unsigned)s->EdgeUs,
+                       (unsigned)s->DecisionUs, (unsigned)s->ActionUs, (unsigned)s->ReadyUs,
+                       (unsigned)s->FirstPixelUs, (unsigned)s->LastPixelUs);
+    }
+}
+
+// Raw edges, oldest first, in the format scripts/latency_replay.cpp reads
+void Latency_DumpEdges(void)
+{
+    uint32_t n = edgeCount < LATENCY_EDGE_LOG ? edgeCount : LATENCY_EDGE_LOG;
+    LATENCY_PRINTF("# edges: %u (%u total)\n", (unsigned)n, (unsigned)edgeCount);
+    for (uint32_t i = 0; i < n; i++) {
+        const LATENCY_EDGE *e = &edges[(edgeCount - n + i) % LATENCY_EDGE_LOG];
+        LATENCY_PRINTF("edge %u %u\n", (unsigned)e->TimeUs, e->Pressed ? 1u : 0u);
+    }
+}
@@ -0,0 +1,76 @@
+/*****************************************************************************
+* | File        :   Latency_Trace.h
+* | Function    :   Input-to-photon latency: per-stage timestamps and histograms
+* | Info        :
+*   One button action is followed from the physical edge to the end of the
+*   LCD transfer that shows its result:
+*     edge        interrupt timestamp of the press/release the gesture began at
+*     decision    when the recognizer decided the gesture (a click in
+*                 slideshow mode waits out the double-click window first)
+*     ready       the frame to show is decoded (or was already prefetched)
+*     first/last  the LCD transfer that shows it starts and ends
+*   Each stage gap and the total go into a histogram with 1/8 ms steps up
+*   to 2 ms and 8 steps per doubling above (at most 12.5% wide), from which
+*   p50/p95/p99 are reported. The panel's own refresh after the last pixel
+*   (up to one 60 Hz frame) is not included.
+*   No Arduino dependency: scripts/latency_replay.cpp runs recorded edges
+*   through the same recognizer and histograms on the host.
+******************************************************************************/
+#ifndef __LATENCY_TRACE_H
+#define __LATENCY_TRACE_H
+
+#include <stdint.h>
+
+#define LATENCY_BUCKETS     112
+#define LATENCY_RECENT      16      // Complete samples kept for the dump
+#define LATENCY_EDGE_LOG    64      // Raw button edges kept for host replay
+
+typedef enum {
+    LAT_EDGE_TO_DECISION = 0,
+    LAT_DECISION_TO_READY,
+    LAT_READY_TO_FIRST,
+    LAT_FIRST_TO_LAST,
+    LAT_EDGE_TO_LAST,               // The whole path
+    LAT_SEGMENT_COUNT
+} LATENCY_SEGMENT;
+
+typedef struct {
+    uint8_t Gesture;                // GESTURE_TYPE
+    uint32_t EdgeUs;
+    uint32_t DecisionUs;
+    uint32_t ActionUs;              // When loop() acted on it (opens the sample)
+    uint32_t ReadyUs;               // 0 until the frame is ready
+    uint32_t FirstPixelUs;
+    uint32_t LastPixelUs;
+} LATENCY_SAMPLE;
+
+typedef struct {
+    uint32_t Count;
+    uint32_t MinUs;
+    uint32_t MaxUs;
+    uint64_t SumUs;
+    uint32_t Buckets[LATENCY_BUCKETS];
+} LATENCY_HISTOGRAM;
+
+typedef struct {
+    uint32_t TimeUs;
+    bool Pressed;
+} LATENCY_EDGE;
+
+// Recording (device: loop() and Pipeline_Trace)
+void Latency_Input(uint8_t gesture, uint32_t edgeUs, uint32_t decisionUs, uint32_t actionUs);
+void Latency_FrameReady(uint32_t readyUs);
+void Latency_Photons(uint32_t firstPixelUs, uint32_t lastPixelUs);
+void Latency_RecordEdge(uint32_t timeUs, bool pressed);
+void Latency_Reset(void);
+
+// Results
+void Latency_AddSample(const LATENCY_SAMPLE *sample);
+const LATENCY_HISTOGRAM *Latency_Histogram(LATENCY_SEGMENT segment);
+uint32_t Latency_Percentile(const LATENCY_HISTOGRAM *histogram, uint32_t percent);
+uint32_t Latency_Superseded(void);
+const char *Latency_SegmentName(LATENCY_SEGMENT segment);
+void Latency_Print(void);
+void Latency_DumpEdges(void);
+
+#endif
@@ -0,0 +1,158 @@
+/*****************************************************************************
+* | File        :   Log_Ring.cpp
+* | Function    :   Levelled logging into a lock-free ring drained by a task
+******************************************************************************/
+#include "Log_Ring.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#define LOG_MICROS()    micros()
+static TaskHandle_t drainTask = NULL;
+#else
+#include <chrono>
+#define LOG_MICROS()    ((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>( \
+                            std::chrono::steady_clock::now().time_since_epoch()).count())
+#endif
+
+static LOG_LINE ring[LOG_RING_LINES];
+static uint32_t head = 0;           // Next position to claim (any writer)
+static uint32_t tail = 0;           // Next position to drain (drain task only)
+static uint32_t dropped = 0;
+static uint32_t droppedReported = 0;
+
+// Sequence of a slot that is free for position pos
+static uint32_t lapOf(uint32_t pos)
+{
+    return pos - pos % LOG_RING_LINES;
+}
+
+/******************************************************************************
+function: Format one line into the ring
+info:
+    A slot is free for position p when its sequence is lapOf(p); the CAS
+    on head hands it to exactly one writer, which fills it and stores
+    lapOf(p) + 1. A slot still holding the previous lap means the ring is
+    full, and the line is dropped rather than waiting for the drain task.
+******************************************************************************/
+void Log_Write(uint8_t level, const char *format, ...)
+{
+    uint32_t pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    LOG_LINE *line;
+    for (;;) {
+        line = &ring[pos % LOG_RING_LINES];
+        int32_t diff = (int32_t)(__atomic_load_n(&line->Sequence, __ATOMIC_ACQUIRE) - lapOf(pos));
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&head, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&head, __ATOMIC_RELAXED);
+        }
+    }
+
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(line->Text, LOG_LINE_SIZE, format, args);
+    va_end(args);
+    line->Length = n < 0 ? 0 : n < LOG_LINE_SIZE ? n : LOG_LINE_SIZE - 1;
+    line->Level = level;
+    line->TimeUs = LOG_MICROS();
+    __atomic_store_n(&line->Sequence, lapOf(pos) + 1, __ATOMIC_RELEASE);
+#ifdef ARDUINO
+    if (drainTask != NULL) {
+        xTaskNotifyGive(drainTask);
+    }
+#endif
+}
+
+/******************************************************************************
+function: Hand published lines to sink, oldest first (one caller at a time)
+info:
+    Stops at the first slot not yet published, so lines come out in the
+    order they were claimed. Returns how many were drained.
+******************************************************************************/
+uint32_t Log_Drain(LOG_SINK sink)
+{
+    uint32_t n = 0;
+    for (;;) {
+        LOG_LINE *line = &ring[tail % LOG_RING_LINES];
+        if (__atomic_load_n(&line->Sequence, __ATOMIC_ACQUIRE) != lapOf(tail) + 1) {
+            break;
+        }
+        sink(line);
+        __atomic_store_n(&line->Sequence, lapOf(tail) + LOG_RING_LINES, __ATOMIC_RELEASE);
+        tail++;
+        n++;
+    }
+
+    uint32_t lost = __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+    if (lost != droppedReported) {
+        LOG_LINE note;
+        note.TimeUs = LOG_MICROS();
+        note.Level = LOG_LEVEL_WARN;
+        int len = snprintf(note.Text, LOG_LINE_SIZE, "log: %u lines dropped (ring full)",
+                           (unsigned)(lost - droppedReported));
+        note.Length = len < LOG_LINE_SIZE ? len : LOG_LINE_SIZE - 1;
+        droppedReported = lost;
+        sink(&note);
+    }
+    return n;
+}
+
+uint32_t Log_Dropped(void)
+{
+    return __atomic_load_n(&dropped, __ATOMIC_RELAXED);
+}
+
+char Log_LevelLetter(uint8_t level)
+{
+    static const char LETTERS[] = "-EWID";
+    return level <= LOG_LEVEL_DEBUG ? LETTERS[level] : '?';
+}
+
+#ifdef ARDUINO
+// "I   12.345 text": level, seconds since boot, then the line
+static void serialSink(const LOG_LINE *line)
+{
+    static char out[LOG_LINE_SIZE + 24];
+    uint32_t ms = line->TimeUs / 1000;
+    int n = snprintf(out, sizeof(out), "%c %5u.%03u %.*s\n", Log_LevelLetter(line->Level), (unsigned)(ms / 1000),
+                     (unsigned)(ms % 1000), (int)line->Length, line->Text);
+    Serial.write((const uint8_t *)out, n < (int)sizeof(out) ? n : sizeof(out) - 1);
+}
+
+static void drainTaskMain(void *param)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        Log_Drain(serialSink);
+    }
+}
+
+/******************************************************************************
+function: Start the drain task (after Serial.begin)
+info:
+    Idle priority on core 0: it only runs when the present and SD fill
+    tasks have nothing to do. Lines logged before this come out first.
+******************************************************************************/
+void Log_Begin(void)
+{
+    if (drainTask != NULL) {
+        return;
+    }
+    if (xTaskCreatePinnedToCore(drainTaskMain, "log_drain", 3072, NULL, tskIDLE_PRIORITY, &drainTask, 0) == pdPASS) {
+        xTaskNotifyGive(drainTask);
+    }
+}
+#else
+void Log_Begin(void)
+{
+}
+#endif
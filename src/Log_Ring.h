@@ -0,0 +1,72 @@
+/*****************************************************************************
+* | File        :   Log_Ring.h
+* | Function    :   Levelled logging into a lock-free ring drained by a task
+* | Info        :
+*   LOG_ERROR/WARN/INFO/DEBUG(format, ...) format with vsnprintf straight
+*   into a fixed slot of a static ring, so a decode or draw path that logs
+*   never touches the heap or waits on the serial port: a low-priority
+*   task on core 0 writes finished lines out. Levels above LOG_LEVEL
+*   (build flag, default INFO) compile to nothing, arguments included.
+*   Any task may log. A writer claims a slot with a compare-and-swap on
+*   the head and publishes it through the slot's sequence number, so
+*   there is no lock; a full ring drops the line and counts it. Lines are
+*   cut at LOG_LINE_SIZE - 1 characters. Keep %f off hot paths: newlib's
+*   float formatting allocates.
+*   On the host there is no task; Log_Drain hands lines to a callback.
+******************************************************************************/
+#ifndef __LOG_RING_H
+#define __LOG_RING_H
+
+#include <stdint.h>
+
+#define LOG_LEVEL_NONE      0
+#define LOG_LEVEL_ERROR     1
+#define LOG_LEVEL_WARN      2
+#define LOG_LEVEL_INFO      3
+#define LOG_LEVEL_DEBUG     4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL           LOG_LEVEL_INFO
+#endif
+
+#define LOG_RING_LINES      32      // Power of two
+#define LOG_LINE_SIZE       112     // Text bytes per line, terminator included
+
+typedef struct {
+    uint32_t Sequence;      // Free for position p: p - p % N; published: that + 1
+    uint32_t TimeUs;
+    uint8_t Level;
+    uint8_t Length;
+    char Text[LOG_LINE_SIZE];
+} LOG_LINE;
+
+typedef void (*LOG_SINK)(const LOG_LINE *line);
+
+void Log_Begin(void);
+void Log_Write(uint8_t level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+uint32_t Log_Drain(LOG_SINK sink);
+uint32_t Log_Dropped(void);
+char Log_LevelLetter(uint8_t level);
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...)      Log_Write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...)      do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...)       Log_Write(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...)       do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...)       Log_Write(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...)       do {} while (0)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...)      Log_Write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...)      do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,192 @@
+/*****************************************************************************
+* | File        :   MJPEG_Clip.cpp
+* | Function    :   Frame index for MJPEG clips (AVI and concatenated JPEG)
+******************************************************************************/
+#include "MJPEG_Clip.h"
+#include <string.h>
+#include <strings.h>
+
+static uint32_t le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static bool readAt(SD_READER *reader, uint32_t position, uint8_t *dst, uint32_t len)
+{
+    return SDReader_Seek(reader, position) &&
+           SDReader_Read(reader, dst, len) == (int32_t)len;
+}
+
+// Offset of the next FF <code> marker at or after position, skipping FF fill bytes
+static bool findMarker(SD_READER *reader, uint32_t position, uint32_t end, uint8_t code, uint32_t *found)
+{
+    uint8_t block[MJPEG_CLIP_SCAN_BLOCK];
+    bool lastFF = false;
+
+    while (position < end) {
+        uint32_t n = end - position;
+        if (n > sizeof(block)) {
+            n = sizeof(block);
+        }
+        if (!readAt(reader, position, block, n)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < n; i++) {
+            if (lastFF && block[i] == code) {
+                *found = position + i - 1;
+                return true;
+            }
+            lastFF = block[i] == 0xFF;
+        }
+        position += n;
+    }
+    return false;
+}
+
+/******************************************************************************
+function: Locate the 'movi' list and the frame period of an AVI
+info:
+    Only the 'hdrl'/'strl' lists are entered on the way; everything else
+    at the top level is skipped by its size. RIFF chunks are padded to an
+    even length.
+******************************************************************************/
+static bool openAVI(MJPEG_CLIP *clip)
+{
+    SD_READER *reader = clip->Reader;
+    uint8_t header[12];
+    if (!readAt(reader, 0, header, sizeof(header)) ||
+        memcmp(header, "RIFF", 4) != 0 || memcmp(&header[8], "AVI ", 4) != 0) {
+        return false;
+    }
+    uint32_t riffEnd = 8 + le32(&header[4]);
+    if (riffEnd > SDReader_Size(reader)) {
+        riffEnd = SDReader_Size(reader);
+    }
+
+    uint32_t position = 12;
+    while (position + 12 <= riffEnd) {
+        if (!readAt(reader, position, header, sizeof(header))) {
+            return false;
+        }
+        uint32_t size = le32(&header[4]);
+        if (memcmp(header, "LIST", 4) == 0) {
+            if (memcmp(&header[8], "movi", 4) == 0) {
+                clip->FirstFrame = position + 12;
+                clip->End = position + 8 + size;
+                if (clip->End > riffEnd) {
+                    clip->End = riffEnd;
+                }
+                return true;
+            }
+            if (memcmp(&header[8], "hdrl", 4) == 0 || memcmp(&header[8], "strl", 4) == 0) {
+                position += 12;
+                continue;
+            }
+        } else if (memcmp(header, "avih", 4) == 0 && size >= 40) {
+            uint8_t avih[40];
+            if (!readAt(reader, position + 8, avih, sizeof(avih))) {
+                return false;
+            }
+            clip->FrameMicros = le32(&avih[0]);
+            clip->Width = le32(&avih[32]);
+            clip->Height = le32(&avih[36]);
+        }
+        position += 8 + size + (size & 1);
+    }
+    return false; // No 'movi' list
+}
+
+bool MJPEGClip_Open(MJPEG_CLIP *clip, SD_READER *reader, const char *path)
+{
+    memset(clip, 0, sizeof(*clip));
+    clip->Reader = reader;
+    if (!SDReader_Open(reader, path)) {
+        return false;
+    }
+
+    const char *dot = strrchr(path, '.');
+    if (dot != NULL && strcasecmp(dot, ".avi") == 0) {
+        clip->Format = CLIP_AVI;
+        if (!openAVI(clip)) {
+            SDReader_Close(reader);
+            return false;
+        }
+    } else {
+        clip->Format = CLIP_MJPG;
+        clip->FirstFrame = 0;
+        clip->End = SDReader_Size(reader);
+    }
+    if (clip->FrameMicros == 0) {
+        clip->FrameMicros = 1000000 / MJPEG_CLIP_DEFAULT_FPS;
+    }
+    MJPEGClip_Rewind(clip);
+    return true;
+}
+
+/******************************************************************************
+function: Find the next frame
+info:
+    Returns its file offset and length, or false at the end of the clip.
+    Only chunk headers (AVI) or marker scans (.mjpg) are read; the caller
+    reads the frame itself if it is going to decode it.
+******************************************************************************/
+bool MJPEGClip_NextFrame(MJPEG_CLIP *clip, uint32_t *offset, uint32_t *length)
+{
+    SD_READER *reader = clip->Reader;
+
+    if (clip->Format == CLIP_MJPG) {
+        uint32_t soi, eoi;
+        if (!findMarker(reader, clip->Next, clip->End, 0xD8, &soi) ||
+            !findMarker(reader, soi + 2, clip->End, 0xD9, &eoi)) {
+            return false;
+        }
+        *offset = soi;
+        *length = eoi + 2 - soi;
+        clip->Next = eoi + 2;
+        clip->FrameIndex++;
+        return true;
+    }
+
+    uint8_t header[8];
+    while (clip->Next + 8 <= clip->End) {
+        if (!readAt(reader, clip->Next, header, sizeof(header))) {
+            return false;
+        }
+        uint32_t size = le32(&header[4]);
+        if (memcmp(header, "LIST", 4) == 0) {
+            clip->Next += 12; // Enter 'rec ' groups
+            continue;
+        }
+        uint32_t data = clip->Next + 8;
+        if (data + size > clip->End) {
+            return false;
+        }
+        clip->Next = data + size + (size & 1);
+        // '00dc' / '00db' video chunks; empty ones are frames the encoder dropped
+        if (header[2] == 'd' && (header[3] == 'c' || header[3] == 'b') && size > 0) {
+            *offset = data;
+            *length = size;
+            clip->FrameIndex++;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MJPEGClip_Rewind(MJPEG_CLIP *clip)
+{
+    clip->Next = clip->FirstFrame;
+    clip->FrameIndex = 0;
+}
+
+void MJPEGClip_Close(MJPEG_CLIP *clip)
+{
+    SDReader_Close(clip->Reader);
+}
+
+bool MJPEGClip_IsClipFile(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    return dot != NULL && (strcasecmp(dot, ".avi") == 0 || strcasecmp(dot, ".mjpg") == 0 ||
+                           strcasecmp(dot, ".mjpeg") == 0);
+}
@@ -0,0 +1,48 @@
+/*****************************************************************************
+* | File        :   MJPEG_Clip.h
+* | Function    :   Frame index for MJPEG clips (AVI and concatenated JPEG)
+* | Info        :
+*   Walks a clip one frame at a time through an SD_READER and reports where
+*   each JPEG frame lies in the file, without reading the frame itself, so
+*   late frames can be skipped for the price of a chunk header.
+*   - .avi: RIFF/AVI with an MJPEG video stream. Frames are the '##dc' /
+*     '##db' chunks of the 'movi' list ('rec ' lists are entered, audio,
+*     JUNK and index chunks skipped). The frame period comes from 'avih'.
+*   - .mjpg / .mjpeg: JPEG files back to back. Frames run from SOI (FFD8)
+*     to EOI (FFD9); frames carrying an embedded thumbnail are not
+*     supported. There is no timing in the file: MJPEG_CLIP_DEFAULT_FPS.
+*   Without ARDUINO this compiles against the stdio-backed SD_READER.
+******************************************************************************/
+#ifndef __MJPEG_CLIP_H
+#define __MJPEG_CLIP_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define MJPEG_CLIP_DEFAULT_FPS 15
+#define MJPEG_CLIP_SCAN_BLOCK  512    // Bytes examined per read while looking for markers
+
+typedef enum {
+    CLIP_MJPG = 0,
+    CLIP_AVI,
+} CLIP_FORMAT;
+
+typedef struct {
+    SD_READER *Reader;
+    uint8_t Format;         // CLIP_FORMAT
+    uint32_t FirstFrame;    // File offset where the frame walk starts
+    uint32_t End;           // End of the frame data ('movi' list or file)
+    uint32_t Next;          // Where the next frame search starts
+    uint32_t FrameMicros;   // Frame period
+    uint32_t Width;         // From 'avih'; 0 for .mjpg
+    uint32_t Height;
+    uint32_t FrameIndex;    // Frames returned since the last rewind
+} MJPEG_CLIP;
+
+bool MJPEGClip_Open(MJPEG_CLIP *clip, SD_READER *reader, const char *path);
+bool MJPEGClip_NextFrame(MJPEG_CLIP *clip, uint32_t *offset, uint32_t *length);
+void MJPEGClip_Rewind(MJPEG_CLIP *clip);
+void MJPEGClip_Close(MJPEG_CLIP *clip);
+bool MJPEGClip_IsClipFile(const char *path);
+
+#endif
@@ -0,0 +1,276 @@
+/*****************************************************************************
+* | File        :   MJPEG_Player.cpp
+* | Function    :   Paced MJPEG clip playback through the frame pipeline
+******************************************************************************/
+#include "MJPEG_Player.h"
+#include "MJPEG_Clip.h"
+#include "Frame_Transform.h"
+#include "Frame_Pipeline.h"
+#include "LCD_Driver.h"
+#include "Stage_Profiler.h"
+#include "Heap_Telemetry.h"
+#include <Arduino.h>
+#include <JPEGDEC.h>
+#include <string.h>
+#include <stdlib.h>
+#include <new>
+
+// The decoder carries its Huffman tables and MCU buffers; keep it off the stack
+static JPEGDEC *jpeg = NULL;
+static MJPEG_CLIP clip;
+static bool playing = false;
+static int clipImage = -1;          // Pipeline image id the clip's frames carry
+
+static uint8_t *frameData = NULL;   // One compressed frame, grown as needed
+static uint32_t frameCapacity = 0;
+static FRAME_TRANSFORM transform;
+static int decodedWidth = -1;       // Source size the transform was built for
+static int decodedHeight = -1;
+static int scaleFlag = 0;
+static uint16_t *targetFrame = NULL;
+
+static uint32_t nextDueUs = 0;
+static MJPEG_STATS stats;
+static const char *lastError = "";
+
+static int jpegDraw(JPEGDRAW *draw)
+{
+    Transform_PutBlock(&transform, targetFrame, draw->x, draw->y, draw->iWidth, draw->iHeight,
+                       draw->pPixels, draw->iWidth);
+    return 1;
+}
+
+// Same choice as the still-image JPEG path: the largest DCT scale-down that
+// still leaves at least one source pixel per display pixel
+static void chooseScale(int width, int height)
+{
+    float scaleX = (float)LCD_WIDTH / height;
+    float scaleY = (float)LCD_HEIGHT / width;
+    float scale = scaleX < scaleY ? scaleX : scaleY;
+    int divisor = 1;
+
+    scaleFlag = 0;
+    if (scale <= 0.125f) {
+        scaleFlag = JPEG_SCALE_EIGHTH;
+        divisor = 8;
+    } else if (scale <= 0.25f) {
+        scaleFlag = JPEG_SCALE_QUARTER;
+        divisor = 4;
+    } else if (scale <= 0.5f) {
+        scaleFlag = JPEG_SCALE_HALF;
+        divisor = 2;
+    }
+    Transform_Init(&transform, width / divisor, height / divisor);
+    decodedWidth = width;
+    decodedHeight = height;
+}
+
+// Next frame of the clip, wrapping around at the end
+static bool nextFrame(uint32_t *offset, uint32_t *length)
+{
+    if (MJPEGClip_NextFrame(&clip, offset, length)) {
+        return true;
+    }
+    if (clip.FrameIndex == 0) {
+        return false; // Not a single frame in the clip
+    }
+    MJPEGClip_Rewind(&clip);
+    stats.Loops++;
+    return MJPEGClip_NextFrame(&clip, offset, length);
+}
+
+static bool readFrame(uint32_t offset, uint32_t length)
+{
+    if (length > MJPEG_MAX_FRAME_BYTES) {
+        return false;
+    }
+    if (length > frameCapacity) {
+        Heap_Free(frameData);
+        frameData = (uint8_t *)Heap_Alloc(HEAP_DECODER, length, HEAP_CAP_DEFAULT);
+        frameCapacity = frameData != NULL ? length : 0;
+        if (frameData == NULL) {
+            return false;
+        }
+    }
+    return SDReader_Seek(clip.Reader, offset) &&
+           SDReader_Read(clip.Reader, frameData, length) == (int32_t)length;
+}
+
+static bool decodeFrame(uint32_t length, uint16_t *frame)
+{
+    if (!jpeg->openRAM(frameData, length, jpegDraw)) {
+        return false;
+    }
+    if (jpeg->getWidth() != decodedWidth || jpeg->getHeight() != decodedHeight) {
+        chooseScale(jpeg->getWidth(), jpeg->getHeight());
+    }
+    if (transform.FinalWidth < LCD_WIDTH || transform.FinalHeight < LCD_HEIGHT) {
+        memset(frame, 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t)); // Letterbox bars
+    }
+    targetFrame = frame;
+    jpeg->setPixelType(RGB565_LITTLE_ENDIAN);
+    bool ok = jpeg->decode(0, 0, scaleFlag) != 0;
+    jpeg->close();
+    return ok;
+}
+
+/******************************************************************************
+function: Open a clip and schedule its first frame
+info:
+    image is the id the clip's frames carry in the pipeline, so a redraw of
+    the same image just presents the front frame again.
+******************************************************************************/
+bool MJPEG_Start(SD_READER *reader, const char *path, int image)
+{
+    MJPEG_Stop();
+    if (jpeg == NULL) {
+        void *mem = Heap_Alloc(HEAP_DECODER, sizeof(JPEGDEC), HEAP_CAP_DEFAULT);
+        jpeg = mem != NULL ? new (mem) JPEGDEC() : NULL;
+        if (jpeg == NULL) {
+            lastError = "out of memory for decoder";
+            return false;
+        }
+    }
+
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    bool opened = MJPEGClip_Open(&clip, reader, path);
+    Bus_Release(BUS_SD);
+    if (!opened) {
+        lastError = "not an MJPEG AVI or concatenated JPEG clip";
+        return false;
+    }
+
+    memset(&stats, 0, sizeof(stats));
+    stats.StartMs = millis();
+    nextDueUs = micros();
+    decodedWidth = -1;
+    decodedHeight = -1;
+    clipImage = image;
+    playing = true;
+    return true;
+}
+
+void MJPEG_Stop(void)
+{
+    if (!playing) {
+        return;
+    }
+    playing = false;
+    Pipeline_Invalidate();
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    MJPEGClip_Close(&clip);
+    Bus_Release(BUS_SD);
+    MJPEG_PrintStats();
+}
+
+bool MJPEG_IsPlaying(void)
+{
+    return playing;
+}
+
+// When the next frame is due, for callers that sleep until then
+bool MJPEG_NextDeadline(uint32_t *dueUs)
+{
+    *dueUs = nextDueUs;
+    return playing;
+}
+
+/******************************************************************************
+function: Decode and present the next frame once it is due
+info:
+    Deadlines advance by exactly one frame period per frame, shown or
+    skipped, so decode time never accumulates into drift. Frames that are
+    already late are stepped over using only their container headers.
+******************************************************************************/
+void MJPEG_Service(uint32_t nowUs)
+{
+    if (!playing || (int32_t)(nowUs - nextDueUs) < 0) {
+        return;
+    }
+
+    uint32_t late = (nowUs - nextDueUs) / clip.FrameMicros;
+    if (late > MJPEG_RESYNC_FRAMES) {
+        nextDueUs = nowUs; // Stalled (card, overlay): restart the clock rather than race
+        late = 0;
+    }
+
+    uint32_t offset = 0, length = 0;
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    uint32_t t0 = micros();
+    bool found = nextFrame(&offset, &length);
+    while (found && late > 0) {
+        stats.Dropped++;
+        nextDueUs += clip.FrameMicros;
+        late--;
+        found = nextFrame(&offset, &length);
+    }
+    bool ok = found && readFrame(offset, length);
+    uint32_t t1 = micros();
+    Pipeline_Trace(STAGE_DECODE, BUS_SD, clipImage, t0, t1);
+    Bus_Release(BUS_SD);
+    stats.ReadMicros += t1 - t0;
+
+    if (!found) {
+        lastError = "clip has no readable frames";
+        MJPEG_Stop();
+        return;
+    }
+    nextDueUs += clip.FrameMicros;
+    if (!ok) {
+        stats.Errors++;
+        return;
+    }
+
+    // Decode into the back frame while the present task may still push the front one
+    Pipeline_SetBackImage(-1);
+    {
+        PROFILE_SCOPE(PROF_DECODE);
+        ok = decodeFrame(length, Pipeline_BackFrame());
+    }
+    PROFILE_FLUSH(clipImage);
+    stats.DecodeMicros += micros() - t1;
+    if (!ok) {
+        stats.Errors++;
+        return;
+    }
+    Pipeline_SetBackImage(clipImage);
+    Pipeline_Swap();
+    Pipeline_PresentFront();
+    stats.Frames++;
+}
+
+// Present the last decoded frame again, e.g. after an overlay covered it
+void MJPEG_Redraw(void)
+{
+    if (playing && Pipeline_FrontImage() == clipImage) {
+        Pipeline_PresentFront();
+    }
+}
+
+/******************************************************************************
+function: Playback statistics
+******************************************************************************/
+void MJPEG_GetStats(MJPEG_STATS *out)
+{
+    *out = stats;
+}
+
+void MJPEG_PrintStats(void)
+{
+    uint32_t elapsed = millis() - stats.StartMs;
+    float achieved = elapsed > 0 ? stats.Frames * 1000.0f / elapsed : 0.0f;
+    float target = clip.FrameMicros > 0 ? 1000000.0f / clip.FrameMicros : 0.0f;
+    uint32_t attempts = stats.Frames + stats.Errors;
+    Serial.printf("🎬 Clip: %u frames, %u dropped, %u errors, %u loops, %.1f/%.1f fps\n",
+                  (unsigned)stats.Frames, (unsigned)stats.Dropped, (unsigned)stats.Errors,
+                  (unsigned)stats.Loops, achieved, target);
+    if (attempts > 0) {
+        Serial.printf("🎬 Clip: read %u us/frame, decode %u us/frame\n",
+                      (unsigned)(stats.ReadMicros / attempts), (unsigned)(stats.DecodeMicros / attempts));
+    }
+}
+
+const char *MJPEG_LastError(void)
+{
+    return lastError;
+}
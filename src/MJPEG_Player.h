@@ -0,0 +1,42 @@
+/*****************************************************************************
+* | File        :   MJPEG_Player.h
+* | Function    :   Paced MJPEG clip playback through the frame pipeline
+* | Info        :
+*   Frames found by MJPEG_Clip are read whole into RAM and decoded by
+*   JPEGDEC at the largest 1/2, 1/4 or 1/8 scale that still covers the
+*   display, then fitted and rotated block by block into the pipeline's
+*   back frame. The present task pushes frame N while frame N+1 decodes.
+*   Frames are due on absolute deadlines from the clip's frame period.
+*   When playback falls behind, frames whose slot has already passed are
+*   skipped before they are read or decoded, so the clip keeps its pace.
+******************************************************************************/
+#ifndef __MJPEG_PLAYER_H
+#define __MJPEG_PLAYER_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define MJPEG_MAX_FRAME_BYTES (256 * 1024) // Largest compressed frame accepted
+#define MJPEG_RESYNC_FRAMES   30           // Further behind than this: restart the clock
+
+typedef struct {
+    uint32_t Frames;        // Frames decoded and presented
+    uint32_t Dropped;       // Frames skipped to hold the frame rate
+    uint32_t Errors;        // Frames that failed to read or decode
+    uint32_t Loops;
+    uint32_t ReadMicros;
+    uint32_t DecodeMicros;
+    uint32_t StartMs;
+} MJPEG_STATS;
+
+bool MJPEG_Start(SD_READER *reader, const char *path, int image);
+void MJPEG_Stop(void);
+bool MJPEG_IsPlaying(void);
+bool MJPEG_NextDeadline(uint32_t *dueUs);
+void MJPEG_Service(uint32_t nowUs);
+void MJPEG_Redraw(void);
+void MJPEG_GetStats(MJPEG_STATS *stats);
+void MJPEG_PrintStats(void);
+const char *MJPEG_LastError(void);
+
+#endif
@@ -0,0 +1,483 @@
+/*****************************************************************************
+* | File        :   PNG_Adam7.cpp
+* | Function    :   Progressive decoding of interlaced (Adam7) PNGs
+******************************************************************************/
+#include "PNG_Adam7.h"
+#include "Frame_Transform.h"
+#include "Heap_Telemetry.h"
+#include <string.h>
+#include <zlib.h>
+
+#define MAX_ROW_BYTES   (PNG_LOADER_MAX_WIDTH * 8)  // RGBA at 16 bits per sample
+#define ROW_SIZE        (MAX_ROW_BYTES + 1)         // Filter byte, then the row
+#define INPUT_SIZE      512
+#define ALLOC_ALIGN     8
+
+enum {
+    COLOR_GRAY = 0,
+    COLOR_RGB = 2,
+    COLOR_PALETTE = 3,
+    COLOR_GRAY_ALPHA = 4,
+    COLOR_RGBA = 6,
+};
+
+static const uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+// Adam7 passes: first column and row, then the step between them
+static const uint8_t PASS_X0[ADAM7_PASSES] = {0, 4, 0, 2, 0, 1, 0};
+static const uint8_t PASS_Y0[ADAM7_PASSES] = {0, 0, 4, 0, 2, 0, 1};
+static const uint8_t PASS_DX[ADAM7_PASSES] = {8, 8, 4, 4, 2, 2, 1};
+static const uint8_t PASS_DY[ADAM7_PASSES] = {8, 8, 8, 4, 4, 2, 2};
+
+// Image
+static uint32_t width = 0;
+static uint32_t height = 0;
+static uint8_t depth = 0;
+static uint8_t colorType = 0;
+static uint8_t channels = 0;
+static uint8_t palette[256 * 3];
+static uint16_t paletteSize = 0;
+static uint8_t alpha[256];          // tRNS for palette images
+static uint16_t alphaCount = 0;
+static uint16_t key[3];             // tRNS for gray and RGB images
+static bool hasKey = false;
+
+// Compressed input, read across IDAT chunks
+static SD_READER *reader = NULL;
+static uint8_t input[INPUT_SIZE];
+static uint32_t chunkLeft = 0;
+
+// Workspace: two pass rows, then an arena for zlib's state and window
+static uint8_t *workspace = NULL;
+static uint32_t arenaUsed = 0;
+static z_stream stream;
+
+// Inflated output, one pass row at a time
+static uint8_t *curRow = NULL;
+static uint8_t *prevRow = NULL;
+static uint32_t rowFill = 0;
+static uint32_t rowBytes = 0;
+static uint32_t pixelBytes = 0;     // Filter distance, at least 1
+static int pass = 0;
+static uint32_t passWidth = 0;
+static uint32_t passHeight = 0;
+static uint32_t passRow = 0;
+static bool done = false;
+
+static FRAME_TRANSFORM transform;
+static uint16_t *targetFrame = NULL;
+static uint16_t *targetLine = NULL;
+static PNG_PREVIEW previewFrame = NULL;
+static const char *lastError = "";
+
+static uint32_t be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static bool readChunkHeader(uint32_t *length, uint8_t type[4])
+{
+    uint8_t header[8];
+    if (SDReader_Read(reader, header, sizeof(header)) != (int32_t)sizeof(header)) {
+        return false;
+    }
+    *length = be32(header);
+    memcpy(type, header + 4, 4);
+    return true;
+}
+
+static bool skip(uint32_t bytes)
+{
+    return SDReader_Seek(reader, SDReader_Position(reader) + bytes);
+}
+
+/******************************************************************************
+function: Read the chunks before the image data
+info:
+    IHDR, PLTE and tRNS are kept, anything else is skipped. Leaves the
+    reader at the first IDAT byte with chunkLeft set to its length.
+******************************************************************************/
+static bool readHeader(void)
+{
+    uint8_t buffer[sizeof(palette)];
+    uint8_t type[4];
+    uint32_t length;
+
+    if (SDReader_Read(reader, buffer, 8) != 8 || memcmp(buffer, SIGNATURE, 8) != 0 ||
+        !readChunkHeader(&length, type) || memcmp(type, "IHDR", 4) != 0 || length != 13 ||
+        SDReader_Read(reader, buffer, 13) != 13 || !skip(4)) {
+        lastError = "not a PNG or unreadable";
+        return false;
+    }
+    width = be32(buffer);
+    height = be32(buffer + 4);
+    depth = buffer[8];
+    colorType = buffer[9];
+    bool depthOk;
+    switch (colorType) {
+    case COLOR_GRAY:       channels = 1; depthOk = depth == 1 || depth == 2 || depth == 4 || depth == 8 || depth == 16; break;
+    case COLOR_RGB:        channels = 3; depthOk = depth == 8 || depth == 16; break;
+    case COLOR_PALETTE:    channels = 1; depthOk = depth == 1 || depth == 2 || depth == 4 || depth == 8; break;
+    case COLOR_GRAY_ALPHA: channels = 2; depthOk = depth == 8 || depth == 16; break;
+    case COLOR_RGBA:       channels = 4; depthOk = depth == 8 || depth == 16; break;
+    default:               depthOk = false; break;
+    }
+    if (!depthOk || buffer[10] != 0 || buffer[11] != 0 || buffer[12] != 1) {
+        lastError = "unsupported PNG header";
+        return false;
+    }
+    if (width == 0 || height == 0 || width > PNG_LOADER_MAX_WIDTH) {
+        lastError = "image wider than PNG_LOADER_MAX_WIDTH";
+        return false;
+    }
+
+    paletteSize = 0;
+    alphaCount = 0;
+    hasKey = false;
+    while (readChunkHeader(&length, type)) {
+        if (memcmp(type, "IDAT", 4) == 0) {
+            chunkLeft = length;
+            return true;
+        }
+        if (memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        bool keep = (memcmp(type, "PLTE", 4) == 0 && length % 3 == 0 && length <= sizeof(palette)) ||
+                    (memcmp(type, "tRNS", 4) == 0 && length <= sizeof(alpha));
+        if (keep) {
+            if (SDReader_Read(reader, buffer, length) != (int32_t)length || !skip(4)) {
+                break;
+            }
+            if (type[0] == 'P') {
+                memcpy(palette, buffer, length);
+                paletteSize = length / 3;
+            } else if (colorType == COLOR_PALETTE) {
+                memcpy(alpha, buffer, length);
+                alphaCount = length;
+            } else if (length >= (uint32_t)channels * 2 && (colorType == COLOR_GRAY || colorType == COLOR_RGB)) {
+                for (int i = 0; i < channels; i++) {
+                    key[i] = (buffer[2 * i] << 8) | buffer[2 * i + 1];
+                }
+                hasKey = true;
+            }
+        } else if (!skip(length + 4)) {
+            break;
+        }
+    }
+    lastError = "no image data";
+    return false;
+}
+
+// Fill input[] from the IDAT chunks, read back to back with their CRCs skipped
+static int32_t readData(void)
+{
+    while (chunkLeft == 0) {
+        uint32_t length;
+        uint8_t type[4];
+        if (!skip(4) || !readChunkHeader(&length, type) || memcmp(type, "IDAT", 4) != 0) {
+            return 0;
+        }
+        chunkLeft = length;
+    }
+    int32_t got = SDReader_Read(reader, input, chunkLeft < INPUT_SIZE ? chunkLeft : INPUT_SIZE);
+    if (got > 0) {
+        chunkLeft -= got;
+    }
+    return got;
+}
+
+/******************************************************************************
+function: zlib allocations from the kept workspace
+info:
+    inflate asks for its state and its window once per file; both come out
+    of the arena, which is simply rewound for the next file.
+******************************************************************************/
+static voidpf arenaAlloc(voidpf opaque, uInt items, uInt size)
+{
+    (void)opaque;
+    uint32_t bytes = ((uint32_t)items * size + ALLOC_ALIGN - 1) / ALLOC_ALIGN * ALLOC_ALIGN;
+    if (arenaUsed + bytes > ADAM7_INFLATE_MEMORY) {
+        return Z_NULL;
+    }
+    voidpf p = workspace + 2 * ROW_SIZE + arenaUsed;
+    arenaUsed += bytes;
+    return p;
+}
+
+static void arenaFree(voidpf opaque, voidpf address)
+{
+    (void)opaque;
+    (void)address;
+}
+
+/******************************************************************************
+function: Pixel x of the current pass row as RGB565, alpha over black
+******************************************************************************/
+static uint16_t sample(const uint8_t *row, uint32_t index)
+{
+    if (depth == 16) {
+        return (row[2 * index] << 8) | row[2 * index + 1];
+    }
+    if (depth == 8) {
+        return row[index];
+    }
+    uint32_t bit = index * depth;
+    return (row[bit >> 3] >> (8 - depth - (bit & 7))) & ((1 << depth) - 1);
+}
+
+static uint8_t to8(uint16_t value)
+{
+    return depth == 16 ? value >> 8 : depth == 8 ? value : value * 255 / ((1 << depth) - 1);
+}
+
+static uint16_t pixelAt(const uint8_t *row, uint32_t x)
+{
+    uint32_t s = x * channels;
+    uint8_t r = 0, g = 0, b = 0, a = 255;
+
+    switch (colorType) {
+    case COLOR_GRAY: {
+        uint16_t v = sample(row, s);
+        r = g = b = to8(v);
+        a = hasKey && v == key[0] ? 0 : 255;
+        break;
+    }
+    case COLOR_RGB: {
+        uint16_t vr = sample(row, s), vg = sample(row, s + 1), vb = sample(row, s + 2);
+        r = to8(vr);
+        g = to8(vg);
+        b = to8(vb);
+        a = hasKey && vr == key[0] && vg == key[1] && vb == key[2] ? 0 : 255;
+        break;
+    }
+    case COLOR_PALETTE: {
+        uint16_t v = sample(row, s);
+        if (v < paletteSize) {
+            r = palette[3 * v];
+            g = palette[3 * v + 1];
+            b = palette[3 * v + 2];
+            a = v < alphaCount ? alpha[v] : 255;
+        }
+        break;
+    }
+    case COLOR_GRAY_ALPHA:
+        r = g = b = to8(sample(row, s));
+        a = to8(sample(row, s + 1));
+        break;
+    case COLOR_RGBA:
+        r = to8(sample(row, s));
+        g = to8(sample(row, s + 1));
+        b = to8(sample(row, s + 2));
+        a = to8(sample(row, s + 3));
+        break;
+    }
+    if (a != 255) {
+        r = (r * a + 127) / 255;
+        g = (g * a + 127) / 255;
+        b = (b * a + 127) / 255;
+    }
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+static uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+    int p = a + b - c;
+    int pa = p > a ? p - a : a - p;
+    int pb = p > b ? p - b : b - p;
+    int pc = p > c ? p - c : c - p;
+    return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+// Pass dimensions; passes with no pixels have no rows in the data either
+static void beginPass(int index)
+{
+    pass = index;
+    passWidth = width > PASS_X0[pass] ? (width - PASS_X0[pass] + PASS_DX[pass] - 1) / PASS_DX[pass] : 0;
+    passHeight = height > PASS_Y0[pass] ? (height - PASS_Y0[pass] + PASS_DY[pass] - 1) / PASS_DY[pass] : 0;
+    if (passWidth == 0) {
+        passHeight = 0;
+    }
+    rowBytes = (passWidth * channels * depth + 7) / 8;
+    passRow = 0;
+    rowFill = 0;
+    memset(prevRow, 0, ROW_SIZE);   // The first row of each pass filters against zeros
+}
+
+// Move on to the next pass that has rows, or finish
+static void nextPass(void)
+{
+    for (int next = pass + 1; next < ADAM7_PASSES; next++) {
+        beginPass(next);
+        if (passHeight > 0) {
+            return;
+        }
+    }
+    done = true;
+}
+
+/******************************************************************************
+function: Unfilter a complete pass row and place its pixels
+info:
+    With a preview to show, pass 1 pixels are spread over their 8x8
+    blocks; every later pass, and pass 1 without a preview, writes only
+    the display pixels that sample its own columns, so the finished frame
+    is exactly the non-interlaced decode.
+******************************************************************************/
+static bool finishRow(void)
+{
+    uint8_t *cur = curRow + 1;
+    const uint8_t *up = prevRow + 1;
+
+    for (uint32_t i = 0; i < rowBytes; i++) {
+        uint8_t left = i >= pixelBytes ? cur[i - pixelBytes] : 0;
+        uint8_t upLeft = i >= pixelBytes ? up[i - pixelBytes] : 0;
+        switch (curRow[0]) {
+        case 0: break;
+        case 1: cur[i] += left; break;
+        case 2: cur[i] += up[i]; break;
+        case 3: cur[i] += (left + up[i]) >> 1; break;
+        case 4: cur[i] += paeth(left, up[i], upLeft); break;
+        default:
+            lastError = "bad filter type";
+            return false;
+        }
+    }
+
+    uint32_t y = PASS_Y0[pass] + passRow * PASS_DY[pass];
+    if (pass == 0 && previewFrame != NULL) {
+        for (uint32_t x = 0; x < passWidth; x++) {
+            uint16_t pixel = pixelAt(cur, x);
+            uint32_t end = (x + 1) * ADAM7_SCALE < width ? (x + 1) * ADAM7_SCALE : width;
+            for (uint32_t dx = x * ADAM7_SCALE; dx < end; dx++) {
+                targetLine[dx] = pixel;
+            }
+        }
+        uint32_t end = y + ADAM7_SCALE < height ? y + ADAM7_SCALE : height;
+        for (uint32_t by = y; by < end; by++) {
+            if (Transform_RowUsed(&transform, by)) {
+                Transform_PutRow(&transform, targetFrame, by, targetLine);
+            }
+        }
+    } else if (Transform_RowUsed(&transform, y)) {
+        for (uint32_t x = 0; x < passWidth; x++) {
+            targetLine[x] = pixelAt(cur, x);
+        }
+        Transform_PutSpaced(&transform, targetFrame, y, targetLine, PASS_X0[pass], PASS_DX[pass]);
+    }
+
+    uint8_t *t = prevRow;
+    prevRow = curRow;
+    curRow = t;
+    if (++passRow < passHeight) {
+        return true;
+    }
+    if (pass == 0 && previewFrame != NULL) {
+        previewFrame(targetFrame);
+    }
+    nextPass();
+    return true;
+}
+
+/******************************************************************************
+function: Inflate the zlib stream pass row by pass row until pass 7 is placed
+******************************************************************************/
+static bool inflatePasses(void)
+{
+    stream.next_in = input;
+    stream.avail_in = 0;
+    while (!done) {
+        if (stream.avail_in == 0) {
+            int32_t got = readData();
+            if (got <= 0) {
+                lastError = "truncated image data";
+                return false;
+            }
+            stream.next_in = input;
+            stream.avail_in = got;
+        }
+        stream.next_out = curRow + rowFill;
+        stream.avail_out = rowBytes + 1 - rowFill;
+        int result = inflate(&stream, Z_NO_FLUSH);
+        rowFill = rowBytes + 1 - stream.avail_out;
+        if (rowFill == rowBytes + 1) {
+            rowFill = 0;
+            if (!finishRow()) {
+                return false;
+            }
+        }
+        if (result == Z_STREAM_END && !done) {
+            lastError = "image data ends before the last pass";
+            return false;
+        }
+        if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR) {
+            lastError = stream.msg != NULL ? stream.msg : "corrupt image data";
+            return false;
+        }
+    }
+    return true;
+}
+
+/******************************************************************************
+function: Decode an interlaced PNG into a 135x240 display frame
+parameter:
+    line    : PNG_LOADER_MAX_WIDTH pixels of scratch for one image row
+    preview : called with the frame once pass 1 is in it, or NULL
+******************************************************************************/
+bool Adam7_DecodeToFrame(SD_READER *source, const char *path, uint16_t *frame, uint16_t *line, PNG_PREVIEW preview)
+{
+    lastError = "";
+    if (workspace == NULL) {
+        workspace = (uint8_t *)Heap_Alloc(HEAP_DECODER, 2 * ROW_SIZE + ADAM7_INFLATE_MEMORY, HEAP_CAP_DEFAULT);
+        if (workspace == NULL) {
+            lastError = "out of memory for the inflate workspace";
+            return false;
+        }
+    }
+    reader = source;
+    if (!SDReader_Open(reader, path)) {
+        lastError = "not a PNG or unreadable";
+        return false;
+    }
+    if (!readHeader()) {
+        SDReader_Close(reader);
+        return false;
+    }
+
+    arenaUsed = 0;
+    memset(&stream, 0, sizeof(stream));
+    stream.zalloc = arenaAlloc;
+    stream.zfree = arenaFree;
+    if (inflateInit(&stream) != Z_OK) {
+        lastError = "out of memory for the inflate window";
+        SDReader_Close(reader);
+        return false;
+    }
+
+    curRow = workspace;
+    prevRow = workspace + ROW_SIZE;
+    pixelBytes = channels * depth >= 8 ? channels * depth / 8 : 1;
+    done = false;
+    beginPass(0);
+    targetFrame = frame;
+    targetLine = line;
+    previewFrame = preview;
+    Transform_Init(&transform, width, height);
+    memset(frame, 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+
+    bool ok = inflatePasses();
+    inflateEnd(&stream);
+    SDReader_Close(reader);
+    return ok;
+}
+
+const char *Adam7_LastError(void)
+{
+    return lastError;
+}
+
+// Static scratch, plus the workspace once an interlaced file has needed it
+uint32_t Adam7_WorkingMemory(void)
+{
+    return (workspace != NULL ? 2 * ROW_SIZE + ADAM7_INFLATE_MEMORY : 0) + sizeof(input) + sizeof(stream) +
+           sizeof(palette) + sizeof(alpha);
+}
@@ -0,0 +1,34 @@
+/*****************************************************************************
+* | File        :   PNG_Adam7.h
+* | Function    :   Progressive decoding of interlaced (Adam7) PNGs
+* | Info        :
+*   PNGdec does not deinterlace, so interlaced files are decoded here from
+*   the same SD_READER. The first of Adam7's seven passes is a whole
+*   1/8-scale image at the very start of the data: with a preview callback
+*   each of its pixels becomes an 8x8 block and the frame is handed out
+*   once the pass is in. Passes 2-7 then fill in the rest, each pass pixel
+*   placed at its own position through Frame_Transform, so the finished
+*   frame matches a non-interlaced decode.
+*   Inflate is the zlib bundled with PNGdec. Its state and 32 KB window,
+*   and the two pass row buffers, come from one HEAP_DECODER workspace
+*   taken on the first interlaced file and kept. Pass rows are converted
+*   like PNG_Loader's: palette, grayscale and 16-bit samples to RGB565,
+*   alpha and tRNS over black.
+******************************************************************************/
+#ifndef __PNG_ADAM7_H
+#define __PNG_ADAM7_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+#include "PNG_Loader.h"
+
+#define ADAM7_PASSES          7
+#define ADAM7_SCALE           8     // Pass 1 keeps every 8th row and column
+#define ADAM7_WINDOW_SIZE     32768 // Deflate's largest match distance
+#define ADAM7_INFLATE_MEMORY  (ADAM7_WINDOW_SIZE + 8192)    // Window plus inflate's state
+
+bool Adam7_DecodeToFrame(SD_READER *reader, const char *path, uint16_t *frame, uint16_t *line, PNG_PREVIEW preview);
+const char *Adam7_LastError(void);
+uint32_t Adam7_WorkingMemory(void);
+
+#endif
@@ -0,0 +1,130 @@
+/*****************************************************************************
+* | File        :   PNG_Loader.cpp
+* | Function    :   Bounded-memory streaming PNG loader (PNGdec)
+******************************************************************************/
+#include "PNG_Loader.h"
+#include "PNG_Adam7.h"
+#include "Frame_Transform.h"
+#include "Heap_Telemetry.h"
+#include <PNGdec.h>
+#include <string.h>
+#include <new>
+
+// The decoder carries its inflate window and line buffers; keep it off the stack
+static PNG *png = NULL;
+static SD_READER *activeReader = NULL;
+static FRAME_TRANSFORM transform;
+static uint16_t line[PNG_LOADER_MAX_WIDTH];
+static uint16_t *targetFrame = NULL;
+static PNG_PREVIEW preview = NULL;
+static const char *lastError = "";
+
+/******************************************************************************
+function: PNGdec file callbacks backed by the SD reader
+******************************************************************************/
+static void *pngOpen(const char *path, int32_t *size)
+{
+    if (!SDReader_Open(activeReader, path)) {
+        return NULL;
+    }
+    *size = SDReader_Size(activeReader);
+    return activeReader;
+}
+
+static void pngClose(void *handle)
+{
+    SDReader_Close((SD_READER *)handle);
+}
+
+static int32_t pngRead(PNGFILE *file, uint8_t *buffer, int32_t length)
+{
+    SD_READER *reader = (SD_READER *)file->fHandle;
+    int32_t got = SDReader_Read(reader, buffer, length);
+    file->iPos = SDReader_Position(reader);
+    return got;
+}
+
+static int32_t pngSeek(PNGFILE *file, int32_t position)
+{
+    SD_READER *reader = (SD_READER *)file->fHandle;
+    if (!SDReader_Seek(reader, position)) {
+        return -1;
+    }
+    file->iPos = position;
+    return position;
+}
+
+// One inflated scanline: convert (alpha over black) and place it in the frame
+static int pngDraw(PNGDRAW *draw)
+{
+    if (Transform_RowUsed(&transform, draw->y)) {
+        png->getLineAsRGB565(draw, line, PNG_RGB565_LITTLE_ENDIAN, 0x00000000);
+        Transform_PutRow(&transform, targetFrame, draw->y, line);
+    }
+    return 1;
+}
+
+/******************************************************************************
+function: Decode a PNG into a 135x240 display frame
+******************************************************************************/
+bool PNG_LoadToFrame(SD_READER *reader, const char *path, uint16_t *frame)
+{
+    if (png == NULL) {
+        void *mem = Heap_Alloc(HEAP_DECODER, sizeof(PNG), HEAP_CAP_DEFAULT);
+        png = mem != NULL ? new (mem) PNG() : NULL;
+        if (png == NULL) {
+            lastError = "out of memory for decoder";
+            return false;
+        }
+    }
+    activeReader = reader;
+    targetFrame = frame;
+
+    if (png->open(path, pngOpen, pngClose, pngRead, pngSeek, pngDraw) != PNG_SUCCESS) {
+        lastError = "not a PNG or unreadable";
+        return false;
+    }
+
+    int width = png->getWidth();
+    int height = png->getHeight();
+    bool interlaced = png->isInterlaced();
+    bool fits = width > 0 && height > 0 && width <= PNG_LOADER_MAX_WIDTH;
+    bool ok = false;
+    if (!fits) {
+        lastError = "image wider than PNG_LOADER_MAX_WIDTH";
+    } else if (!interlaced) {
+        Transform_Init(&transform, width, height);
+        memset(frame, 0, LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t));
+        ok = png->decode(NULL, 0) == PNG_SUCCESS;
+        if (!ok) {
+            lastError = "decode failed (too wide for PNG_MAX_BUFFERED_PIXELS or corrupt)";
+        }
+    }
+    png->close();
+
+    // PNGdec does not deinterlace: decode the passes on their own
+    if (fits && interlaced) {
+        ok = Adam7_DecodeToFrame(reader, path, frame, line, preview);
+        if (!ok) {
+            lastError = Adam7_LastError();
+        }
+    }
+    return ok;
+}
+
+// Shown the coarse first pass of interlaced files; NULL for none
+void PNG_SetPreview(PNG_PREVIEW callback)
+{
+    preview = callback;
+}
+
+const char *PNG_LastError(void)
+{
+    return lastError;
+}
+
+// Decoder and line buffer, plus the Adam7 workspace once one has run
+uint32_t PNG_WorkingMemory(void)
+{
+    return sizeof(PNG) + sizeof(line) + Adam7_WorkingMemory();
+}
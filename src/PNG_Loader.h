@@ -0,0 +1,30 @@
+/*****************************************************************************
+* | File        :   PNG_Loader.h
+* | Function    :   Bounded-memory streaming PNG loader (PNGdec)
+* | Info        :
+*   PNGdec inflates one scanline at a time from the shared SD_READER; each
+*   line is converted to RGB565 (palette, grayscale, 16-bit and alpha over
+*   black are handled by the decoder) and placed straight into the display
+*   frame by Frame_Transform. No full-size image buffer is ever allocated.
+*   Working memory is capped at build time by PNG_MAX_BUFFERED_PIXELS
+*   (platformio.ini); wider images are rejected instead of allocating more.
+*   Interlaced files, which PNGdec cannot decode, are deinterlaced by
+*   PNG_Adam7; a preview callback set with PNG_SetPreview gets the frame
+*   once their coarse first pass is in, before the other six are decoded.
+******************************************************************************/
+#ifndef __PNG_LOADER_H
+#define __PNG_LOADER_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define PNG_LOADER_MAX_WIDTH 1024   // Widest image whose line buffer we keep
+
+typedef void (*PNG_PREVIEW)(const uint16_t *frame);
+
+bool PNG_LoadToFrame(SD_READER *reader, const char *path, uint16_t *frame);
+void PNG_SetPreview(PNG_PREVIEW preview);
+const char *PNG_LastError(void);
+uint32_t PNG_WorkingMemory(void);
+
+#endif
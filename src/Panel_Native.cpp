@@ -0,0 +1,126 @@
+/*****************************************************************************
+* | File        :   Panel_Native.cpp
+* | Function    :   Host entry point of the virtual panel (env:native)
+* | Info        :
+*   pio run -e native
+*   .pio/build/native/program -r card -o out /pics/a.bmp /pics/b.png /c.565
+*   Initialises the LCD through LCD_Driver on the DEV_Native backend, clears
+*   it, then draws each image the way the firmware does: panel-native BMP
+*   and .565 files streamed to the panel, other BMPs and PNGs decoded into
+*   a frame and drawn with GUI_Paint. Every step prints one JSON line with
+*   its SPI traffic and modelled bus time, and dumps the panel to
+*   <out>/<step>.png. Card paths are looked up under -r.
+*   Exits 1 if a load fails or the panel saw a timing violation, a stray
+*   byte or a pixel outside its window.
+*   Empty in firmware builds and under pio test, whose runner has its own
+*   main().
+******************************************************************************/
+#if !defined(ARDUINO) && !defined(PIO_UNIT_TESTING)
+#include "DEV_Config.h"
+#include "LCD_Driver.h"
+#include "GUI_Paint.h"
+#include "SD_Reader.h"
+#include "BMP_Loader.h"
+#include "Raw565_Loader.h"
+#include "PNG_Loader.h"
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+
+static SD_READER reader;
+static uint16_t frame[LCD_WIDTH * LCD_HEIGHT];
+static const char *outDir = ".";
+static bool clean = true;
+
+static void report(const char *step, bool ok)
+{
+    const NATIVE_STATS *stats = Native_Stats();
+    char png[512];
+    snprintf(png, sizeof(png), "%s/%s.png", outDir, step);
+    for (char *p = png + strlen(outDir) + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '_';
+        }
+    }
+    bool dumped = Native_DumpPNG(png, false);
+
+    printf("{\"step\":\"%s\",\"ok\":%s,\"bytes\":%llu,\"command_bytes\":%llu,\"transactions\":%u,"
+           "\"spi_calls\":%u,\"gpio_writes\":%u,\"pixels\":%llu,\"windows\":%u,\"bus_us\":%.1f,"
+           "\"violations\":%u,\"stray_bytes\":%u,\"overflows\":%u,\"png\":\"%s\"}\n",
+           step, ok ? "true" : "false", (unsigned long long)stats->Bytes,
+           (unsigned long long)stats->CommandBytes, (unsigned)stats->Transactions, (unsigned)stats->SpiCalls,
+           (unsigned)stats->GpioWrites, (unsigned long long)stats->Pixels, (unsigned)stats->Windows,
+           stats->BusNs / 1000.0, (unsigned)stats->Violations, (unsigned)stats->StrayBytes,
+           (unsigned)stats->Overflows, dumped ? png : "");
+    if (!ok || stats->Violations != 0 || stats->StrayBytes != 0 || stats->Overflows != 0) {
+        clean = false;
+    }
+    Native_ResetStats();
+}
+
+static bool hasExtension(const char *path, const char *ext)
+{
+    size_t len = strlen(path), n = strlen(ext);
+    return len > n && strcasecmp(path + len - n, ext) == 0;
+}
+
+// Same paths as main.cpp: stream what is panel-ready, decode the rest into a frame
+static bool drawImage(const char *path)
+{
+    bool ok = false;
+    if (hasExtension(path, ".png")) {
+        ok = PNG_LoadToFrame(&reader, path, frame);
+        if (ok) {
+            Paint_DrawImage(frame, 0, 0, LCD_WIDTH, LCD_HEIGHT);
+        }
+    } else if (SDReader_Open(&reader, path)) {
+        if (hasExtension(path, ".565")) {
+            RAW565_INFO info;
+            ok = Raw565_ReadHeader(&reader, &info) && Raw565_StreamToPanel(&reader, &info);
+        } else if (hasExtension(path, ".bmp")) {
+            BMP_INFO info;
+            if (BMP_ReadHeader(&reader, &info)) {
+                if (BMP_IsPanelNative(&info)) {
+                    ok = BMP_StreamToPanel(&reader, &info);
+                } else if (BMP_DecodeToFrame(&reader, &info, frame)) {
+                    Paint_DrawImage(frame, 0, 0, LCD_WIDTH, LCD_HEIGHT);
+                    ok = true;
+                }
+            }
+        }
+        SDReader_Close(&reader);
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: not drawn\n", path);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int first = 1;
+    for (; first + 1 < argc && argv[first][0] == '-'; first += 2) {
+        if (strcmp(argv[first], "-r") == 0) {
+            Native_SetStorageRoot(argv[first + 1]);
+        } else if (strcmp(argv[first], "-o") == 0) {
+            outDir = argv[first + 1];
+        }
+    }
+
+    Native_Reset();
+    LCD_Init();
+    LCD_SetBacklight(560);
+    Paint_NewImage(LCD_WIDTH, LCD_HEIGHT, ROTATE_0, WHITE);
+    report("init", true);
+
+    LCD_Clear(BLACK);
+    report("clear", true);
+
+    for (int i = first; i < argc; i++) {
+        bool ok = drawImage(argv[i]);
+        report(argv[i][0] == '/' ? argv[i] + 1 : argv[i], ok);
+    }
+    SDReader_Free(&reader);
+    return clean ? 0 : 1;
+}
+#endif
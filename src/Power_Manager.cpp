@@ -0,0 +1,149 @@
+/*****************************************************************************
+* | File        :   Power_Manager.cpp
+* | Function    :   Light sleep between deadlines, with residency statistics
+******************************************************************************/
+#include "Power_Manager.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#endif
+
+static POWER_STATS stats;
+
+void Power_Init(POWER_CONFIG *config)
+{
+    config->Enabled = true;
+    config->MinSleepMs = POWER_MIN_SLEEP_MS;
+    config->WakeMarginMs = POWER_WAKE_MARGIN_MS;
+    config->MaxSleepMs = POWER_MAX_SLEEP_MS;
+}
+
+/******************************************************************************
+function: Whether to light-sleep until the next deadline, and for how long
+info:
+    Checked in order of what makes sleeping wrong rather than merely not
+    worth it, so the skip counters say why the device stayed awake.
+    The sleep ends WakeMarginMs early so the deadline is met on time.
+******************************************************************************/
+POWER_DECISION Power_Decide(const POWER_CONFIG *config, const POWER_INPUT *input, uint32_t *sleepMs)
+{
+    *sleepMs = 0;
+    if (!config->Enabled) {
+        return POWER_SKIP_DISABLED;
+    }
+    if (input->Busy) {
+        return POWER_SKIP_BUSY;
+    }
+    if (input->UsbConnected) {
+        return POWER_SKIP_USB;
+    }
+    if (input->ButtonPressed) {
+        return POWER_SKIP_BUTTON;
+    }
+    if (!input->DisplayHoldable) {
+        return POWER_SKIP_DISPLAY;
+    }
+    uint32_t until = input->UntilNextMs < config->MaxSleepMs ? input->UntilNextMs : config->MaxSleepMs;
+    if (until < config->MinSleepMs + config->WakeMarginMs) {
+        return POWER_SKIP_SHORT;
+    }
+    *sleepMs = until - config->WakeMarginMs;
+    return POWER_SLEEP;
+}
+
+void Power_AccountActive(uint32_t activeUs)
+{
+    stats.ActiveUs += activeUs;
+}
+
+void Power_AccountSleep(uint32_t plannedMs, uint32_t sleptUs, POWER_WAKE wake)
+{
+    stats.Sleeps++;
+    stats.SleepUs += sleptUs;
+    if (wake < POWER_WAKE_COUNT) {
+        stats.Wakes[wake]++;
+    }
+    if (sleptUs + POWER_WAKE_MARGIN_MS * 1000 < plannedMs * 1000) {
+        stats.EarlyWakes++;
+    }
+}
+
+void Power_AccountSkip(POWER_DECISION decision)
+{
+    if (decision < POWER_DECISION_COUNT) {
+        stats.Skips[decision]++;
+    }
+}
+
+void Power_GetStats(POWER_STATS *out)
+{
+    *out = stats;
+}
+
+void Power_ResetStats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+const char *Power_DecisionName(POWER_DECISION decision)
+{
+    switch (decision) {
+    case POWER_SLEEP:         return "sleep";
+    case POWER_SKIP_DISABLED: return "disabled";
+    case POWER_SKIP_BUSY:     return "busy";
+    case POWER_SKIP_USB:      return "usb";
+    case POWER_SKIP_BUTTON:   return "button held";
+    case POWER_SKIP_DISPLAY:  return "backlight";
+    case POWER_SKIP_SHORT:    return "too short";
+    default:                  return "?";
+    }
+}
+
+const char *Power_WakeName(POWER_WAKE wake)
+{
+    switch (wake) {
+    case POWER_WAKE_TIMER:  return "timer";
+    case POWER_WAKE_BUTTON: return "button";
+    default:                return "other";
+    }
+}
+
+#ifdef ARDUINO
+/******************************************************************************
+function: Light-sleep for up to sleepMs, or until wakePin goes low
+info:
+    GPIO wakeup is level-triggered, so for the duration of the sleep the
+    pin's edge interrupt is swapped for a low-level wake source and put
+    back afterwards. A press that woke the chip has no edge in the button
+    queue; the caller compares the pin with its settled level.
+    esp_timer (millis/micros) is corrected for the time asleep.
+******************************************************************************/
+POWER_WAKE Power_LightSleep(uint32_t sleepMs, int wakePin, uint32_t *sleptUs)
+{
+    gpio_num_t pin = (gpio_num_t)wakePin;
+
+    gpio_intr_disable(pin);
+    gpio_wakeup_enable(pin, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleepMs * 1000);
+
+    uint32_t start = micros();
+    esp_light_sleep_start();
+    *sleptUs = micros() - start;
+
+    esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+    gpio_wakeup_disable(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+    gpio_intr_enable(pin);
+
+    switch (cause) {
+    case ESP_SLEEP_WAKEUP_TIMER: return POWER_WAKE_TIMER;
+    case ESP_SLEEP_WAKEUP_GPIO:  return POWER_WAKE_BUTTON;
+    default:                     return POWER_WAKE_OTHER;
+    }
+}
+#endif
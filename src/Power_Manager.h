@@ -0,0 +1,79 @@
+/*****************************************************************************
+* | File        :   Power_Manager.h
+* | Function    :   Light sleep between deadlines, with residency statistics
+* | Info        :
+*   When loop() has nothing to do until its next deadline (slide advance,
+*   heartbeat, gesture timeout, animation frame), Power_Decide() says
+*   whether that gap is worth a light sleep and for how long. Light sleep
+*   clock-gates both cores and the peripherals but keeps RAM, PSRAM and
+*   GPIO levels, so the panel keeps its GRAM and the image stays up; the
+*   timer or a low level on the button pin wakes the chip.
+*   Power_Decide() and the statistics have no Arduino dependency and run
+*   on the host; Power_LightSleep() is target-only.
+******************************************************************************/
+#ifndef __POWER_MANAGER_H
+#define __POWER_MANAGER_H
+
+#include <stdint.h>
+
+#define POWER_MIN_SLEEP_MS    20    // Shorter gaps cost more to enter and leave than they save
+#define POWER_WAKE_MARGIN_MS  2     // Wake this much before the deadline
+#define POWER_MAX_SLEEP_MS    60000
+
+typedef enum {
+    POWER_SLEEP = 0,        // Sleep for the returned time
+    POWER_SKIP_DISABLED,
+    POWER_SKIP_BUSY,        // Work in flight: scan, prefetch, present, SD fill
+    POWER_SKIP_USB,         // USB host attached: sleep would drop the serial port
+    POWER_SKIP_BUTTON,      // Button held: its level cannot wake the chip again
+    POWER_SKIP_DISPLAY,     // Backlight level cannot be held through sleep
+    POWER_SKIP_SHORT,       // Next deadline too close
+    POWER_DECISION_COUNT
+} POWER_DECISION;
+
+typedef enum {
+    POWER_WAKE_TIMER = 0,
+    POWER_WAKE_BUTTON,
+    POWER_WAKE_OTHER,
+    POWER_WAKE_COUNT
+} POWER_WAKE;
+
+typedef struct {
+    uint32_t UntilNextMs;   // Time to the earliest deadline
+    bool Busy;
+    bool UsbConnected;
+    bool ButtonPressed;
+    bool DisplayHoldable;   // LCD_CanHoldForSleep()
+} POWER_INPUT;
+
+typedef struct {
+    bool Enabled;
+    uint32_t MinSleepMs;
+    uint32_t WakeMarginMs;
+    uint32_t MaxSleepMs;
+} POWER_CONFIG;
+
+typedef struct {
+    uint32_t Sleeps;
+    uint64_t SleepUs;       // Time spent in light sleep
+    uint64_t ActiveUs;      // Time awake (working or waiting without sleep)
+    uint32_t Wakes[POWER_WAKE_COUNT];
+    uint32_t Skips[POWER_DECISION_COUNT];
+    uint32_t EarlyWakes;    // Woken more than a margin before the planned time
+} POWER_STATS;
+
+void Power_Init(POWER_CONFIG *config);
+POWER_DECISION Power_Decide(const POWER_CONFIG *config, const POWER_INPUT *input, uint32_t *sleepMs);
+void Power_AccountActive(uint32_t activeUs);
+void Power_AccountSleep(uint32_t plannedMs, uint32_t sleptUs, POWER_WAKE wake);
+void Power_AccountSkip(POWER_DECISION decision);
+void Power_GetStats(POWER_STATS *stats);
+void Power_ResetStats(void);
+const char *Power_DecisionName(POWER_DECISION decision);
+const char *Power_WakeName(POWER_WAKE wake);
+
+#ifdef ARDUINO
+POWER_WAKE Power_LightSleep(uint32_t sleepMs, int wakePin, uint32_t *sleptUs);
+#endif
+
+#endif
@@ -0,0 +1,130 @@
+/*****************************************************************************
+* | File        :   RLE565.cpp
+* | Function    :   Streaming run-length RGB565 decoder into the LCD burst path
+******************************************************************************/
+#include "RLE565.h"
+#include <string.h>
+
+enum {
+    STATE_CONTROL = 0,
+    STATE_RUN_HIGH,
+    STATE_RUN_LOW,
+    STATE_LITERAL,
+};
+
+static RLE565_DECODER assetDecoder;
+
+// Bursts are kept in stream byte order and swapped once, just before the write
+static void flush(RLE565_DECODER *decoder)
+{
+    if (decoder->Fill == 0) {
+        return;
+    }
+    if (decoder->Swap) {
+        for (uint32_t i = 0; i + 1 < decoder->Fill; i += 2) {
+            uint8_t t = decoder->Burst[i];
+            decoder->Burst[i] = decoder->Burst[i + 1];
+            decoder->Burst[i + 1] = t;
+        }
+    }
+    LCD_WriteData_Buffer(decoder->Burst, decoder->Fill);
+    decoder->Fill = 0;
+}
+
+void RLE565_Begin(RLE565_DECODER *decoder, uint32_t pixels, bool littleEndian)
+{
+    decoder->Remaining = pixels;
+    decoder->PacketBytes = 0;
+    decoder->State = STATE_CONTROL;
+    decoder->Swap = littleEndian;
+    decoder->Fill = 0;
+}
+
+/******************************************************************************
+function: Consume the next len bytes of the stream
+info:
+    Slices may split packets anywhere. Bytes after the last pixel are
+    ignored. Returns false on a packet that would overrun the image.
+******************************************************************************/
+bool RLE565_Feed(RLE565_DECODER *decoder, const uint8_t *data, uint32_t len)
+{
+    while (len > 0 && (decoder->Remaining > 0 || decoder->State != STATE_CONTROL)) {
+        switch (decoder->State) {
+        case STATE_CONTROL: {
+            uint8_t control = *data++;
+            len--;
+            uint32_t count = (control & 0x7F) + 1;
+            if (count > decoder->Remaining) {
+                return false;
+            }
+            decoder->Remaining -= count;
+            if (control & 0x80) {
+                decoder->PacketBytes = count; // Pixels to repeat
+                decoder->State = STATE_RUN_HIGH;
+            } else {
+                decoder->PacketBytes = count * 2;
+                decoder->State = STATE_LITERAL;
+            }
+            break;
+        }
+        case STATE_RUN_HIGH:
+            decoder->Pixel[0] = *data++;
+            len--;
+            decoder->State = STATE_RUN_LOW;
+            break;
+        case STATE_RUN_LOW:
+            decoder->Pixel[1] = *data++;
+            len--;
+            while (decoder->PacketBytes > 0) {
+                decoder->Burst[decoder->Fill++] = decoder->Pixel[0];
+                decoder->Burst[decoder->Fill++] = decoder->Pixel[1];
+                decoder->PacketBytes--;
+                if (decoder->Fill == RLE565_BURST_BYTES) {
+                    flush(decoder);
+                }
+            }
+            decoder->State = STATE_CONTROL;
+            break;
+        case STATE_LITERAL: {
+            uint32_t n = RLE565_BURST_BYTES - decoder->Fill;
+            if (n > decoder->PacketBytes) n = decoder->PacketBytes;
+            if (n > len) n = len;
+            memcpy(&decoder->Burst[decoder->Fill], data, n);
+            decoder->Fill += n;
+            decoder->PacketBytes -= n;
+            data += n;
+            len -= n;
+            if (decoder->Fill == RLE565_BURST_BYTES) {
+                flush(decoder);
+            }
+            if (decoder->PacketBytes == 0) {
+                decoder->State = STATE_CONTROL;
+            }
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+// Write out the last partial burst; true when the stream covered every pixel
+bool RLE565_Finish(RLE565_DECODER *decoder)
+{
+    flush(decoder);
+    return decoder->Remaining == 0 && decoder->State == STATE_CONTROL;
+}
+
+/******************************************************************************
+function: Draw an RLE565 image held in memory (PROGMEM assets)
+info:
+    Replaces Paint_DrawImage's word-by-word pgm_read_word loop: the panel
+    window is set once and pixels go out in bursts with CS held low.
+    The caller owns the LCD bus.
+******************************************************************************/
+bool RLE565_DrawImage(const uint8_t *data, uint32_t len, uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+{
+    LCD_SetCursor(x, y, x + width - 1, y + height - 1);
+    RLE565_Begin(&assetDecoder, (uint32_t)width * height, false);
+    bool ok = RLE565_Feed(&assetDecoder, data, len);
+    return RLE565_Finish(&assetDecoder) && ok;
+}
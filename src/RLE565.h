@@ -0,0 +1,41 @@
+/*****************************************************************************
+* | File        :   RLE565.h
+* | Function    :   Streaming run-length RGB565 decoder into the LCD burst path
+* | Info        :
+*   Packets: a control byte c, then either one pixel repeated (c & 0x7F) + 1
+*   times (c & 0x80 set) or c + 1 literal pixels. Pixels are two bytes in
+*   wire (big-endian) order unless the stream says otherwise. Runs cross
+*   row boundaries, so flat screens (status images, letterbox bars) shrink
+*   to a few hundred bytes.
+*   The decoder is a small state machine fed with arbitrary slices of the
+*   stream (a PROGMEM array in one go, or SD chunks as they arrive); output
+*   is gathered into RLE565_BURST_BYTES and written with LCD_WriteData_Buffer
+*   into a window the caller has already set with LCD_SetCursor.
+*   Encoders: scripts/rle565.py (status headers) and scripts/pack_565.py.
+******************************************************************************/
+#ifndef __RLE565_H
+#define __RLE565_H
+
+#include <stdint.h>
+#include "LCD_Driver.h"
+
+#define RLE565_MAX_PACKET  128
+#define RLE565_BURST_ROWS  8                                 // Display rows per LCD burst
+#define RLE565_BURST_BYTES (LCD_WIDTH * 2 * RLE565_BURST_ROWS)
+
+typedef struct {
+    uint32_t Remaining;     // Pixels not yet emitted
+    uint32_t PacketBytes;   // Literal bytes (or run pixels) left in the current packet
+    uint8_t State;
+    uint8_t Pixel[2];       // Run pixel being assembled
+    bool Swap;              // Stream is little-endian
+    uint32_t Fill;          // Bytes waiting in Burst
+    uint8_t Burst[RLE565_BURST_BYTES];
+} RLE565_DECODER;
+
+void RLE565_Begin(RLE565_DECODER *decoder, uint32_t pixels, bool littleEndian);
+bool RLE565_Feed(RLE565_DECODER *decoder, const uint8_t *data, uint32_t len);
+bool RLE565_Finish(RLE565_DECODER *decoder);
+bool RLE565_DrawImage(const uint8_t *data, uint32_t len, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+#endif
@@ -0,0 +1,127 @@
+/*****************************************************************************
+* | File        :   Raw565_Loader.cpp
+* | Function    :   Panel-ready .565 images streamed from the SD card to the LCD
+******************************************************************************/
+#include "Raw565_Loader.h"
+#include "LCD_Driver.h"
+#include "RLE565.h"
+#include <string.h>
+
+// Its burst buffer also carries uncompressed files to the panel
+static RLE565_DECODER decoder;
+
+static uint16_t le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void swapBytes(uint8_t *data, uint32_t len)
+{
+    for (uint32_t i = 0; i + 1 < len; i += 2) {
+        uint8_t t = data[i];
+        data[i] = data[i + 1];
+        data[i + 1] = t;
+    }
+}
+
+bool Raw565_ReadHeader(SD_READER *reader, RAW565_INFO *info)
+{
+    uint8_t header[RAW565_HEADER_SIZE];
+    SDReader_Seek(reader, 0);
+    if (SDReader_Read(reader, header, sizeof(header)) != (int32_t)sizeof(header)) {
+        return false;
+    }
+    if (memcmp(header, "R565", 4) != 0 || header[4] != RAW565_VERSION) {
+        return false;
+    }
+
+    info->Flags = header[5];
+    info->Width = le16(&header[6]);
+    info->Height = le16(&header[8]);
+    info->DataOffset = le16(&header[10]);
+    info->DataLength = le32(&header[12]);
+
+    // The packer bakes in fit, letterbox and rotation, so only full panel frames exist
+    if (info->Width != LCD_WIDTH || info->Height != LCD_HEIGHT ||
+        info->DataOffset < RAW565_HEADER_SIZE ||
+        info->DataOffset + info->DataLength > SDReader_Size(reader)) {
+        return false;
+    }
+    if (!(info->Flags & RAW565_FLAG_RLE) &&
+        info->DataLength < (uint32_t)info->Width * info->Height * 2) {
+        return false;
+    }
+    return true;
+}
+
+/******************************************************************************
+function: Stream the pixel data into the panel
+info:
+    Pixels are gathered into RLE565_BURST_BYTES bursts and written with one
+    CS-low transfer each. Uncompressed wire-order files are read straight
+    into the burst buffer; nothing is converted. RLE files are fed to the
+    RLE565 decoder one card read at a time.
+    The caller owns both the SD and the LCD bus.
+******************************************************************************/
+bool Raw565_StreamToPanel(SD_READER *reader, const RAW565_INFO *info)
+{
+    const bool swap = !(info->Flags & RAW565_FLAG_BIG_ENDIAN);
+    const uint32_t pixels = (uint32_t)info->Width * info->Height;
+
+    SDReader_Seek(reader, info->DataOffset);
+    LCD_SetCursor(0, 0, info->Width - 1, info->Height - 1);
+
+    if (!(info->Flags & RAW565_FLAG_RLE)) {
+        uint32_t bytes = pixels * 2;
+        while (bytes > 0) {
+            uint32_t n = bytes < RLE565_BURST_BYTES ? bytes : RLE565_BURST_BYTES;
+            if (SDReader_Read(reader, decoder.Burst, n) != (int32_t)n) {
+                return false;
+            }
+            if (swap) {
+                swapBytes(decoder.Burst, n);
+            }
+            LCD_WriteData_Buffer(decoder.Burst, n);
+            bytes -= n;
+        }
+        return true;
+    }
+
+    uint8_t input[SD_READER_SECTOR_SIZE];
+    uint32_t bytes = info->DataLength;
+    bool ok = true;
+    RLE565_Begin(&decoder, pixels, swap);
+    while (ok && bytes > 0) {
+        uint32_t n = bytes < sizeof(input) ? bytes : sizeof(input);
+        ok = SDReader_Read(reader, input, n) == (int32_t)n && RLE565_Feed(&decoder, input, n);
+        bytes -= n;
+    }
+    return RLE565_Finish(&decoder) && ok;
+}
+
+/******************************************************************************
+function: Read an uncompressed frame into memory in wire byte order
+info:
+    For callers that keep panel-ready frames (flipbook cache). RLE files
+    are only ever streamed to the panel and are refused here.
+******************************************************************************/
+bool Raw565_ReadFrame(SD_READER *reader, const RAW565_INFO *info, uint8_t *panelBytes)
+{
+    if (info->Flags & RAW565_FLAG_RLE) {
+        return false;
+    }
+    uint32_t bytes = (uint32_t)info->Width * info->Height * 2;
+    SDReader_Seek(reader, info->DataOffset);
+    if (SDReader_Read(reader, panelBytes, bytes) != (int32_t)bytes) {
+        return false;
+    }
+    if (!(info->Flags & RAW565_FLAG_BIG_ENDIAN)) {
+        swapBytes(panelBytes, bytes);
+    }
+    return true;
+}
@@ -0,0 +1,46 @@
+/*****************************************************************************
+* | File        :   Raw565_Loader.h
+* | Function    :   Panel-ready .565 images streamed from the SD card to the LCD
+* | Info        :
+*   A .565 file is a 16-byte header followed by a 135x240 RGB565 frame,
+*   already fitted, letterboxed and rotated, row-major in the order the
+*   panel is written. Pixels are normally stored in wire (big-endian) byte
+*   order and may be run-length packed; either way they go from the card
+*   to the LCD in burst writes with no frame buffer and no decode.
+*   Files are produced on the host by scripts/pack_565.py.
+*
+*   Header (multi-byte fields little-endian):
+*     0  'R','5','6','5'
+*     4  uint8  version (1)
+*     5  uint8  flags (RAW565_FLAG_*)
+*     6  uint16 width   (135)
+*     8  uint16 height  (240)
+*    10  uint16 header size (offset of the pixel data)
+*    12  uint32 pixel data length in bytes
+*
+*   RLE payloads use the packet format of RLE565.h.
+******************************************************************************/
+#ifndef __RAW565_LOADER_H
+#define __RAW565_LOADER_H
+
+#include <stdint.h>
+#include "SD_Reader.h"
+
+#define RAW565_VERSION         1
+#define RAW565_HEADER_SIZE     16
+#define RAW565_FLAG_BIG_ENDIAN 0x01 // Pixels in wire byte order (no swap needed)
+#define RAW565_FLAG_RLE        0x02 // Pixel data is run-length packed
+
+typedef struct {
+    uint16_t Width;
+    uint16_t Height;
+    uint8_t Flags;
+    uint32_t DataOffset;
+    uint32_t DataLength;
+} RAW565_INFO;
+
+bool Raw565_ReadHeader(SD_READER *reader, RAW565_INFO *info);
+bool Raw565_StreamToPanel(SD_READER *reader, const RAW565_INFO *info);
+bool Raw565_ReadFrame(SD_READER *reader, const RAW565_INFO *info, uint8_t *panelBytes);
+
+#endif
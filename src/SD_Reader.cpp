@@ -0,0 +1,370 @@
+/*****************************************************************************
+* | File        :   SD_Reader.cpp
+* | Function    :   Buffered read-ahead reader for image files on the SD card
+******************************************************************************/
+#include "SD_Reader.h"
+#include "Stage_Profiler.h"
+#include "Heap_Telemetry.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <SD.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#else
+#include "DEV_Native.h"
+#include <time.h>
+#define HOST_PATH_SIZE 512
+#endif
+
+static SD_READER_STATS totalStats;
+
+#ifdef ARDUINO
+#define READER_MICROS() ((uint32_t)micros())
+#else
+static uint32_t READER_MICROS(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+#endif
+
+static uint32_t chunkStart(uint32_t position)
+{
+    return position & ~(uint32_t)(SD_READER_CHUNK_SIZE - 1);
+}
+
+static bool inBuffer(const SD_READER_BUFFER *buffer, uint32_t position)
+{
+    return buffer->Length > 0 && position >= buffer->Start &&
+           position < buffer->Start + buffer->Length;
+}
+
+// One card access: seek and read up to len bytes at a chunk-aligned offset
+static uint32_t readFromCard(SD_READER *reader, uint8_t *dst, uint32_t start, uint32_t len)
+{
+    uint32_t t0 = READER_MICROS();
+#ifdef ARDUINO
+    reader->Handle.seek(start);
+    uint32_t got = reader->Handle.read(dst, len);
+#else
+    fseek(reader->Handle, start, SEEK_SET);
+    uint32_t got = fread(dst, 1, len, reader->Handle);
+    Native_PaceSd(got);     // The card's bus time, when a test asks for it
+#endif
+    uint32_t us = READER_MICROS() - t0;
+
+    reader->Stats.BytesRead += got;
+    reader->Stats.Reads++;
+    reader->Stats.ReadMicros += us;
+    totalStats.BytesRead += got;
+    totalStats.Reads++;
+    totalStats.ReadMicros += us;
+    return got;
+}
+
+static void fillBuffer(SD_READER *reader, SD_READER_BUFFER *buffer, uint32_t start)
+{
+    uint32_t len = reader->Size - start;
+    if (len > SD_READER_CHUNK_SIZE) {
+        len = SD_READER_CHUNK_SIZE;
+    }
+    buffer->Start = start;
+    buffer->Length = readFromCard(reader, buffer->Data, start, len);
+}
+
+/******************************************************************************
+function: Background fill
+info:
+    A single task on core 0 serves fill requests for whichever reader asks,
+    one at a time.
+    The requester marks FillPending before notifying; waitFill() loops on the
+    flag so a stale semaphore give from an earlier fill cannot end the wait.
+******************************************************************************/
+#if SD_READER_BACKGROUND_FILL
+static TaskHandle_t fillTask = NULL;
+static SemaphoreHandle_t fillDone = NULL;
+static SD_READER *volatile fillReader = NULL;
+static volatile uint32_t fillStart = 0;
+
+static void fillTaskMain(void *param)
+{
+    (void)param;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        SD_READER *reader = fillReader;
+        if (reader != NULL) {
+            fillBuffer(reader, &reader->Buffer[1 - reader->Front], fillStart);
+            reader->FillPending = false;
+        }
+        xSemaphoreGive(fillDone);
+    }
+}
+
+static bool startFillTask(void)
+{
+    if (fillTask != NULL) {
+        return true;
+    }
+    fillDone = xSemaphoreCreateBinary();
+    if (fillDone == NULL) {
+        return false;
+    }
+    return xTaskCreatePinnedToCore(fillTaskMain, "sd_fill", 3072, NULL, 2, &fillTask, 0) == pdPASS;
+}
+#endif
+
+static void waitFill(SD_READER *reader)
+{
+#if SD_READER_BACKGROUND_FILL
+    if (reader->FillPending) {
+        reader->Stats.Waits++;
+        totalStats.Waits++;
+    }
+    while (reader->FillPending) {
+        xSemaphoreTake(fillDone, portMAX_DELAY);
+    }
+#else
+    (void)reader;
+#endif
+}
+
+// Read ahead the chunk that follows the front buffer into the back buffer
+static void startFill(SD_READER *reader)
+{
+    const SD_READER_BUFFER *front = &reader->Buffer[reader->Front];
+    SD_READER_BUFFER *back = &reader->Buffer[1 - reader->Front];
+    uint32_t next = front->Start + SD_READER_CHUNK_SIZE;
+
+    if (front->Length < SD_READER_CHUNK_SIZE || next >= reader->Size) {
+        return; // Front buffer already reaches the end of the file
+    }
+    if (back->Length > 0 && back->Start == next) {
+        return;
+    }
+    back->Length = 0;
+#if SD_READER_BACKGROUND_FILL
+    if (fillTask != NULL) {
+        // One fill in flight at a time: let another reader's fill land first
+        if (fillReader != NULL && fillReader != reader) {
+            waitFill(fillReader);
+        }
+        fillReader = reader;
+        fillStart = next;
+        reader->FillPending = true;
+        xTaskNotifyGive(fillTask);
+        return;
+    }
+#endif
+    fillBuffer(reader, back, next);
+}
+
+// Make the front buffer hold reader->Position
+static bool ensureBuffered(SD_READER *reader)
+{
+    if (inBuffer(&reader->Buffer[reader->Front], reader->Position)) {
+        return true;
+    }
+
+    waitFill(reader);
+    if (inBuffer(&reader->Buffer[1 - reader->Front], reader->Position)) {
+        reader->Front = 1 - reader->Front;
+    } else {
+        SD_READER_BUFFER *front = &reader->Buffer[reader->Front];
+        fillBuffer(reader, front, chunkStart(reader->Position));
+        if (!inBuffer(front, reader->Position)) {
+            return false; // Short read from the card
+        }
+    }
+    startFill(reader);
+    return true;
+}
+
+static uint8_t *allocBuffer(void)
+{
+    // Internal, DMA-capable and word aligned so FATFS can read sectors straight in
+    return (uint8_t *)Heap_Alloc(HEAP_IO, SD_READER_CHUNK_SIZE, HEAP_CAP_DMA);
+}
+
+/******************************************************************************
+function: Open a file for buffered reading
+info:
+    Buffers are allocated on first use and kept across Close/Open, so a
+    reader that is reused for every image never fragments the heap.
+******************************************************************************/
+bool SDReader_Open(SD_READER *reader, const char *path)
+{
+    PROFILE_SCOPE(PROF_OPEN);
+    if (reader->IsOpen) {
+        SDReader_Close(reader);
+    }
+    for (int i = 0; i < 2; i++) {
+        if (reader->Buffer[i].Data == NULL) {
+            reader->Buffer[i].Data = allocBuffer();
+            if (reader->Buffer[i].Data == NULL) {
+                return false;
+            }
+        }
+        reader->Buffer[i].Length = 0;
+    }
+
+#ifdef ARDUINO
+    reader->Handle = SD.open(path);
+    if (!reader->Handle) {
+        return false;
+    }
+    reader->Size = reader->Handle.size();
+#else
+    char hostPath[HOST_PATH_SIZE];
+    if (!Native_StoragePath(path, hostPath, sizeof(hostPath))) {
+        return false;
+    }
+    reader->Handle = fopen(hostPath, "rb");
+    if (reader->Handle == NULL) {
+        return false;
+    }
+    fseek(reader->Handle, 0, SEEK_END);
+    reader->Size = ftell(reader->Handle);
+    fseek(reader->Handle, 0, SEEK_SET);
+#endif
+
+#if SD_READER_BACKGROUND_FILL
+    startFillTask();
+#endif
+    reader->IsOpen = true;
+    reader->Position = 0;
+    reader->Front = 0;
+    reader->FillPending = false;
+    memset(&reader->Stats, 0, sizeof(reader->Stats));
+    return true;
+}
+
+void SDReader_Close(SD_READER *reader)
+{
+    if (!reader->IsOpen) {
+        return;
+    }
+    waitFill(reader);
+#ifdef ARDUINO
+    reader->Handle.close();
+#else
+    fclose(reader->Handle);
+    reader->Handle = NULL;
+#endif
+    reader->IsOpen = false;
+    reader->Buffer[0].Length = 0;
+    reader->Buffer[1].Length = 0;
+}
+
+void SDReader_Free(SD_READER *reader)
+{
+    SDReader_Close(reader);
+    for (int i = 0; i < 2; i++) {
+        Heap_Free(reader->Buffer[i].Data);
+        reader->Buffer[i].Data = NULL;
+    }
+}
+
+/******************************************************************************
+function: Read len bytes at the current position
+info:
+    Requests that start on a chunk boundary and cover whole chunks bypass
+    the buffers and go to the card as one multi-sector read.
+******************************************************************************/
+int32_t SDReader_Read(SD_READER *reader, uint8_t *dst, int32_t len)
+{
+    PROFILE_SCOPE(PROF_READ);
+    int32_t total = 0;
+    if (!reader->IsOpen || len <= 0) {
+        return 0;
+    }
+
+    while (len > 0 && reader->Position < reader->Size) {
+        const SD_READER_BUFFER *front = &reader->Buffer[reader->Front];
+        if (!inBuffer(front, reader->Position) &&
+            reader->Position == chunkStart(reader->Position) &&
+            (uint32_t)len >= SD_READER_CHUNK_SIZE) {
+            waitFill(reader);
+            uint32_t direct = chunkStart((uint32_t)len);
+            uint32_t got = readFromCard(reader, dst, reader->Position, direct);
+            reader->Position += got;
+            dst += got;
+            len -= got;
+            total += got;
+            if (got < direct) {
+                break;
+            }
+            continue;
+        }
+
+        if (!ensureBuffered(reader)) {
+            break;
+        }
+        front = &reader->Buffer[reader->Front];
+        uint32_t offset = reader->Position - front->Start;
+        uint32_t n = front->Length - offset;
+        if (n > (uint32_t)len) {
+            n = len;
+        }
+        memcpy(dst, front->Data + offset, n);
+        reader->Position += n;
+        dst += n;
+        len -= n;
+        total += n;
+    }
+    return total;
+}
+
+bool SDReader_Seek(SD_READER *reader, uint32_t position)
+{
+    if (!reader->IsOpen || position > reader->Size) {
+        return false;
+    }
+    reader->Position = position; // Buffers are refilled lazily on the next read
+    return true;
+}
+
+uint32_t SDReader_Size(const SD_READER *reader)
+{
+    return reader->Size;
+}
+
+uint32_t SDReader_Position(const SD_READER *reader)
+{
+    return reader->Position;
+}
+
+/******************************************************************************
+function: Throughput instrumentation
+******************************************************************************/
+float SDReader_MBps(const SD_READER_STATS *stats)
+{
+    if (stats->ReadMicros == 0) {
+        return 0.0f;
+    }
+    return (float)stats->BytesRead / (float)stats->ReadMicros; // bytes/us == MB/s
+}
+
+void SDReader_TotalStats(SD_READER_STATS *stats)
+{
+    *stats = totalStats;
+}
+
+void SDReader_ResetTotalStats(void)
+{
+    memset(&totalStats, 0, sizeof(totalStats));
+}
+
+// A read-ahead is on the card right now (the SD bus must not be stopped)
+bool SDReader_FillInFlight(void)
+{
+#if SD_READER_BACKGROUND_FILL
+    SD_READER *reader = fillReader;
+    return reader != NULL && reader->FillPending;
+#else
+    return false;
+#endif
+}
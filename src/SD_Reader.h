@@ -0,0 +1,80 @@
+/*****************************************************************************
+* | File        :   SD_Reader.h
+* | Function    :   Buffered read-ahead reader for image files on the SD card
+* | Info        :
+*   Decoders ask for small, unaligned pieces of a file. The reader turns that
+*   into whole-chunk reads (SD_READER_CHUNK_SIZE bytes, sector aligned in the
+*   file) into a double buffer, and refills the second buffer in a background
+*   task while the decoder works on the first one.
+*   Without ARDUINO the same code reads from a host file (stdio), so chunk
+*   boundary handling can be exercised off-target.
+******************************************************************************/
+#ifndef __SD_READER_H
+#define __SD_READER_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <FS.h>
+#else
+#include <stdio.h>
+#endif
+
+#define SD_READER_SECTOR_SIZE 512
+
+// Bytes per read-ahead buffer; a power of two, multiple of the sector size
+#ifndef SD_READER_CHUNK_SIZE
+#define SD_READER_CHUNK_SIZE  (16 * 1024)
+#endif
+
+// 1 = fill the next buffer from a FreeRTOS task, 0 = fill on demand
+#ifndef SD_READER_BACKGROUND_FILL
+#ifdef ARDUINO
+#define SD_READER_BACKGROUND_FILL 1
+#else
+#define SD_READER_BACKGROUND_FILL 0
+#endif
+#endif
+
+typedef struct {
+    uint32_t BytesRead;     // Bytes transferred from the card
+    uint32_t Reads;         // Card read calls issued
+    uint32_t ReadMicros;    // Time spent inside card reads
+    uint32_t Waits;         // Times a caller had to wait for the background fill
+} SD_READER_STATS;
+
+typedef struct {
+    uint8_t *Data;
+    uint32_t Start;         // File offset of Data[0]
+    uint32_t Length;        // Valid bytes, 0 when empty
+} SD_READER_BUFFER;
+
+typedef struct {
+#ifdef ARDUINO
+    fs::File Handle;
+#else
+    FILE *Handle;
+#endif
+    bool IsOpen;
+    uint32_t Size;
+    uint32_t Position;
+    SD_READER_BUFFER Buffer[2];
+    int Front;              // Buffer holding Position, the other one reads ahead
+    volatile bool FillPending;
+    SD_READER_STATS Stats;
+} SD_READER;
+
+bool SDReader_Open(SD_READER *reader, const char *path);
+void SDReader_Close(SD_READER *reader);
+void SDReader_Free(SD_READER *reader);
+int32_t SDReader_Read(SD_READER *reader, uint8_t *dst, int32_t len);
+bool SDReader_Seek(SD_READER *reader, uint32_t position);
+uint32_t SDReader_Size(const SD_READER *reader);
+uint32_t SDReader_Position(const SD_READER *reader);
+bool SDReader_FillInFlight(void);
+
+float SDReader_MBps(const SD_READER_STATS *stats);
+void SDReader_TotalStats(SD_READER_STATS *stats);
+void SDReader_ResetTotalStats(void);
+
+#endif
@@ -0,0 +1,95 @@
+/*****************************************************************************
+* | File        :   Slideshow_Clock.cpp
+* | Function    :   Drift-free slideshow timeline with early frame preparation
+******************************************************************************/
+#include "Slideshow_Clock.h"
+#include <math.h>
+
+// a is at or after b, across the 32-bit microsecond wrap
+static bool reached(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) >= 0;
+}
+
+// A new timeline: first flip one period from now (mode or speed change)
+void Slide_Start(SLIDE_CLOCK *clock, uint32_t nowUs, uint32_t periodUs)
+{
+    clock->PeriodUs = periodUs > 0 ? periodUs : 1;
+    clock->NextUs = nowUs + clock->PeriodUs;
+}
+
+uint32_t Slide_FlipDueUs(const SLIDE_CLOCK *clock)
+{
+    return clock->NextUs;
+}
+
+// Never earlier than the previous flip: preparing overwrites the back frame
+uint32_t Slide_PrepareDueUs(const SLIDE_CLOCK *clock)
+{
+    uint32_t lead = clock->PrepareUs + clock->PrepareUs / 4 + SLIDE_PREPARE_MARGIN_US;
+    return lead < clock->PeriodUs ? clock->NextUs - lead : clock->NextUs - clock->PeriodUs;
+}
+
+void Slide_RecordPrepare(SLIDE_CLOCK *clock, uint32_t costUs)
+{
+    if (costUs >= clock->PrepareUs) {
+        clock->PrepareUs = costUs;
+    } else {
+        clock->PrepareUs -= (clock->PrepareUs - costUs) / 16;
+    }
+}
+
+/******************************************************************************
+function: A slide was put up at flipUs
+info:
+    The next deadline is the first point of the ideal timeline after the
+    flip; any earlier ones were missed and are counted as skipped.
+******************************************************************************/
+void Slide_Flipped(SLIDE_CLOCK *clock, uint32_t flipUs)
+{
+    int32_t error = (int32_t)(flipUs - clock->NextUs);
+    if (clock->Flips == 0 || error < clock->MinErrorUs) {
+        clock->MinErrorUs = error;
+    }
+    if (clock->Flips == 0 || error > clock->MaxErrorUs) {
+        clock->MaxErrorUs = error;
+    }
+    clock->Flips++;
+    clock->SumErrorUs += error;
+    clock->SumSquareErrorUs += (uint64_t)((int64_t)error * error);
+    if (error > SLIDE_LATE_US) {
+        clock->Late++;
+    }
+
+    clock->NextUs += clock->PeriodUs;
+    while (reached(flipUs, clock->NextUs)) {
+        clock->NextUs += clock->PeriodUs;
+        clock->Skipped++;
+    }
+}
+
+void Slide_ResetStats(SLIDE_CLOCK *clock)
+{
+    clock->Flips = 0;
+    clock->Late = 0;
+    clock->Skipped = 0;
+    clock->MinErrorUs = 0;
+    clock->MaxErrorUs = 0;
+    clock->SumErrorUs = 0;
+    clock->SumSquareErrorUs = 0;
+}
+
+float Slide_MeanErrorUs(const SLIDE_CLOCK *clock)
+{
+    return clock->Flips > 0 ? (float)clock->SumErrorUs / clock->Flips : 0.0f;
+}
+
+float Slide_StdDevUs(const SLIDE_CLOCK *clock)
+{
+    if (clock->Flips == 0) {
+        return 0.0f;
+    }
+    double mean = (double)clock->SumErrorUs / clock->Flips;
+    double variance = (double)clock->SumSquareErrorUs / clock->Flips - mean * mean;
+    return variance > 0 ? (float)sqrt(variance) : 0.0f;
+}
@@ -0,0 +1,50 @@
+/*****************************************************************************
+* | File        :   Slideshow_Clock.h
+* | Function    :   Drift-free slideshow timeline with early frame preparation
+* | Info        :
+*   Slides flip at start + k * period. Each deadline comes from the ideal
+*   timeline, not from when the last slide finished drawing, so decode and
+*   draw time never add up. A flip that misses whole periods skips them
+*   and stays in phase.
+*   The next frame is prepared (decoded into the back frame) at the flip
+*   deadline minus an estimate of the prepare cost, with a quarter of it
+*   and a fixed margin on top. The estimate follows a rising cost at once
+*   and decays slowly (1/16 per sample), so the flip itself is only a
+*   buffer swap.
+*   Each flip's error against its deadline feeds the jitter statistics.
+*   No Arduino dependency: times are micros() values, tested on the host
+*   with a virtual clock.
+******************************************************************************/
+#ifndef __SLIDESHOW_CLOCK_H
+#define __SLIDESHOW_CLOCK_H
+
+#include <stdint.h>
+
+#define SLIDE_PREPARE_MARGIN_US 10000   // Lead beyond the estimate plus a quarter
+#define SLIDE_LATE_US           1000    // Flips later than this count as late
+
+typedef struct {
+    uint32_t PeriodUs;
+    uint32_t NextUs;            // Deadline of the next flip
+    uint32_t PrepareUs;         // Estimated cost of preparing a frame
+
+    // Jitter of flips against their deadlines
+    uint32_t Flips;
+    uint32_t Late;
+    uint32_t Skipped;           // Periods missed entirely
+    int32_t MinErrorUs;
+    int32_t MaxErrorUs;
+    int64_t SumErrorUs;
+    uint64_t SumSquareErrorUs;
+} SLIDE_CLOCK;
+
+void Slide_Start(SLIDE_CLOCK *clock, uint32_t nowUs, uint32_t periodUs);
+uint32_t Slide_FlipDueUs(const SLIDE_CLOCK *clock);
+uint32_t Slide_PrepareDueUs(const SLIDE_CLOCK *clock);
+void Slide_RecordPrepare(SLIDE_CLOCK *clock, uint32_t costUs);
+void Slide_Flipped(SLIDE_CLOCK *clock, uint32_t flipUs);
+void Slide_ResetStats(SLIDE_CLOCK *clock);
+float Slide_MeanErrorUs(const SLIDE_CLOCK *clock);
+float Slide_StdDevUs(const SLIDE_CLOCK *clock);
+
+#endif
@@ -0,0 +1,210 @@
+/*****************************************************************************
+* | File        :   Stage_Profiler.cpp
+* | Function    :   Per-stage image pipeline profiler with a fixed event ring
+******************************************************************************/
+#include "Stage_Profiler.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+static portMUX_TYPE ringLock = portMUX_INITIALIZER_UNLOCKED;
+#define PROFILER_LOCK()     portENTER_CRITICAL(&ringLock)
+#define PROFILER_UNLOCK()   portEXIT_CRITICAL(&ringLock)
+#define PROFILER_PRINTF     Serial.printf
+#define PROFILER_CORES      2
+#define PROFILER_CORE()     xPortGetCoreID()
+#define PROFILER_NOW()      ESP.getCycleCount()
+#else
+#include <stdio.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+static std::mutex ringLock;
+#define PROFILER_LOCK()     ringLock.lock()
+#define PROFILER_UNLOCK()   ringLock.unlock()
+#define PROFILER_PRINTF     printf
+#define PROFILER_CORES      2
+#define PROFILER_CORE()     hostCore()
+// Threads stand in for cores: the first thread to profile is core 0, any other core 1
+static inline uint8_t hostCore(void)
+{
+    static std::atomic<uint8_t> threads(0);
+    thread_local uint8_t core = 0xFF;
+    if (core == 0xFF) {
+        uint8_t n = threads++;
+        core = n < PROFILER_CORES ? n : PROFILER_CORES - 1;
+    }
+    return core;
+}
+#define PROFILER_NOW()      ((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>( \
+                                std::chrono::steady_clock::now().time_since_epoch()).count())
+#endif
+
+static const char *STAGE_NAMES[PROF_STAGE_COUNT] = {"open", "read", "decode", "transform", "present"};
+
+static PROF_EVENT ring[PROFILER_RING_SIZE];
+static uint32_t ringCount = 0;
+
+#if PROFILER_ENABLED
+typedef struct {
+    uint8_t Stage;
+    uint32_t Start;
+    uint32_t ChildTicks;    // Time of scopes nested inside this one
+} PROF_FRAME;
+
+typedef struct {
+    uint32_t Start;
+    uint32_t Ticks;
+    uint16_t Spans;
+} PROF_PENDING;
+
+typedef struct {
+    PROF_FRAME Stack[PROFILER_MAX_DEPTH];
+    uint8_t Depth;
+    uint8_t Overflow;       // Scopes deeper than the stack, not timed
+    PROF_PENDING Pending[PROF_STAGE_COUNT];
+} PROF_CORE;
+
+static PROF_CORE cores[PROFILER_CORES];
+
+void Profiler_Begin(PROF_STAGE stage)
+{
+    PROF_CORE *core = &cores[PROFILER_CORE()];
+    if (core->Depth >= PROFILER_MAX_DEPTH) {
+        core->Overflow++;
+        return;
+    }
+    PROF_FRAME *frame = &core->Stack[core->Depth++];
+    frame->Stage = stage;
+    frame->ChildTicks = 0;
+    frame->Start = PROFILER_NOW();
+}
+
+void Profiler_End(void)
+{
+    uint32_t now = PROFILER_NOW();
+    PROF_CORE *core = &cores[PROFILER_CORE()];
+    if (core->Overflow > 0) {
+        core->Overflow--;
+        return;
+    }
+    if (core->Depth == 0) {
+        return;
+    }
+    PROF_FRAME *frame = &core->Stack[--core->Depth];
+    uint32_t elapsed = now - frame->Start;
+    PROF_PENDING *pending = &core->Pending[frame->Stage];
+    if (pending->Spans == 0) {
+        pending->Start = frame->Start;
+    }
+    pending->Ticks += elapsed - frame->ChildTicks;
+    if (pending->Spans < UINT16_MAX) {
+        pending->Spans++;
+    }
+    if (core->Depth > 0) {
+        core->Stack[core->Depth - 1].ChildTicks += elapsed;
+    }
+}
+
+/******************************************************************************
+function: One ring event per stage the calling core has timed since its last flush
+******************************************************************************/
+void Profiler_Flush(int image)
+{
+    uint8_t id = PROFILER_CORE();
+    PROF_CORE *core = &cores[id];
+    for (int stage = 0; stage < PROF_STAGE_COUNT; stage++) {
+        PROF_PENDING *pending = &core->Pending[stage];
+        if (pending->Spans == 0) {
+            continue;
+        }
+        PROFILER_LOCK();
+        PROF_EVENT *event = &ring[ringCount % PROFILER_RING_SIZE];
+        event->Stage = stage;
+        event->Core = id;
+        event->Spans = pending->Spans;
+        event->Image = image;
+        event->StartTicks = pending->Start;
+        event->Ticks = pending->Ticks;
+        ringCount++;
+        PROFILER_UNLOCK();
+        pending->Spans = 0;
+        pending->Ticks = 0;
+    }
+}
+#endif
+
+uint32_t Profiler_TicksPerUs(void)
+{
+#ifdef ARDUINO
+    return getCpuFrequencyMhz();
+#else
+    return 1000;
+#endif
+}
+
+// Oldest first; returns how many were copied
+uint32_t Profiler_Copy(PROF_EVENT *events, uint32_t max)
+{
+    PROFILER_LOCK();
+    uint32_t n = ringCount < PROFILER_RING_SIZE ? ringCount : PROFILER_RING_SIZE;
+    n = n < max ? n : max;
+    for (uint32_t i = 0; i < n; i++) {
+        events[i] = ring[(ringCount - n + i) % PROFILER_RING_SIZE];
+    }
+    PROFILER_UNLOCK();
+    return n;
+}
+
+const char *Profiler_StageName(PROF_STAGE stage)
+{
+    return (unsigned)stage < PROF_STAGE_COUNT ? STAGE_NAMES[stage] : "?";
+}
+
+/******************************************************************************
+function: Print the ring, oldest first, then totals per stage
+info:
+    The totals say which stage bounds the slow images: SD (open, read),
+    CPU (decode, transform) or SPI (present).
+******************************************************************************/
+void Profiler_Dump(void)
+{
+#if PROFILER_ENABLED
+    static PROF_EVENT copy[PROFILER_RING_SIZE];
+    uint32_t n = Profiler_Copy(copy, PROFILER_RING_SIZE);
+    float perUs = (float)Profiler_TicksPerUs();
+    uint32_t count[PROF_STAGE_COUNT] = {0};
+    float totalUs[PROF_STAGE_COUNT] = {0};
+    float maxUs[PROF_STAGE_COUNT] = {0};
+
+    PROFILER_PRINTF("# profile: %u events (%u total)\n", (unsigned)n, (unsigned)ringCount);
+    PROFILER_PRINTF("# stage      core  image  spans     start_ticks        us\n");
+    for (uint32_t i = 0; i < n; i++) {
+        const PROF_EVENT *e = &copy[i];
+        float us = e->Ticks / perUs;
+        PROFILER_PRINTF("%-10s %5u %6d %6u %15u %9.1f\n", STAGE_NAMES[e->Stage], (unsigned)e->Core, e->Image,
+                        (unsigned)e->Spans, (unsigned)e->StartTicks, us);
+        count[e->Stage]++;
+        totalUs[e->Stage] += us;
+        if (us > maxUs[e->Stage]) {
+            maxUs[e->Stage] = us;
+        }
+    }
+    PROFILER_PRINTF("# stage      events   total_ms   mean_ms    max_ms\n");
+    for (int s = 0; s < PROF_STAGE_COUNT; s++) {
+        PROFILER_PRINTF("%-10s %9u %10.1f %9.2f %9.2f\n", STAGE_NAMES[s], (unsigned)count[s], totalUs[s] / 1000.0f,
+                        count[s] > 0 ? totalUs[s] / 1000.0f / count[s] : 0.0f, maxUs[s] / 1000.0f);
+    }
+#else
+    PROFILER_PRINTF("# profile: disabled at build time (PROFILER_ENABLED=0)\n");
+#endif
+}
+
+void Profiler_Reset(void)
+{
+    PROFILER_LOCK();
+    ringCount = 0;
+    PROFILER_UNLOCK();
+}
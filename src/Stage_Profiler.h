@@ -0,0 +1,72 @@
+/*****************************************************************************
+* | File        :   Stage_Profiler.h
+* | Function    :   Per-stage image pipeline profiler with a fixed event ring
+* | Info        :
+*   PROFILE_SCOPE(stage) times the rest of the enclosing block: the CPU
+*   cycle counter on target, steady_clock (ns) on the host. Scopes nest,
+*   and each stage is charged only its own time, so a decode that reads
+*   the card and transforms rows shows up as separate read, decode and
+*   transform times. PROFILE_FLUSH(image) turns what the calling core has
+*   gathered into one ring event per stage, tagged with the image id.
+*   Nothing is allocated: per-core state and the ring are static. Only
+*   one task per core may use scopes (loop() on core 1, the present task
+*   on core 0); cycle counts are per core, so only durations compare.
+*   Build with -DPROFILER_ENABLED=0 and the macros expand to nothing.
+******************************************************************************/
+#ifndef __STAGE_PROFILER_H
+#define __STAGE_PROFILER_H
+
+#include <stdint.h>
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED    1
+#endif
+
+#define PROFILER_RING_SIZE  256     // Events kept for the dump
+#define PROFILER_MAX_DEPTH  8       // Nested scopes per core
+
+typedef enum {
+    PROF_OPEN = 0,          // File open and header parse
+    PROF_READ,              // SD reads, including waits for read-ahead
+    PROF_DECODE,            // Decoder time outside reads and transform
+    PROF_TRANSFORM,         // Fit, letterbox and rotate into the frame
+    PROF_PRESENT,           // LCD transfer
+    PROF_STAGE_COUNT
+} PROF_STAGE;
+
+typedef struct {
+    uint8_t Stage;
+    uint8_t Core;
+    uint16_t Spans;         // Scopes merged into this event
+    int16_t Image;
+    uint32_t StartTicks;    // First scope's start (per-core clock)
+    uint32_t Ticks;         // Exclusive time of all its scopes
+} PROF_EVENT;
+
+#if PROFILER_ENABLED
+void Profiler_Begin(PROF_STAGE stage);
+void Profiler_End(void);
+void Profiler_Flush(int image);
+
+class ProfileScope {
+public:
+    explicit ProfileScope(PROF_STAGE stage) { Profiler_Begin(stage); }
+    ~ProfileScope() { Profiler_End(); }
+};
+
+#define PROFILE_CONCAT_(a, b)   a##b
+#define PROFILE_CONCAT(a, b)    PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(stage)    ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(stage)
+#define PROFILE_FLUSH(image)    Profiler_Flush(image)
+#else
+#define PROFILE_SCOPE(stage)    do {} while (0)
+#define PROFILE_FLUSH(image)    do {} while (0)
+#endif
+
+uint32_t Profiler_TicksPerUs(void);
+uint32_t Profiler_Copy(PROF_EVENT *events, uint32_t max);
+void Profiler_Dump(void);
+void Profiler_Reset(void);
+const char *Profiler_StageName(PROF_STAGE stage);
+
+#endif
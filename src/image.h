@@ -4,12 +4,8 @@
 // Uncomment the line below to enable embedded images
 // #define ENABLE_EMBEDDED_IMAGES
 
-// Status images are always included for system feedback
-#include "no_sd_card_data.h"
-#include "no_images_found_data.h"
-#include "scanning_data.h"
-#include "manual_mode_data.h"
-#include "slideshow_mode_data.h"
+// Status images are linked in as binary assets (Asset_Registry.h,
+// regenerated by scripts/build_assets.py) rather than included as headers
 
 #ifdef ENABLE_EMBEDDED_IMAGES
 // When enabled, place your image data files (e.g., pic1_data.h) in src/ directory
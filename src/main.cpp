@@ -12,10 +12,43 @@
 #include "LCD_Driver.h"
 #include "GUI_Paint.h"
 #include "image.h"
+#include "Album_Index.h"
+#include "SD_Reader.h"
+#include "Frame_Pipeline.h"
+#include "BMP_Loader.h"
+#include "PNG_Loader.h"
+#include "GIF_Player.h"
+#include "MJPEG_Player.h"
+#include "MJPEG_Clip.h"
+#include "Flipbook_Player.h"
+#include "Raw565_Loader.h"
+#include "RLE565.h"
+#include "Asset_Registry.h"
+#include "Asset_Pack.h"
+#include "Button_Input.h"
+#include "Button_Gesture.h"
+#include "Deadline_Scheduler.h"
+#include "Power_Manager.h"
+#include "Boot_Profile.h"
+#include "Latency_Trace.h"
+#include "Slideshow_Clock.h"
+#include "Stage_Profiler.h"
+#include "Log_Ring.h"
+#include "Heap_Telemetry.h"
+#include "Bench_Suite.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
 
 #define BUTTON_PIN     0   // BOOT button
 #define LED_PIN        2   // Built-in LED  
 
+// Fast boot: no serial wait or splash delays, SD mounted while the panel
+// comes up. Set to 0 to get time to open a serial monitor before setup logs.
+#ifndef FAST_BOOT
+#define FAST_BOOT      1
+#endif
+
 // SD Card SPI pins for ESP32-S3 Geek
 #define SDCARD_SCK     36  // SD card clock pin
 #define SDCARD_MISO    37  // SD card data out pin  
@@ -24,11 +57,21 @@
 
 // Custom SPI instance for SD card
 SPIClass sdSPI(HSPI);
+#define SD_SPI_FREQUENCY 80000000
+
+// Boot-time SD mount on core 0, overlapping the panel's reset-to-sleep-out wait
+SemaphoreHandle_t sdMountDone = NULL;
+volatile bool sdMountResult = false;
 
 // Global variables
 bool sdCardInitialized = false;
 bool slideshowMode = false;
-unsigned long slideshowTimer = 0;
+SCHED_TIMER slideshowTimer; // Next auto-advance, armed while in slideshow mode
+SCHED_TIMER slidePrepareTimer; // Decodes the next slide one estimated decode time before its flip
+SLIDE_CLOCK slideClock; // Ideal flip timeline and jitter stats
+bool slideRebase = false; // The next flip starts a new timeline (advance was held back)
+uint32_t frameShownUs = 0; // When displayCurrentImage() started putting the image up
+PIPE_PRESENT slideTransition = PRESENT_CUT; // How a new pipeline frame replaces the last ('x' cycles)
 
 // Slideshow speed control (intervals in milliseconds) - non-linear progression
 const unsigned long SLIDESHOW_SPEEDS[] = {500, 1000, 2000, 3000, 5000, 10000, 15000, 30000}; // 0.5s to 30s
@@ -37,37 +80,54 @@ int currentSpeedIndex = 4; // Start with 3 seconds (middle of range)
 unsigned long currentSlideshowInterval = SLIDESHOW_SPEEDS[currentSpeedIndex];
 
 const unsigned long BUTTON_HOLD_TIME = 2000; // 2 seconds to toggle mode (reduced from 3s)
+const unsigned long ALBUM_HOLD_TIME = 5000; // Keep holding to 5 seconds to jump to the next album
 const unsigned long DOUBLE_CLICK_TIME = 1200; // Increased to 1200ms for easier double-click
+const unsigned long BUTTON_DEBOUNCE_TIME = 20; // Edges closer than this to the last change are bounce
 const unsigned long MODE_DISPLAY_TIME = 2000; // Show mode graphics for 2 seconds
 const unsigned long SD_CHECK_INTERVAL = 3000; // Check for SD card every 3 seconds
 const unsigned long SPEED_INDICATOR_TIME = 800; // Reduced to 800ms for faster UI
+const int BENCHMARK_MAX_IMAGES = 32; // Images timed by the 'b' serial command
+const unsigned long HEARTBEAT_INTERVAL = 1000; // LED toggles every second to show we're alive
+const unsigned long HEAP_TELEMETRY_INTERVAL = 60000; // One heap/PSRAM summary line a minute
+const unsigned long LOOP_MAX_IDLE_MS = 50; // Longest loop() blocks, so serial commands stay responsive
 
-// Button state tracking
-unsigned long buttonPressTime = 0;
-unsigned long lastClickTime = 0;
-bool buttonPressed = false;
-bool holdDetected = false;
-bool waitingForDoubleClick = false;
+// Light sleep between deadlines when nothing is attached to the serial port
+POWER_CONFIG powerConfig;
+bool buttonNeedsResync = false; // Woke from light sleep: the pin may have changed unseen
+uint32_t lastWakeUs = 0;
+
+// Button gestures, decided from interrupt-timestamped edges (Button_Input)
+BUTTON_GESTURE buttonGesture;
 
 // Mode display tracking
 bool showingModeGraphic = false;
-unsigned long modeGraphicTimer = 0;
+SCHED_TIMER modeGraphicTimer;
 
 // Speed indicator overlay tracking
 bool showingSpeedIndicator = false;
-unsigned long speedIndicatorTimer = 0;
+SCHED_TIMER speedIndicatorTimer; // Hides the overlay, or steps the limit blink
 bool speedLimitBlink = false;
-unsigned long speedLimitBlinkTimer = 0;
 int speedLimitBlinkCount = 0;
 const unsigned long SPEED_LIMIT_BLINK_TIME = 300; // 300ms per blink
+const unsigned long SPEED_LIMIT_BLINK_GAP = 50; // Overlay off for 50ms within each blink
 const int SPEED_LIMIT_BLINK_TOTAL = 2; // Blink twice
+bool speedBlinkGap = false; // The overlay was cleared and is redrawn on the next step
 bool speedIncreased = false; // true if speed was increased, false if decreased
 
 // SD card monitoring
-unsigned long lastSDCheck = 0;
+SCHED_TIMER sdCheckTimer;
+SCHED_TIMER sdReloadTimer; // Reloads a new card once the scanning screen has been up
+const unsigned long SD_RELOAD_DELAY = 500; // Scanning screen shown before the reload
 bool lastSDCardState = false;
 
-// Image management for dynamic loading
+SCHED_TIMER heartbeatTimer;
+SCHED_TIMER ledFlashTimer; // Steps the mode-change LED flash
+int ledFlashStep = 0;
+const unsigned long LED_FLASH_TIME = 100; // 100ms per LED edge
+const int LED_FLASH_STEPS = 6; // On/off three times
+SCHED_TIMER heapTimer; // Periodic free / largest block / lowest-ever summary
+
+// Image management: embedded images first, then the files of the current SD album
 struct ImageInfo {
   String fileName;
   bool isEmbedded;
@@ -77,52 +137,87 @@ struct ImageInfo {
   uint16_t height;
 };
 
-const int MAX_TOTAL_IMAGES = 10;
-ImageInfo imageList[MAX_TOTAL_IMAGES];
+const int MAX_EMBEDDED_IMAGES = 10;
+ImageInfo imageList[MAX_EMBEDDED_IMAGES];
+int embeddedImageCount = 0;
 int totalImages = 0;
 int currentImageIndex = 0;  
 
+// SD images are decoded into the pipeline's back frame; after presenting an
+// image, the next one is prefetched while the present task drives the LCD
+bool prefetchPending = false;
+uint32_t lcdDrawStart = 0;
+
+// Animations (GIF, MJPEG clips) play from their own reader so prefetching never closes it
+SD_READER animReader;
+int animImage = -1;
+
 // Function declarations
 void drawString(int x, int y, const char* str, uint16_t color);
 void drawStringRotated(int x, int y, const char* str, uint16_t color);
+void displayCurrentImage();
+bool decodeIntoBackFrame(int image);
+void restartSlideshowTimer();
+void armSlideshowTimers();
+void printSlideshowStats();
+void printSchedulerStats();
+void printPowerStats();
 
 void GPIO_Init() {
   pinMode(DEV_CS_PIN, OUTPUT);
   pinMode(DEV_RST_PIN, OUTPUT);
   pinMode(DEV_DC_PIN, OUTPUT);
   pinMode(DEV_BL_PIN, OUTPUT);
-  analogWrite(DEV_BL_PIN, 140); // Set backlight
+  LCD_SetBacklight(560); // Set backlight
 }
 
-// Status image display functions
-void displayStatusImage(const uint16_t* imageData, uint16_t width, uint16_t height) {
-  LCD_Clear(BLACK);
-  Paint_DrawImage(imageData, 0, 0, width, height);
+// LCD drawing from loop() must not interleave with the present task
+void beginLCDDraw() {
+  Pipeline_WaitPresent();
+  Bus_Acquire(BUS_LCD, STAGE_UI);
+  lcdDrawStart = micros();
+}
+
+void endLCDDraw() {
+  Pipeline_Trace(STAGE_UI, BUS_LCD, -1, lcdDrawStart, micros());
+  Bus_Release(BUS_LCD);
+}
+
+// Status image display functions (RLE565 assets, decoded straight into LCD bursts).
+// The assets partition's copy is read in place when mounted, else the linked-in one.
+void displayStatusImage(ASSET_ID id) {
+  const ASSET* asset = Asset_Resolve(id);
+  beginLCDDraw();
+  if (asset->Width < LCD_WIDTH || asset->Height < LCD_HEIGHT) {
+    LCD_Clear(BLACK);
+  }
+  RLE565_DrawImage(asset->Data, asset->Size, 0, 0, asset->Width, asset->Height);
+  endLCDDraw();
 }
 
 void showNoSDCardStatus() {
   Serial.println("📱 Displaying: No SD Card");
-  displayStatusImage(no_sd_card_data, no_sd_card_data_width, no_sd_card_data_height);
+  displayStatusImage(ASSET_NO_SD_CARD);
 }
 
 void showNoImagesFoundStatus() {
   Serial.println("📱 Displaying: No Images Found");
-  displayStatusImage(no_images_found_data, no_images_found_data_width, no_images_found_data_height);
+  displayStatusImage(ASSET_NO_IMAGES_FOUND);
 }
 
 void showScanningStatus() {
   Serial.println("📱 Displaying: Scanning...");
-  displayStatusImage(scanning_data, scanning_data_width, scanning_data_height);
+  displayStatusImage(ASSET_SCANNING);
 }
 
 void showManualModeStatus() {
   Serial.println("📱 Displaying: Manual Mode");
-  displayStatusImage(manual_mode_data, manual_mode_data_width, manual_mode_data_height);
+  displayStatusImage(ASSET_MANUAL_MODE);
 }
 
 void showSlideshowModeStatus() {
   Serial.println("📱 Displaying: Slideshow Mode");
-  displayStatusImage(slideshow_mode_data, slideshow_mode_data_width, slideshow_mode_data_height);
+  displayStatusImage(ASSET_SLIDESHOW_MODE);
 }
 
 // Simple 5x7 pixel font patterns for digits and letters (normal upright orientation)
@@ -270,6 +365,8 @@ void drawSpeedIndicator(bool increased) {
   uint16_t orange = 0xFD20; // Orange color in RGB565
   uint16_t black = 0x0000;
   
+  beginLCDDraw();
+  
   // Clear the indicator area with black background
   for (int y = indicator_y; y < indicator_y + height; y++) {
     for (int x = indicator_x; x < indicator_x + width; x++) {
@@ -310,6 +407,8 @@ void drawSpeedIndicator(bool increased) {
   
   // Draw the speed text (rotated 90° clockwise)
   drawStringRotated(text_x, text_y, speedText, orange);
+  
+  endLCDDraw();
 }
 
 void Config_Init() {
@@ -347,7 +446,7 @@ void initializeEmbeddedImages() {
   totalImages++;
   */
   
-  Serial.println("✅ " + String(totalImages) + " embedded images initialized");
+  LOG_INFO("✅ %d embedded images initialized", totalImages);
 #else
   Serial.println("📸 Embedded images disabled - using SD card images only");
   Serial.println("💡 To enable embedded images, uncomment #define ENABLE_EMBEDDED_IMAGES in image.h");
@@ -357,6 +456,13 @@ void initializeEmbeddedImages() {
 // Global JPEG decoder
 JPEGDEC jpeg;
 
+// Decode buffer of loadJPEGFromSD, kept across images and only grown. It starts
+// at twice the panel each way, which covers everything the decoder's 1/2-1/8
+// scaling brings near the panel, so a run of photos allocates once.
+#define JPEG_TEMP_MIN_PIXELS ((uint32_t)(2 * LCD_HEIGHT) * (2 * LCD_WIDTH))
+uint16_t* jpegTemp = nullptr;
+uint32_t jpegTempPixels = 0;
+
 // Callback function for JPEG decoder to draw pixels
 int JPEGDraw(JPEGDRAW *pDraw) {
   // Get the target image buffer
@@ -374,7 +480,7 @@ int JPEGDraw(JPEGDRAW *pDraw) {
   // Debug info for first few calls
   static int callCount = 0;
   if (callCount < 3) {
-    Serial.println("🎨 JPEGDraw: x=" + String(x) + " y=" + String(y) + " w=" + String(w) + " h=" + String(h));
+    LOG_DEBUG("🎨 JPEGDraw: x=%d y=%d w=%d h=%d", x, y, w, h);
     callCount++;
   }
   
@@ -400,52 +506,53 @@ int JPEGDraw(JPEGDRAW *pDraw) {
   return 1; // Return 1 to continue decoding
 }
 
-uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* height) {
-  Serial.println("📖 Loading JPEG: " + fileName);
-  
-  File jpegFile = SD.open("/" + fileName);
-  if (!jpegFile) {
-    Serial.println("❌ Failed to open: " + fileName);
-    return nullptr;
-  }
-  
-  // Read entire file into memory
-  size_t fileSize = jpegFile.size();
-  uint8_t* jpegData = (uint8_t*)malloc(fileSize);
-  if (jpegData == nullptr) {
-    Serial.println("❌ Failed to allocate memory for JPEG data");
-    jpegFile.close();
-    return nullptr;
-  }
-  
-  jpegFile.read(jpegData, fileSize);
-  jpegFile.close();
-  
-  // Initialize JPEG decoder
-  if (!jpeg.openRAM(jpegData, fileSize, JPEGDraw)) {
-    Serial.println("❌ Failed to open JPEG");
-    free(jpegData);
-    return nullptr;
+// All SD loaders read through one buffered read-ahead reader
+SD_READER sdReader;
+
+// JPEGDEC file callbacks backed by sdReader
+void* JPEGOpen(const char* path, int32_t* size) {
+  if (!SDReader_Open(&sdReader, path)) return nullptr;
+  *size = SDReader_Size(&sdReader);
+  return &sdReader;
+}
+
+void JPEGClose(void* handle) {
+  SDReader_Close((SD_READER*)handle);
+}
+
+int32_t JPEGRead(JPEGFILE* file, uint8_t* buffer, int32_t length) {
+  SD_READER* reader = (SD_READER*)file->fHandle;
+  int32_t got = SDReader_Read(reader, buffer, length);
+  file->iPos = SDReader_Position(reader);
+  return got;
+}
+
+int32_t JPEGSeek(JPEGFILE* file, int32_t position) {
+  SD_READER* reader = (SD_READER*)file->fHandle;
+  if (!SDReader_Seek(reader, position)) return -1;
+  file->iPos = position;
+  return position;
+}
+
+// Decode a JPEG into imageData (display-sized), scaled, letterboxed and rotated
+bool loadJPEGFromSD(const char* path, uint16_t* imageData) {
+  LOG_INFO("📖 Loading JPEG: %s", path);
+  
+  // Stream the file through the read-ahead reader instead of loading it whole
+  if (!jpeg.open(path, JPEGOpen, JPEGClose, JPEGRead, JPEGSeek, JPEGDraw)) {
+    LOG_ERROR("❌ Failed to open JPEG: %s", path);
+    return false;
   }
   
   int imgWidth = jpeg.getWidth();
   int imgHeight = jpeg.getHeight();
   
-  Serial.println("📏 Original size: " + String(imgWidth) + "x" + String(imgHeight));
+  LOG_DEBUG("📏 Original size: %dx%d", imgWidth, imgHeight);
   
   // Display dimensions
   int displayWidth = 135;
   int displayHeight = 240;
   
-  // Allocate buffer for final image (full display size)
-  uint16_t* imageData = (uint16_t*)malloc(displayWidth * displayHeight * sizeof(uint16_t));
-  if (imageData == nullptr) {
-    Serial.println("❌ Failed to allocate image buffer");
-    jpeg.close();
-    free(jpegData);
-    return nullptr;
-  }
-  
   // Fill with black for letterbox background
   memset(imageData, 0, displayWidth * displayHeight * sizeof(uint16_t));
   
@@ -463,9 +570,8 @@ uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* heig
   int offsetX = (displayWidth - finalWidth) / 2;
   int offsetY = (displayHeight - finalHeight) / 2;
   
-  Serial.println("📐 Target size (after rotation): " + String(finalWidth) + "x" + String(finalHeight));
-  Serial.println("📍 Offset: (" + String(offsetX) + ", " + String(offsetY) + ")");
-  Serial.println("🔍 Scale factor: " + String(scale, 3));
+  LOG_DEBUG("📐 Target size (after rotation): %dx%d, offset (%d, %d), scale %d/1000",
+            finalWidth, finalHeight, offsetX, offsetY, (int)(scale * 1000));
   
   // Use built-in JPEG scaling if possible
   int scaleFlag = 0;
@@ -474,7 +580,7 @@ uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* heig
   else if (scale <= 0.5) scaleFlag = JPEG_SCALE_HALF;
   
   if (scaleFlag != 0) {
-    Serial.println("🎯 Using hardware scale: " + String(scaleFlag));
+    LOG_DEBUG("🎯 Using hardware scale: %d", scaleFlag);
   }
   
   // Create a temporary larger buffer for the decoded JPEG
@@ -491,13 +597,18 @@ uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* heig
     }
   }
   
-  uint16_t* tempBuffer = (uint16_t*)malloc(tempWidth * tempHeight * sizeof(uint16_t));
+  uint32_t tempPixels = (uint32_t)tempWidth * tempHeight;
+  if (tempPixels > jpegTempPixels) {
+    uint32_t pixels = max(tempPixels, JPEG_TEMP_MIN_PIXELS);
+    Heap_Free(jpegTemp);
+    jpegTemp = (uint16_t*)Heap_Alloc(HEAP_DECODER, pixels * sizeof(uint16_t), HEAP_CAP_DEFAULT);
+    jpegTempPixels = jpegTemp != nullptr ? pixels : 0;
+  }
+  uint16_t* tempBuffer = jpegTemp;
   if (tempBuffer == nullptr) {
-    Serial.println("❌ Failed to allocate temp buffer");
-    free(imageData);
+    LOG_ERROR("❌ Failed to allocate temp buffer");
     jpeg.close();
-    free(jpegData);
-    return nullptr;
+    return false;
   }
   
   // Create temp ImageInfo for decoding
@@ -513,11 +624,11 @@ uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* heig
   bool success = jpeg.decode(0, 0, scaleFlag);
   
   if (success) {
-    Serial.println("✅ JPEG decoded to temp buffer");
+    LOG_DEBUG("✅ JPEG decoded to temp buffer");
     
     // Now manually scale/copy from temp buffer to final buffer with 270° clockwise rotation (90° + 180°)
     // For 270° clockwise rotation (or 90° counter-clockwise): new_x = old_height - 1 - old_y, new_y = old_x
-    
+    PROFILE_SCOPE(PROF_TRANSFORM);
     for (int srcY = 0; srcY < tempHeight; srcY++) {
       for (int srcX = 0; srcX < tempWidth; srcX++) {
         // Source pixel index
@@ -545,83 +656,354 @@ uint16_t* loadJPEGFromSD(const String& fileName, uint16_t* width, uint16_t* heig
       }
     }
     
-    Serial.println("✅ Scaled, letterboxed, and rotated 270° clockwise (corrected orientation)");
-    *width = displayWidth;
-    *height = displayHeight;
+    LOG_DEBUG("✅ Scaled, letterboxed, and rotated 270° clockwise (corrected orientation)");
   } else {
-    Serial.println("❌ JPEG decode failed");
-    free(imageData);
-    imageData = nullptr;
+    LOG_ERROR("❌ JPEG decode failed");
   }
   
-  free(tempBuffer);
   jpeg.close();
-  free(jpegData);
+  LOG_INFO("💾 SD read: %u bytes in %u reads, %u KB/s", (unsigned)sdReader.Stats.BytesRead,
+           (unsigned)sdReader.Stats.Reads, (unsigned)(SDReader_MBps(&sdReader.Stats) * 1000));
   
-  return imageData;
+  return success;
+}
+
+void refreshImageCount() {
+  totalImages = embeddedImageCount + Album_FileCount();
+}
+
+void stopAnimation() {
+  GIF_Stop();
+  MJPEG_Stop();
+  Flipbook_Stop();
+  animImage = -1;
+}
+
+bool enterAlbum(int album) {
+  if (!Album_Enter(album)) {
+    LOG_ERROR("❌ Failed to index album %d", album + 1);
+    return false;
+  }
+  Pipeline_Invalidate();
+  stopAnimation();
+  currentImageIndex = 0;
+  refreshImageCount();
+  LOG_INFO("📂 Album %d/%d: %s (%d images)", album + 1, Album_Count(), Album_Get(album)->Path,
+           Album_FileCount());
+  return true;
+}
+
+void reportScanComplete() {
+  LOG_INFO("✅ SD card scan complete - found %d albums", Album_Count());
+  if (Album_SkippedDirs() > 0) {
+    LOG_WARN("⚠️  Skipped %u folders (album, depth or path limit reached)", (unsigned)Album_SkippedDirs());
+  }
 }
 
 void loadSDCardImages() {
-  if (!sdCardInitialized || totalImages >= MAX_TOTAL_IMAGES) return;
+  if (!sdCardInitialized) return;
   
-  Serial.println("🔍 Loading images from SD card...");
-  File root = SD.open("/");
-  if (!root) {
-    Serial.println("❌ Failed to open SD root directory");
-    return;
+  Serial.println("🔍 Scanning SD card for albums...");
+  Album_ScanBegin("/");
+  
+  // Only block until the first album turns up; loop() discovers the rest
+  Bus_Acquire(BUS_SD, STAGE_SCAN);
+  while (Album_Count() == 0 && Album_ScanStep(ALBUM_SCAN_BUDGET) == SCAN_RUNNING) {
+  }
+  Bus_Release(BUS_SD);
+  if (Album_ScanState() == SCAN_DONE) {
+    reportScanComplete();
+  }
+  if (Album_Count() > 0) {
+    enterAlbum(0);
+  }
+}
+
+// Incremental album discovery, one bounded step per loop() pass
+void continueAlbumScan() {
+  if (Album_ScanState() != SCAN_RUNNING) return;
+  
+  Bus_Acquire(BUS_SD, STAGE_SCAN);
+  SCAN_STATE state = Album_ScanStep(ALBUM_SCAN_BUDGET);
+  Bus_Release(BUS_SD);
+  if (state == SCAN_DONE) {
+    reportScanComplete();
   }
   
-  int sdImagesLoaded = 0;
-  File file = root.openNextFile();
-  while (file && totalImages < MAX_TOTAL_IMAGES) {
-    if (!file.isDirectory()) {
-      String fileName = file.name();
-      String lowerName = fileName;
-      lowerName.toLowerCase();
-      
-      // Check for supported image formats
-      if (lowerName.endsWith(".jpg") || lowerName.endsWith(".jpeg")) {
-        Serial.println("🖼️  Loading JPEG: " + fileName);
-        
-        uint16_t width, height;
-        uint16_t* imageData = loadJPEGFromSD(fileName, &width, &height);
-        
-        if (imageData != nullptr) {
-          imageList[totalImages].fileName = fileName;
-          imageList[totalImages].isEmbedded = false;
-          imageList[totalImages].embeddedData = nullptr;
-          imageList[totalImages].sdData = imageData;
-          imageList[totalImages].width = width;
-          imageList[totalImages].height = height;
-          totalImages++;
-          sdImagesLoaded++;
-          Serial.println("✅ Loaded JPEG: " + fileName);
-        }
-      } else if (lowerName.endsWith(".png") || lowerName.endsWith(".bmp")) {
-        Serial.println("⚠️  PNG/BMP not yet supported: " + fileName);
-        // TODO: Add PNG/BMP support later if needed
-      }
+  // First album found after setup showed "no images": show it right away
+  if (Album_Current() < 0 && Album_Count() > 0 && enterAlbum(0)) {
+    if (totalImages > 0 && !showingModeGraphic) {
+      displayCurrentImage();
+    }
+  }
+}
+
+bool hasExtension(const char* path, const char* ext) {
+  const char* dot = strrchr(path, '.');
+  return dot != nullptr && strcasecmp(dot, ext) == 0;
+}
+
+// Stream a BMP row by row into imageData (display-sized)
+bool loadBMPFromSD(const char* path, uint16_t* imageData) {
+  LOG_INFO("📖 Loading BMP: %s", path);
+  
+  if (!SDReader_Open(&sdReader, path)) {
+    LOG_ERROR("❌ Failed to open BMP: %s", path);
+    return false;
+  }
+  BMP_INFO info;
+  bool success = BMP_ReadHeader(&sdReader, &info) && BMP_DecodeToFrame(&sdReader, &info, imageData);
+  if (!success) {
+    LOG_ERROR("❌ Unsupported or truncated BMP (16/24-bit uncompressed only)");
+  }
+  SDReader_Close(&sdReader);
+  return success;
+}
+
+// Inflate a PNG scanline by scanline into imageData (display-sized)
+bool loadPNGFromSD(const char* path, uint16_t* imageData) {
+  LOG_INFO("📖 Loading PNG: %s", path);
+  
+  uint32_t t0 = micros();
+  if (!PNG_LoadToFrame(&sdReader, path, imageData)) {
+    LOG_ERROR("❌ PNG failed: %s", PNG_LastError());
+    return false;
+  }
+  LOG_INFO("✅ PNG decoded in %u ms, working memory %u bytes", (unsigned)((micros() - t0) / 1000),
+           (unsigned)PNG_WorkingMemory());
+  return true;
+}
+
+// Decode any supported SD image into a display-sized frame
+bool loadImageFromSD(const char* path, uint16_t* imageData) {
+  if (hasExtension(path, ".bmp")) {
+    return loadBMPFromSD(path, imageData);
+  }
+  if (hasExtension(path, ".png")) {
+    return loadPNGFromSD(path, imageData);
+  }
+  if (hasExtension(path, ".565")) {
+    return false; // Only ever streamed to the panel (presentRaw565Direct)
+  }
+  return loadJPEGFromSD(path, imageData);
+}
+
+// 240x135 RGB565 BMPs go from the card to the panel with no frame or conversion
+bool presentBMPDirect(const char* path) {
+  if (!hasExtension(path, ".bmp")) return false;
+  
+  Bus_Acquire(BUS_SD, STAGE_DECODE);
+  bool success = false;
+  if (SDReader_Open(&sdReader, path)) {
+    BMP_INFO info;
+    if (BMP_ReadHeader(&sdReader, &info) && BMP_IsPanelNative(&info)) {
+      beginLCDDraw();
+      PROFILE_SCOPE(PROF_PRESENT);
+      success = BMP_StreamToPanel(&sdReader, &info);
+      endLCDDraw();
+    }
+    SDReader_Close(&sdReader);
+  }
+  PROFILE_FLUSH(currentImageIndex);
+  Bus_Release(BUS_SD);
+  return success;
+}
+
+// Panel-ready .565 files are streamed to the LCD in bursts with no decode at all
+bool presentRaw565Direct(const char* path) {
+  if (!hasExtension(path, ".565")) return false;
+  
+  Bus_Acquire(BUS_SD, STAGE_DECODE);
+  bool success = false;
+  uint32_t t0 = micros();
+  if (SDReader_Open(&sdReader, path)) {
+    RAW565_INFO info;
+    if (Raw565_ReadHeader(&sdReader, &info)) {
+      beginLCDDraw();
+      PROFILE_SCOPE(PROF_PRESENT);
+      success = Raw565_StreamToPanel(&sdReader, &info);
+      endLCDDraw();
     }
-    file = root.openNextFile();
+    SDReader_Close(&sdReader);
+  }
+  PROFILE_FLUSH(currentImageIndex);
+  Bus_Release(BUS_SD);
+  if (success) {
+    LOG_INFO("✅ .565 streamed in %u ms", (unsigned)((micros() - t0) / 1000));
+  } else {
+    LOG_ERROR("❌ Not a panel-ready .565 file: %s", path);
+  }
+  return success;
+}
+
+// Read and decode an SD image into the pipeline's back frame (SD bus only)
+bool decodeIntoBackFrame(int image) {
+  char path[ALBUM_MAX_PATH];
+  if (!Album_FilePath(image - embeddedImageCount, path, sizeof(path))) return false;
+  
+  Pipeline_SetBackImage(-1);
+  Bus_Acquire(BUS_SD, STAGE_DECODE);
+  uint32_t t0 = micros();
+  bool success;
+  {
+    PROFILE_SCOPE(PROF_DECODE);
+    success = loadImageFromSD(path, Pipeline_BackFrame());
   }
+  uint32_t t1 = micros();
+  PROFILE_FLUSH(image);
+  Pipeline_Trace(STAGE_DECODE, BUS_SD, image, t0, t1);
+  Bus_Release(BUS_SD);
   
-  root.close();
-  Serial.println("✅ SD card scan complete - loaded " + String(sdImagesLoaded) + " JPEG images");
+  if (success) {
+    Pipeline_SetBackImage(image);
+    Slide_RecordPrepare(&slideClock, t1 - t0);
+  }
+  return success;
+}
+
+// An interlaced PNG being decoded for the screen shows its coarse first pass meanwhile
+void presentDecodePreview(const uint16_t* frame) {
+  Pipeline_PresentPreview(frame, currentImageIndex);
 }
 
 void displayCurrentImage() {
   if (totalImages == 0) return;
+  if (animImage != currentImageIndex) stopAnimation();
+  if (Flipbook_IsPlaying()) {
+    Flipbook_Redraw();
+    return;
+  }
   
-  ImageInfo& img = imageList[currentImageIndex];
-  String modeText = slideshowMode ? 
-    "(Slideshow " + String(currentSlideshowInterval/1000.0, 1) + "s)" : 
-    "(Manual)";
-  Serial.println("🖼️  Displaying (" + String(currentImageIndex + 1) + "/" + String(totalImages) + "): " + img.fileName + " " + modeText);
+  // Mode text without a float: "(Slideshow 2.5s)" from the interval in ms
+  char modeText[24];
+  if (slideshowMode) {
+    snprintf(modeText, sizeof(modeText), "(Slideshow %u.%us)", (unsigned)(currentSlideshowInterval / 1000),
+             (unsigned)(currentSlideshowInterval % 1000 / 100));
+  } else {
+    snprintf(modeText, sizeof(modeText), "(Manual)");
+  }
   
-  if (img.isEmbedded) {
+  if (currentImageIndex < embeddedImageCount) {
+    ImageInfo& img = imageList[currentImageIndex];
+    LOG_INFO("🖼️  Displaying (%d/%d): %s %s", currentImageIndex + 1, totalImages, img.fileName.c_str(), modeText);
+    beginLCDDraw();
     Paint_DrawImage(img.embeddedData, 0, 0, img.width, img.height);
+    endLCDDraw();
+    return;
+  }
+  
+  char path[ALBUM_MAX_PATH];
+  if (!Album_FilePath(currentImageIndex - embeddedImageCount, path, sizeof(path))) return;
+  LOG_INFO("🖼️  Displaying (%d/%d): %s %s", currentImageIndex + 1, totalImages, path, modeText);
+  
+  // Animations are decoded frame by frame from loop(); an overlay redraw just repaints the canvas
+  if (hasExtension(path, ".gif")) {
+    if (animImage == currentImageIndex) {
+      GIF_Redraw();
+    } else if (GIF_Start(&animReader, path)) {
+      animImage = currentImageIndex;
+    } else {
+      LOG_ERROR("❌ GIF: %s", GIF_LastError());
+    }
+    prefetchPending = true;
+    return;
+  }
+  
+  // Clips decode through the pipeline frames from loop(); a redraw re-presents the last frame
+  if (MJPEGClip_IsClipFile(path)) {
+    if (animImage == currentImageIndex) {
+      MJPEG_Redraw();
+    } else if (MJPEG_Start(&animReader, path, currentImageIndex)) {
+      animImage = currentImageIndex;
+    } else {
+      LOG_ERROR("❌ Clip: %s", MJPEG_LastError());
+    }
+    return;
+  }
+  
+  // Overlay redraws reuse the front frame; a prefetched image is just swapped in and slides over the last
+  PIPE_PRESENT present = PRESENT_CUT;
+  if (Pipeline_FrontImage() != currentImageIndex) {
+    if (Pipeline_BackImage() != currentImageIndex) {
+      frameShownUs = micros();
+      if (presentBMPDirect(path) || presentRaw565Direct(path)) {
+        prefetchPending = true;
+        return;
+      }
+      PNG_SetPreview(presentDecodePreview);
+      bool decoded = decodeIntoBackFrame(currentImageIndex);
+      PNG_SetPreview(NULL);
+      if (!decoded) return;
+    }
+    Pipeline_Swap();
+    present = slideTransition;
+  }
+  Latency_FrameReady(micros());
+  Pipeline_PresentFrontWith(present);
+  frameShownUs = micros();
+  prefetchPending = true;
+}
+
+// Decode the image after the current one while the present task pushes this one
+void prefetchNextImage() {
+  if (!prefetchPending) return;
+  prefetchPending = false;
+  if (MJPEG_IsPlaying() || Flipbook_IsPlaying()) return; // The clip or flipbook owns the pipeline frames
+  
+  if (totalImages < 2) return;
+  int next = (currentImageIndex + 1) % totalImages;
+  if (next < embeddedImageCount || Pipeline_BackImage() == next || Pipeline_FrontImage() == next) return;
+  
+  char path[ALBUM_MAX_PATH];
+  if (!Album_FilePath(next - embeddedImageCount, path, sizeof(path))) return;
+  if (hasExtension(path, ".gif") || hasExtension(path, ".565") || MJPEGClip_IsClipFile(path)) {
+    return; // Never decoded into a frame
+  }
+  decodeIntoBackFrame(next);
+}
+
+// One flipbook frame: .565 files as stored, anything else decoded, fitted and put in wire order
+bool loadFlipbookFrame(int file, uint8_t* panelBytes) {
+  char path[ALBUM_MAX_PATH];
+  if (!Album_FilePath(file, path, sizeof(path))) return false;
+  if (hasExtension(path, ".gif") || MJPEGClip_IsClipFile(path)) return false;
+  
+  Bus_Acquire(BUS_SD, STAGE_DECODE);
+  uint32_t t0 = micros();
+  bool success = false;
+  if (hasExtension(path, ".565")) {
+    PROFILE_SCOPE(PROF_DECODE);
+    if (SDReader_Open(&sdReader, path)) {
+      RAW565_INFO info;
+      success = Raw565_ReadHeader(&sdReader, &info) && Raw565_ReadFrame(&sdReader, &info, panelBytes);
+      SDReader_Close(&sdReader);
+    }
+  } else {
+    PROFILE_SCOPE(PROF_DECODE);
+    Pipeline_SetBackImage(-1);
+    uint16_t* frame = Pipeline_BackFrame();
+    success = loadImageFromSD(path, frame);
+    for (int i = 0; success && i < LCD_WIDTH * LCD_HEIGHT; i++) {
+      panelBytes[2 * i] = frame[i] >> 8;
+      panelBytes[2 * i + 1] = frame[i] & 0xFF;
+    }
+  }
+  PROFILE_FLUSH(embeddedImageCount + file);
+  Pipeline_Trace(STAGE_DECODE, BUS_SD, embeddedImageCount + file, t0, micros());
+  Bus_Release(BUS_SD);
+  return success;
+}
+
+// Play the current album as a flipbook (its files in name order)
+void startFlipbook(uint16_t fps, FLIPBOOK_MODE mode) {
+  stopAnimation();
+  Pipeline_Invalidate();
+  if (Flipbook_Start(Album_FileCount(), fps, mode, loadFlipbookFrame, currentImageIndex)) {
+    animImage = currentImageIndex;
+    Serial.printf("📽️  Flipbook: loading %d frames, %u fps, %s\n", Album_FileCount(), (unsigned)fps,
+                  mode == FLIPBOOK_PINGPONG ? "ping-pong" : "loop");
   } else {
-    Paint_DrawImage(img.sdData, 0, 0, img.width, img.height);
+    LOG_ERROR("❌ Flipbook: %s", Flipbook_LastError());
   }
 }
 
@@ -632,12 +1014,33 @@ void nextImage() {
   }
 }
 
+void nextAlbum() {
+  if (Album_Count() < 2) {
+    Serial.println("📂 No other album on the SD card");
+    return;
+  }
+  if (enterAlbum((Album_Current() + 1) % Album_Count())) {
+    restartSlideshowTimer();
+    uint16_t fps;
+    FLIPBOOK_MODE mode;
+    if (totalImages > 0) {
+      displayCurrentImage();
+      if (Flipbook_ParseName(Album_Get(Album_Current())->Path, &fps, &mode)) {
+        startFlipbook(fps, mode);
+      }
+    } else {
+      showNoImagesFoundStatus();
+    }
+  }
+}
+
 void toggleSlideshowMode() {
   slideshowMode = !slideshowMode;
-  slideshowTimer = millis();
+  restartSlideshowTimer();
   
   if (slideshowMode) {
-    Serial.println("🎬 Slideshow mode ENABLED - Auto-advancing every " + String(currentSlideshowInterval/1000.0, 1) + " seconds");
+    LOG_INFO("🎬 Slideshow mode ENABLED - Auto-advancing every %lu.%lu seconds",
+             currentSlideshowInterval / 1000, currentSlideshowInterval % 1000 / 100);
     Serial.println("💡 Single press: Slower | Double press: Faster | Hold 2s: Manual mode");
     showSlideshowModeStatus();
   } else {
@@ -648,70 +1051,33 @@ void toggleSlideshowMode() {
   
   // Set mode display timer (non-blocking)
   showingModeGraphic = true;
-  modeGraphicTimer = millis();
+  Sched_After(&modeGraphicTimer, millis(), MODE_DISPLAY_TIME);
 }
 
 void checkAndReloadSDCard() {
   // Try to reinitialize SD card
-  bool currentSDState = SD.begin(SDCARD_SS_PIN, sdSPI, 80000000);
+  Bus_Acquire(BUS_SD, STAGE_SCAN);
+  bool currentSDState = SD.begin(SDCARD_SS_PIN, sdSPI, SD_SPI_FREQUENCY);
+  Bus_Release(BUS_SD);
   
   if (currentSDState != lastSDCardState) {
     if (currentSDState) {
       Serial.println("🔄 SD Card detected! Reloading images...");
       showScanningStatus();
-      delay(500);
-      
-      // Clear existing SD card images
-      for (int i = 0; i < totalImages; i++) {
-        if (!imageList[i].isEmbedded && imageList[i].sdData != nullptr) {
-          free(imageList[i].sdData);
-          imageList[i].sdData = nullptr;
-        }
-      }
-      
-      // Reset to only embedded images
-      int embeddedCount = 0;
-      for (int i = 0; i < totalImages; i++) {
-        if (imageList[i].isEmbedded) {
-          if (i != embeddedCount) {
-            imageList[embeddedCount] = imageList[i];
-          }
-          embeddedCount++;
-        }
-      }
-      totalImages = embeddedCount;
-      
-      // Reload SD card images
-      sdCardInitialized = true;
-      loadSDCardImages();
-      currentImageIndex = 0;
-      
-      Serial.println("✅ SD Card reloaded! Total images: " + String(totalImages));
-      
-      if (totalImages > 0) {
-        displayCurrentImage();
-      } else {
-        showNoImagesFoundStatus();
-      }
+      // The reload runs from sdReloadTimer; no slide may cover the scanning screen until then
+      Sched_Cancel(&slideshowTimer);
+      Sched_Cancel(&slidePrepareTimer);
+      Sched_After(&sdReloadTimer, millis(), SD_RELOAD_DELAY);
     } else {
       Serial.println("⚠️  SD Card removed!");
       sdCardInitialized = false;
       
       // Keep only embedded images
-      int embeddedCount = 0;
-      for (int i = 0; i < totalImages; i++) {
-        if (imageList[i].isEmbedded) {
-          if (i != embeddedCount) {
-            imageList[embeddedCount] = imageList[i];
-          }
-          embeddedCount++;
-        } else if (imageList[i].sdData != nullptr) {
-          free(imageList[i].sdData);
-          imageList[i].sdData = nullptr;
-        }
-      }
-      totalImages = embeddedCount;
+      Album_Reset();
+      Pipeline_Invalidate();
+      stopAnimation();
       currentImageIndex = 0;
+      refreshImageCount();
       
       if (totalImages > 0) {
         displayCurrentImage();
@@ -723,18 +1089,43 @@ void checkAndReloadSDCard() {
   }
 }
 
+void reloadSDCard() {
+  // Forget the previous card's albums and decoded frame
+  Album_Reset();
+  Pipeline_Invalidate();
+  stopAnimation();
+  currentImageIndex = 0;
+  refreshImageCount();
+  
+  // Reload SD card images
+  sdCardInitialized = true;
+  loadSDCardImages();
+  
+  LOG_INFO("✅ SD Card reloaded! Total images: %d", totalImages);
+  Heap_Print("card reload"); // Live bytes that grow from one card to the next are a leak
+  
+  if (totalImages > 0) {
+    displayCurrentImage();
+  } else {
+    showNoImagesFoundStatus();
+  }
+  restartSlideshowTimer();
+}
+
 void adjustSlideshowSpeed(bool increase) {
   bool hitLimit = false;
   
   if (increase && currentSpeedIndex > 0) {
     currentSpeedIndex--; // Lower index = faster (shorter interval)
     currentSlideshowInterval = SLIDESHOW_SPEEDS[currentSpeedIndex];
-    Serial.println("⚡ Slideshow speed INCREASED to " + String(currentSlideshowInterval/1000.0, 2) + " seconds");
+    LOG_INFO("⚡ Slideshow speed INCREASED to %lu.%02lu seconds",
+             currentSlideshowInterval / 1000, currentSlideshowInterval % 1000 / 10);
     speedIncreased = true;
   } else if (!increase && currentSpeedIndex < NUM_SPEEDS - 1) {
     currentSpeedIndex++; // Higher index = slower (longer interval)
     currentSlideshowInterval = SLIDESHOW_SPEEDS[currentSpeedIndex];
-    Serial.println("🐌 Slideshow speed DECREASED to " + String(currentSlideshowInterval/1000.0, 2) + " seconds");
+    LOG_INFO("🐌 Slideshow speed DECREASED to %lu.%02lu seconds",
+             currentSlideshowInterval / 1000, currentSlideshowInterval % 1000 / 10);
     speedIncreased = false;
   } else {
     Serial.println("⚠️  Speed limit reached!");
@@ -745,15 +1136,15 @@ void adjustSlideshowSpeed(bool increase) {
   // Show speed indicator overlay immediately
   if (totalImages > 0 && !showingModeGraphic) {
     showingSpeedIndicator = true;
-    speedIndicatorTimer = millis();
     
     // If we hit a limit, set up blinking
     if (hitLimit) {
       speedLimitBlink = true;
-      speedLimitBlinkTimer = millis();
       speedLimitBlinkCount = 0;
+      Sched_After(&speedIndicatorTimer, millis(), SPEED_LIMIT_BLINK_TIME);
     } else {
       speedLimitBlink = false;
+      Sched_After(&speedIndicatorTimer, millis(), SPEED_INDICATOR_TIME);
     }
     
     drawSpeedIndicator(speedIncreased);
@@ -761,23 +1152,513 @@ void adjustSlideshowSpeed(bool increase) {
   
   // Reset timer with new interval (only if speed actually changed)
   if (!hitLimit) {
-    slideshowTimer = millis();
+    restartSlideshowTimer();
+  }
+}
+
+// Time-to-display of each image in the current album, averaged per format
+void benchmarkAlbum() {
+  const char* formats[] = {".jpg", ".jpeg", ".bmp", ".png", ".565"};
+  const int NUM_FORMATS = sizeof(formats) / sizeof(formats[0]);
+  uint32_t totalUs[NUM_FORMATS] = {0};
+  uint32_t worstUs[NUM_FORMATS] = {0};
+  int count[NUM_FORMATS] = {0};
+  int files = min(Album_FileCount(), BENCHMARK_MAX_IMAGES);
+  
+  LOG_INFO("⏱️  Benchmarking %d images...", files);
+  stopAnimation();
+  for (int i = 0; i < files; i++) {
+    char path[ALBUM_MAX_PATH];
+    if (!Album_FilePath(i, path, sizeof(path))) continue;
+    int format = -1;
+    for (int f = 0; f < NUM_FORMATS; f++) {
+      if (hasExtension(path, formats[f])) format = f;
+    }
+    if (format < 0) continue;
+    
+    // Cold path: card to glass, nothing prefetched
+    Pipeline_Invalidate();
+    uint32_t t0 = micros();
+    bool shown = presentBMPDirect(path) || presentRaw565Direct(path);
+    if (!shown && decodeIntoBackFrame(embeddedImageCount + i)) {
+      Pipeline_Swap();
+      Pipeline_PresentFront();
+      Pipeline_WaitPresent();
+      shown = true;
+    }
+    if (!shown) continue;
+    uint32_t us = micros() - t0;
+    totalUs[format] += us;
+    worstUs[format] = max(worstUs[format], us);
+    count[format]++;
+  }
+  
+  for (int f = 0; f < NUM_FORMATS; f++) {
+    if (count[f] == 0) continue;
+    uint32_t avgUs = totalUs[f] / count[f];
+    LOG_INFO("⏱️  %s: %d images, avg %u.%u ms, worst %u.%u ms", formats[f], count[f],
+             (unsigned)(avgUs / 1000), (unsigned)(avgUs % 1000 / 100),
+             (unsigned)(worstUs[f] / 1000), (unsigned)(worstUs[f] % 1000 / 100));
+  }
+  Pipeline_Invalidate();
+  displayCurrentImage();
+}
+
+#if BENCHMARK_BUILD
+// Bench_Suite hooks: one overlay text line, and an image from card to glass with nothing prefetched
+void benchDrawText(const char* text) {
+  beginLCDDraw();
+  drawStringRotated(LCD_WIDTH - 18, 10, text, WHITE);
+  endLCDDraw();
+}
+
+bool benchShowImage(const char* path) {
+  Pipeline_Invalidate();
+  if (presentBMPDirect(path) || presentRaw565Direct(path)) return true;
+  
+  Pipeline_SetBackImage(-1);
+  Bus_Acquire(BUS_SD, STAGE_DECODE);
+  bool success = loadImageFromSD(path, Pipeline_BackFrame());
+  Bus_Release(BUS_SD);
+  if (!success) return false;
+  Pipeline_Swap();
+  Pipeline_PresentFront();
+  Pipeline_WaitPresent();
+  return true;
+}
+
+// The JSON-lines benchmark suite over the corpus in /bench (env:benchmark)
+void runBenchmarkSuite() {
+  static const BENCH_HOOKS hooks = {benchDrawText, benchShowImage};
+  stopAnimation();
+  Bench_RunAll(BENCH_CORPUS_DIR, &hooks);
+  Pipeline_Invalidate();
+  displayCurrentImage();
+}
+#endif
+
+// Single-character commands from the serial monitor
+void handleSerialCommand() {
+  if (!Serial.available()) return;
+  
+  char command = Serial.read();
+  if (command == 't') {
+    Pipeline_DumpTrace();
+  } else if (command == 'g') {
+    GIF_PrintStats();
+  } else if (command == 'v') {
+    MJPEG_PrintStats();
+  } else if (command == 'b') {
+    benchmarkAlbum();
+  } else if (command == 'i') {
+    printSchedulerStats();
+  } else if (command == 'l') {
+    Latency_Print();
+  } else if (command == 'e') {
+    Latency_DumpEdges();
+  } else if (command == 'o') {
+    Boot_Print();
+  } else if (command == 'f') {
+    // Toggle flipbook playback of the current album (rate and mode from a ".flip" folder name)
+    if (Flipbook_IsPlaying()) {
+      stopAnimation();
+      displayCurrentImage();
+    } else if (Album_Current() >= 0 && Album_FileCount() > 0) {
+      uint16_t fps;
+      FLIPBOOK_MODE mode;
+      Flipbook_ParseName(Album_Get(Album_Current())->Path, &fps, &mode);
+      startFlipbook(fps, mode);
+    }
+  } else if (command == 'j') {
+    printSlideshowStats();
+  } else if (command == 'r') {
+    Profiler_Dump();
+    Profiler_Reset();
+  } else if (command == 'm') {
+    Heap_Print("serial");
+#if BENCHMARK_BUILD
+  } else if (command == 'y') {
+    runBenchmarkSuite();
+#endif
+  } else if (command == 'p') {
+    printPowerStats();
+  } else if (command == 'z') {
+    powerConfig.Enabled = !powerConfig.Enabled;
+    Serial.printf("💤 Light sleep %s\n", powerConfig.Enabled ? "enabled" : "disabled");
+  } else if (command == 'x') {
+    slideTransition = (PIPE_PRESENT)((slideTransition + 1) % PRESENT_MODE_COUNT);
+    const PIPE_TRANSITION_STATS* stats = Pipeline_TransitionStats();
+    Serial.printf("🎞️  Transition: %s (%u done, %u bytes, %u steps, %u late, last %.1f ms)\n",
+                  Pipeline_PresentName(slideTransition), (unsigned)stats->Transitions,
+                  (unsigned)stats->Bytes, (unsigned)stats->Steps, (unsigned)stats->LateSteps,
+                  stats->LastUs / 1000.0);
+    Serial.printf("🎞️  Last: %u frames, %.1f fps; blend %.2f ms/frame, %u levels dropped, next blend %u steps\n",
+                  (unsigned)stats->LastFrames,
+                  stats->LastUs > 0 ? stats->LastFrames * 1000000.0 / stats->LastUs : 0.0,
+                  stats->BlendFrames > 0 ? stats->BlendUs / 1000.0 / stats->BlendFrames : 0.0,
+                  (unsigned)stats->Dropped, (unsigned)stats->BlendSteps);
+  } else if (command == 'k') {
+    Serial.printf("🔘 Button: %u bounces filtered, %u edges dropped, %u gestures lost\n",
+                  (unsigned)buttonGesture.Bounces, (unsigned)Button_DroppedEdges(),
+                  (unsigned)buttonGesture.Overflows);
+  }
+}
+
+// Act on one recognised gesture
+void handleGesture(const GESTURE_EVENT& event) {
+  // Everything but the hold (LED only) changes the screen: trace it to the panel
+  if (event.Type != GESTURE_HOLD) {
+    Latency_Input(event.Type, event.EdgeUs, event.TimeUs, micros());
+  }
+  switch (event.Type) {
+  case GESTURE_CLICK:
+    if (slideshowMode) {
+      adjustSlideshowSpeed(false); // Single click = slower
+    } else if (totalImages > 0) {
+      nextImage(); // Manual mode: single click = next image (immediate)
+    }
+    break;
+  case GESTURE_DOUBLE_CLICK:
+    adjustSlideshowSpeed(true); // Double click = faster
+    break;
+  case GESTURE_HOLD:
+    // Past 2s the LED stays lit: release to toggle mode, keep holding for the next album
+    digitalWrite(LED_PIN, HIGH);
+    break;
+  case GESTURE_HOLD_RELEASE:
+    toggleSlideshowMode();
+    
+    // Flash LED to indicate mode change; ledFlashTimer steps the rest
+    ledFlashStep = 0;
+    digitalWrite(LED_PIN, HIGH);
+    Sched_After(&ledFlashTimer, millis(), LED_FLASH_TIME);
+    break;
+  case GESTURE_LONG_HOLD:
+    digitalWrite(LED_PIN, LOW);
+    nextAlbum();
+    break;
+  }
+}
+
+// Scheduled UI work: each runs when its timer comes due (Deadline_Scheduler)
+// A new slideshow timeline starting now (mode or speed change)
+void restartSlideshowTimer() {
+  slideRebase = false;
+  if (slideshowMode) {
+    Slide_Start(&slideClock, micros(), currentSlideshowInterval * 1000);
+    armSlideshowTimers();
+  } else {
+    Sched_Cancel(&slideshowTimer);
+    Sched_Cancel(&slidePrepareTimer);
+  }
+}
+
+// Milliseconds from now until a microsecond deadline, rounded down so the timer is never late
+uint32_t msBeforeMicros(uint32_t dueUs) {
+  int32_t remaining = (int32_t)(dueUs - micros());
+  return remaining <= 0 ? 0 : remaining / 1000;
+}
+
+void armSlideshowTimers() {
+  uint32_t now = millis();
+  Sched_At(&slidePrepareTimer, now + msBeforeMicros(Slide_PrepareDueUs(&slideClock)));
+  Sched_At(&slideshowTimer, now + msBeforeMicros(Slide_FlipDueUs(&slideClock)));
+}
+
+void hideSpeedIndicator() {
+  showingSpeedIndicator = false;
+  speedLimitBlink = false;
+  speedBlinkGap = false;
+  speedLimitBlinkCount = 0;
+  Sched_Cancel(&speedIndicatorTimer);
+}
+
+// Flip to the next slide on its deadline; the timeline, not this call's finish, sets the next one
+void onSlideshowTimer(void*) {
+  if (!slideshowMode) return;
+  if (showingModeGraphic) {
+    // Advance right after the mode graphic is taken down, then keep time from there
+    Sched_At(&slideshowTimer, modeGraphicTimer.Due + 1);
+    slideRebase = true;
+    return;
+  }
+  // The timer fires up to a millisecond early: wait out the rest
+  while (!slideRebase && (int32_t)(Slide_FlipDueUs(&slideClock) - micros()) > 0) {
+  }
+  frameShownUs = micros();
+  if (totalImages > 1) {
+    nextImage();
+    // Clear speed indicator when advancing to next image
+    if (showingSpeedIndicator) {
+      hideSpeedIndicator();
+    }
+  }
+  if (slideRebase) {
+    slideRebase = false;
+    Slide_Start(&slideClock, frameShownUs, currentSlideshowInterval * 1000);
+  } else {
+    Slide_Flipped(&slideClock, frameShownUs);
+  }
+  armSlideshowTimers();
+}
+
+// Decode the next slide early enough that its flip is only a buffer swap
+void onSlidePrepareTimer(void*) {
+  if (!slideshowMode || showingModeGraphic) return;
+  prefetchPending = true;
+  prefetchNextImage();
+}
+
+void onModeGraphicTimer(void*) {
+  showingModeGraphic = false;
+  // Return to current image if we have any
+  if (totalImages > 0) {
+    displayCurrentImage();
+  }
+}
+
+void onSpeedIndicatorTimer(void*) {
+  if (speedBlinkGap) {
+    // Second half of a blink: the indicator comes back over the image
+    speedBlinkGap = false;
+    if (!showingModeGraphic) {
+      drawSpeedIndicator(speedIncreased);
+    }
+    Sched_After(&speedIndicatorTimer, millis(), SPEED_LIMIT_BLINK_TIME);
+    return;
+  }
+  if (speedLimitBlink && ++speedLimitBlinkCount < SPEED_LIMIT_BLINK_TOTAL) {
+    // Redraw to create blink effect; the indicator returns after a short gap
+    if (totalImages > 0 && !showingModeGraphic) {
+      displayCurrentImage();
+      speedBlinkGap = true;
+      Sched_After(&speedIndicatorTimer, millis(), SPEED_LIMIT_BLINK_GAP);
+      return;
+    }
+    Sched_After(&speedIndicatorTimer, millis(), SPEED_LIMIT_BLINK_TIME);
+    return;
+  }
+  hideSpeedIndicator();
+  // Redraw current image to clear the overlay
+  if (totalImages > 0 && !showingModeGraphic) {
+    displayCurrentImage();
+  }
+}
+
+void onSDCheckTimer(void*) {
+  checkAndReloadSDCard();
+  Sched_After(&sdCheckTimer, millis(), SD_CHECK_INTERVAL);
+}
+
+void onSDReloadTimer(void*) {
+  reloadSDCard();
+}
+
+void onHeartbeatTimer(void*) {
+  static bool ledState = false;
+  ledState = !ledState;
+  if (!Sched_IsArmed(&ledFlashTimer)) { // A mode-change flash owns the LED
+    digitalWrite(LED_PIN, ledState);
+  }
+  Sched_After(&heartbeatTimer, millis(), HEARTBEAT_INTERVAL);
+}
+
+void onLedFlashTimer(void*) {
+  ledFlashStep++;
+  digitalWrite(LED_PIN, ledFlashStep % 2 == 0 ? HIGH : LOW);
+  if (ledFlashStep < LED_FLASH_STEPS - 1) {
+    Sched_After(&ledFlashTimer, millis(), LED_FLASH_TIME);
+  }
+}
+
+void onHeapTimer(void*) {
+  Heap_LogSummary();
+  Sched_After(&heapTimer, millis(), HEAP_TELEMETRY_INTERVAL);
+}
+
+void initScheduler() {
+  uint32_t now = millis();
+  Sched_Init(&slideshowTimer, "slideshow", onSlideshowTimer, NULL);
+  Sched_Init(&slidePrepareTimer, "slide prepare", onSlidePrepareTimer, NULL);
+  Sched_Init(&modeGraphicTimer, "mode graphic", onModeGraphicTimer, NULL);
+  Sched_Init(&speedIndicatorTimer, "speed overlay", onSpeedIndicatorTimer, NULL);
+  Sched_Init(&sdCheckTimer, "sd check", onSDCheckTimer, NULL);
+  Sched_Init(&sdReloadTimer, "sd reload", onSDReloadTimer, NULL);
+  Sched_Init(&heartbeatTimer, "heartbeat", onHeartbeatTimer, NULL);
+  Sched_Init(&ledFlashTimer, "led flash", onLedFlashTimer, NULL);
+  Sched_Init(&heapTimer, "heap telemetry", onHeapTimer, NULL);
+  Sched_After(&sdCheckTimer, now, SD_CHECK_INTERVAL);
+  Sched_After(&heartbeatTimer, now, HEARTBEAT_INTERVAL);
+  Sched_After(&heapTimer, now, HEAP_TELEMETRY_INTERVAL);
+}
+
+// Milliseconds from now until a microsecond deadline, rounded up
+uint32_t msUntilMicros(uint32_t dueUs) {
+  int32_t remaining = (int32_t)(dueUs - micros());
+  return remaining <= 0 ? 0 : (remaining + 999) / 1000;
+}
+
+// A USB host is attached: light sleep would drop the USB Serial/JTAG port
+bool usbHostConnected() {
+  return (bool)Serial;
+}
+
+// Block until the earliest timer, gesture or animation deadline, or a button edge.
+// Work that is still in progress (album scan, prefetch) means no wait at all.
+// With no USB host the wait becomes a light sleep when it is long enough.
+void waitForNextEvent(uint32_t loopStart) {
+  uint32_t now = millis();
+  bool usb = usbHostConnected();
+  uint32_t wait = Sched_TimeUntilNext(now, usb ? LOOP_MAX_IDLE_MS : powerConfig.MaxSleepMs);
+  uint32_t due;
+  bool busy = Album_ScanState() == SCAN_RUNNING || prefetchPending;
+  if (busy) {
+    wait = 0;
+  }
+  if (Gesture_NextDeadline(&buttonGesture, &due)) {
+    wait = min(wait, msUntilMicros(due));
+  }
+  if (!showingModeGraphic && !showingSpeedIndicator) {
+    if (GIF_NextDeadline(&due)) {
+      wait = min(wait, msUntilMicros(due));
+    }
+    if (MJPEG_NextDeadline(&due)) {
+      wait = min(wait, msUntilMicros(due));
+    }
+    if (Flipbook_NextDeadline(&due)) {
+      wait = min(wait, msUntilMicros(due));
+    }
+  }
+  
+  POWER_INPUT input;
+  input.UntilNextMs = wait;
+  input.Busy = busy || Pipeline_IsPresenting() || SDReader_FillInFlight();
+  input.UsbConnected = usb;
+  input.ButtonPressed = Button_IsPressed() || buttonGesture.Pressed;
+  input.DisplayHoldable = LCD_CanHoldForSleep();
+  uint32_t sleepMs = 0;
+  POWER_DECISION decision = Power_Decide(&powerConfig, &input, &sleepMs);
+  
+  uint32_t idleStart = micros();
+  uint32_t sleptUs = 0;
+  if (decision == POWER_SLEEP && LCD_HoldForSleep(true)) {
+    POWER_WAKE wake = Power_LightSleep(sleepMs, BUTTON_PIN, &sleptUs);
+    LCD_HoldForSleep(false);
+    Power_AccountSleep(sleepMs, sleptUs, wake);
+    lastWakeUs = micros();
+    buttonNeedsResync = true;
+  } else {
+    Power_AccountSkip(decision);
+    Button_WaitEdge(wait);
+  }
+  uint32_t end = micros();
+  Sched_AccountTime(idleStart - loopStart, end - idleStart);
+  Power_AccountActive(end - loopStart - sleptUs);
+}
+
+void printSchedulerStats() {
+  SCHED_STATS stats;
+  Sched_GetStats(&stats);
+  uint64_t total = stats.IdleUs + stats.BusyUs;
+  uint32_t next = 0;
+  bool armed = Sched_NextDeadline(&next);
+  Serial.printf("⏲️  Loop: %.1f%% idle over %.1f s, %u timer runs, worst %u ms late, next deadline %s%d ms\n",
+                total > 0 ? stats.IdleUs * 100.0 / total : 0.0, total / 1e6,
+                (unsigned)stats.Runs, (unsigned)stats.MaxLateMs,
+                armed ? "in " : "none ", armed ? (int)(int32_t)(next - millis()) : 0);
+  Sched_ResetStats();
+}
+
+void printSlideshowStats() {
+  Serial.printf("🎬 Slideshow clock: %u flips every %u ms, error mean %+.2f ms, sd %.2f ms, min %+.2f, max %+.2f ms\n",
+                (unsigned)slideClock.Flips, (unsigned)(slideClock.PeriodUs / 1000),
+                Slide_MeanErrorUs(&slideClock) / 1000.0, Slide_StdDevUs(&slideClock) / 1000.0,
+                slideClock.MinErrorUs / 1000.0, slideClock.MaxErrorUs / 1000.0);
+  Serial.printf("   %u late (> %u us), %u periods skipped, decode estimate %.1f ms\n",
+                (unsigned)slideClock.Late, (unsigned)SLIDE_LATE_US, (unsigned)slideClock.Skipped,
+                slideClock.PrepareUs / 1000.0);
+  Slide_ResetStats(&slideClock);
+}
+
+void printPowerStats() {
+  POWER_STATS stats;
+  Power_GetStats(&stats);
+  uint64_t total = stats.SleepUs + stats.ActiveUs;
+  Serial.printf("💤 Power: %.1f%% asleep over %.1f s, %u light sleeps (avg %u ms), light sleep %s\n",
+                total > 0 ? stats.SleepUs * 100.0 / total : 0.0, total / 1e6, (unsigned)stats.Sleeps,
+                stats.Sleeps > 0 ? (unsigned)(stats.SleepUs / stats.Sleeps / 1000) : 0,
+                powerConfig.Enabled ? "on" : "off");
+  Serial.printf("   Wakes: %u timer, %u button, %u other, %u early\n",
+                (unsigned)stats.Wakes[POWER_WAKE_TIMER], (unsigned)stats.Wakes[POWER_WAKE_BUTTON],
+                (unsigned)stats.Wakes[POWER_WAKE_OTHER], (unsigned)stats.EarlyWakes);
+  Serial.print("   Stayed awake:");
+  for (int i = POWER_SLEEP + 1; i < POWER_DECISION_COUNT; i++) {
+    Serial.printf(" %s %u%s", Power_DecisionName((POWER_DECISION)i), (unsigned)stats.Skips[i],
+                  i + 1 < POWER_DECISION_COUNT ? "," : "\n");
+  }
+  Power_ResetStats();
+}
+
+// Mount the card in the background; finishSDMount() collects the result
+void sdMountTask(void*) {
+  Bus_Acquire(BUS_SD, STAGE_SCAN);
+  sdSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_SS_PIN);
+  sdMountResult = SD.begin(SDCARD_SS_PIN, sdSPI, SD_SPI_FREQUENCY);
+  Bus_Release(BUS_SD);
+  xSemaphoreGive(sdMountDone);
+  vTaskDelete(NULL);
+}
+
+void startSDMount() {
+  sdMountDone = xSemaphoreCreateBinary();
+  if (sdMountDone != NULL &&
+      xTaskCreatePinnedToCore(sdMountTask, "sd_mount", 4096, NULL, 2, NULL, 0) != pdPASS) {
+    vSemaphoreDelete(sdMountDone);
+    sdMountDone = NULL; // finishSDMount() mounts inline instead
   }
 }
 
+bool finishSDMount() {
+  if (sdMountDone != NULL) {
+    xSemaphoreTake(sdMountDone, portMAX_DELAY);
+    vSemaphoreDelete(sdMountDone);
+    sdMountDone = NULL;
+    return sdMountResult;
+  }
+  Bus_Acquire(BUS_SD, STAGE_SCAN);
+  sdSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_SS_PIN);
+  bool mounted = SD.begin(SDCARD_SS_PIN, sdSPI, SD_SPI_FREQUENCY);
+  Bus_Release(BUS_SD);
+  return mounted;
+}
+
 void setup() {
   Serial.begin(115200);
+#if FAST_BOOT
+#if ARDUINO_USB_CDC_ON_BOOT
+  Serial.setTxTimeoutMs(0); // With no USB host attached, logging must not stall boot
+#endif
+#else
   delay(3000);
+#endif
+  Boot_Mark("serial");
   
   Serial.println("===================================");
   Serial.println("ESP32-S3 Geek LCD_BUTTON Program");
   Serial.println("===================================");
   Serial.println("Cycling between pic1.png, pic2.png, and JPG image");
   Serial.println();
+  Log_Begin(); // Image-path logging goes through the ring from here on
 
-  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  Button_Begin(BUTTON_PIN);
+  Gesture_Init(&buttonGesture, BUTTON_DEBOUNCE_TIME, DOUBLE_CLICK_TIME, BUTTON_HOLD_TIME, ALBUM_HOLD_TIME);
+  initScheduler(); // Timeouts run from loop() once they are due
+  Power_Init(&powerConfig);
   pinMode(LED_PIN, OUTPUT);
   
+#if FAST_BOOT
+  digitalWrite(LED_PIN, HIGH); // Lit while starting; the heartbeat takes over
+#else
   // Flash LED to show starting
   for (int i = 0; i < 3; i++) {
     digitalWrite(LED_PIN, HIGH);
@@ -785,56 +1666,77 @@ void setup() {
     digitalWrite(LED_PIN, LOW);
     delay(300);
   }
+#endif
+  
+  // Album index and the frame SD images are decoded into; the pipeline also
+  // creates the bus locks the SD mount takes
+  if (!Album_Init()) {
+    Serial.println("❌ Failed to allocate album index");
+  }
+  if (!Pipeline_Init()) {
+    Serial.println("❌ Failed to start frame pipeline");
+  }
+  Boot_Mark("pipeline");
+  
+#if FAST_BOOT
+  startSDMount();
+#endif
   
   Serial.println("Initializing hardware...");
   Config_Init();
   Serial.println("✅ Hardware initialized");
   
+  // Reset and registers now; sleep out has to wait 120 ms after the reset,
+  // so the screen clear and asset mapping below happen inside that window
   Serial.println("Initializing LCD display...");
-  LCD_Init();
-  Serial.println("✅ LCD initialized successfully!");
-  
-  Serial.println("Setting backlight...");
-  LCD_SetBacklight(1000);
-  Serial.println("✅ Backlight set");
-  
-  Serial.println("Clearing screen and initializing paint...");
+  LCD_InitBegin();
   LCD_Clear(BLACK);
   Paint_NewImage(LCD_WIDTH, LCD_HEIGHT, 0, BLACK);
-  Serial.println("✅ Paint initialized");
+  Boot_Mark("lcd registers");
+  
+  // Status images: the assets partition overrides the copies linked into the app
+  if (AssetPack_Mount()) {
+    LOG_INFO("✅ Assets partition mapped: %d images, %u bytes", AssetPack_Count(), (unsigned)AssetPack_Size());
+  } else {
+    Serial.println("📦 No asset pack in flash - using built-in status images");
+  }
   
   // Initialize embedded images first
   initializeEmbeddedImages();
+  embeddedImageCount = totalImages;
+  Boot_Mark("assets");
+  
+  LCD_InitFinish();
+  LCD_SetBacklight(1000);
+  Serial.println("✅ LCD initialized successfully!");
+  Boot_Mark("lcd on");
   
   // Initialize SD card (required for image loading)
   Serial.println();
   Serial.println("Initializing SD card...");
-  
-  // Show scanning status
+#if !FAST_BOOT
   showScanningStatus();
   delay(500); // Brief scanning display
+#endif
   
-  sdSPI.begin(SDCARD_SCK, SDCARD_MISO, SDCARD_MOSI, SDCARD_SS_PIN);
-  if (SD.begin(SDCARD_SS_PIN, sdSPI, 80000000)) {
+  if (finishSDMount()) {
     sdCardInitialized = true;
     lastSDCardState = true;
     Serial.println("✅ SD Card initialized successfully!");
+    Boot_Mark("sd mount");
     
-    // Load images from SD card
+    // Find the first album now, the rest is discovered in the background
     loadSDCardImages();
-    
-    // List all available images
-    Serial.println("📁 All available images:");
-    for (int i = 0; i < totalImages; i++) {
-      String type = imageList[i].isEmbedded ? "(embedded)" : "(SD card)";
-      Serial.println("  " + String(i+1) + ". " + imageList[i].fileName + " " + type);
-    }
+    Boot_Mark("first album");
   } else {
     Serial.println("❌ SD Card initialization failed!");
     sdCardInitialized = false;
     lastSDCardState = false;
+    Boot_Mark("sd mount");
     showNoSDCardStatus();
+#if !FAST_BOOT
     delay(2000); // Show error longer
+#endif
   }
   
   // Display first image immediately if available, otherwise show status
@@ -842,20 +1744,25 @@ void setup() {
     Serial.println("🖼️  Going directly to images...");
     displayCurrentImage(); // Skip directly to first image
     Serial.println("✅ Image display ready");
+  } else if (FAST_BOOT && !sdCardInitialized) {
+    Serial.println("⚠️  No SD card - insert one with images"); // No-card screen stays up
   } else {
-    Serial.println("⚠️  No images found! Please add JPEG files to SD card root directory");
+    Serial.println("⚠️  No images found! Please add JPEG files to the SD card (root or album folders)");
     showNoImagesFoundStatus();
   }
+  Pipeline_WaitPresent();
+  Boot_MarkFirstImage();
   
   Serial.println();
   Serial.println("🎉 FLIPPER-STYLE IMAGE VIEWER READY!");
-  Serial.println("📸 Total images available: " + String(totalImages));
+  LOG_INFO("📸 Total images available: %d", totalImages);
   if (sdCardInitialized) {
     Serial.println("💾 SD Card: Ready");
   } else {
     Serial.println("💾 SD Card: Not found - will auto-detect when inserted");
   }
   Serial.println("🔄 Auto SD card detection: Every 3 seconds");
+  Serial.println("📂 Albums: every folder with images (hold 5s for next album)");
   Serial.println("📋 Controls:");
   Serial.println("   Manual Mode:");
   Serial.println("     • Press: Next image");
@@ -864,154 +1771,64 @@ void setup() {
   Serial.println("     • Single press: Slower (0.25s to 30s range)");
   Serial.println("     • Double press: Faster (with speed overlay)");
   Serial.println("     • Hold 2s: Manual mode");
+  Serial.println("   Both modes:");
+  Serial.println("     • Hold 5s: Next album (folder)");
   Serial.println("📱 FlipperZero-style status screens");
+  Serial.println("⌨️  Serial: 't' dumps the SD/LCD pipeline trace, 'i' loop idle time and timers, 'k' button stats");
+  Serial.println("           'p' sleep residency, 'z' toggles light sleep, 'o' boot phases");
+  Serial.println("           'l' input-to-photon latency, 'e' recorded button edges");
+  Boot_Print();
+  digitalWrite(LED_PIN, LOW);
+#if BENCHMARK_BUILD
+  if (sdCardInitialized) {
+    runBenchmarkSuite(); // 'y' runs it again
+  }
+#endif
+  Sched_ResetStats(); // Idle accounting starts with loop()
+  Power_ResetStats();
 }
 
 void loop() {
-  static unsigned long lastBlink = 0;
-  static bool ledState = false;
-  static bool lastButtonState = HIGH;
-  
-  // Blink LED every second to show we're alive
-  if (millis() - lastBlink > 1000) {
-    ledState = !ledState;
-    digitalWrite(LED_PIN, ledState);
-    lastBlink = millis();
-  }
-  
-  // Handle mode graphic display timeout
-  if (showingModeGraphic && (millis() - modeGraphicTimer > MODE_DISPLAY_TIME)) {
-    showingModeGraphic = false;
-    // Return to current image if we have any
-    if (totalImages > 0) {
-      displayCurrentImage();
-    }
-  }
+  uint32_t loopStart = micros();
   
-  // Handle speed indicator timeout and blinking
-  if (showingSpeedIndicator) {
-    bool shouldHide = false;
-    
-    if (speedLimitBlink) {
-      // Handle limit blinking - blink multiple times
-      if (millis() - speedLimitBlinkTimer > SPEED_LIMIT_BLINK_TIME) {
-        speedLimitBlinkCount++;
-        speedLimitBlinkTimer = millis();
-        
-        if (speedLimitBlinkCount >= SPEED_LIMIT_BLINK_TOTAL) {
-          speedLimitBlink = false;
-          shouldHide = true;
-        } else {
-          // Redraw to create blink effect
-          if (totalImages > 0 && !showingModeGraphic) {
-            displayCurrentImage();
-            // Small delay then redraw indicator
-            delay(50);
-            drawSpeedIndicator(speedIncreased);
-          }
-        }
-      }
-    } else if (millis() - speedIndicatorTimer > SPEED_INDICATOR_TIME) {
-      // Normal timeout
-      shouldHide = true;
-    }
-    
-    if (shouldHide) {
-      showingSpeedIndicator = false;
-      speedLimitBlink = false;
-      speedLimitBlinkCount = 0;
-      // Redraw current image to clear the overlay
-      if (totalImages > 0 && !showingModeGraphic) {
-        displayCurrentImage();
-      }
-    }
-  }
+  // Mode graphic, speed overlay, slideshow advance, SD probe and LED heartbeat
+  Sched_RunDue(millis());
   
-  // Check for SD card changes periodically
-  if (millis() - lastSDCheck > SD_CHECK_INTERVAL) {
-    checkAndReloadSDCard();
-    lastSDCheck = millis();
-  }
+  // Discover remaining albums a few directory entries at a time
+  continueAlbumScan();
   
-  // Handle slideshow mode auto-advance (only when not showing mode graphic and speed indicator finished drawing)
-  if (slideshowMode && totalImages > 1 && !showingModeGraphic) {
-    // Small delay after speed indicator starts to let it finish drawing
-    bool speedIndicatorDrawing = showingSpeedIndicator && (millis() - speedIndicatorTimer < 50);
-    
-    if (!speedIndicatorDrawing && millis() - slideshowTimer > currentSlideshowInterval) {
-      nextImage();
-      slideshowTimer = millis();
-      // Clear speed indicator when advancing to next image
-      if (showingSpeedIndicator) {
-        showingSpeedIndicator = false;
-      }
-    }
+  // Button gestures: edges were timestamped by the interrupt, so a busy loop
+  // only delays when a gesture is acted on, not what it is or when it happened
+  Gesture_SetDoubleClick(&buttonGesture, slideshowMode); // Manual mode clicks act at once
+  BUTTON_EDGE edge;
+  while (Button_PopEdge(&edge)) {
+    Latency_RecordEdge(edge.TimeUs, edge.Pressed);
+    Gesture_Edge(&buttonGesture, edge.TimeUs, edge.Pressed);
   }
-  
-  // Handle double-click timeout - MUST happen before button detection
-  if (waitingForDoubleClick && (millis() - lastClickTime > DOUBLE_CLICK_TIME)) {
-    waitingForDoubleClick = false;
-    // Process the single click that was waiting
-    if (slideshowMode) {
-      adjustSlideshowSpeed(false); // Single click = slower
+  if (buttonNeedsResync) {
+    // A press that woke the chip from light sleep left no edge in the queue
+    buttonNeedsResync = false;
+    bool pressed = Button_IsPressed();
+    if (pressed != buttonGesture.RawPressed) {
+      Gesture_Edge(&buttonGesture, lastWakeUs, pressed);
     }
   }
-  
-  // Advanced button handling
-  bool currentButtonState = digitalRead(BUTTON_PIN);
-  
-  // Button press detection (falling edge)
-  if (lastButtonState == HIGH && currentButtonState == LOW) {
-    buttonPressed = true;
-    buttonPressTime = millis();
-    holdDetected = false;
+  Gesture_Poll(&buttonGesture, micros());
+  GESTURE_EVENT gesture;
+  while (Gesture_Next(&buttonGesture, &gesture)) {
+    handleGesture(gesture);
   }
   
-  // Button hold detection (while pressed)
-  if (buttonPressed && currentButtonState == LOW) {
-    if (!holdDetected && (millis() - buttonPressTime > BUTTON_HOLD_TIME)) {
-      holdDetected = true;
-      waitingForDoubleClick = false; // Cancel any pending actions
-      toggleSlideshowMode();
-      
-      // Flash LED to indicate mode change
-      for (int i = 0; i < 3; i++) {
-        digitalWrite(LED_PIN, HIGH);
-        delay(100);
-        digitalWrite(LED_PIN, LOW);
-        delay(100);
-      }
-    }
+  // Advance an animated GIF or clip when its next frame is due (overlays pause them)
+  if (!showingModeGraphic && !showingSpeedIndicator) {
+    GIF_Service(micros());
+    MJPEG_Service(micros());
+    Flipbook_Service(micros());
   }
   
-  // Button release detection (rising edge)
-  if (lastButtonState == LOW && currentButtonState == HIGH) {
-    if (buttonPressed && !holdDetected) {
-      unsigned long currentTime = millis();
-      
-      if (slideshowMode) {
-        // In slideshow mode: handle single vs double click for speed control
-        if (waitingForDoubleClick && (currentTime - lastClickTime < DOUBLE_CLICK_TIME)) {
-          // Double-click detected - increase speed immediately
-          waitingForDoubleClick = false;
-          adjustSlideshowSpeed(true);
-        } else {
-          // First click - start waiting for potential double-click
-          waitingForDoubleClick = true;
-          lastClickTime = currentTime;
-        }
-      } else {
-        // In manual mode: single click = next image (immediate)
-        if (totalImages > 0) {
-          nextImage();
-        }
-        waitingForDoubleClick = false;
-      }
-    }
-    buttonPressed = false;
-    holdDetected = false;
-  }
+  // Decode the next image on the SD bus while the current one goes to the LCD
+  prefetchNextImage();
+  handleSerialCommand();
   
-  lastButtonState = currentButtonState;
-  delay(10);
+  waitForNextEvent(loopStart);
 }
\ No newline at end of file
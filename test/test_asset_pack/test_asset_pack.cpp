@@ -0,0 +1,157 @@
+/*****************************************************************************
+* | File        :   test_asset_pack.cpp
+* | Function    :   Asset pack validation, lookup and the host file mapping
+* | Info        :
+*   pio test -e native -f test_asset_pack
+*   Packs are built in memory with the layout of Asset_Pack.h, the same one
+*   scripts/build_assets.py --partition writes.
+******************************************************************************/
+#include <unity.h>
+#include "Asset_Pack.h"
+#include "LCD_Scroll.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TEST_PACK_ENTRIES 2
+#define TEST_BLOB_SIZE    8
+
+static uint8_t pack[sizeof(ASSET_PACK_HEADER) + TEST_PACK_ENTRIES * (sizeof(ASSET_PACK_ENTRY) + TEST_BLOB_SIZE)];
+
+static ASSET_PACK_ENTRY *packEntry(int index)
+{
+    return (ASSET_PACK_ENTRY *)(pack + sizeof(ASSET_PACK_HEADER) + index * sizeof(ASSET_PACK_ENTRY));
+}
+
+// Two full-panel entries: "scanning" (a registry name) and "custom"
+static void buildPack(void)
+{
+    ASSET_PACK_HEADER header;
+    const char *names[TEST_PACK_ENTRIES] = {"scanning", "custom"};
+    uint32_t offset = sizeof(header) + TEST_PACK_ENTRIES * sizeof(ASSET_PACK_ENTRY);
+
+    memset(pack, 0, sizeof(pack));
+    memcpy(header.Magic, ASSET_PACK_MAGIC, 4);
+    header.Version = ASSET_PACK_VERSION;
+    header.Count = TEST_PACK_ENTRIES;
+    header.DataSize = sizeof(pack);
+    header.Reserved = 0;
+    memcpy(pack, &header, sizeof(header));
+    for (int i = 0; i < TEST_PACK_ENTRIES; i++) {
+        ASSET_PACK_ENTRY *entry = packEntry(i);
+        strcpy(entry->Name, names[i]);
+        entry->Offset = offset + i * TEST_BLOB_SIZE;
+        entry->Size = TEST_BLOB_SIZE;
+        entry->Width = LCD_WIDTH;
+        entry->Height = LCD_HEIGHT;
+        entry->Format = ASSET_FORMAT_RLE565;
+        memset(pack + entry->Offset, 0xA0 + i, TEST_BLOB_SIZE);
+    }
+}
+
+void setUp(void)
+{
+    buildPack();
+}
+
+void tearDown(void)
+{
+    AssetPack_Unmount();
+}
+
+static void test_valid_pack_is_indexed_in_place(void)
+{
+    TEST_ASSERT_TRUE(AssetPack_Attach(pack, sizeof(pack)));
+    TEST_ASSERT_TRUE(AssetPack_IsMounted());
+    TEST_ASSERT_EQUAL(TEST_PACK_ENTRIES, AssetPack_Count());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(pack), AssetPack_Size());
+
+    const ASSET *custom = AssetPack_Find("custom");
+    TEST_ASSERT_NOT_NULL(custom);
+    TEST_ASSERT_TRUE(custom->Data == pack + packEntry(1)->Offset);
+    TEST_ASSERT_EQUAL_UINT32(TEST_BLOB_SIZE, custom->Size);
+    TEST_ASSERT_EQUAL_UINT16(LCD_WIDTH, custom->Width);
+    TEST_ASSERT_EQUAL_UINT16(LCD_HEIGHT, custom->Height);
+    TEST_ASSERT_NULL(AssetPack_Find("no_sd_card"));
+    TEST_ASSERT_NULL(AssetPack_Get(TEST_PACK_ENTRIES));
+}
+
+static void test_resolve_prefers_the_pack_copy(void)
+{
+    const ASSET *linked = Asset_Get(ASSET_SCANNING);
+    TEST_ASSERT_NOT_NULL(linked);
+    TEST_ASSERT_TRUE(Asset_Resolve(ASSET_SCANNING) == linked);
+
+    TEST_ASSERT_TRUE(AssetPack_Attach(pack, sizeof(pack)));
+    const ASSET *packed = Asset_Resolve(ASSET_SCANNING);
+    TEST_ASSERT_TRUE(packed == AssetPack_Find("scanning"));
+    TEST_ASSERT_TRUE(Asset_Resolve(ASSET_NO_SD_CARD) == Asset_Get(ASSET_NO_SD_CARD));
+    TEST_ASSERT_NULL(Asset_Resolve(ASSET_COUNT));
+}
+
+static void test_header_and_extent_errors_are_rejected(void)
+{
+    TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(ASSET_PACK_HEADER) - 1));
+    TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(pack) - 1)); // DataSize past the mapping
+
+    packEntry(1)->Size = TEST_BLOB_SIZE + 1;
+    TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(pack)));
+    buildPack();
+    packEntry(0)->Name[ASSET_PACK_NAME_LEN - 1] = 'x';
+    TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(pack)));
+    buildPack();
+    pack[0] = 0xFF; // Erased flash
+    TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(pack)));
+    TEST_ASSERT_FALSE(AssetPack_IsMounted());
+    TEST_ASSERT_EQUAL(0, AssetPack_Count());
+}
+
+static void test_dimensions_outside_the_panel_are_rejected(void)
+{
+    const uint16_t widths[] = {0, LCD_WIDTH + 1, LCD_WIDTH, LCD_WIDTH};
+    const uint16_t heights[] = {LCD_HEIGHT, LCD_HEIGHT, 0, LCD_HEIGHT + 1};
+    for (unsigned i = 0; i < sizeof(widths) / sizeof(widths[0]); i++) {
+        buildPack();
+        packEntry(1)->Width = widths[i];
+        packEntry(1)->Height = heights[i];
+        TEST_ASSERT_FALSE(AssetPack_Attach(pack, sizeof(pack)));
+        TEST_ASSERT_EQUAL(0, AssetPack_Count());
+    }
+
+    buildPack();
+    packEntry(1)->Width = 1;
+    packEntry(1)->Height = 1;
+    TEST_ASSERT_TRUE(AssetPack_Attach(pack, sizeof(pack)));
+}
+
+static void test_mount_file_maps_a_partition_image(void)
+{
+    char path[] = "/tmp/asset_packXXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL(sizeof(pack), write(fd, pack, sizeof(pack)));
+    close(fd);
+
+    TEST_ASSERT_TRUE(AssetPack_MountFile(path));
+    const ASSET *custom = AssetPack_Find("custom");
+    TEST_ASSERT_NOT_NULL(custom);
+    TEST_ASSERT_EQUAL_MEMORY(pack + packEntry(1)->Offset, custom->Data, TEST_BLOB_SIZE);
+    AssetPack_Unmount();
+    TEST_ASSERT_NULL(AssetPack_Find("custom"));
+
+    TEST_ASSERT_FALSE(AssetPack_MountFile("/nonexistent/assets.bin"));
+    unlink(path);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_valid_pack_is_indexed_in_place);
+    RUN_TEST(test_resolve_prefers_the_pack_copy);
+    RUN_TEST(test_header_and_extent_errors_are_rejected);
+    RUN_TEST(test_dimensions_outside_the_panel_are_rejected);
+    RUN_TEST(test_mount_file_maps_a_partition_image);
+    return UNITY_END();
+}
@@ -0,0 +1,219 @@
+/*****************************************************************************
+* | File        :   test_button_gesture.cpp
+* | Function    :   Gesture recognition from recorded edge sequences
+* | Info        :
+*   pio test -e native -f test_button_gesture
+*   Edges are fed with hand-picked microsecond timestamps (20 ms debounce,
+*   300 ms double-click window, 800 ms hold, 3 s long hold) and the queued
+*   events are checked for type and time.
+******************************************************************************/
+#include <unity.h>
+#include "Button_Gesture.h"
+
+#define MS 1000u
+
+static BUTTON_GESTURE gesture;
+static GESTURE_EVENT events[GESTURE_QUEUE_SIZE];
+
+static int drain(void)
+{
+    int n = 0;
+    while (n < GESTURE_QUEUE_SIZE && Gesture_Next(&gesture, &events[n])) {
+        n++;
+    }
+    return n;
+}
+
+static void assertEvent(int i, uint8_t type, uint32_t timeUs, uint32_t edgeUs)
+{
+    TEST_ASSERT_EQUAL_STRING(Gesture_Name(type), Gesture_Name(events[i].Type));
+    TEST_ASSERT_EQUAL_UINT32(timeUs, events[i].TimeUs);
+    TEST_ASSERT_EQUAL_UINT32(edgeUs, events[i].EdgeUs);
+}
+
+void setUp(void)
+{
+    Gesture_Init(&gesture, 20, 300, 800, 3000);
+}
+
+void tearDown(void)
+{
+}
+
+static void test_click_without_double_click_is_immediate(void)
+{
+    Gesture_SetDoubleClick(&gesture, false);
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Edge(&gesture, 101 * MS, false);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_CLICK, 101 * MS, 1 * MS);
+}
+
+static void test_click_waits_for_the_double_click_window(void)
+{
+    uint32_t deadline;
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Edge(&gesture, 101 * MS, false);
+    TEST_ASSERT_TRUE(Gesture_NextDeadline(&gesture, &deadline));
+    TEST_ASSERT_EQUAL_UINT32(401 * MS, deadline);
+    Gesture_Poll(&gesture, 400 * MS);
+    TEST_ASSERT_EQUAL(0, drain());
+    Gesture_Poll(&gesture, 900 * MS);  // Seen late, reported at its own time
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_CLICK, 401 * MS, 101 * MS);
+    TEST_ASSERT_FALSE(Gesture_NextDeadline(&gesture, &deadline));
+}
+
+static void test_double_click(void)
+{
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Edge(&gesture, 101 * MS, false);
+    Gesture_Edge(&gesture, 201 * MS, true);
+    Gesture_Edge(&gesture, 301 * MS, false);
+    Gesture_Poll(&gesture, 2000 * MS);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_DOUBLE_CLICK, 301 * MS, 101 * MS);
+}
+
+static void test_bounces_are_dropped(void)
+{
+    Gesture_SetDoubleClick(&gesture, false);
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Edge(&gesture, 3 * MS, false);     // Contact chatter after the press
+    Gesture_Edge(&gesture, 5 * MS, true);
+    Gesture_Edge(&gesture, 100 * MS, false);
+    Gesture_Edge(&gesture, 100 * MS + 500, true);  // And after the release
+    Gesture_Edge(&gesture, 101 * MS, false);
+    Gesture_Poll(&gesture, 200 * MS);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_CLICK, 100 * MS, 1 * MS);
+    TEST_ASSERT_EQUAL_UINT32(2, gesture.Bounces);
+}
+
+static void test_held_back_edge_settles_at_its_own_time(void)
+{
+    uint32_t deadline;
+    Gesture_SetDoubleClick(&gesture, false);
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Edge(&gesture, 10 * MS, false);    // Within the debounce of the press
+    TEST_ASSERT_TRUE(Gesture_NextDeadline(&gesture, &deadline));
+    TEST_ASSERT_EQUAL_UINT32(30 * MS, deadline);
+    Gesture_Poll(&gesture, 29 * MS);
+    TEST_ASSERT_EQUAL(0, drain());
+    Gesture_Poll(&gesture, 30 * MS);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_CLICK, 10 * MS, 1 * MS);
+}
+
+static void test_hold_and_hold_release(void)
+{
+    uint32_t deadline;
+    Gesture_Edge(&gesture, 1 * MS, true);
+    TEST_ASSERT_TRUE(Gesture_NextDeadline(&gesture, &deadline));
+    TEST_ASSERT_EQUAL_UINT32(801 * MS, deadline);
+    Gesture_Poll(&gesture, 800 * MS);
+    TEST_ASSERT_EQUAL(0, drain());
+    Gesture_Poll(&gesture, 950 * MS);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_HOLD, 801 * MS, 1 * MS);
+    TEST_ASSERT_TRUE(Gesture_NextDeadline(&gesture, &deadline));
+    TEST_ASSERT_EQUAL_UINT32(3001 * MS, deadline);
+    Gesture_Edge(&gesture, 1500 * MS, false);
+    Gesture_Poll(&gesture, 5000 * MS);
+    TEST_ASSERT_EQUAL(1, drain());         // No click after a hold
+    assertEvent(0, GESTURE_HOLD_RELEASE, 1500 * MS, 1 * MS);
+}
+
+static void test_long_hold_has_no_release_event(void)
+{
+    Gesture_Edge(&gesture, 1 * MS, true);
+    Gesture_Poll(&gesture, 5000 * MS);
+    Gesture_Edge(&gesture, 6000 * MS, false);
+    Gesture_Poll(&gesture, 9000 * MS);
+    TEST_ASSERT_EQUAL(2, drain());
+    assertEvent(0, GESTURE_HOLD, 801 * MS, 1 * MS);
+    assertEvent(1, GESTURE_LONG_HOLD, 3001 * MS, 1 * MS);
+}
+
+// The same edges give the same events whether polled every millisecond or never
+static void test_poll_rate_does_not_change_events(void)
+{
+    static const uint32_t edges[] = {1, 101, 201, 1500, 1600, 1603, 1605, 2000};
+    GESTURE_EVENT polled[GESTURE_QUEUE_SIZE];
+    int counts[2];
+
+    for (int run = 0; run < 2; run++) {
+        setUp();
+        uint32_t now = 0;
+        for (unsigned i = 0; i < sizeof(edges) / sizeof(edges[0]); i++) {
+            while (run == 0 && now < edges[i] * MS) {
+                Gesture_Poll(&gesture, now);
+                now += MS;
+            }
+            Gesture_Edge(&gesture, edges[i] * MS, i % 2 == 0);
+        }
+        Gesture_Poll(&gesture, 10000 * MS);
+        counts[run] = drain();
+        if (run == 0) {
+            for (int i = 0; i < counts[0]; i++) {
+                polled[i] = events[i];
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL(4, counts[0]);
+    TEST_ASSERT_EQUAL(counts[0], counts[1]);
+    for (int i = 0; i < counts[0]; i++) {
+        TEST_ASSERT_EQUAL_UINT8(polled[i].Type, events[i].Type);
+        TEST_ASSERT_EQUAL_UINT32(polled[i].TimeUs, events[i].TimeUs);
+        TEST_ASSERT_EQUAL_UINT32(polled[i].EdgeUs, events[i].EdgeUs);
+    }
+    // The second press outlasts the click window before reaching a hold
+    assertEvent(0, GESTURE_CLICK, 401 * MS, 101 * MS);
+    assertEvent(1, GESTURE_HOLD, 1001 * MS, 201 * MS);
+    assertEvent(2, GESTURE_HOLD_RELEASE, 1500 * MS, 201 * MS);
+    assertEvent(3, GESTURE_CLICK, 2300 * MS, 2000 * MS);  // 1603 bounced
+}
+
+static void test_timestamps_wrap(void)
+{
+    uint32_t press = 0xFFFFFFFFu - 500 * MS;
+    Gesture_Poll(&gesture, press - 100 * MS);  // Idle polling keeps the debounce in range
+    Gesture_Edge(&gesture, press, true);
+    Gesture_Poll(&gesture, press + 900 * MS);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_HOLD, press + 800 * MS, press);
+    Gesture_Edge(&gesture, press + 1000 * MS, false);
+    TEST_ASSERT_EQUAL(1, drain());
+    assertEvent(0, GESTURE_HOLD_RELEASE, press + 1000 * MS, press);
+}
+
+static void test_full_queue_counts_overflows(void)
+{
+    Gesture_SetDoubleClick(&gesture, false);
+    for (uint32_t i = 0; i < GESTURE_QUEUE_SIZE + 2; i++) {
+        Gesture_Edge(&gesture, (i * 200 + 1) * MS, true);
+        Gesture_Edge(&gesture, (i * 200 + 101) * MS, false);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, gesture.Overflows);
+    TEST_ASSERT_EQUAL(GESTURE_QUEUE_SIZE, drain());
+    assertEvent(0, GESTURE_CLICK, 101 * MS, 1 * MS);
+    assertEvent(GESTURE_QUEUE_SIZE - 1, GESTURE_CLICK, 1501 * MS, 1401 * MS);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_click_without_double_click_is_immediate);
+    RUN_TEST(test_click_waits_for_the_double_click_window);
+    RUN_TEST(test_double_click);
+    RUN_TEST(test_bounces_are_dropped);
+    RUN_TEST(test_held_back_edge_settles_at_its_own_time);
+    RUN_TEST(test_hold_and_hold_release);
+    RUN_TEST(test_long_hold_has_no_release_event);
+    RUN_TEST(test_poll_rate_does_not_change_events);
+    RUN_TEST(test_timestamps_wrap);
+    RUN_TEST(test_full_queue_counts_overflows);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+/*****************************************************************************
+* | File        :   test_deadline_scheduler.cpp
+* | Function    :   Timer heap driven by a virtual millisecond clock
+* | Info        :
+*   pio test -e native -f test_deadline_scheduler
+*   The clock jumps from one deadline to the next the way loop() blocks
+*   for Sched_TimeUntilNext(); callbacks log which timer ran and when.
+******************************************************************************/
+#include <unity.h>
+#include "Deadline_Scheduler.h"
+
+#define LOG_SIZE 64
+
+static SCHED_TIMER timers[SCHED_MAX_TIMERS + 1];
+static uint32_t clockMs;
+static int logTimer[LOG_SIZE];
+static uint32_t logMs[LOG_SIZE];
+static int logCount;
+static uint32_t periodMs;      // Re-arm period for onPeriodic
+static SCHED_TIMER *victim;    // Cancelled by onCancel
+
+static void onRecord(void *arg)
+{
+    if (logCount < LOG_SIZE) {
+        logTimer[logCount] = (int)((SCHED_TIMER *)arg - timers);
+        logMs[logCount++] = clockMs;
+    }
+}
+
+static void onPeriodic(void *arg)
+{
+    onRecord(arg);
+    Sched_At((SCHED_TIMER *)arg, ((SCHED_TIMER *)arg)->Due + periodMs);
+}
+
+static void onCancel(void *arg)
+{
+    onRecord(arg);
+    Sched_Cancel(victim);
+}
+
+// Sleep until each deadline up to endMs and run what came due
+static void runUntil(uint32_t endMs)
+{
+    for (;;) {
+        uint32_t wait = Sched_TimeUntilNext(clockMs, endMs - clockMs);
+        clockMs += wait;
+        Sched_RunDue(clockMs);
+        if (clockMs == endMs) {
+            break;
+        }
+    }
+}
+
+void setUp(void)
+{
+    for (int i = 0; i <= SCHED_MAX_TIMERS; i++) {
+        Sched_Init(&timers[i], "t", onRecord, &timers[i]);
+    }
+    clockMs = 0;
+    logCount = 0;
+    Sched_ResetStats();
+}
+
+void tearDown(void)
+{
+    for (int i = 0; i <= SCHED_MAX_TIMERS; i++) {
+        Sched_Cancel(&timers[i]);
+    }
+}
+
+static void test_timers_run_in_deadline_order(void)
+{
+    uint32_t seed = 38;
+    for (int i = 0; i < SCHED_MAX_TIMERS; i++) {
+        seed = seed * 1103515245 + 12345;
+        TEST_ASSERT_TRUE(Sched_At(&timers[i], 1 + (seed >> 16) % 500));
+    }
+    runUntil(1000);
+    TEST_ASSERT_EQUAL(SCHED_MAX_TIMERS, logCount);
+    for (int i = 0; i < logCount; i++) {
+        TEST_ASSERT_EQUAL_UINT32(timers[logTimer[i]].Due, logMs[i]); // Never late on a virtual clock
+        if (i > 0) {
+            TEST_ASSERT_TRUE(logMs[i - 1] <= logMs[i]);
+        }
+    }
+    SCHED_STATS stats;
+    Sched_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_MAX_TIMERS, stats.Runs);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.MaxLateMs);
+}
+
+static void test_rearm_and_cancel(void)
+{
+    uint32_t due;
+    Sched_At(&timers[0], 100);
+    Sched_At(&timers[1], 200);
+    Sched_At(&timers[2], 300);
+    Sched_At(&timers[2], 50);     // Moved ahead of the others
+    Sched_After(&timers[0], 100, 150);
+    Sched_Cancel(&timers[1]);
+    TEST_ASSERT_FALSE(Sched_IsArmed(&timers[1]));
+    TEST_ASSERT_TRUE(Sched_NextDeadline(&due));
+    TEST_ASSERT_EQUAL_UINT32(50, due);
+    runUntil(1000);
+    TEST_ASSERT_EQUAL(2, logCount);
+    TEST_ASSERT_EQUAL(2, logTimer[0]);
+    TEST_ASSERT_EQUAL(0, logTimer[1]);
+    TEST_ASSERT_EQUAL_UINT32(250, logMs[1]);
+    TEST_ASSERT_FALSE(Sched_NextDeadline(&due));
+}
+
+static void test_full_heap(void)
+{
+    for (int i = 0; i < SCHED_MAX_TIMERS; i++) {
+        TEST_ASSERT_TRUE(Sched_At(&timers[i], 10 + i));
+    }
+    TEST_ASSERT_FALSE(Sched_At(&timers[SCHED_MAX_TIMERS], 5));
+    TEST_ASSERT_FALSE(Sched_IsArmed(&timers[SCHED_MAX_TIMERS]));
+    TEST_ASSERT_TRUE(Sched_At(&timers[3], 1)); // Moving an armed timer needs no new slot
+    TEST_ASSERT_EQUAL(1, Sched_RunDue(1));
+    TEST_ASSERT_EQUAL(3, logTimer[0]);
+}
+
+static void test_periodic_callback_rearms_itself(void)
+{
+    periodMs = 250;
+    Sched_Init(&timers[0], "tick", onPeriodic, &timers[0]);
+    Sched_At(&timers[0], 250);
+    Sched_At(&timers[1], 600);
+    runUntil(1000);
+    TEST_ASSERT_EQUAL(5, logCount);
+    static const uint32_t expected[] = {250, 500, 600, 750, 1000};
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i], logMs[i]);
+    }
+    TEST_ASSERT_TRUE(Sched_IsArmed(&timers[0]));
+}
+
+static void test_rearm_in_the_past_runs_on_the_next_call(void)
+{
+    periodMs = 0;
+    Sched_Init(&timers[0], "again", onPeriodic, &timers[0]);
+    Sched_At(&timers[0], 10);
+    TEST_ASSERT_EQUAL(1, Sched_RunDue(20));
+    TEST_ASSERT_EQUAL(0, Sched_TimeUntilNext(20, 100));
+    TEST_ASSERT_EQUAL(1, Sched_RunDue(20));
+    SCHED_STATS stats;
+    Sched_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(10, stats.MaxLateMs);
+}
+
+static void test_callback_cancels_a_timer_in_the_same_batch(void)
+{
+    Sched_Init(&timers[0], "cancel", onCancel, &timers[0]);
+    victim = &timers[1];
+    Sched_At(&timers[0], 10);
+    Sched_At(&timers[1], 20);
+    Sched_At(&timers[2], 30);
+    TEST_ASSERT_EQUAL(2, Sched_RunDue(40));
+    TEST_ASSERT_EQUAL(2, logCount);
+    TEST_ASSERT_EQUAL(0, logTimer[0]);
+    TEST_ASSERT_EQUAL(2, logTimer[1]);
+    TEST_ASSERT_FALSE(Sched_IsArmed(&timers[1]));
+}
+
+static void test_deadlines_across_the_millis_wrap(void)
+{
+    clockMs = 0xFFFFFF00u;
+    Sched_After(&timers[0], clockMs, 0x200);  // Due at 0x100, after the wrap
+    Sched_After(&timers[1], clockMs, 0x80);
+    TEST_ASSERT_EQUAL_UINT32(0x80, Sched_TimeUntilNext(clockMs, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0x20, Sched_TimeUntilNext(clockMs, 0x20));
+    runUntil(0x200);
+    TEST_ASSERT_EQUAL(2, logCount);
+    TEST_ASSERT_EQUAL(1, logTimer[0]);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF80u, logMs[0]);
+    TEST_ASSERT_EQUAL(0, logTimer[1]);
+    TEST_ASSERT_EQUAL_UINT32(0x100, logMs[1]);
+}
+
+static void test_time_accounting(void)
+{
+    Sched_AccountTime(300, 700);
+    Sched_AccountTime(100, 900);
+    SCHED_STATS stats;
+    Sched_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT64(400, stats.BusyUs);
+    TEST_ASSERT_EQUAL_UINT64(1600, stats.IdleUs);
+    TEST_ASSERT_EQUAL_UINT32(1000, Sched_TimeUntilNext(0, 1000)); // Nothing armed
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_timers_run_in_deadline_order);
+    RUN_TEST(test_rearm_and_cancel);
+    RUN_TEST(test_full_heap);
+    RUN_TEST(test_periodic_callback_rearms_itself);
+    RUN_TEST(test_rearm_in_the_past_runs_on_the_next_call);
+    RUN_TEST(test_callback_cancels_a_timer_in_the_same_batch);
+    RUN_TEST(test_deadlines_across_the_millis_wrap);
+    RUN_TEST(test_time_accounting);
+    return UNITY_END();
+}
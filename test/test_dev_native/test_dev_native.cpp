@@ -0,0 +1,165 @@
+/*****************************************************************************
+* | File        :   test_dev_native.cpp
+* | Function    :   Virtual ST7789 (DEV_Native) driven through LCD_Driver
+* | Info        :
+*   pio test -e native -f test_dev_native
+*   Every test starts from a freshly reset board with LCD_Init() done and
+*   the default bus timing.
+******************************************************************************/
+#include <unity.h>
+#include "DEV_Config.h"
+#include "LCD_Driver.h"
+#include "GUI_Paint.h"
+
+static const NATIVE_TIMING DEFAULT_TIMING = {NATIVE_DEFAULT_SPI_HZ, NATIVE_DEFAULT_CALL_NS, NATIVE_DEFAULT_GPIO_NS};
+static uint16_t frame[LCD_WIDTH * LCD_HEIGHT];
+
+void setUp(void)
+{
+    Native_SetTiming(&DEFAULT_TIMING);
+    Native_Reset();
+    LCD_Init();
+    LCD_SetScroll(0);
+    Native_ResetStats();
+}
+
+void tearDown(void)
+{
+}
+
+static void assertPanelShowsFrame(void)
+{
+    for (uint16_t y = 0; y < LCD_HEIGHT; y++) {
+        for (uint16_t x = 0; x < LCD_WIDTH; x++) {
+            if (Native_PanelPixel(x, y) != frame[y * LCD_WIDTH + x]) {
+                char msg[64];
+                snprintf(msg, sizeof(msg), "panel pixel (%u, %u) differs", x, y);
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+static void test_init_wakes_the_panel_within_datasheet_timing(void)
+{
+    Native_Reset();
+    LCD_Init();
+    const NATIVE_PANEL *panel = Native_Panel();
+    TEST_ASSERT_EQUAL_UINT32(0, Native_Stats()->Violations);
+    TEST_ASSERT_EQUAL_UINT32(0, Native_Stats()->StrayBytes);
+    TEST_ASSERT_FALSE(panel->Sleeping);
+    TEST_ASSERT_TRUE(panel->DisplayOn);
+    TEST_ASSERT_TRUE(panel->Inverted);
+    TEST_ASSERT_EQUAL_HEX8(0x05, panel->Colmod);
+    TEST_ASSERT_EQUAL_HEX8(0x00, panel->Madctl);
+    // Reset pulse, 5 ms, registers, then SLPOUT no earlier than 120 ms after the reset
+    TEST_ASSERT_GREATER_OR_EQUAL(LCD_RESET_TO_SLPOUT_MS + LCD_SLPOUT_READY_MS, (int)DEV_Millis());
+}
+
+static void test_command_right_after_reset_is_a_violation(void)
+{
+    DEV_Digital_Write(DEV_RST_PIN, 0);
+    DEV_Delay_us(LCD_RESET_PULSE_US);
+    DEV_Digital_Write(DEV_RST_PIN, 1);
+    LCD_WriteReg(0x29);
+    TEST_ASSERT_EQUAL_UINT32(1, Native_Stats()->Violations);
+    TEST_ASSERT_TRUE(Native_Panel()->Sleeping);
+}
+
+static void test_clear_fills_the_panel_one_burst_per_row(void)
+{
+    LCD_Clear(RED);
+    const NATIVE_STATS *stats = Native_Stats();
+    TEST_ASSERT_EQUAL_UINT32(LCD_WIDTH * LCD_HEIGHT, (uint32_t)stats->Pixels);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->Overflows);
+    TEST_ASSERT_EQUAL_UINT32(1, stats->Windows);
+    // CASET, RASET and RAMWR with their parameters, then one transaction per row
+    TEST_ASSERT_EQUAL_UINT32(7 + LCD_HEIGHT, stats->Transactions);
+    for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        frame[i] = RED;
+    }
+    assertPanelShowsFrame();
+}
+
+static void test_image_lands_on_the_panel_across_the_gram_wrap(void)
+{
+    for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        frame[i] = (uint16_t)(i * 2654435761u >> 16);
+    }
+    // Panel row 0 sits on GRAM row 300, so the window runs past row 319
+    LCD_SetScroll(300 - LCD_Y_OFFSET);
+    Native_ResetStats();
+    Paint_DrawImage(frame, 0, 0, LCD_WIDTH, LCD_HEIGHT);
+    const NATIVE_STATS *stats = Native_Stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats->Windows);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->Overflows);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->StrayBytes);
+    assertPanelShowsFrame();
+}
+
+static void test_pixels_past_the_window_are_dropped(void)
+{
+    LCD_SetCursor(0, 0, 1, 0);
+    LCD_WriteData_Word(BLUE);
+    LCD_WriteData_Word(GREEN);
+    LCD_WriteData_Word(WHITE);
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)Native_Stats()->Pixels);
+    TEST_ASSERT_EQUAL_UINT32(1, Native_Stats()->Overflows);
+    TEST_ASSERT_EQUAL_HEX16(BLUE, Native_PanelPixel(0, 0));
+    TEST_ASSERT_EQUAL_HEX16(GREEN, Native_PanelPixel(1, 0));
+}
+
+static void test_bytes_clocked_with_cs_high_are_stray(void)
+{
+    DEV_SPI_WRITE(0x28);
+    TEST_ASSERT_EQUAL_UINT32(1, Native_Stats()->StrayBytes);
+    TEST_ASSERT_EQUAL_UINT32(0, (uint32_t)Native_Stats()->CommandBytes);
+    TEST_ASSERT_TRUE(Native_Panel()->DisplayOn);
+}
+
+static void test_bus_time_follows_the_timing_model(void)
+{
+    static const uint8_t row[LCD_WIDTH * 2] = {0};
+    NATIVE_TIMING wireOnly = {8000000, 0, 0};
+    Native_SetTiming(&wireOnly);
+    LCD_WriteData_Buffer(row, sizeof(row));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(row) * 1000, (uint32_t)Native_Stats()->BusNs); // 1 us per byte at 8 MHz
+
+    // Plus one call and three GPIO writes (DC, CS low, CS high)
+    Native_SetTiming(&DEFAULT_TIMING);
+    Native_ResetStats();
+    LCD_WriteData_Buffer(row, sizeof(row));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(row) * 1000 + NATIVE_DEFAULT_CALL_NS + 3 * NATIVE_DEFAULT_GPIO_NS,
+                             (uint32_t)Native_Stats()->BusNs);
+}
+
+static void test_backlight_pwm_and_sleep_hold(void)
+{
+    LCD_SetBacklight(1023);
+    TEST_ASSERT_EQUAL_UINT8(255, Native_Panel()->Backlight);
+    TEST_ASSERT_TRUE(LCD_HoldForSleep(true));
+    TEST_ASSERT_EQUAL_UINT8(255, Native_Panel()->Backlight); // Held as a plain high level
+    TEST_ASSERT_TRUE(LCD_HoldForSleep(false));
+    TEST_ASSERT_EQUAL_UINT8(255, Native_Panel()->Backlight);
+
+    LCD_SetBacklight(512);
+    TEST_ASSERT_EQUAL_UINT8(128, Native_Panel()->Backlight);
+    TEST_ASSERT_FALSE(LCD_CanHoldForSleep());
+    TEST_ASSERT_FALSE(LCD_HoldForSleep(true));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_init_wakes_the_panel_within_datasheet_timing);
+    RUN_TEST(test_command_right_after_reset_is_a_violation);
+    RUN_TEST(test_clear_fills_the_panel_one_burst_per_row);
+    RUN_TEST(test_image_lands_on_the_panel_across_the_gram_wrap);
+    RUN_TEST(test_pixels_past_the_window_are_dropped);
+    RUN_TEST(test_bytes_clocked_with_cs_high_are_stray);
+    RUN_TEST(test_bus_time_follows_the_timing_model);
+    RUN_TEST(test_backlight_pwm_and_sleep_hold);
+    return UNITY_END();
+}
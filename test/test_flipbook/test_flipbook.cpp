@@ -0,0 +1,268 @@
+/*****************************************************************************
+* | File        :   test_flipbook.cpp
+* | Function    :   Flipbook playback order, drops and cycles on a virtual clock
+* | Info        :
+*   pio test -e native -f test_flipbook
+*   Time is the virtual board clock (DEV_Native), advanced by the test to
+*   just past each deadline. Every file loads as a flat colour that names
+*   it, so the frame on the panel after each present says which was shown.
+******************************************************************************/
+#include <unity.h>
+#include "DEV_Config.h"
+#include "LCD_Driver.h"
+#include "Frame_Pipeline.h"
+#include "Flipbook_Player.h"
+
+#define FPS         10
+#define PERIOD_US   (1000000 / FPS)
+#define IMAGE       7
+#define NO_FILE     (-1)
+
+// A present takes ~130 us of virtual bus time, well inside one period
+static const NATIVE_TIMING FAST_BUS = {4000000000UL, 0, 0};
+
+static int failingFile = NO_FILE;
+static int loads = 0;
+
+static uint16_t colorOf(int file)
+{
+    return (uint16_t)(0x0841 * (file + 1));
+}
+
+static bool loadFrame(int file, uint8_t *panelBytes)
+{
+    loads++;
+    if (file == failingFile) {
+        return false;
+    }
+    uint16_t color = colorOf(file);
+    for (uint32_t i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
+        panelBytes[2 * i] = color >> 8;
+        panelBytes[2 * i + 1] = color & 0xFF;
+    }
+    return true;
+}
+
+static uint32_t now(void)
+{
+    return (uint32_t)Native_Micros();
+}
+
+static void advanceTo(uint32_t us)
+{
+    if ((int32_t)(us - now()) > 0) {
+        Native_DelayUs(us - now());
+    }
+}
+
+// The file whose colour fills the panel, or -1
+static int shownFile(void)
+{
+    uint16_t color = Native_PanelPixel(0, 0);
+    for (int file = 0; file < FLIPBOOK_MAX_FRAMES; file++) {
+        if (colorOf(file) == color) {
+            return file;
+        }
+    }
+    return -1;
+}
+
+static uint32_t nextDue(void)
+{
+    uint32_t due = 0;
+    TEST_ASSERT_TRUE(Flipbook_NextDeadline(&due));
+    return due;
+}
+
+static FLIPBOOK_STATS stats(void)
+{
+    FLIPBOOK_STATS s;
+    Flipbook_GetStats(&s);
+    return s;
+}
+
+// Start and service until loading ends (one file per service), as loop() would
+static void start(int files, FLIPBOOK_MODE mode)
+{
+    TEST_ASSERT_TRUE(Flipbook_Start(files, FPS, mode, loadFrame, IMAGE));
+    for (int i = 0; i < files; i++) {
+        Flipbook_Service(now());
+        if (loads != stats().Cached) {
+            break;  // A failed load ends the sequence
+        }
+    }
+}
+
+// Service at `us` and return the file the present put on the panel
+static int serviceAt(uint32_t us)
+{
+    advanceTo(us);
+    Flipbook_Service(now());
+    Pipeline_WaitPresent();
+    return shownFile();
+}
+
+// Service just after the next deadline
+static int step(void)
+{
+    return serviceAt(nextDue() + 10);
+}
+
+static void assertOrder(const int *expected, int count)
+{
+    for (int i = 0; i < count; i++) {
+        char message[32];
+        snprintf(message, sizeof(message), "frame %d", i);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(expected[i], step(), message);
+    }
+}
+
+void setUp(void)
+{
+    Native_SetTiming(&FAST_BUS);
+    Native_Reset();
+    LCD_Init();
+    TEST_ASSERT_TRUE(Pipeline_Init());
+    failingFile = NO_FILE;
+    loads = 0;
+}
+
+void tearDown(void)
+{
+    Flipbook_Stop();
+}
+
+static void test_loop_order_and_cycles(void)
+{
+    static const int order[] = {0, 1, 2, 0, 1, 2, 0};
+    start(3, FLIPBOOK_LOOP);
+    TEST_ASSERT_EQUAL_UINT16(3, stats().Cached);
+    assertOrder(order, 7);
+    TEST_ASSERT_EQUAL_UINT32(7, stats().Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+}
+
+static void test_pingpong_of_one_frame_repeats_it(void)
+{
+    static const int order[] = {0, 0, 0};
+    start(1, FLIPBOOK_PINGPONG);
+    assertOrder(order, 3);
+    TEST_ASSERT_EQUAL_UINT32(0, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+}
+
+static void test_pingpong_of_two_frames_alternates(void)
+{
+    static const int order[] = {0, 1, 0, 1, 0};
+    start(2, FLIPBOOK_PINGPONG);
+    assertOrder(order, 5);
+    TEST_ASSERT_EQUAL_UINT32(0, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+}
+
+// 0..n-1, then back down to 1, without showing either end twice
+static void test_pingpong_of_n_frames_turns_at_both_ends(void)
+{
+    static const int order[] = {0, 1, 2, 3, 2, 1, 0, 1, 2, 3, 2, 1, 0};
+    start(4, FLIPBOOK_PINGPONG);
+    assertOrder(order, 13);
+    TEST_ASSERT_EQUAL_UINT32(13, stats().Frames);
+    TEST_ASSERT_EQUAL_UINT32(0, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+}
+
+static void test_nothing_is_shown_before_its_deadline(void)
+{
+    start(3, FLIPBOOK_LOOP);
+    TEST_ASSERT_EQUAL_INT(0, step());
+    uint32_t due = nextDue();
+    advanceTo(due - 1);
+    Flipbook_Service(now());
+    Pipeline_WaitPresent();
+    TEST_ASSERT_EQUAL_UINT32(1, stats().Frames);
+    TEST_ASSERT_EQUAL_UINT32(due, nextDue());
+}
+
+// Missed slots are skipped and counted; the timeline does not slip
+static void test_late_service_drops_the_missed_frames(void)
+{
+    start(5, FLIPBOOK_LOOP);
+    TEST_ASSERT_EQUAL_INT(0, step());
+    uint32_t first = nextDue() - PERIOD_US;
+    TEST_ASSERT_EQUAL_INT(3, serviceAt(first + 3 * PERIOD_US + PERIOD_US / 2));
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Frames);
+    TEST_ASSERT_EQUAL_UINT32(first + 4 * PERIOD_US, nextDue());
+    TEST_ASSERT_EQUAL_INT(4, step());
+    TEST_ASSERT_EQUAL_INT(0, step());
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats().Cycles);
+}
+
+// Lateness of more than a whole cycle folds into the cycle count
+static void test_lateness_past_a_cycle_folds_into_cycles(void)
+{
+    start(3, FLIPBOOK_LOOP);
+    TEST_ASSERT_EQUAL_INT(0, step());
+    uint32_t due = nextDue();
+    // Step 1 is due; 7 more slots pass, so step 8 (file 2) is shown
+    TEST_ASSERT_EQUAL_INT(2, serviceAt(due + 7 * PERIOD_US + 10));
+    TEST_ASSERT_EQUAL_UINT32(7, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+    TEST_ASSERT_EQUAL_INT(0, step());
+    TEST_ASSERT_EQUAL_UINT32(3, stats().Cycles);
+}
+
+static void test_pingpong_lateness_folds_into_cycles(void)
+{
+    start(4, FLIPBOOK_PINGPONG);    // Cycle 0 1 2 3 2 1
+    TEST_ASSERT_EQUAL_INT(0, step());
+    uint32_t due = nextDue();
+    // Step 1 + 10 = 11: one whole cycle, then step 5 (file 1)
+    TEST_ASSERT_EQUAL_INT(1, serviceAt(due + 10 * PERIOD_US + 10));
+    TEST_ASSERT_EQUAL_UINT32(10, stats().Dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, stats().Cycles);
+    TEST_ASSERT_EQUAL_INT(0, step());
+    TEST_ASSERT_EQUAL_UINT32(2, stats().Cycles);
+}
+
+static void test_sequence_ends_at_the_first_unreadable_file(void)
+{
+    static const int order[] = {0, 1, 2, 0, 1};
+    failingFile = 3;
+    start(6, FLIPBOOK_LOOP);
+    TEST_ASSERT_TRUE(Flipbook_IsPlaying());
+    TEST_ASSERT_EQUAL_INT(4, loads);    // Nothing is loaded past the failure
+    TEST_ASSERT_EQUAL_UINT16(6, stats().Files);
+    TEST_ASSERT_EQUAL_UINT16(3, stats().Cached);
+    assertOrder(order, 5);
+    TEST_ASSERT_EQUAL_UINT32(1, stats().Cycles);
+}
+
+static void test_unreadable_first_file_stops_playback(void)
+{
+    failingFile = 0;
+    start(4, FLIPBOOK_LOOP);
+    TEST_ASSERT_FALSE(Flipbook_IsPlaying());
+    TEST_ASSERT_EQUAL_INT(1, loads);
+    TEST_ASSERT_EQUAL_STRING("no frame could be decoded", Flipbook_LastError());
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_loop_order_and_cycles);
+    RUN_TEST(test_pingpong_of_one_frame_repeats_it);
+    RUN_TEST(test_pingpong_of_two_frames_alternates);
+    RUN_TEST(test_pingpong_of_n_frames_turns_at_both_ends);
+    RUN_TEST(test_nothing_is_shown_before_its_deadline);
+    RUN_TEST(test_late_service_drops_the_missed_frames);
+    RUN_TEST(test_lateness_past_a_cycle_folds_into_cycles);
+    RUN_TEST(test_pingpong_lateness_folds_into_cycles);
+    RUN_TEST(test_sequence_ends_at_the_first_unreadable_file);
+    RUN_TEST(test_unreadable_first_file_stops_playback);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************
+* | File        :   test_frame_blend.cpp
+* | Function    :   Crossfade and dissolve golden values, frame pacer
+* | Info        :
+*   pio test -e native -f test_frame_blend
+*   The packed crossfade is checked against a plain per-channel blend
+*   (floor((from * (32 - a) + to * a) / 32), a = 5-bit alpha) and a few
+*   hand-worked pixels; the pacer against a scripted clock.
+******************************************************************************/
+#include <unity.h>
+#include "Frame_Blend.h"
+
+#define ROW 135
+
+static uint16_t reference(uint16_t from, uint16_t to, uint16_t level)
+{
+    uint32_t a = level >= BLEND_LEVELS ? 32 : (level + 4) / 8;
+    uint32_t r = (((from >> 11) & 31) * (32 - a) + ((to >> 11) & 31) * a) / 32;
+    uint32_t g = (((from >> 5) & 63) * (32 - a) + ((to >> 5) & 63) * a) / 32;
+    uint32_t b = ((from & 31) * (32 - a) + (to & 31) * a) / 32;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_golden_pixels(void)
+{
+    TEST_ASSERT_EQUAL_HEX16(0xF800, Blend_Pixel565(0xF800, 0x001F, 0));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, Blend_Pixel565(0xF800, 0x001F, 3));     // Rounds to alpha 0
+    TEST_ASSERT_EQUAL_HEX16(0x780F, Blend_Pixel565(0xF800, 0x001F, 128));   // 15/32 red, 15/32 blue
+    TEST_ASSERT_EQUAL_HEX16(0x001F, Blend_Pixel565(0xF800, 0x001F, 252));   // Alpha 32 before the end
+    TEST_ASSERT_EQUAL_HEX16(0x001F, Blend_Pixel565(0xF800, 0x001F, BLEND_LEVELS));
+    TEST_ASSERT_EQUAL_HEX16(0x03E0, Blend_Pixel565(0x0000, 0x07E0, 128));   // Green keeps its 6th bit
+    TEST_ASSERT_EQUAL_HEX16(0x7BEF, Blend_Pixel565(0xFFFF, 0x0000, 128));
+    TEST_ASSERT_EQUAL_HEX16(0x1234, Blend_Pixel565(0x1234, 0x1234, 77));    // Same pixel unchanged
+}
+
+// No channel borrows from or carries into its neighbour, at any level
+static void test_matches_per_channel_blend(void)
+{
+    uint32_t seed = 43;
+    for (int i = 0; i < 4000; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint16_t from = seed >> 8;
+        seed = seed * 1103515245 + 12345;
+        uint16_t to = seed >> 8;
+        if (i < 4) {
+            from = i & 1 ? 0xFFFF : 0x0000;
+            to = i & 2 ? 0xFFFF : 0x0000;
+        }
+        for (uint16_t level = 0; level <= BLEND_LEVELS; level++) {
+            TEST_ASSERT_EQUAL_HEX16(reference(from, to, level), Blend_Pixel565(from, to, level));
+        }
+    }
+}
+
+static void test_row_is_big_endian(void)
+{
+    uint16_t from[ROW], to[ROW];
+    uint8_t out[ROW * 2];
+    for (int i = 0; i < ROW; i++) {
+        from[i] = i < 20 ? 0x0000 : (uint16_t)(i * 0x0421);
+        to[i] = i < 20 ? 0x0000 : (uint16_t)~from[i];   // Letterbox bar stays black
+    }
+    Blend_Row565(from, to, ROW, 96, out);
+    for (int i = 0; i < ROW; i++) {
+        uint16_t c = (out[2 * i] << 8) | out[2 * i + 1];
+        TEST_ASSERT_EQUAL_HEX16(reference(from[i], to[i], 96), c);
+    }
+}
+
+static void test_dissolve_switches_each_pixel_once(void)
+{
+    uint16_t from[ROW], to[ROW];
+    uint8_t out[ROW * 2];
+    uint16_t switchedAt[ROW];
+    for (int i = 0; i < ROW; i++) {
+        from[i] = 0x0000;
+        to[i] = 0xFFFF;
+        switchedAt[i] = 0xFFFF;
+    }
+    for (uint16_t y = 0; y < 240; y += 17) {
+        for (int i = 0; i < ROW; i++) {
+            switchedAt[i] = 0xFFFF;
+        }
+        for (uint16_t level = 0; level <= BLEND_LEVELS; level++) {
+            Blend_DissolveRow565(from, to, ROW, y, level, out);
+            for (int i = 0; i < ROW; i++) {
+                bool incoming = out[2 * i] == 0xFF;
+                TEST_ASSERT_EQUAL(Blend_DissolveThreshold(i, y) < level, incoming);
+                if (incoming && switchedAt[i] == 0xFFFF) {
+                    switchedAt[i] = level;
+                }
+                TEST_ASSERT_TRUE_MESSAGE(!(switchedAt[i] != 0xFFFF && !incoming), "pixel switched back");
+            }
+        }
+        for (int i = 0; i < ROW; i++) {
+            TEST_ASSERT_TRUE(switchedAt[i] >= 1 && switchedAt[i] <= BLEND_LEVELS);
+        }
+    }
+}
+
+// Thresholds over the panel fill the 16 bands of 16 levels about evenly
+static void test_dissolve_thresholds_are_spread(void)
+{
+    uint32_t bands[16] = {0};
+    for (uint16_t y = 0; y < 240; y++) {
+        for (uint16_t x = 0; x < ROW; x++) {
+            bands[Blend_DissolveThreshold(x, y) >> 4]++;
+        }
+    }
+    uint32_t expected = ROW * 240 / 16;
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT_UINT32_WITHIN(expected / 10, expected, bands[i]);
+    }
+}
+
+static void test_pacer_on_time(void)
+{
+    BLEND_PACER pacer;
+    uint16_t level;
+    Blend_Begin(&pacer, 8, 1000, 5000);
+    for (uint16_t k = 1; k <= 8; k++) {
+        TEST_ASSERT_TRUE(Blend_Next(&pacer, 5000 + (k - 1) * 1000 + 400, &level));
+        TEST_ASSERT_EQUAL_UINT16(k * BLEND_LEVELS / 8, level);
+        TEST_ASSERT_EQUAL_UINT32(5000 + k * 1000, Blend_SlotEndUs(&pacer));
+    }
+    TEST_ASSERT_FALSE(Blend_Next(&pacer, 20000, &level));
+    TEST_ASSERT_EQUAL_UINT16(0, pacer.Dropped);
+}
+
+static void test_pacer_skips_late_levels(void)
+{
+    BLEND_PACER pacer;
+    uint16_t level;
+    Blend_Begin(&pacer, 10, 1000, 0);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 0, &level));
+    TEST_ASSERT_EQUAL_UINT16(25, level);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 4500, &level));     // Slot 5: levels 2-4 skipped
+    TEST_ASSERT_EQUAL_UINT16(128, level);
+    TEST_ASSERT_EQUAL_UINT16(3, pacer.Dropped);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 4900, &level));     // Early is never held back here
+    TEST_ASSERT_EQUAL_UINT16(6 * BLEND_LEVELS / 10, level);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 60000, &level));    // Far behind: straight to the end
+    TEST_ASSERT_EQUAL_UINT16(BLEND_LEVELS, level);
+    TEST_ASSERT_EQUAL_UINT16(6, pacer.Dropped);
+    TEST_ASSERT_FALSE(Blend_Next(&pacer, 60001, &level));
+}
+
+static void test_pacer_across_the_micros_wrap(void)
+{
+    BLEND_PACER pacer;
+    uint16_t level;
+    Blend_Begin(&pacer, 0, 40000, 0xFFFFF000u);  // At least one frame
+    TEST_ASSERT_EQUAL_UINT16(1, pacer.Steps);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 0x00000100u, &level));
+    TEST_ASSERT_EQUAL_UINT16(BLEND_LEVELS, level);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFF000u + 40000, Blend_SlotEndUs(&pacer));
+
+    Blend_Begin(&pacer, 4, 1000, 0xFFFFFC00u);
+    TEST_ASSERT_TRUE(Blend_Next(&pacer, 0x00000500u, &level)); // 2304 us in: slot 3
+    TEST_ASSERT_EQUAL_UINT16(3 * BLEND_LEVELS / 4, level);
+    TEST_ASSERT_EQUAL_UINT16(2, pacer.Dropped);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_golden_pixels);
+    RUN_TEST(test_matches_per_channel_blend);
+    RUN_TEST(test_row_is_big_endian);
+    RUN_TEST(test_dissolve_switches_each_pixel_once);
+    RUN_TEST(test_dissolve_thresholds_are_spread);
+    RUN_TEST(test_pacer_on_time);
+    RUN_TEST(test_pacer_skips_late_levels);
+    RUN_TEST(test_pacer_across_the_micros_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,228 @@
+/*****************************************************************************
+* | File        :   test_frame_pipeline.cpp
+* | Function    :   Frame_Pipeline on the virtual panel and the host SD_Reader
+* | Info        :
+*   pio test -e native -f test_frame_pipeline
+*   The present task is a host thread, and DEV_Native paces LCD bursts and
+*   card reads in real time, so the two buses really run side by side.
+*   Images are raw frames in generated host files, read through SD_Reader
+*   into the back frame the way main.cpp decodes. Every check is made on
+*   the pipeline's own trace.
+******************************************************************************/
+#include <unity.h>
+#include "DEV_Config.h"
+#include "LCD_Driver.h"
+#include "SD_Reader.h"
+#include "Frame_Pipeline.h"
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define IMAGES          5
+#define FRAME_PIXELS    (LCD_WIDTH * LCD_HEIGHT)
+#define OVERLAY         20      // UI draws a square this size in the corner
+
+// A present (~13 ms) outlasts a decode (~7 ms in 5 card reads)
+static const NATIVE_PACING PACING = {200, 200000, 100};
+
+static char paths[IMAGES][32];
+static SD_READER reader;        // Reused for every image, as main.cpp does
+static uint16_t pixels[FRAME_PIXELS];
+static UBYTE overlay[OVERLAY * OVERLAY * 2];
+static PIPE_EVENT events[PIPELINE_TRACE_SIZE];
+static uint32_t eventCount;
+static uint32_t uiAskedUs[IMAGES];
+static PIPE_STAGE decodeOwner[IMAGES];
+static PIPE_STAGE uiOwner[IMAGES];
+
+// Same clock as the pipeline's host trace
+static uint32_t nowUs(void)
+{
+    using namespace std::chrono;
+    return (uint32_t)duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+static uint16_t pixelOf(int image, uint32_t i)
+{
+    return (uint16_t)(i * 31 + image * 0x0841);
+}
+
+static bool overlaps(const PIPE_EVENT *a, const PIPE_EVENT *b)
+{
+    return (int32_t)(a->StartUs - b->EndUs) < 0 && (int32_t)(b->StartUs - a->EndUs) < 0;
+}
+
+static const PIPE_EVENT *findEvent(PIPE_STAGE stage, int image)
+{
+    for (uint32_t i = 0; i < eventCount; i++) {
+        if (events[i].Stage == stage && events[i].Image == image) {
+            return &events[i];
+        }
+    }
+    return NULL;
+}
+
+// Read + "decode" under the SD bus, as decodeIntoBackFrame does
+static bool decode(int image)
+{
+    Pipeline_SetBackImage(-1);
+    Bus_Acquire(BUS_SD, STAGE_DECODE);
+    decodeOwner[image] = Bus_Owner(BUS_SD);
+    uint32_t t0 = nowUs();
+    bool ok = SDReader_Open(&reader, paths[image]) &&
+              SDReader_Read(&reader, (uint8_t *)Pipeline_BackFrame(), FRAME_PIXELS * 2) == FRAME_PIXELS * 2;
+    SDReader_Close(&reader);
+    Pipeline_Trace(STAGE_DECODE, BUS_SD, image, t0, nowUs());
+    Bus_Release(BUS_SD);
+    if (ok) {
+        Pipeline_SetBackImage(image);
+    }
+    return ok;
+}
+
+// An overlay from loop() that skips Pipeline_WaitPresent: only the bus mutex keeps it out
+static void drawOverlay(int image)
+{
+    uiAskedUs[image] = nowUs();
+    Bus_Acquire(BUS_LCD, STAGE_UI);
+    uiOwner[image] = Bus_Owner(BUS_LCD);
+    uint32_t start = nowUs();
+    LCD_SetCursor(0, 0, OVERLAY - 1, OVERLAY - 1);
+    LCD_WriteData_Buffer(overlay, sizeof(overlay));
+    Pipeline_Trace(STAGE_UI, BUS_LCD, -1, start, nowUs());
+    Bus_Release(BUS_LCD);
+}
+
+// Image 0 is shown, then each next image is decoded while the previous one is pushed
+static void runSlideshow(bool withOverlays)
+{
+    Pipeline_ResetTrace();
+    TEST_ASSERT_TRUE(decode(0));
+    Pipeline_Swap();
+    Pipeline_PresentFront();
+    for (int image = 1; image < IMAGES; image++) {
+        TEST_ASSERT_TRUE(decode(image));
+        if (withOverlays) {
+            drawOverlay(image);
+        }
+        Pipeline_Swap();
+        Pipeline_PresentFront();
+    }
+    Pipeline_WaitPresent();
+    eventCount = Pipeline_CopyTrace(events, PIPELINE_TRACE_SIZE);
+}
+
+void setUp(void)
+{
+    static bool written = false;
+    if (!written) {
+        for (int image = 0; image < IMAGES; image++) {
+            strcpy(paths[image], "/tmp/pipelineXXXXXX");
+            int fd = mkstemp(paths[image]);
+            TEST_ASSERT_TRUE(fd >= 0);
+            for (uint32_t i = 0; i < FRAME_PIXELS; i++) {
+                pixels[i] = pixelOf(image, i);
+            }
+            TEST_ASSERT_EQUAL(FRAME_PIXELS * 2, write(fd, pixels, FRAME_PIXELS * 2));
+            close(fd);
+        }
+        memset(overlay, 0xFF, sizeof(overlay));
+        written = true;
+    }
+    Native_SetPacing(&PACING);
+    Native_Reset();
+    LCD_Init();
+    TEST_ASSERT_TRUE(Pipeline_Init());
+}
+
+void tearDown(void)
+{
+    Pipeline_WaitPresent();
+}
+
+static void test_decode_of_next_image_overlaps_present(void)
+{
+    runSlideshow(false);
+    TEST_ASSERT_EQUAL_UINT32(2 * IMAGES, eventCount);
+    for (int image = 0; image + 1 < IMAGES; image++) {
+        const PIPE_EVENT *present = findEvent(STAGE_PRESENT, image);
+        const PIPE_EVENT *decode = findEvent(STAGE_DECODE, image + 1);
+        TEST_ASSERT_NOT_NULL(present);
+        TEST_ASSERT_NOT_NULL(decode);
+        TEST_ASSERT_EQUAL_UINT8(BUS_LCD, present->Bus);
+        TEST_ASSERT_EQUAL_UINT8(BUS_SD, decode->Bus);
+        TEST_ASSERT_TRUE_MESSAGE(overlaps(present, decode), "decode N+1 ran after present N");
+    }
+}
+
+static void test_buses_are_owned_by_their_stage(void)
+{
+    runSlideshow(true);
+    for (int image = 0; image < IMAGES; image++) {
+        TEST_ASSERT_EQUAL(STAGE_DECODE, decodeOwner[image]);
+    }
+    for (int image = 1; image < IMAGES; image++) {
+        TEST_ASSERT_EQUAL(STAGE_UI, uiOwner[image]);
+    }
+    TEST_ASSERT_EQUAL(STAGE_NONE, Bus_Owner(BUS_SD));
+    TEST_ASSERT_EQUAL(STAGE_NONE, Bus_Owner(BUS_LCD));
+}
+
+static void test_ui_draws_never_interleave_with_a_present(void)
+{
+    runSlideshow(true);
+    TEST_ASSERT_EQUAL_UINT32(3 * IMAGES - 1, eventCount);
+    uint32_t ui = 0, contended = 0;
+    for (uint32_t i = 0; i < eventCount; i++) {
+        if (events[i].Stage != STAGE_UI) continue;
+        TEST_ASSERT_EQUAL_UINT8(BUS_LCD, events[i].Bus);
+        for (uint32_t j = 0; j < eventCount; j++) {
+            if (events[j].Stage == STAGE_PRESENT) {
+                TEST_ASSERT_FALSE_MESSAGE(overlaps(&events[i], &events[j]), "UI draw inside a present");
+            }
+        }
+        ui++;
+    }
+    TEST_ASSERT_EQUAL_UINT32(IMAGES - 1, ui);
+
+    // The overlays were asked for mid-present, so the mutex was actually tested
+    for (int image = 1; image < IMAGES; image++) {
+        const PIPE_EVENT *present = findEvent(STAGE_PRESENT, image - 1);
+        TEST_ASSERT_NOT_NULL(present);
+        if ((int32_t)(uiAskedUs[image] - present->StartUs) >= 0 &&
+            (int32_t)(uiAskedUs[image] - present->EndUs) < 0) {
+            contended++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(IMAGES - 1, contended);
+}
+
+static void test_panel_shows_the_last_image(void)
+{
+    runSlideshow(true);
+    TEST_ASSERT_EQUAL(IMAGES - 1, Pipeline_FrontImage());
+    for (uint32_t i = 0; i < FRAME_PIXELS; i++) {
+        if (Native_PanelPixel(i % LCD_WIDTH, i / LCD_WIDTH) != pixelOf(IMAGES - 1, i)) {
+            char message[64];
+            snprintf(message, sizeof(message), "panel pixel %u", (unsigned)i);
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_decode_of_next_image_overlaps_present);
+    RUN_TEST(test_buses_are_owned_by_their_stage);
+    RUN_TEST(test_ui_draws_never_interleave_with_a_present);
+    RUN_TEST(test_panel_shows_the_last_image);
+    int failures = UNITY_END();
+    for (int image = 0; image < IMAGES; image++) {
+        unlink(paths[image]);
+    }
+    return failures;
+}
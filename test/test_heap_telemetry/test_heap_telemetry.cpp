@@ -0,0 +1,208 @@
+/*****************************************************************************
+* | File        :   test_heap_telemetry.cpp
+* | Function    :   Placement, accounting and fragmentation on the host shim
+* | Info        :
+*   pio test -e native -f test_heap_telemetry
+*   Each test starts from empty arenas (Heap_HostReset). A block costs its
+*   bytes plus the 16-byte owner header and the shim's own 16-byte block
+*   header, rounded up to 16.
+******************************************************************************/
+#include <unity.h>
+#include "Heap_Telemetry.h"
+#include "Log_Ring.h"
+#include <stdint.h>
+#include <string.h>
+
+#define BLOCK_COST(bytes) (((bytes) + 32 + 15) / 16 * 16)
+#define ARENA_FREE(total) ((total) - 16)
+
+static char lastLog[LOG_LINE_SIZE];
+
+static void keepLast(const LOG_LINE *line)
+{
+    strcpy(lastLog, line->Text);
+}
+
+static HEAP_REGION_STATS region(HEAP_REGION which)
+{
+    HEAP_REGION_STATS stats;
+    Heap_RegionStats(which, &stats);
+    return stats;
+}
+
+void setUp(void)
+{
+    Heap_HostReset();
+    Log_Drain(keepLast);
+    lastLog[0] = '\0';
+}
+
+void tearDown(void)
+{
+}
+
+static void test_empty_arenas(void)
+{
+    HEAP_REGION_STATS internal = region(HEAP_INTERNAL);
+    TEST_ASSERT_EQUAL_UINT32(HEAP_HOST_INTERNAL_BYTES, internal.TotalBytes);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES), internal.FreeBytes);
+    TEST_ASSERT_EQUAL_UINT32(internal.FreeBytes, internal.LargestFree);
+    TEST_ASSERT_EQUAL_UINT32(internal.FreeBytes, internal.MinFree);
+    TEST_ASSERT_EQUAL_UINT8(0, Heap_Fragmentation(&internal));
+    TEST_ASSERT_EQUAL_UINT32(HEAP_HOST_PSRAM_BYTES, region(HEAP_PSRAM).TotalBytes);
+}
+
+static void test_placement_follows_caps(void)
+{
+    void *small = Heap_Alloc(HEAP_LINES, HEAP_INTERNAL_FIRST_MAX, HEAP_CAP_DEFAULT);
+    void *big = Heap_Alloc(HEAP_FRAMES, HEAP_INTERNAL_FIRST_MAX + 1, HEAP_CAP_DEFAULT);
+    void *internal = Heap_Alloc(HEAP_DECODER, 40000, HEAP_CAP_INTERNAL);
+    void *psram = Heap_Alloc(HEAP_CACHE, 100, HEAP_CAP_PSRAM);
+    void *dma = Heap_Alloc(HEAP_IO, 513, HEAP_CAP_DMA);
+    void *blocks[] = {small, big, internal, psram, dma};
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+        TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)blocks[i] % 16);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_LINES)->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(HEAP_INTERNAL_FIRST_MAX + 1, Heap_SubsystemStats(HEAP_FRAMES)->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_DECODER)->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(100, Heap_SubsystemStats(HEAP_CACHE)->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_IO)->PsramBytes);
+
+    uint32_t internalUsed = BLOCK_COST(HEAP_INTERNAL_FIRST_MAX) + BLOCK_COST(40000) + BLOCK_COST(513);
+    uint32_t psramUsed = BLOCK_COST(HEAP_INTERNAL_FIRST_MAX + 1) + BLOCK_COST(100);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES) - internalUsed, region(HEAP_INTERNAL).FreeBytes);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_PSRAM_BYTES) - psramUsed, region(HEAP_PSRAM).FreeBytes);
+
+    for (int i = 0; i < 5; i++) {
+        Heap_Free(blocks[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES), region(HEAP_INTERNAL).LargestFree);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_PSRAM_BYTES), region(HEAP_PSRAM).LargestFree);
+}
+
+static void test_subsystem_accounting(void)
+{
+    void *a = Heap_Alloc(HEAP_CATALOGUE, 1000, HEAP_CAP_DEFAULT);
+    void *b = Heap_Alloc(HEAP_CATALOGUE, 20000, HEAP_CAP_DEFAULT);
+    const HEAP_SUBSYSTEM_STATS *stats = Heap_SubsystemStats(HEAP_CATALOGUE);
+    TEST_ASSERT_EQUAL_UINT32(21000, stats->Bytes);
+    TEST_ASSERT_EQUAL_UINT32(20000, stats->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(2, stats->Blocks);
+    TEST_ASSERT_EQUAL_UINT32(2, stats->Allocs);
+    Heap_Free(b);
+    void *c = Heap_Alloc(HEAP_CATALOGUE, 500, HEAP_CAP_DEFAULT);
+    TEST_ASSERT_EQUAL_UINT32(1500, stats->Bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->PsramBytes);
+    TEST_ASSERT_EQUAL_UINT32(21000, stats->PeakBytes);
+    TEST_ASSERT_EQUAL_UINT32(3, stats->Allocs);
+    Heap_Free(a);
+    Heap_Free(c);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->Bytes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->Blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, stats->Failures);
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_FRAMES)->Allocs);  // Others untouched
+}
+
+static void test_fallback_and_failure(void)
+{
+    uint32_t psramFree = ARENA_FREE(HEAP_HOST_PSRAM_BYTES);
+    void *fill = Heap_Alloc(HEAP_FRAMES, psramFree - 32, HEAP_CAP_PSRAM);   // Exactly all of it
+    TEST_ASSERT_NOT_NULL(fill);
+    TEST_ASSERT_EQUAL_UINT32(0, region(HEAP_PSRAM).FreeBytes);
+
+    void *spill = Heap_Alloc(HEAP_FRAMES, 100000, HEAP_CAP_PSRAM);          // Internal instead
+    TEST_ASSERT_NOT_NULL(spill);
+    TEST_ASSERT_EQUAL_UINT32(psramFree - 32, Heap_SubsystemStats(HEAP_FRAMES)->PsramBytes);
+
+    void *none = Heap_Alloc(HEAP_FRAMES, HEAP_HOST_INTERNAL_BYTES, HEAP_CAP_DEFAULT);
+    TEST_ASSERT_NULL(none);
+    TEST_ASSERT_EQUAL_UINT32(1, Heap_SubsystemStats(HEAP_FRAMES)->Failures);
+    TEST_ASSERT_EQUAL_UINT32(3, Heap_SubsystemStats(HEAP_FRAMES)->Allocs);
+    TEST_ASSERT_EQUAL_UINT32(2, Heap_SubsystemStats(HEAP_FRAMES)->Blocks);
+    Log_Drain(keepLast);
+    TEST_ASSERT_EQUAL_STRING("heap: frames: 327680 bytes failed", lastLog);
+
+    Heap_Free(spill);
+    Heap_Free(fill);
+}
+
+// Freeing every other block leaves holes: plenty free, small largest block
+static void test_fragmentation_and_coalescing(void)
+{
+    void *blocks[16];
+    for (int i = 0; i < 16; i++) {
+        blocks[i] = Heap_Alloc(HEAP_CACHE, 16384 - 32, HEAP_CAP_INTERNAL);
+        TEST_ASSERT_NOT_NULL(blocks[i]);
+    }
+    uint32_t lowest = region(HEAP_INTERNAL).FreeBytes;
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES) - 16 * 16384, lowest);
+    for (int i = 0; i < 16; i += 2) {
+        Heap_Free(blocks[i]);
+    }
+    HEAP_REGION_STATS holes = region(HEAP_INTERNAL);
+    TEST_ASSERT_EQUAL_UINT32(lowest + 8 * (16384 - 16), holes.FreeBytes);  // Each hole keeps a block header
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES - 16 * 16384), holes.LargestFree);  // The tail
+    TEST_ASSERT_EQUAL_UINT32(lowest, holes.MinFree);
+    TEST_ASSERT_TRUE(Heap_Fragmentation(&holes) > 50);
+
+    void *wide = Heap_Alloc(HEAP_CACHE, 20000, HEAP_CAP_INTERNAL);   // Too big for a hole: goes to the tail
+    TEST_ASSERT_TRUE((uint8_t *)wide > (uint8_t *)blocks[15]);
+    Heap_Free(wide);
+    void *narrow = Heap_Alloc(HEAP_CACHE, 1000, HEAP_CAP_INTERNAL);  // First fit: the first hole
+    TEST_ASSERT_EQUAL_PTR(blocks[0], narrow);
+    Heap_Free(narrow);
+
+    for (int i = 1; i < 16; i += 2) {
+        Heap_Free(blocks[i]);    // Each joins the holes on both sides
+    }
+    HEAP_REGION_STATS whole = region(HEAP_INTERNAL);
+    TEST_ASSERT_EQUAL_UINT32(ARENA_FREE(HEAP_HOST_INTERNAL_BYTES), whole.FreeBytes);
+    TEST_ASSERT_EQUAL_UINT32(whole.FreeBytes, whole.LargestFree);
+    TEST_ASSERT_EQUAL_UINT8(0, Heap_Fragmentation(&whole));
+    TEST_ASSERT_EQUAL_UINT32(lowest, whole.MinFree);   // Low-water mark kept
+}
+
+static void test_foreign_and_double_free_are_refused(void)
+{
+    alignas(16) static uint8_t foreign[64];
+    void *p = Heap_Alloc(HEAP_IO, 64, HEAP_CAP_DEFAULT);
+    Heap_Free(NULL);
+    Heap_Free(foreign + 32);
+    Log_Drain(keepLast);
+    TEST_ASSERT_TRUE(strstr(lastLog, "not from Heap_Alloc") != NULL);
+    TEST_ASSERT_EQUAL_UINT32(1, Heap_SubsystemStats(HEAP_IO)->Blocks);
+
+    Heap_Free(p);
+    lastLog[0] = '\0';
+    Heap_Free(p);
+    Log_Drain(keepLast);
+    TEST_ASSERT_TRUE(strstr(lastLog, "not from Heap_Alloc") != NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_IO)->Blocks);
+    TEST_ASSERT_EQUAL_UINT32(0, Heap_SubsystemStats(HEAP_IO)->Bytes);
+}
+
+static void test_names(void)
+{
+    TEST_ASSERT_EQUAL_STRING("catalogue", Heap_SubsystemName(HEAP_CATALOGUE));
+    TEST_ASSERT_EQUAL_STRING("io", Heap_SubsystemName(HEAP_IO));
+    TEST_ASSERT_EQUAL_STRING("?", Heap_SubsystemName(HEAP_SUBSYSTEM_COUNT));
+    TEST_ASSERT_EQUAL_STRING("psram", Heap_RegionName(HEAP_PSRAM));
+    TEST_ASSERT_EQUAL_STRING("?", Heap_RegionName(HEAP_REGION_COUNT));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_arenas);
+    RUN_TEST(test_placement_follows_caps);
+    RUN_TEST(test_subsystem_accounting);
+    RUN_TEST(test_fallback_and_failure);
+    RUN_TEST(test_fragmentation_and_coalescing);
+    RUN_TEST(test_foreign_and_double_free_are_refused);
+    RUN_TEST(test_names);
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+* | File        :   test_lcd_scroll.cpp
+* | Function    :   Scroll geometry and push transition plans
+* | Info        :
+*   pio test -e native -f test_lcd_scroll
+*   A model GRAM of 320 rows records which image row each GRAM row holds.
+*   Every step of a plan is applied to it: the rows written must be off
+*   screen at the time, and after the scroll line moves the panel must show
+*   the tail of the old image and the head of the new one (or the reverse).
+******************************************************************************/
+#include <unity.h>
+#include "LCD_Scroll.h"
+
+#define OLD_ROW(r) (r)
+#define NEW_ROW(r) (1000 + (r))
+
+static int gram[LCD_GRAM_ROWS];
+static uint16_t line;
+
+static bool visible(uint16_t gramRow)
+{
+    return (uint16_t)((gramRow + 2 * LCD_GRAM_ROWS - LCD_Y_OFFSET - line) % LCD_GRAM_ROWS) < SCROLL_VIEW_ROWS;
+}
+
+static void applyStep(const SCROLL_STEP *step)
+{
+    TEST_ASSERT_TRUE(step->Rows <= SCROLL_SPARE_ROWS);
+    TEST_ASSERT_TRUE(step->GramRow < LCD_GRAM_ROWS);
+    TEST_ASSERT_TRUE(step->SrcRow + step->Rows <= SCROLL_VIEW_ROWS);
+    for (uint16_t i = 0; i < step->Rows; i++) {
+        uint16_t row = (step->GramRow + i) % LCD_GRAM_ROWS;
+        TEST_ASSERT_FALSE_MESSAGE(visible(row), "row written while on screen");
+        gram[row] = NEW_ROW(step->SrcRow + i);
+    }
+    TEST_ASSERT_TRUE(step->Line < LCD_GRAM_ROWS);
+    line = step->Line;
+}
+
+// The panel after travel rows of movement
+static void assertPanel(SCROLL_DIRECTION direction, uint16_t travel)
+{
+    for (uint16_t y = 0; y < SCROLL_VIEW_ROWS; y++) {
+        int want;
+        if (direction == SCROLL_PUSH_UP) {
+            want = y < SCROLL_VIEW_ROWS - travel ? OLD_ROW(y + travel) : NEW_ROW(y - (SCROLL_VIEW_ROWS - travel));
+        } else {
+            want = y < travel ? NEW_ROW(SCROLL_VIEW_ROWS - travel + y) : OLD_ROW(y - travel);
+        }
+        TEST_ASSERT_EQUAL_INT(want, gram[Scroll_GramRow(line, y)]);
+    }
+}
+
+static void runTransition(SCROLL_DIRECTION direction, uint16_t startLine, uint16_t steps)
+{
+    SCROLL_PLAN plan;
+    SCROLL_STEP step;
+    uint32_t sent = 0;
+    uint16_t travel = 0;
+    int count = 0;
+
+    line = startLine;
+    for (int i = 0; i < LCD_GRAM_ROWS; i++) {
+        gram[i] = -1;
+    }
+    for (uint16_t y = 0; y < SCROLL_VIEW_ROWS; y++) {
+        gram[Scroll_GramRow(line, y)] = OLD_ROW(y);
+    }
+
+    Scroll_Begin(&plan, direction, startLine, steps);
+    while (Scroll_Next(&plan, &step)) {
+        applyStep(&step);
+        travel += step.Rows;
+        sent += step.Rows;
+        count++;
+        assertPanel(direction, travel);
+    }
+    TEST_ASSERT_EQUAL(steps < SCROLL_MIN_STEPS ? SCROLL_MIN_STEPS : steps, count);
+    TEST_ASSERT_EQUAL_UINT32(SCROLL_VIEW_ROWS, sent);   // Exactly one frame
+    TEST_ASSERT_EQUAL_UINT16(Scroll_EndLine(&plan), line);
+    TEST_ASSERT_FALSE(Scroll_Next(&plan, &step));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static void test_gram_row_mapping(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(LCD_Y_OFFSET, Scroll_GramRow(0, 0));
+    TEST_ASSERT_EQUAL_UINT16(279, Scroll_GramRow(0, LCD_HEIGHT - 1));
+    TEST_ASSERT_EQUAL_UINT16(0, Scroll_GramRow(LCD_GRAM_ROWS - LCD_Y_OFFSET, 0));
+    TEST_ASSERT_EQUAL_UINT16(20, Scroll_GramRow(300, 0));
+    TEST_ASSERT_EQUAL_UINT16(259, Scroll_GramRow(300, LCD_HEIGHT - 1));
+}
+
+static void test_rows_before_wrap(void)
+{
+    TEST_ASSERT_EQUAL_UINT16(10, Scroll_RowsBeforeWrap(100, 10));
+    TEST_ASSERT_EQUAL_UINT16(20, Scroll_RowsBeforeWrap(300, 240));
+    TEST_ASSERT_EQUAL_UINT16(1, Scroll_RowsBeforeWrap(LCD_GRAM_ROWS - 1, 5));
+    TEST_ASSERT_EQUAL_UINT16(0, Scroll_RowsBeforeWrap(0, 0));
+}
+
+static void test_push_up_from_every_start_line(void)
+{
+    for (uint16_t start = 0; start < LCD_GRAM_ROWS; start += 7) {
+        runTransition(SCROLL_PUSH_UP, start, 12);
+    }
+}
+
+static void test_push_down_from_every_start_line(void)
+{
+    for (uint16_t start = 0; start < LCD_GRAM_ROWS; start += 7) {
+        runTransition(SCROLL_PUSH_DOWN, start, 12);
+    }
+}
+
+static void test_step_counts(void)
+{
+    static const uint16_t counts[] = {0, 1, SCROLL_MIN_STEPS, 7, 30, 240, 500};
+    for (unsigned i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        runTransition(SCROLL_PUSH_UP, 200, counts[i]);
+        runTransition(SCROLL_PUSH_DOWN, 200, counts[i]);
+    }
+}
+
+// Consecutive transitions start where the previous one stopped
+static void test_chained_transitions(void)
+{
+    SCROLL_PLAN plan;
+    uint16_t start = 0;
+    for (int i = 0; i < 5; i++) {
+        SCROLL_DIRECTION direction = i % 3 == 2 ? SCROLL_PUSH_DOWN : SCROLL_PUSH_UP;
+        runTransition(direction, start, 10);
+        Scroll_Begin(&plan, direction, start, 10);
+        start = Scroll_EndLine(&plan);
+    }
+    // Up, up, down, up, up: 4 * 240 - 240 rows forward
+    TEST_ASSERT_EQUAL_UINT16((3 * SCROLL_VIEW_ROWS) % LCD_GRAM_ROWS, start);
+    TEST_ASSERT_EQUAL_UINT16(start, line);
+}
+
+static void test_start_line_is_reduced(void)
+{
+    SCROLL_PLAN plan;
+    Scroll_Begin(&plan, SCROLL_PUSH_UP, LCD_GRAM_ROWS + 5, 10);
+    TEST_ASSERT_EQUAL_UINT16(5, plan.StartLine);
+    TEST_ASSERT_EQUAL_UINT16(5 + SCROLL_VIEW_ROWS, Scroll_EndLine(&plan));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_gram_row_mapping);
+    RUN_TEST(test_rows_before_wrap);
+    RUN_TEST(test_push_up_from_every_start_line);
+    RUN_TEST(test_push_down_from_every_start_line);
+    RUN_TEST(test_step_counts);
+    RUN_TEST(test_chained_transitions);
+    RUN_TEST(test_start_line_is_reduced);
+    return UNITY_END();
+}
@@ -0,0 +1,185 @@
+/*****************************************************************************
+* | File        :   test_log_ring.cpp
+* | Function    :   Log ring order, truncation, drops and allocation count
+* | Info        :
+*   pio test -e native -f test_log_ring
+*   With glibc, malloc/calloc/realloc are wrapped here to count calls
+*   while logging runs, so a line that reaches the heap fails the test.
+******************************************************************************/
+#include <unity.h>
+#include "Log_Ring.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __GLIBC__
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *p, size_t size);
+
+static volatile bool counting = false;
+static volatile uint32_t allocations = 0;
+
+extern "C" void *malloc(size_t size)
+{
+    if (counting) {
+        allocations++;
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size)
+{
+    if (counting) {
+        allocations++;
+    }
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *p, size_t size)
+{
+    if (counting) {
+        allocations++;
+    }
+    return __libc_realloc(p, size);
+}
+#endif
+
+#define SEEN_MAX (LOG_RING_LINES * 2)
+
+static LOG_LINE seen[SEEN_MAX];
+static int seenCount;
+
+static void record(const LOG_LINE *line)
+{
+    if (seenCount < SEEN_MAX) {
+        seen[seenCount++] = *line;
+    }
+}
+
+static void discard(const LOG_LINE *line)
+{
+    (void)line;
+}
+
+static int evaluated;
+
+static int sideEffect(void)
+{
+    return ++evaluated;
+}
+
+void setUp(void)
+{
+    Log_Drain(discard);
+    seenCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_lines_come_out_in_order(void)
+{
+    LOG_ERROR("sd: %s", "no card");
+    LOG_WARN("jpeg: %ux%u too large", 4000u, 3000u);
+    LOG_INFO("album %d/%d", 2, 5);
+    TEST_ASSERT_EQUAL_UINT32(3, Log_Drain(record));
+    TEST_ASSERT_EQUAL(3, seenCount);
+    TEST_ASSERT_EQUAL_UINT8(LOG_LEVEL_ERROR, seen[0].Level);
+    TEST_ASSERT_EQUAL_STRING("sd: no card", seen[0].Text);
+    TEST_ASSERT_EQUAL_UINT8(11, seen[0].Length);
+    TEST_ASSERT_EQUAL_STRING("jpeg: 4000x3000 too large", seen[1].Text);
+    TEST_ASSERT_EQUAL_UINT8(LOG_LEVEL_INFO, seen[2].Level);
+    TEST_ASSERT_EQUAL_STRING("album 2/5", seen[2].Text);
+    TEST_ASSERT_EQUAL_UINT32(0, Log_Drain(record));
+}
+
+static void test_long_lines_are_cut(void)
+{
+    char text[LOG_LINE_SIZE * 2];
+    memset(text, 'x', sizeof(text) - 1);
+    text[sizeof(text) - 1] = '\0';
+    LOG_INFO("%s", text);
+    Log_Drain(record);
+    TEST_ASSERT_EQUAL(1, seenCount);
+    TEST_ASSERT_EQUAL_UINT8(LOG_LINE_SIZE - 1, seen[0].Length);
+    TEST_ASSERT_EQUAL(LOG_LINE_SIZE - 1, (int)strlen(seen[0].Text));
+}
+
+static void test_full_ring_drops_and_reports(void)
+{
+    uint32_t before = Log_Dropped();
+    for (int i = 0; i < LOG_RING_LINES + 5; i++) {
+        LOG_INFO("line %d", i);
+    }
+    TEST_ASSERT_EQUAL_UINT32(before + 5, Log_Dropped());
+    TEST_ASSERT_EQUAL_UINT32(LOG_RING_LINES, Log_Drain(record));
+    TEST_ASSERT_EQUAL(LOG_RING_LINES + 1, seenCount);
+    TEST_ASSERT_EQUAL_STRING("line 0", seen[0].Text);
+    TEST_ASSERT_EQUAL_STRING("line 31", seen[LOG_RING_LINES - 1].Text);
+    TEST_ASSERT_EQUAL_UINT8(LOG_LEVEL_WARN, seen[LOG_RING_LINES].Level);
+    TEST_ASSERT_EQUAL_STRING("log: 5 lines dropped (ring full)", seen[LOG_RING_LINES].Text);
+
+    seenCount = 0;
+    LOG_INFO("after");
+    Log_Drain(record);
+    TEST_ASSERT_EQUAL(1, seenCount);     // Drops are reported once
+    TEST_ASSERT_EQUAL_STRING("after", seen[0].Text);
+}
+
+static void test_levels_above_log_level_compile_out(void)
+{
+    evaluated = 0;
+    LOG_DEBUG("%d", sideEffect());
+    LOG_INFO("%d", sideEffect());
+    TEST_ASSERT_EQUAL(LOG_LEVEL >= LOG_LEVEL_DEBUG ? 2 : 1, evaluated);
+    Log_Drain(record);
+    TEST_ASSERT_EQUAL(evaluated, seenCount);
+    TEST_ASSERT_EQUAL('E', Log_LevelLetter(LOG_LEVEL_ERROR));
+    TEST_ASSERT_EQUAL('D', Log_LevelLetter(LOG_LEVEL_DEBUG));
+    TEST_ASSERT_EQUAL('?', Log_LevelLetter(9));
+}
+
+// The hot-path lines of a slideshow frame, many times over, and their drains
+static void test_logging_does_not_allocate(void)
+{
+#ifdef __GLIBC__
+    allocations = 0;
+    counting = true;
+    for (int frame = 0; frame < 1000; frame++) {
+        LOG_INFO("image %d/%d: %s", frame % 40 + 1, 40, "/images/photo_0001.jpg");
+        LOG_DEBUG("jpeg: %ux%u scale 1/%u at %d,%d", 1600u, 1200u, 8u, -32, 0);
+        LOG_WARN("sd: %u KB/s, %u.%03u ms", 812u, 4u, 250u);
+        if (frame % 8 == 7) {
+            Log_Drain(discard);
+        }
+    }
+    for (int i = 0; i < LOG_RING_LINES + 1; i++) {
+        LOG_ERROR("full %d", i);
+    }
+    Log_Drain(discard);   // Includes the dropped-lines note
+    counting = false;
+    TEST_ASSERT_EQUAL_UINT32(0, allocations);
+
+    counting = true;      // The counter itself works
+    void *volatile p = malloc(16);
+    free(p);
+    counting = false;
+    TEST_ASSERT_EQUAL_UINT32(1, allocations);
+#else
+    TEST_IGNORE_MESSAGE("allocation counting needs glibc");
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_lines_come_out_in_order);
+    RUN_TEST(test_long_lines_are_cut);
+    RUN_TEST(test_full_ring_drops_and_reports);
+    RUN_TEST(test_levels_above_log_level_compile_out);
+    RUN_TEST(test_logging_does_not_allocate);
+    return UNITY_END();
+}
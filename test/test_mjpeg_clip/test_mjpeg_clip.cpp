@@ -0,0 +1,266 @@
+/*****************************************************************************
+* | File        :   test_mjpeg_clip.cpp
+* | Function    :   MJPEG clip frame index over synthetic AVI and .mjpg files
+* | Info        :
+*   pio test -e native -f test_mjpeg_clip
+*   Clips are assembled in memory, with stand-in frames that are only SOI,
+*   filler and EOI, and written to temporary files. Each test then checks
+*   the offsets and lengths MJPEGClip_NextFrame reports.
+******************************************************************************/
+#include <unity.h>
+#include "MJPEG_Clip.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CLIP_MAX_BYTES 8192
+#define CLIP_MAX_FRAMES 8
+
+static uint8_t clip[CLIP_MAX_BYTES];
+static uint32_t clipLen;
+static uint32_t frameOffset[CLIP_MAX_FRAMES];
+static uint32_t frameLength[CLIP_MAX_FRAMES];
+static int frameCount;
+static SD_READER reader;
+static MJPEG_CLIP mjpeg;
+static char path[32];
+
+static void put(const void *data, uint32_t len)
+{
+    memcpy(clip + clipLen, data, len);
+    clipLen += len;
+}
+
+static void put32(uint32_t value)
+{
+    uint8_t le[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    put(le, 4);
+}
+
+static void patch32(uint32_t at, uint32_t value)
+{
+    uint32_t end = clipLen;
+    clipLen = at;
+    put32(value);
+    clipLen = end;
+}
+
+// Opens a chunk or list; returns where its size goes
+static uint32_t beginChunk(const char *id, const char *listType)
+{
+    put(id, 4);
+    uint32_t sizeAt = clipLen;
+    put32(0);
+    if (listType != NULL) {
+        put(listType, 4);
+    }
+    return sizeAt;
+}
+
+// Closes it: patches the size and pads to an even length, as RIFF does
+static void endChunk(uint32_t sizeAt)
+{
+    patch32(sizeAt, clipLen - sizeAt - 4);
+    if (clipLen & 1) {
+        clip[clipLen++] = 0;
+    }
+}
+
+// Stand-in JPEG: SOI, filler with FF bytes that are not markers, EOI
+static void putFrame(uint32_t len, bool record)
+{
+    static const uint8_t soi[2] = {0xFF, 0xD8};
+    static const uint8_t eoi[2] = {0xFF, 0xD9};
+
+    if (record) {
+        frameOffset[frameCount] = clipLen;
+        frameLength[frameCount++] = len;
+    }
+    put(soi, 2);
+    for (uint32_t i = 2; i < len - 2; i++) {
+        clip[clipLen++] = i % 7 == 0 ? 0xFF : i & 0x7F;
+    }
+    put(eoi, 2);
+}
+
+static void putVideo(const char *id, uint32_t len, bool record)
+{
+    uint32_t chunk = beginChunk(id, NULL);
+    if (len > 0) {
+        putFrame(len, false);
+        if (record) {
+            frameOffset[frameCount] = chunk + 4;
+            frameLength[frameCount++] = clipLen - chunk - 4;
+        }
+    }
+    endChunk(chunk);
+}
+
+static void writeClip(const char *suffix)
+{
+    snprintf(path, sizeof(path), "/tmp/clipXXXXXX%s", suffix);
+    int fd = mkstemps(path, strlen(suffix));
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL(clipLen, write(fd, clip, clipLen));
+    close(fd);
+}
+
+static void assertFrames(void)
+{
+    uint32_t offset, length;
+    for (int i = 0; i < frameCount; i++) {
+        TEST_ASSERT_TRUE_MESSAGE(MJPEGClip_NextFrame(&mjpeg, &offset, &length), "frame missing");
+        TEST_ASSERT_EQUAL_UINT32(frameOffset[i], offset);
+        TEST_ASSERT_EQUAL_UINT32(frameLength[i], length);
+        TEST_ASSERT_EQUAL_UINT32(i + 1, mjpeg.FrameIndex);
+    }
+    TEST_ASSERT_FALSE(MJPEGClip_NextFrame(&mjpeg, &offset, &length));
+}
+
+// hdrl with a 25 fps 320x240 avih and a stream list, then JUNK and movi
+static void buildAvi(bool withMovi)
+{
+    uint32_t riff = beginChunk("RIFF", "AVI ");
+    uint32_t hdrl = beginChunk("LIST", "hdrl");
+    uint32_t avih = beginChunk("avih", NULL);
+    put32(40000);                   // Microseconds per frame
+    for (int i = 1; i < 8; i++) {
+        put32(0);
+    }
+    put32(320);
+    put32(240);
+    for (int i = 10; i < 14; i++) {
+        put32(0);
+    }
+    endChunk(avih);
+    uint32_t strl = beginChunk("LIST", "strl");
+    uint32_t strh = beginChunk("strh", NULL);
+    put("vidsMJPG", 8);
+    endChunk(strh);
+    endChunk(strl);
+    endChunk(hdrl);
+    uint32_t junk = beginChunk("JUNK", NULL);
+    put("odd", 3);                  // Padded to an even size
+    endChunk(junk);
+
+    if (withMovi) {
+        uint32_t movi = beginChunk("LIST", "movi");
+        putVideo("00dc", 301, true);
+        uint32_t audio = beginChunk("01wb", NULL);
+        put("pcm!", 4);
+        endChunk(audio);
+        putVideo("00dc", 0, false); // Dropped by the encoder
+        uint32_t rec = beginChunk("LIST", "rec ");
+        putVideo("00db", 700, true);
+        endChunk(rec);
+        putVideo("00dc", 64, true);
+        endChunk(movi);
+        uint32_t idx = beginChunk("idx1", NULL);
+        put32(0);
+        endChunk(idx);
+    }
+    endChunk(riff);
+}
+
+void setUp(void)
+{
+    clipLen = 0;
+    frameCount = 0;
+    path[0] = '\0';
+}
+
+void tearDown(void)
+{
+    if (path[0] != '\0') {
+        MJPEGClip_Close(&mjpeg);
+        unlink(path);
+    }
+}
+
+static void test_avi_frames_and_timing(void)
+{
+    buildAvi(true);
+    writeClip(".avi");
+    TEST_ASSERT_TRUE(MJPEGClip_Open(&mjpeg, &reader, path));
+    TEST_ASSERT_EQUAL(CLIP_AVI, mjpeg.Format);
+    TEST_ASSERT_EQUAL_UINT32(40000, mjpeg.FrameMicros);
+    TEST_ASSERT_EQUAL_UINT32(320, mjpeg.Width);
+    TEST_ASSERT_EQUAL_UINT32(240, mjpeg.Height);
+    assertFrames();
+}
+
+static void test_rewind_restarts_the_walk(void)
+{
+    buildAvi(true);
+    writeClip(".AVI");
+    TEST_ASSERT_TRUE(MJPEGClip_Open(&mjpeg, &reader, path));
+    uint32_t offset, length;
+    TEST_ASSERT_TRUE(MJPEGClip_NextFrame(&mjpeg, &offset, &length));
+    TEST_ASSERT_TRUE(MJPEGClip_NextFrame(&mjpeg, &offset, &length));
+    MJPEGClip_Rewind(&mjpeg);
+    TEST_ASSERT_EQUAL_UINT32(0, mjpeg.FrameIndex);
+    assertFrames();
+}
+
+static void test_avi_without_movi_is_rejected(void)
+{
+    buildAvi(false);
+    writeClip(".avi");
+    TEST_ASSERT_FALSE(MJPEGClip_Open(&mjpeg, &reader, path));
+    unlink(path);
+
+    setUp();
+    put("RIFX\0\0\0\0AVI ", 12);
+    writeClip(".avi");
+    TEST_ASSERT_FALSE(MJPEGClip_Open(&mjpeg, &reader, path));
+    unlink(path);
+    path[0] = '\0';
+}
+
+static void test_concatenated_jpegs(void)
+{
+    static const uint8_t fill[3] = {0xFF, 0xFF, 0x00};
+    putFrame(100, true);
+    put(fill, sizeof(fill));        // Stray bytes between frames
+    putFrame(MJPEG_CLIP_SCAN_BLOCK * 3 + 7, true); // Markers across scan blocks
+    putFrame(4, true);
+    writeClip(".mjpg");
+    TEST_ASSERT_TRUE(MJPEGClip_Open(&mjpeg, &reader, path));
+    TEST_ASSERT_EQUAL(CLIP_MJPG, mjpeg.Format);
+    TEST_ASSERT_EQUAL_UINT32(1000000 / MJPEG_CLIP_DEFAULT_FPS, mjpeg.FrameMicros);
+    assertFrames();
+}
+
+static void test_clip_without_eoi_ends(void)
+{
+    putFrame(40, true);
+    static const uint8_t cut[4] = {0xFF, 0xD8, 0x12, 0x34};
+    put(cut, sizeof(cut));
+    writeClip(".mjpeg");
+    TEST_ASSERT_TRUE(MJPEGClip_Open(&mjpeg, &reader, path));
+    assertFrames();
+}
+
+static void test_clip_file_names(void)
+{
+    TEST_ASSERT_TRUE(MJPEGClip_IsClipFile("/clips/a.avi"));
+    TEST_ASSERT_TRUE(MJPEGClip_IsClipFile("/clips/b.MJPG"));
+    TEST_ASSERT_TRUE(MJPEGClip_IsClipFile("/c.mjpeg"));
+    TEST_ASSERT_FALSE(MJPEGClip_IsClipFile("/clips/a.jpg"));
+    TEST_ASSERT_FALSE(MJPEGClip_IsClipFile("/avi"));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_avi_frames_and_timing);
+    RUN_TEST(test_rewind_restarts_the_walk);
+    RUN_TEST(test_avi_without_movi_is_rejected);
+    RUN_TEST(test_concatenated_jpegs);
+    RUN_TEST(test_clip_without_eoi_ends);
+    RUN_TEST(test_clip_file_names);
+    SDReader_Free(&reader);
+    return UNITY_END();
+}
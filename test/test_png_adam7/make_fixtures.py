@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""
+Writes png_fixtures.h for test_png_adam7: small interlaced PNGs covering
+each color type, the three deflate block types, every row filter, IDAT split
+across chunks and tRNS, each with the RGB565 of every pixel of the
+deinterlaced image (alpha and tRNS over black, as src/PNG_Adam7.cpp
+converts). The tests take the first pass preview from the same pixels.
+
+    python test/test_png_adam7/make_fixtures.py
+"""
+
+import os
+import random
+import struct
+import zlib
+
+ADAM7 = [(0, 0, 8, 8), (4, 0, 8, 8), (0, 4, 4, 8), (2, 0, 4, 4), (0, 2, 2, 4), (1, 0, 2, 2), (0, 1, 1, 2)]
+CHANNELS = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}
+
+
+def chunk(kind, data):
+    return struct.pack('>I', len(data)) + kind + data + struct.pack('>I', zlib.crc32(kind + data))
+
+
+def pack_row(samples, depth):
+    if depth == 16:
+        return b''.join(struct.pack('>H', v) for v in samples)
+    if depth == 8:
+        return bytes(samples)
+    out, acc, bits = bytearray(), 0, 0
+    for v in samples:
+        acc, bits = (acc << depth) | v, bits + depth
+        if bits == 8:
+            out.append(acc)
+            acc, bits = 0, 0
+    if bits:
+        out.append(acc << (8 - bits))
+    return bytes(out)
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    return a if pa <= pb and pa <= pc else b if pb <= pc else c
+
+
+def filter_row(row, prev, bpp, kind):
+    out = bytearray([kind])
+    for i, v in enumerate(row):
+        a = row[i - bpp] if i >= bpp else 0
+        c = prev[i - bpp] if i >= bpp else 0
+        out.append((v - [0, a, prev[i], (a + prev[i]) // 2, paeth(a, prev[i], c)][kind]) & 255)
+    return out
+
+
+def png(width, height, depth, color, pixel, strategy=zlib.Z_DEFAULT_STRATEGY, level=9,
+        plte=None, trns=None, idat_split=None, interlace=1):
+    """Rows cycle through filters 0-4; pixel(x, y) gives the samples"""
+    bpp = max(1, CHANNELS[color] * depth // 8)
+    raw, n = bytearray(), 0
+    for x0, y0, dx, dy in ADAM7 if interlace else [(0, 0, 1, 1)]:
+        xs = range(x0, width, dx)
+        prev = None
+        for y in range(y0, height, dy) if xs else []:
+            row = pack_row([s for x in xs for s in pixel(x, y)], depth)
+            raw += filter_row(row, prev or bytes(len(row)), bpp, n % 5)
+            prev, n = row, n + 1
+    compressor = zlib.compressobj(level, zlib.DEFLATED, 15, 9, strategy)
+    data = compressor.compress(bytes(raw)) + compressor.flush()
+    out = b'\x89PNG\r\n\x1a\n' + chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, depth, color, 0, 0, interlace))
+    out += chunk(b'tEXt', b'Comment\x00skipped')
+    out += chunk(b'PLTE', plte) if plte else b''
+    out += chunk(b'tRNS', trns) if trns else b''
+    step = idat_split or len(data)
+    for i in range(0, len(data), step):
+        out += chunk(b'IDAT', data[i:i + step])
+    return out + chunk(b'IEND', b'')
+
+
+def to8(v, depth):
+    return v >> 8 if depth == 16 else v if depth == 8 else v * 255 // ((1 << depth) - 1)
+
+
+def rgb565(r, g, b, a=255):
+    if a != 255:
+        r, g, b = [(c * a + 127) // 255 for c in (r, g, b)]
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def pixels(width, height, color):
+    return [color(x, y) for y in range(height) for x in range(width)]
+
+
+def fixtures():
+    rng = random.Random(7)
+    cases = []
+
+    # RGBA8, dynamic Huffman, IDAT in 61-byte chunks
+    w, h = 24, 17
+    rgba = lambda x, y: (x * 5 % 256, y * 9 % 256, x * y % 256, (x + y * 7) % 256)
+    cases.append(('rgba8_dynamic', w, h, png(w, h, 8, 6, rgba, idat_split=61),
+                  pixels(w, h, lambda x, y: rgb565(*rgba(x, y)))))
+
+    # 4-bit palette with partial tRNS and indices past the palette, fixed Huffman
+    w, h = 37, 21
+    plte = bytes(rng.randrange(256) for _ in range(12 * 3))
+    trns = bytes([0, 128, 255, 64, 10])
+    index = lambda x, y: (x + 3 * y) % 14
+
+    def palette_color(x, y):
+        v = index(x, y)
+        return 0 if v >= 12 else rgb565(*plte[3 * v:3 * v + 3], trns[v] if v < len(trns) else 255)
+    cases.append(('palette4_fixed', w, h, png(w, h, 4, 3, lambda x, y: (index(x, y),), strategy=zlib.Z_FIXED,
+                                              plte=plte, trns=trns), pixels(w, h, palette_color)))
+
+    # 16-bit gray with a tRNS key on a pass 1 pixel, stored blocks
+    w, h = 9, 17
+    gray = lambda x, y: (x * 3001 + y * 977) % 65536
+    key = gray(8, 8)
+    cases.append(('gray16_stored_key', w, h, png(w, h, 16, 0, lambda x, y: (gray(x, y),), level=0,
+                                                 trns=struct.pack('>H', key), idat_split=100),
+                  pixels(w, h, lambda x, y: 0 if gray(x, y) == key else rgb565(*3 * [to8(gray(x, y), 16)]))))
+
+    # 1-bit gray
+    w, h = 20, 9
+    bit = {(x, y): (x // 8 + y // 8) & 1 if x % 8 == 0 else rng.randrange(2) for x in range(w) for y in range(h)}
+    cases.append(('gray1', w, h, png(w, h, 1, 0, lambda x, y: (bit[x, y],)),
+                  pixels(w, h, lambda x, y: rgb565(*3 * [to8(bit[x, y], 1)]))))
+
+    # 16-bit RGB with a tRNS key
+    w, h = 16, 9
+    rgb = lambda x, y: (x * 2000, y * 3000, 65535 - x * 1000)
+    cases.append(('rgb16_key', w, h, png(w, h, 16, 2, rgb, trns=struct.pack('>HHH', *rgb(8, 0))),
+                  pixels(w, h, lambda x, y: 0 if (x, y) == (8, 0) else rgb565(*[to8(v, 16) for v in rgb(x, y)]))))
+
+    # 8-bit gray with alpha
+    w, h = 9, 9
+    cases.append(('gray_alpha8', w, h, png(w, h, 8, 4, lambda x, y: (200, x * 28)),
+                  pixels(w, h, lambda x, y: rgb565(200, 200, 200, x * 28))))
+
+    # 8-bit gray ramp larger than the panel, so rows and columns are skipped;
+    # the test computes its pixels, gray (x + 3y) & 255, instead of a table
+    w, h = 300, 200
+    cases.append(('gray8_downscaled', w, h, png(w, h, 8, 0, lambda x, y: ((x + 3 * y) & 255,)), None))
+
+    # Not interlaced: left to PNGdec
+    cases.append(('not_interlaced', 8, 8, png(8, 8, 8, 0, lambda x, y: (x,), interlace=0), None))
+    return cases
+
+
+def c_array(kind, name, values, per_line, fmt):
+    lines = [', '.join(fmt.format(v) for v in values[i:i + per_line]) for i in range(0, len(values), per_line)]
+    return f"static const {kind} {name}[] = {{\n" + ''.join(f"    {line},\n" for line in lines) + "};\n"
+
+
+def main():
+    path = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'png_fixtures.h')
+    with open(path, 'w') as f:
+        f.write("// Generated by make_fixtures.py - do not edit.\n")
+        f.write("#ifndef __PNG_FIXTURES_H\n#define __PNG_FIXTURES_H\n\n#include <stdint.h>\n\n")
+        for name, width, height, data, expected in fixtures():
+            f.write(f"// {width}x{height}\n")
+            f.write(c_array('uint8_t', name.upper(), data, 16, '0x{:02X}'))
+            if expected is not None:
+                f.write(c_array('uint16_t', name.upper() + '_PIXELS', expected, 8, '0x{:04X}'))
+            f.write("\n")
+        f.write("#endif\n")
+    print(f"✅ {path}")
+
+
+if __name__ == '__main__':
+    main()
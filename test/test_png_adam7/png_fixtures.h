@@ -0,0 +1,611 @@
+// Generated by make_fixtures.py - do not edit.
+#ifndef __PNG_FIXTURES_H
+#define __PNG_FIXTURES_H
+
+#include <stdint.h>
+
+// 24x17
+static const uint8_t RGBA8_DYNAMIC[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x11, 0x08, 0x06, 0x00, 0x00, 0x01, 0xB0, 0x7F, 0x5C,
+    0xA6, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x3D,
+    0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0xBD, 0xD4, 0x4F, 0x6F, 0x1B, 0x45, 0x1C, 0xC6, 0xF1, 0x67,
+    0xFF, 0xD9, 0x3B, 0x6B, 0x67, 0x77, 0xB3, 0xD9, 0x24, 0x76, 0xEA, 0xBA, 0x29, 0xB6, 0x90, 0x55,
+    0x70, 0x09, 0x46, 0xAC, 0x5D, 0x30, 0xC4, 0x4E, 0xC1, 0x6C, 0xE3, 0x26, 0xEC, 0x94, 0x3A, 0xAA,
+    0x46, 0x48, 0x41, 0x34, 0x42, 0x8A, 0x54, 0x45, 0x01, 0x53, 0x01, 0x02, 0x02, 0x08, 0x50, 0x25,
+    0xC4, 0xB7, 0x2F, 0xBD, 0x06, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x61, 0xAE, 0x88,
+    0x4B, 0xC5, 0x95, 0x4B, 0x0F, 0xBD, 0x22, 0x71, 0x42, 0xDC, 0xE0, 0x05, 0xF0, 0x22, 0x78, 0x09,
+    0x3C, 0x4E, 0xF6, 0x80, 0x02, 0x48, 0x39, 0xB4, 0xAC, 0xF4, 0x39, 0xAC, 0xB4, 0x1A, 0xCD, 0xEF,
+    0x3B, 0xA3, 0x05, 0xF8, 0xB4, 0x00, 0x37, 0x03, 0x42, 0x03, 0x29, 0x7A, 0x2D, 0x0C, 0xDC, 0x19,
+    0x73, 0xF6, 0x82, 0x74, 0x40, 0x9F, 0xF7, 0xAC, 0x18, 0xB0, 0x57, 0xED, 0x87, 0xFB, 0x00, 0x00,
+    0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x3B, 0x80, 0x37, 0x02, 0x7C, 0x1B, 0xE9, 0x6A, 0x0F, 0xFC,
+    0xE4, 0x58, 0xAC, 0x07, 0xEF, 0xF7, 0xF5, 0xCF, 0x9F, 0xEC, 0xE9, 0xC1, 0x57, 0x06, 0x9A, 0xA8,
+    0xC5, 0x08, 0xED, 0xD3, 0xF2, 0xC5, 0x56, 0xF3, 0x05, 0xDF, 0x3A, 0x5E, 0x14, 0xE9, 0xFD, 0x9E,
+    0xE5, 0x01, 0x66, 0x15, 0x70, 0x1A, 0x40, 0xB1, 0x0D, 0x88, 0x2E, 0x50, 0x1A, 0x02, 0x73, 0x36,
+    0x9A, 0x6E, 0x8D, 0xED, 0x47, 0xB9, 0x0F, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x7B,
+    0xB2, 0xFF, 0xC1, 0x4B, 0xC3, 0x17, 0xEA, 0xE9, 0xDA, 0xCB, 0x9D, 0x34, 0xDB, 0x18, 0xA5, 0x87,
+    0x23, 0x95, 0xEA, 0xCD, 0x83, 0xF4, 0xC1, 0xB6, 0xE1, 0xDD, 0xA9, 0xEC, 0xC4, 0x58, 0xB3, 0x4F,
+    0x33, 0x8F, 0x97, 0x6A, 0x56, 0xA8, 0x45, 0x3D, 0x4A, 0xE9, 0x56, 0xCD, 0x42, 0x04, 0xDF, 0x13,
+    0xB6, 0x08, 0x44, 0xC1, 0x8B, 0x85, 0x5B, 0xAA, 0x0A, 0xAF, 0x5C, 0x17, 0x72, 0x01, 0xF2, 0xC3,
+    0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0xE5, 0xB9, 0x86, 0xF0, 0xFD, 0x96, 0x08, 0x83,
+    0xB6, 0x88, 0xC2, 0x8E, 0x88, 0xE7, 0xBB, 0x62, 0x29, 0xEA, 0x8B, 0xCA, 0x82, 0x3D, 0x9B, 0x8F,
+    0xB1, 0x4C, 0xA0, 0x7C, 0x46, 0x0A, 0x23, 0x4F, 0xC5, 0x69, 0xAC, 0x5A, 0x9B, 0x75, 0xD5, 0xBF,
+    0xDE, 0x52, 0xD9, 0x76, 0x47, 0xED, 0x65, 0x7D, 0xF5, 0xE1, 0x8D, 0x91, 0xFA, 0xF6, 0x66, 0xA6,
+    0xEE, 0xEF, 0x28, 0xF5, 0xF0, 0xB9, 0xAD, 0xF8, 0x5B, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41,
+    0x54, 0xD6, 0x9E, 0xFA, 0x55, 0x1D, 0xA8, 0x3F, 0xDE, 0x34, 0x70, 0x84, 0xB7, 0x3D, 0xD4, 0xCC,
+    0xB3, 0x32, 0x1D, 0xC0, 0x08, 0x00, 0xEB, 0xDF, 0x22, 0x8E, 0x81, 0x60, 0x02, 0xCC, 0xEF, 0x02,
+    0x0B, 0xFB, 0xC0, 0xE2, 0x14, 0x58, 0xB6, 0xAC, 0xC8, 0x0C, 0x1C, 0xE1, 0xB8, 0x8E, 0x28, 0x92,
+    0xA0, 0x12, 0xCD, 0x51, 0x40, 0xF3, 0xB4, 0x40, 0x8B, 0xB4, 0x4C, 0x55, 0xD7, 0x46, 0xD9, 0x15,
+    0x8B, 0xA6, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x64, 0xFA, 0x40, 0xC1, 0x3C, 0x19,
+    0xFC, 0x0C, 0x9C, 0xA4, 0xF0, 0x54, 0x90, 0x44, 0xED, 0x6A, 0x52, 0x7F, 0xA6, 0x91, 0x5C, 0x7A,
+    0xB6, 0x9D, 0x24, 0xCF, 0x75, 0x93, 0x8D, 0xE7, 0x87, 0xC9, 0x76, 0x77, 0x9C, 0xA8, 0x2B, 0x93,
+    0xE4, 0x9D, 0x17, 0x77, 0x93, 0xF7, 0x5E, 0xDA, 0x4F, 0x8E, 0xD6, 0xA7, 0xC9, 0x37, 0x43, 0xC3,
+    0x49, 0xDD, 0x2B, 0x1E, 0x42, 0xF3, 0xAC, 0x2A, 0x8B, 0x6A, 0x69, 0x00, 0x00, 0x00, 0x3D, 0x49,
+    0x44, 0x41, 0x54, 0xCC, 0xE3, 0x2D, 0x45, 0x05, 0xF2, 0xC8, 0xA7, 0x88, 0x96, 0x68, 0x85, 0xEA,
+    0xF4, 0x04, 0x3D, 0x49, 0x97, 0xE8, 0xB2, 0x6F, 0x59, 0xEB, 0xC5, 0xCE, 0x7F, 0x0D, 0xE8, 0x88,
+    0x73, 0x74, 0x9E, 0x2E, 0xD0, 0x45, 0x6A, 0xFC, 0x7D, 0x68, 0x8F, 0x7C, 0x8A, 0x68, 0x89, 0x56,
+    0xA8, 0x76, 0xCA, 0x65, 0x0E, 0xAD, 0xC3, 0x77, 0x03, 0xBD, 0x36, 0xAD, 0xEA, 0xEC, 0x6E, 0x43,
+    0x2C, 0x90, 0x0E, 0x3D, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x1F, 0x7E, 0xD0, 0xD6,
+    0xFA, 0xA3, 0xAE, 0x7E, 0xF0, 0xF1, 0x50, 0xFF, 0xFE, 0xE9, 0x58, 0xFF, 0xF9, 0xD9, 0x44, 0x87,
+    0x5F, 0xEC, 0xEA, 0xB5, 0x2F, 0xF7, 0x75, 0xF6, 0xF5, 0x54, 0x1F, 0xDE, 0x33, 0x20, 0x50, 0x74,
+    0x60, 0x18, 0x8F, 0x8B, 0x39, 0xBB, 0xDD, 0x27, 0xA1, 0xEC, 0x3C, 0x96, 0x9B, 0x07, 0x2B, 0xE7,
+    0xD1, 0xC2, 0x3C, 0x5C, 0x9C, 0xC7, 0xAB, 0xE4, 0x01, 0xE0, 0x99, 0xAA, 0xA0, 0x00, 0x00, 0x00,
+    0x3D, 0x49, 0x44, 0x41, 0x54, 0x6B, 0x79, 0xC4, 0xD5, 0x3C, 0x64, 0x33, 0x8F, 0xD9, 0xCA, 0x83,
+    0x3E, 0x7D, 0x12, 0x15, 0xAB, 0xA8, 0x5A, 0xC2, 0x76, 0x2D, 0xDE, 0x26, 0x4B, 0x14, 0xA8, 0x48,
+    0x2E, 0x09, 0xF2, 0xA8, 0x44, 0x65, 0x9A, 0x23, 0x9F, 0x02, 0x0A, 0x69, 0x9E, 0x22, 0x5A, 0xA0,
+    0x98, 0x16, 0x69, 0x89, 0x96, 0xA9, 0x42, 0x55, 0x5A, 0x99, 0x1D, 0x02, 0x27, 0x80, 0x69, 0xF0,
+    0xE7, 0x43, 0xAA, 0x0B, 0x99, 0xD1, 0x00, 0x00, 0x00, 0x3D, 0x49, 0x44, 0x41, 0x54, 0x05, 0x2A,
+    0x3E, 0x62, 0x12, 0xEB, 0x8E, 0x14, 0x03, 0x4F, 0x46, 0xC3, 0x40, 0x9E, 0xDB, 0x88, 0x65, 0xF3,
+    0x6A, 0x55, 0xB6, 0x5F, 0xA9, 0xCB, 0xE4, 0xD5, 0x86, 0x5C, 0x1F, 0xB5, 0x64, 0xFA, 0x5A, 0x5B,
+    0xCA, 0xB4, 0x23, 0xD5, 0xB5, 0xAE, 0xBC, 0xBD, 0xD9, 0x97, 0x77, 0xC6, 0x43, 0x79, 0xF7, 0xFA,
+    0x48, 0x1E, 0x6D, 0x8D, 0xE5, 0xBD, 0xED, 0x4C, 0xEA, 0xD7, 0x27, 0x64, 0xC9, 0x85, 0x75, 0x00,
+    0x00, 0x00, 0x39, 0x49, 0x44, 0x41, 0x54, 0xF2, 0xBB, 0x4C, 0xC9, 0x1F, 0xE4, 0xAE, 0xFC, 0xF1,
+    0xC6, 0x9E, 0x7C, 0xF8, 0xC6, 0xBE, 0xFC, 0xE9, 0xE6, 0x81, 0xFC, 0x65, 0x32, 0x95, 0xBF, 0xED,
+    0x18, 0xB8, 0x8D, 0x2D, 0x07, 0x25, 0xE3, 0x71, 0xF9, 0x1F, 0x0E, 0x79, 0x0B, 0xFD, 0x47, 0x75,
+    0xA0, 0x96, 0xF8, 0x9E, 0x6A, 0x74, 0x9E, 0xEA, 0x74, 0xC1, 0xFD, 0x0B, 0x36, 0xE8, 0x96, 0x68,
+    0x19, 0xF5, 0xE6, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+static const uint16_t RGBA8_DYNAMIC_PIXELS[] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800, 0x0800, 0x0800,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0800,
+    0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x0800, 0x1000, 0x1000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0800, 0x0820, 0x0820, 0x0820,
+    0x0820, 0x0821, 0x0821, 0x0821, 0x1021, 0x1021, 0x1021, 0x1021,
+    0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020,
+    0x0020, 0x0020, 0x0020, 0x0820, 0x0821, 0x0821, 0x0821, 0x0821,
+    0x0821, 0x0821, 0x1021, 0x1021, 0x1021, 0x1022, 0x1022, 0x1022,
+    0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020, 0x0020,
+    0x0040, 0x0841, 0x0841, 0x0841, 0x0841, 0x0841, 0x0841, 0x0841,
+    0x1042, 0x1042, 0x1042, 0x1042, 0x1042, 0x1042, 0x1843, 0x1843,
+    0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0040, 0x0041,
+    0x0841, 0x0841, 0x0841, 0x0841, 0x0841, 0x0862, 0x0862, 0x1062,
+    0x1062, 0x1063, 0x1063, 0x1063, 0x1863, 0x1863, 0x1864, 0x1864,
+    0x0060, 0x0060, 0x0060, 0x0060, 0x0060, 0x0060, 0x0061, 0x0861,
+    0x0861, 0x0861, 0x0862, 0x0862, 0x0862, 0x1062, 0x1083, 0x1083,
+    0x1083, 0x1083, 0x1884, 0x1884, 0x1884, 0x1885, 0x1885, 0x2085,
+    0x0080, 0x0080, 0x0080, 0x0080, 0x0081, 0x0081, 0x0081, 0x0881,
+    0x0882, 0x0882, 0x0882, 0x0882, 0x1083, 0x1083, 0x10A3, 0x10A4,
+    0x10A4, 0x18A4, 0x18A5, 0x18A5, 0x18A6, 0x20A6, 0x20A6, 0x20A7,
+    0x00A0, 0x00A0, 0x00A0, 0x00A0, 0x00A1, 0x00A1, 0x08A1, 0x08A2,
+    0x08A2, 0x08A2, 0x08A3, 0x10C3, 0x10C4, 0x10C4, 0x10C4, 0x10C5,
+    0x18C5, 0x18C6, 0x18C6, 0x18C6, 0x20C7, 0x20C7, 0x20C8, 0x20C8,
+    0x00C0, 0x00C0, 0x00C0, 0x00C1, 0x00C1, 0x00C1, 0x08C2, 0x08C2,
+    0x08E3, 0x08E3, 0x10E3, 0x10E4, 0x10E4, 0x10E5, 0x10E5, 0x18E6,
+    0x18E6, 0x18E7, 0x18E7, 0x20E8, 0x2108, 0x2109, 0x2909, 0x290A,
+    0x00E0, 0x00E0, 0x00E0, 0x00E1, 0x00E1, 0x0902, 0x0902, 0x0903,
+    0x0903, 0x0904, 0x1104, 0x1105, 0x1105, 0x1106, 0x1906, 0x1927,
+    0x1928, 0x1928, 0x2129, 0x2129, 0x212A, 0x292B, 0x292B, 0x292C,
+    0x0120, 0x0120, 0x0121, 0x0121, 0x0122, 0x0922, 0x0923, 0x0923,
+    0x0924, 0x1124, 0x1145, 0x1146, 0x1146, 0x1947, 0x1948, 0x1948,
+    0x1949, 0x214A, 0x214A, 0x216B, 0x296C, 0x296D, 0x2960, 0x3161,
+    0x0140, 0x0140, 0x0141, 0x0141, 0x0162, 0x0963, 0x0963, 0x0964,
+    0x1165, 0x1165, 0x1166, 0x1167, 0x1967, 0x1988, 0x1989, 0x198A,
+    0x218A, 0x218B, 0x218C, 0x298D, 0x2980, 0x2980, 0x31A1, 0x31A2,
+    0x0180, 0x0180, 0x0181, 0x0182, 0x0982, 0x0983, 0x0984, 0x09A5,
+    0x11A5, 0x11A6, 0x11A7, 0x19A8, 0x19A9, 0x19A9, 0x19AA, 0x21CB,
+    0x21CC, 0x21CD, 0x29CE, 0x29C0, 0x29C1, 0x31C2, 0x31C3, 0x31E3,
+    0x01C0, 0x01C0, 0x01C1, 0x01C2, 0x09C3, 0x09C4, 0x09C4, 0x09C5,
+    0x11E6, 0x11E7, 0x11E8, 0x19E9, 0x19EA, 0x19EB, 0x21EC, 0x220D,
+    0x220E, 0x2A0F, 0x2A00, 0x2A01, 0x3202, 0x3203, 0x3204, 0x3A25,
+    0x01E0, 0x0200, 0x0201, 0x0202, 0x0A03, 0x0A04, 0x0A05, 0x1206,
+    0x1227, 0x1228, 0x1A29, 0x1A2A, 0x1A2B, 0x222C, 0x222D, 0x224F,
+    0x2A40, 0x2A41, 0x2A42, 0x3243, 0x3244, 0x3245, 0x3A66, 0x3A67,
+};
+
+// 37x21
+static const uint8_t PALETTE4_FIXED[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x15, 0x04, 0x03, 0x00, 0x00, 0x01, 0x44, 0xCD, 0x0A,
+    0x0B, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x24,
+    0x50, 0x4C, 0x54, 0x45, 0xA5, 0x4D, 0xCA, 0x18, 0x25, 0x30, 0xBB, 0x1D, 0x6D, 0x13, 0x2C, 0xDE,
+    0xD6, 0x23, 0x7B, 0x2E, 0xD9, 0x1E, 0x3F, 0x72, 0x1F, 0xCB, 0x19, 0x71, 0x17, 0x44, 0x94, 0xD6,
+    0x49, 0x3C, 0x9D, 0x5C, 0x34, 0x60, 0xBE, 0x31, 0x97, 0x71, 0xDF, 0x8F, 0x00, 0x00, 0x00, 0x05,
+    0x74, 0x52, 0x4E, 0x53, 0x00, 0x80, 0xFF, 0x40, 0x0A, 0x81, 0x06, 0x22, 0x7C, 0x00, 0x00, 0x01,
+    0x21, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x63, 0xE0, 0xD0, 0x72, 0x60, 0x5C, 0xA2, 0x64, 0xC5,
+    0xB4, 0x67, 0xCF, 0x02, 0x66, 0x1F, 0xAB, 0x00, 0x96, 0x3D, 0x4A, 0x0F, 0x18, 0x96, 0x1C, 0x63,
+    0x60, 0x3C, 0xB4, 0x62, 0x56, 0xC7, 0x2C, 0xA6, 0x53, 0x7B, 0xE6, 0xEC, 0x99, 0xC3, 0xCC, 0xD4,
+    0xBD, 0x73, 0xB5, 0x26, 0x8B, 0x5A, 0xD5, 0x8A, 0xAA, 0x79, 0x0C, 0x2C, 0x3D, 0x6A, 0x0B, 0x1C,
+    0xC0, 0xB2, 0x53, 0x98, 0xEE, 0xDD, 0xDB, 0x77, 0xEF, 0x01, 0xB3, 0xCD, 0x1E, 0x9D, 0xC3, 0x73,
+    0x58, 0xEE, 0xDD, 0x7B, 0x73, 0xEF, 0x01, 0x43, 0xC6, 0x1A, 0x26, 0xB7, 0xAE, 0x03, 0x2A, 0x19,
+    0x6B, 0x18, 0x18, 0xDD, 0x5C, 0xCC, 0x52, 0x5C, 0x5C, 0xC2, 0x5C, 0x5C, 0xCC, 0x98, 0x40, 0x72,
+    0x20, 0xB5, 0x40, 0xC5, 0x1F, 0x04, 0x05, 0xAB, 0x16, 0x0A, 0x4A, 0xCC, 0x12, 0xE4, 0x65, 0xD9,
+    0x97, 0x72, 0x4F, 0x09, 0x24, 0x9C, 0x22, 0xC5, 0x20, 0x1C, 0x3E, 0xFB, 0xA2, 0x69, 0xE5, 0x5E,
+    0xE1, 0x70, 0xC6, 0x4A, 0xB0, 0x0E, 0xA0, 0x46, 0xA6, 0x88, 0x8A, 0xB4, 0xB4, 0x8A, 0xB6, 0xB4,
+    0x88, 0x0A, 0xE6, 0xF7, 0xA1, 0xEE, 0x79, 0xA1, 0xA1, 0xE9, 0x4F, 0x43, 0x59, 0xD2, 0xC2, 0x5C,
+    0xD2, 0xCC, 0x52, 0xD2, 0x5C, 0xC2, 0x18, 0xC0, 0xAA, 0x41, 0x9A, 0x18, 0x67, 0xC3, 0xAD, 0x01,
+    0xAB, 0x06, 0x69, 0x62, 0x2E, 0x00, 0xA9, 0x06, 0x69, 0x62, 0x89, 0x00, 0xA9, 0x06, 0x69, 0x62,
+    0x80, 0x59, 0x31, 0x9B, 0xD1, 0x44, 0x09, 0x08, 0x44, 0x9C, 0x94, 0x10, 0x94, 0x18, 0x53, 0x1A,
+    0x50, 0x2B, 0x50, 0x3F, 0x12, 0xD5, 0xC0, 0x7C, 0xF4, 0xEC, 0x15, 0x17, 0xA0, 0xB9, 0xB1, 0x08,
+    0xCA, 0x86, 0x25, 0x0D, 0xA2, 0x05, 0x89, 0x72, 0x60, 0xB8, 0x20, 0x64, 0x12, 0x56, 0x31, 0x6B,
+    0x0F, 0x12, 0x55, 0xC0, 0x18, 0x86, 0x6E, 0x85, 0x92, 0x08, 0x13, 0x86, 0x15, 0x40, 0x3B, 0xAE,
+    0xA1, 0x5B, 0xE1, 0x62, 0x0D, 0xB4, 0x03, 0xCD, 0x0A, 0x27, 0x39, 0x06, 0x0C, 0x2B, 0x2A, 0x26,
+    0x00, 0x00, 0x76, 0xE2, 0xA0, 0xCB, 0xB9, 0x63, 0xB9, 0x5E, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+static const uint16_t PALETTE4_FIXED_PIXELS[] = {
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000,
+    0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047, 0x0800, 0x2EC3,
+    0x3B83, 0xC8CE, 0x1232, 0xD247, 0x0800, 0x2EC3, 0x3B83, 0xC8CE,
+    0x1232, 0xD247, 0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883,
+    0xB8ED, 0x0047, 0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247,
+    0x9AE6, 0x65E6, 0x0000, 0x0000, 0x0000, 0x0883, 0xB8ED, 0x0047,
+    0x0800, 0x2EC3, 0x3B83, 0xC8CE, 0x1232, 0xD247, 0x9AE6, 0x65E6,
+    0x0000,
+};
+
+// 9x17
+static const uint8_t GRAY16_STORED_KEY[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x11, 0x10, 0x00, 0x00, 0x00, 0x01, 0x0D, 0xE8, 0x35,
+    0xEF, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x02,
+    0x74, 0x52, 0x4E, 0x53, 0x7C, 0x50, 0x9E, 0x72, 0xAA, 0x36, 0x00, 0x00, 0x00, 0x64, 0x49, 0x44,
+    0x41, 0x54, 0x78, 0x01, 0x01, 0x54, 0x01, 0xAB, 0xFE, 0x00, 0x00, 0x00, 0x5D, 0xC8, 0x01, 0x1E,
+    0x88, 0x5E, 0xC8, 0x02, 0x1F, 0x88, 0x1E, 0x88, 0x03, 0x2E, 0xE4, 0x04, 0x1F, 0x88, 0x00, 0x6B,
+    0xF4, 0x01, 0x0F, 0x44, 0x2F, 0xE4, 0x2F, 0xE4, 0x02, 0x1E, 0x88, 0x1E, 0x88, 0x1E, 0x88, 0x03,
+    0x17, 0x72, 0x3B, 0x1D, 0x04, 0x0F, 0x44, 0x0F, 0xE4, 0x00, 0x35, 0xFA, 0x64, 0xDE, 0x01, 0x45,
+    0x3E, 0x2F, 0xE4, 0x02, 0x0F, 0x44, 0x0F, 0x44, 0x03, 0x07, 0xA2, 0x1C, 0xC3, 0x27, 0x7C, 0x32,
+    0xB5, 0x3F, 0xEE, 0x04, 0x0F, 0x44, 0x0F, 0x44, 0x0F, 0x44, 0x10, 0x44, 0x0F, 0x72, 0x00, 0x26,
+    0x2A, 0x3D, 0x9C, 0x55, 0x0E, 0x6C, 0x30, 0xBB, 0x80, 0x97, 0x00, 0x00, 0x00, 0x64, 0x49, 0x44,
+    0x41, 0x54, 0x80, 0x83, 0xF2, 0x01, 0x35, 0x6E, 0x17, 0x72, 0x18, 0x72, 0x17, 0x72, 0x18, 0x72,
+    0x02, 0x0B, 0xB9, 0x23, 0x2B, 0x3A, 0x9D, 0x52, 0x0F, 0x03, 0x0E, 0xFF, 0x0F, 0x8A, 0x10, 0x8A,
+    0x0F, 0x8A, 0x04, 0x07, 0xA2, 0x08, 0x72, 0x07, 0xA2, 0x08, 0x72, 0x00, 0x22, 0x9F, 0x3A, 0x11,
+    0x51, 0x83, 0x68, 0xF5, 0x01, 0x2A, 0x41, 0x17, 0x72, 0x18, 0x72, 0x17, 0x72, 0x02, 0x07, 0xA2,
+    0x08, 0xA2, 0x07, 0xA2, 0x08, 0xA2, 0x03, 0x21, 0x14, 0x0F, 0x8A, 0x10, 0x8A, 0x0F, 0x8A, 0x04,
+    0x08, 0xA2, 0x08, 0x14, 0x08, 0xA2, 0x08, 0x14, 0x00, 0x48, 0xC9, 0x60, 0x3B, 0x77, 0xAD, 0x8F,
+    0x1F, 0x01, 0x03, 0xD1, 0x0C, 0xB9, 0xE4, 0x21, 0x92, 0xC7, 0x00, 0x00, 0x00, 0x64, 0x49, 0x44,
+    0x41, 0x54, 0x0C, 0xB9, 0x0B, 0xB9, 0x0C, 0xB9, 0x0C, 0xB9, 0x0C, 0xB9, 0x0B, 0xB9, 0x0C, 0xB9,
+    0x02, 0x08, 0xA2, 0x08, 0xA2, 0x07, 0xA2, 0x08, 0xA2, 0x08, 0xA2, 0x08, 0xA2, 0x07, 0xA2, 0x08,
+    0xA2, 0x08, 0xA2, 0x03, 0x0E, 0xDC, 0x09, 0xAE, 0x0A, 0xAE, 0x0A, 0xAE, 0x09, 0xAE, 0x0A, 0x2E,
+    0x0A, 0xAE, 0x0A, 0xAE, 0x09, 0xAE, 0x04, 0x07, 0xA2, 0x08, 0xA2, 0x08, 0xB9, 0x07, 0xB9, 0x08,
+    0xA2, 0x08, 0xB9, 0x08, 0xB9, 0x07, 0xB9, 0x08, 0xA2, 0x00, 0x22, 0x59, 0x2E, 0x12, 0x39, 0xCB,
+    0x45, 0x84, 0x51, 0x3D, 0x5C, 0xF6, 0x68, 0xAF, 0x74, 0x68, 0x80, 0x21, 0x01, 0x29, 0xFB, 0x0C,
+    0xB9, 0x0C, 0xB9, 0x0C, 0xB9, 0x0B, 0x5A, 0xAD, 0xA4, 0x5E, 0x00, 0x00, 0x00, 0x33, 0x49, 0x44,
+    0x41, 0x54, 0xB9, 0x0C, 0xB9, 0x0C, 0xB9, 0x0C, 0xB9, 0x0B, 0xB9, 0x02, 0x08, 0xA2, 0x08, 0xA2,
+    0x08, 0xA2, 0x07, 0xA2, 0x08, 0xA2, 0x08, 0xA2, 0x07, 0xA2, 0x07, 0xA2, 0x08, 0xA2, 0x03, 0x21,
+    0xF1, 0x09, 0xAE, 0x0A, 0x2E, 0x0A, 0xAE, 0x0A, 0xAE, 0x09, 0xAE, 0x0A, 0xAE, 0x0A, 0xAE, 0x0A,
+    0xAE, 0x91, 0x98, 0x6A, 0x09, 0x7F, 0xFC, 0x26, 0x29, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E,
+    0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+static const uint16_t GRAY16_STORED_KEY_PIXELS[] = {
+    0x0000, 0x0841, 0x10A2, 0x2104, 0x2965, 0x39C7, 0x4228, 0x528A,
+    0x5AEB, 0x0000, 0x0861, 0x18C3, 0x2124, 0x3186, 0x39E7, 0x4A49,
+    0x52AA, 0x630C, 0x0020, 0x1082, 0x18E3, 0x2945, 0x31A6, 0x4208,
+    0x4A69, 0x5ACB, 0x632C, 0x0841, 0x10A2, 0x2104, 0x2965, 0x39C7,
+    0x4228, 0x528A, 0x5AEB, 0x6B4D, 0x0861, 0x18C3, 0x2124, 0x3186,
+    0x39E7, 0x4A49, 0x52AA, 0x630C, 0x6B6D, 0x1082, 0x18E3, 0x2945,
+    0x31A6, 0x4208, 0x4A69, 0x5ACB, 0x632C, 0x738E, 0x10A2, 0x2104,
+    0x2965, 0x39C7, 0x4228, 0x528A, 0x5AEB, 0x6B4D, 0x73AE, 0x18C3,
+    0x2124, 0x3186, 0x39E7, 0x4A49, 0x52AA, 0x630C, 0x6B6D, 0x7BCF,
+    0x18E3, 0x2945, 0x31A6, 0x4208, 0x4A69, 0x5ACB, 0x632C, 0x738E,
+    0x0000, 0x2104, 0x2965, 0x39C7, 0x4228, 0x528A, 0x5AEB, 0x6B4D,
+    0x73AE, 0x8410, 0x2124, 0x3186, 0x39E7, 0x4A49, 0x52AA, 0x630C,
+    0x6B6D, 0x7BCF, 0x8410, 0x2945, 0x31A6, 0x4208, 0x4A69, 0x5ACB,
+    0x632C, 0x738E, 0x7BEF, 0x8430, 0x2965, 0x39C7, 0x4228, 0x528A,
+    0x5AEB, 0x6B4D, 0x73AE, 0x7BEF, 0x8C51, 0x3186, 0x39E7, 0x4A49,
+    0x52AA, 0x630C, 0x6B6D, 0x73AE, 0x8410, 0x8C71, 0x31A6, 0x4208,
+    0x4A69, 0x5ACB, 0x632C, 0x738E, 0x7BCF, 0x8430, 0x9492, 0x39C7,
+    0x4228, 0x528A, 0x5AEB, 0x6B4D, 0x738E, 0x7BEF, 0x8C51, 0x94B2,
+    0x39E7, 0x4A49, 0x52AA, 0x630C, 0x6B4D, 0x73AE, 0x8410, 0x8C71,
+    0x9CD3,
+};
+
+// 20x9
+static const uint8_t GRAY1[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x09, 0x01, 0x00, 0x00, 0x00, 0x01, 0x6D, 0xBD, 0x01,
+    0x73, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x3E,
+    0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0x63, 0x70, 0x60, 0x5C, 0xC0, 0xE4, 0xC0, 0xFC, 0x80, 0x25,
+    0x81, 0xA1, 0x81, 0x91, 0x83, 0xE9, 0x05, 0xB3, 0xF5, 0x63, 0x16, 0x13, 0x56, 0x86, 0xDC, 0x03,
+    0x8C, 0xD2, 0xAA, 0x4C, 0x0B, 0x1D, 0x98, 0xBD, 0x75, 0x58, 0x7C, 0xB8, 0x19, 0xD8, 0x3A, 0x15,
+    0x18, 0x23, 0xEB, 0x35, 0x98, 0x54, 0x59, 0x1D, 0x98, 0xCD, 0x6E, 0x1C, 0x00, 0x00, 0x43, 0xA4,
+    0x0C, 0x4F, 0x93, 0x7C, 0xEC, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42,
+    0x60, 0x82,
+};
+static const uint16_t GRAY1_PIXELS[] = {
+    0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0x0000,
+    0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xFFFF,
+    0x0000, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0x0000, 0x0000,
+    0xFFFF, 0x0000, 0x0000, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0x0000,
+    0x0000, 0x0000, 0x0000, 0x0000, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x0000, 0x0000, 0x0000, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0xFFFF,
+    0xFFFF, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF,
+    0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0x0000, 0x0000, 0x0000,
+    0x0000, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0x0000,
+    0x0000, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0x0000,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF,
+    0x0000, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x0000, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0x0000,
+    0x0000, 0x0000, 0x0000, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0x0000,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0000, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x0000, 0x0000, 0xFFFF, 0xFFFF, 0x0000, 0x0000, 0xFFFF, 0xFFFF,
+    0xFFFF, 0x0000, 0x0000, 0x0000,
+};
+
+// 16x9
+static const uint8_t RGB16_KEY[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x09, 0x10, 0x02, 0x00, 0x00, 0x01, 0x93, 0xDF, 0xD7,
+    0xB0, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x06,
+    0x74, 0x52, 0x4E, 0x53, 0x3E, 0x80, 0x00, 0x00, 0xE0, 0xBF, 0xE4, 0x90, 0x8C, 0x2F, 0x00, 0x00,
+    0x01, 0x9A, 0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0x95, 0x51, 0xBF, 0x4B, 0xC3, 0x50, 0x10, 0xFE,
+    0xDA, 0x06, 0x22, 0xBC, 0x07, 0xC9, 0x16, 0xB7, 0x14, 0x1C, 0xEA, 0xD4, 0x64, 0xB1, 0x66, 0xD2,
+    0x4E, 0xD6, 0xA9, 0xED, 0xE2, 0x58, 0x8C, 0x43, 0xB1, 0x83, 0x42, 0x06, 0x45, 0x5D, 0xA4, 0x7F,
+    0x80, 0x60, 0x47, 0xC7, 0x6E, 0x3A, 0x76, 0xBC, 0x41, 0x68, 0x16, 0x07, 0x07, 0x21, 0x1D, 0x4A,
+    0x1D, 0x1C, 0x9E, 0xE0, 0xD0, 0x41, 0x30, 0x42, 0x87, 0x0A, 0xAD, 0xCF, 0xC6, 0xFA, 0xA3, 0x8A,
+    0x05, 0x7B, 0xC3, 0xC7, 0xBD, 0xFB, 0xEE, 0xE3, 0xEE, 0xBE, 0x07, 0x8C, 0x42, 0xCA, 0x95, 0x2A,
+    0x20, 0x9A, 0x31, 0xA0, 0xE4, 0x8F, 0x1F, 0xF7, 0x7E, 0xDC, 0xCC, 0x02, 0xE1, 0x66, 0xC9, 0x07,
+    0x5A, 0x66, 0x42, 0x4F, 0x96, 0xFC, 0x43, 0xDB, 0xCC, 0x5A, 0xEE, 0xB3, 0x50, 0x80, 0xB4, 0x90,
+    0x32, 0xE2, 0x9F, 0xDD, 0xF7, 0x2E, 0x77, 0x9C, 0x43, 0xAB, 0x03, 0x7D, 0x2B, 0x2D, 0x80, 0xEE,
+    0x69, 0x3E, 0x09, 0xDC, 0x3E, 0xED, 0xBA, 0xC0, 0x75, 0x21, 0xA6, 0xD5, 0xD3, 0xA2, 0x6F, 0x8D,
+    0x7B, 0x93, 0x13, 0x8A, 0x38, 0x60, 0x89, 0x68, 0x85, 0xDF, 0x98, 0x00, 0x0C, 0x4F, 0x4A, 0xAD,
+    0xCE, 0x9D, 0xA3, 0xC6, 0x7C, 0xC8, 0x9D, 0xBD, 0x75, 0xD3, 0xE7, 0x8E, 0xE7, 0xA6, 0x74, 0xEE,
+    0xEC, 0x1C, 0x5A, 0x82, 0x3B, 0x95, 0x5A, 0xA6, 0xC1, 0x9D, 0xF2, 0xC5, 0x2A, 0xB8, 0xB3, 0x95,
+    0x55, 0x3E, 0xD5, 0xFF, 0x0E, 0x35, 0x00, 0x06, 0x86, 0xE1, 0x01, 0xBD, 0x5C, 0x4A, 0x07, 0x1E,
+    0x0F, 0x32, 0x0D, 0xE0, 0xE1, 0x7C, 0xAD, 0x08, 0xDC, 0x75, 0x36, 0x42, 0xA0, 0xAD, 0x96, 0x6B,
+    0xC0, 0xCD, 0xF2, 0xBE, 0x0D, 0x5C, 0x6D, 0xC7, 0xD4, 0xC0, 0xF0, 0x06, 0x86, 0x1E, 0xDD, 0x68,
+    0x8F, 0x51, 0xFB, 0x95, 0xBF, 0xD8, 0x93, 0x6C, 0x3C, 0xBA, 0x21, 0x9A, 0xF4, 0x5F, 0x4C, 0x28,
+    0x15, 0x4B, 0x1C, 0xF3, 0xB9, 0x80, 0xD3, 0x60, 0xFE, 0x03, 0x8B, 0x3F, 0xF3, 0xE1, 0xD9, 0x24,
+    0xAB, 0x7C, 0xAA, 0x67, 0x08, 0x46, 0x52, 0xAA, 0x01, 0xA3, 0x81, 0xA1, 0xD5, 0x19, 0xF5, 0x2D,
+    0xC3, 0x63, 0xD4, 0xCB, 0x99, 0x59, 0x46, 0xE1, 0x66, 0x4A, 0x67, 0xF4, 0x78, 0x90, 0x16, 0x8C,
+    0xBA, 0xA7, 0x99, 0x06, 0xA3, 0x87, 0xF3, 0x95, 0x2A, 0x23, 0xD1, 0x5C, 0x2B, 0x32, 0xBA, 0xEB,
+    0xE4, 0x93, 0x8C, 0x6E, 0x9F, 0x36, 0x42, 0x46, 0x6D, 0xB5, 0xE4, 0x33, 0x6A, 0x99, 0xE5, 0x1A,
+    0xA3, 0x9B, 0xE5, 0x5D, 0x97, 0xD1, 0x75, 0x61, 0xDF, 0x66, 0x34, 0x32, 0x09, 0x58, 0x58, 0x8C,
+    0x06, 0x00, 0xC3, 0xD1, 0x92, 0x23, 0x87, 0xFF, 0x40, 0x75, 0x4A, 0xFD, 0x9B, 0x9D, 0xAE, 0x9D,
+    0xD9, 0xD4, 0x99, 0x3F, 0x01, 0x58, 0xBA, 0xAC, 0x56, 0x95, 0x0A, 0x27, 0x79, 0xA2, 0x74, 0x39,
+    0xBD, 0xF2, 0x3F, 0xB0, 0x32, 0xA5, 0xFE, 0xC5, 0x4E, 0xD7, 0xBE, 0x01, 0x2A, 0x11, 0xF6, 0xBB,
+    0x05, 0x05, 0xBB, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+static const uint16_t RGB16_KEY_PIXELS[] = {
+    0x001F, 0x001F, 0x081F, 0x101E, 0x181E, 0x201D, 0x281D, 0x301C,
+    0x0000, 0x401B, 0x481B, 0x501A, 0x581A, 0x6019, 0x6819, 0x7018,
+    0x005F, 0x005F, 0x085F, 0x105E, 0x185E, 0x205D, 0x285D, 0x305C,
+    0x385C, 0x405B, 0x485B, 0x505A, 0x585A, 0x6059, 0x6859, 0x7058,
+    0x00BF, 0x00BF, 0x08BF, 0x10BE, 0x18BE, 0x20BD, 0x28BD, 0x30BC,
+    0x38BC, 0x40BB, 0x48BB, 0x50BA, 0x58BA, 0x60B9, 0x68B9, 0x70B8,
+    0x011F, 0x011F, 0x091F, 0x111E, 0x191E, 0x211D, 0x291D, 0x311C,
+    0x391C, 0x411B, 0x491B, 0x511A, 0x591A, 0x6119, 0x6919, 0x7118,
+    0x017F, 0x017F, 0x097F, 0x117E, 0x197E, 0x217D, 0x297D, 0x317C,
+    0x397C, 0x417B, 0x497B, 0x517A, 0x597A, 0x6179, 0x6979, 0x7178,
+    0x01DF, 0x01DF, 0x09DF, 0x11DE, 0x19DE, 0x21DD, 0x29DD, 0x31DC,
+    0x39DC, 0x41DB, 0x49DB, 0x51DA, 0x59DA, 0x61D9, 0x69D9, 0x71D8,
+    0x023F, 0x023F, 0x0A3F, 0x123E, 0x1A3E, 0x223D, 0x2A3D, 0x323C,
+    0x3A3C, 0x423B, 0x4A3B, 0x523A, 0x5A3A, 0x6239, 0x6A39, 0x7238,
+    0x029F, 0x029F, 0x0A9F, 0x129E, 0x1A9E, 0x229D, 0x2A9D, 0x329C,
+    0x3A9C, 0x429B, 0x4A9B, 0x529A, 0x5A9A, 0x6299, 0x6A99, 0x7298,
+    0x02FF, 0x02FF, 0x0AFF, 0x12FE, 0x1AFE, 0x22FD, 0x2AFD, 0x32FC,
+    0x3AFC, 0x42FB, 0x4AFB, 0x52FA, 0x5AFA, 0x62F9, 0x6AF9, 0x72F8,
+};
+
+// 9x9
+static const uint8_t GRAY_ALPHA8[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x09, 0x08, 0x04, 0x00, 0x00, 0x01, 0x3D, 0x9F, 0xFE,
+    0x0D, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x63,
+    0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0x65, 0x8D, 0x4B, 0x0D, 0x00, 0x21, 0x0C, 0x44, 0x87, 0xCF,
+    0x19, 0x05, 0x08, 0xA9, 0x10, 0x24, 0x54, 0x40, 0x85, 0x20, 0x04, 0x21, 0x1C, 0x46, 0x06, 0x52,
+    0xB6, 0x64, 0xB3, 0x21, 0x64, 0xDF, 0xBB, 0x34, 0x99, 0x99, 0x14, 0x04, 0x57, 0x20, 0xB0, 0x22,
+    0x2D, 0xA9, 0x64, 0x3F, 0xCD, 0xA5, 0x70, 0x04, 0x0A, 0x2C, 0xC2, 0x49, 0x84, 0x8A, 0x36, 0x35,
+    0xED, 0x19, 0x07, 0x56, 0x36, 0x76, 0xCE, 0xC0, 0x0A, 0xD9, 0xC6, 0x2F, 0x49, 0x5A, 0x50, 0xB7,
+    0xA7, 0xCE, 0x5D, 0x17, 0x1F, 0x98, 0x4F, 0x06, 0xE7, 0xFB, 0xB6, 0xDE, 0x46, 0xFC, 0x48, 0x0A,
+    0x94, 0xDB, 0x07, 0xDD, 0xB0, 0x24, 0x1F, 0x6D, 0x0B, 0x6E, 0x1A, 0x00, 0x00, 0x00, 0x00, 0x49,
+    0x45, 0x4E, 0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+static const uint16_t GRAY_ALPHA8_PIXELS[] = {
+    0x0000, 0x10A2, 0x2965, 0x4208, 0x5ACB, 0x6B6D, 0x8430, 0x9CD3,
+    0xB596, 0x0000, 0x10A2, 0x2965, 0x4208, 0x5ACB, 0x6B6D, 0x8430,
+    0x9CD3, 0xB596, 0x0000, 0x10A2, 0x2965, 0x4208, 0x5ACB, 0x6B6D,
+    0x8430, 0x9CD3, 0xB596, 0x0000, 0x10A2, 0x2965, 0x4208, 0x5ACB,
+    0x6B6D, 0x8430, 0x9CD3, 0xB596, 0x0000, 0x10A2, 0x2965, 0x4208,
+    0x5ACB, 0x6B6D, 0x8430, 0x9CD3, 0xB596, 0x0000, 0x10A2, 0x2965,
+    0x4208, 0x5ACB, 0x6B6D, 0x8430, 0x9CD3, 0xB596, 0x0000, 0x10A2,
+    0x2965, 0x4208, 0x5ACB, 0x6B6D, 0x8430, 0x9CD3, 0xB596, 0x0000,
+    0x10A2, 0x2965, 0x4208, 0x5ACB, 0x6B6D, 0x8430, 0x9CD3, 0xB596,
+    0x0000, 0x10A2, 0x2965, 0x4208, 0x5ACB, 0x6B6D, 0x8430, 0x9CD3,
+    0xB596,
+};
+
+// 300x200
+static const uint8_t GRAY8_DOWNSCALED[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x01, 0x2C, 0x00, 0x00, 0x00, 0xC8, 0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0xB3, 0xB3,
+    0x1F, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x09, 0x91,
+    0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0xED, 0x9B, 0x7B, 0x7C, 0xCD, 0xE5, 0x1F, 0xC0, 0x3F, 0x9F,
+    0xED, 0x38, 0x1B, 0x1D, 0x6B, 0x18, 0x86, 0xD1, 0x62, 0x98, 0x59, 0x33, 0x73, 0x1F, 0xC9, 0x3D,
+    0x96, 0xCB, 0xDC, 0x47, 0x62, 0x58, 0x2C, 0x66, 0xEE, 0x23, 0xB9, 0x8C, 0x66, 0x1B, 0x86, 0xA5,
+    0x25, 0x69, 0x2E, 0x49, 0x92, 0x5B, 0x92, 0x24, 0xB7, 0x24, 0xC9, 0x2D, 0x49, 0x92, 0x5B, 0x92,
+    0xE4, 0x96, 0x24, 0x89, 0xD1, 0xA2, 0x97, 0x7E, 0xE7, 0xF7, 0xFB, 0x9D, 0x7D, 0x3B, 0xE7, 0x78,
+    0x9E, 0xF3, 0xFD, 0x7E, 0xCF, 0xF7, 0x63, 0xFB, 0x3C, 0xFF, 0x6D, 0xDF, 0xEF, 0xF7, 0x7C, 0x9E,
+    0xCF, 0xE7, 0x79, 0x3F, 0xEF, 0xE7, 0x3C, 0xE7, 0x39, 0x07, 0xC0, 0xDB, 0xD7, 0x3F, 0x30, 0x38,
+    0xBC, 0x7E, 0x93, 0xD6, 0xD1, 0x31, 0xB1, 0xF1, 0xC3, 0xC6, 0x26, 0xA7, 0x67, 0xCE, 0x5B, 0xBC,
+    0x7C, 0xED, 0xC6, 0xED, 0xBB, 0x0F, 0x1E, 0x3D, 0x7D, 0xE1, 0x6A, 0xCE, 0x7F, 0xAE, 0xA3, 0xBF,
+    0xB7, 0x48, 0xF3, 0xF0, 0x17, 0x6A, 0x9E, 0xE1, 0xBE, 0xF6, 0x5B, 0x66, 0xA6, 0xED, 0x5F, 0x26,
+    0x07, 0x41, 0x15, 0xFF, 0x06, 0x07, 0x7D, 0x56, 0xE4, 0x84, 0x99, 0x9A, 0xA6, 0x90, 0x60, 0xBF,
+    0xCF, 0x8A, 0xF6, 0xBF, 0x14, 0x9C, 0xD7, 0x0F, 0x1C, 0xF4, 0x59, 0x91, 0x13, 0x7A, 0x6B, 0x9A,
+    0x42, 0xB0, 0xC3, 0x6E, 0xDB, 0xE6, 0x64, 0x72, 0xD8, 0xF5, 0x3C, 0x17, 0xC0, 0x21, 0x3B, 0x79,
+    0x72, 0xC2, 0x64, 0x4D, 0x53, 0x88, 0x73, 0xC4, 0x8E, 0xAF, 0x03, 0x90, 0x9C, 0x8D, 0x03, 0x38,
+    0x64, 0x27, 0x4F, 0x4E, 0x98, 0xA3, 0x69, 0x0A, 0x81, 0x4E, 0xF0, 0xF9, 0x7F, 0x4E, 0x26, 0x27,
+    0x1D, 0xB7, 0xB9, 0x04, 0x26, 0x8B, 0x5F, 0x40, 0x50, 0x68, 0xED, 0x46, 0x2D, 0xDA, 0x76, 0xE9,
+    0x15, 0x97, 0x30, 0x6A, 0x7C, 0x4A, 0x46, 0x56, 0xF6, 0xD2, 0x55, 0xEB, 0xB7, 0xEC, 0xDC, 0x7F,
+    0xF8, 0xE4, 0xD9, 0xCB, 0xD7, 0x73, 0xFF, 0xB9, 0x8E, 0x01, 0xDA, 0x25, 0xE0, 0x19, 0x21, 0x32,
+    0x97, 0xC5, 0xA6, 0x32, 0xD8, 0xEF, 0xAE, 0x22, 0x1D, 0xCC, 0xD2, 0xB0, 0xF7, 0x89, 0x22, 0xD3,
+    0x58, 0x6C, 0x16, 0x83, 0xFD, 0xEE, 0x2A, 0xD2, 0x41, 0x8B, 0x86, 0xBD, 0x0F, 0x11, 0x99, 0xC1,
+    0x62, 0x13, 0x18, 0x1C, 0xC1, 0x92, 0x27, 0x1D, 0x4C, 0xD1, 0xB0, 0xF7, 0x03, 0x44, 0x26, 0xAF,
+    0xD8, 0xDC, 0x05, 0x47, 0xB0, 0xE4, 0x49, 0x07, 0x73, 0x35, 0xEC, 0x7D, 0x45, 0x91, 0x79, 0x2B,
+    0x36, 0x6D, 0xC1, 0xE2, 0xEB, 0xE7, 0x1F, 0x10, 0x18, 0x14, 0x1C, 0x1A, 0x5E, 0xBB, 0x7E, 0xA3,
+    0x26, 0x2D, 0x5A, 0xB7, 0x8D, 0xEE, 0x12, 0xD3, 0x2B, 0x36, 0x2E, 0x3E, 0x61, 0xD8, 0xA8, 0xB1,
+    0xE3, 0x93, 0x53, 0xD2, 0x33, 0x32, 0xB3, 0xE6, 0x65, 0x2F, 0x5E, 0xBA, 0x7C, 0xD5, 0xDA, 0xF5,
+    0x1B, 0xB7, 0x6C, 0xDF, 0xB9, 0x7B, 0xFF, 0xC1, 0xC3, 0x47, 0x4F, 0x9E, 0x3E, 0x7B, 0xE1, 0xF2,
+    0xD5, 0xEB, 0x39, 0xB9, 0x60, 0xF2, 0xB6, 0x79, 0x1E, 0x83, 0x4C, 0x9A, 0x35, 0x41, 0x85, 0x89,
+    0xD5, 0xAB, 0xAE, 0x8F, 0x78, 0x9B, 0x75, 0xAF, 0x39, 0xBE, 0x6C, 0xF2, 0x17, 0xCF, 0xE1, 0x7E,
+    0xB7, 0x82, 0x54, 0x75, 0x9D, 0x8F, 0x0E, 0x66, 0x13, 0xAD, 0xFD, 0x08, 0x99, 0xEA, 0x3A, 0x6F,
+    0x79, 0x0B, 0xEA, 0xAF, 0x2A, 0x47, 0x90, 0xAA, 0xAE, 0xF3, 0xD1, 0x41, 0x3F, 0xA2, 0xB5, 0x0F,
+    0x93, 0x2C, 0xB0, 0x93, 0xD1, 0x91, 0x2D, 0xB7, 0xB3, 0xDB, 0x41, 0xDA, 0x2C, 0x8E, 0x47, 0x07,
+    0x33, 0x88, 0xD6, 0x7E, 0x90, 0xAC, 0x59, 0x64, 0x9C, 0xE3, 0x3A, 0xFB, 0x20, 0x6D, 0x16, 0xC7,
+    0xA3, 0x83, 0x26, 0xA2, 0xB5, 0xAF, 0xE2, 0x42, 0x91, 0x1D, 0x8C, 0x8E, 0x2B, 0xA5, 0x76, 0xF4,
+    0x08, 0x78, 0x98, 0x8B, 0xF8, 0x14, 0x2F, 0x55, 0xB6, 0x42, 0xC5, 0x2A, 0x21, 0x61, 0x11, 0x75,
+    0x23, 0x1B, 0x37, 0x6B, 0x15, 0xD5, 0xBE, 0x53, 0xB7, 0x9E, 0xBD, 0xFB, 0x0D, 0x18, 0x94, 0x38,
+    0x22, 0x69, 0xDC, 0xC4, 0x29, 0xA9, 0xD3, 0x67, 0xCD, 0x99, 0x3B, 0x7F, 0xE1, 0x92, 0x65, 0x2B,
+    0xD6, 0xAC, 0xDB, 0xB0, 0x69, 0xDB, 0x8E, 0x5D, 0x7B, 0x0F, 0x1C, 0x3A, 0x72, 0xFC, 0xD4, 0x99,
+    0x73, 0x97, 0xAE, 0x5C, 0xBB, 0x71, 0xFB, 0x8E, 0xCD, 0xF3, 0xE8, 0xA3, 0x61, 0xED, 0x2D, 0xDA,
+    0x35, 0xCF, 0x32, 0xDE, 0xAE, 0xB5, 0xF4, 0xF4, 0x7F, 0xFD, 0xCB, 0x64, 0x71, 0x2D, 0x1F, 0x7B,
+    0x8F, 0x81, 0x9A, 0x62, 0x2B, 0x06, 0x0B, 0xA3, 0x88, 0xD6, 0xBE, 0x9E, 0x8A, 0x62, 0xBB, 0x5A,
+    0x7B, 0x81, 0xFB, 0x40, 0x4D, 0xB1, 0x15, 0x83, 0x85, 0xA9, 0x44, 0x6B, 0xDF, 0x55, 0x45, 0xB1,
+    0x85, 0x6B, 0x2F, 0x3F, 0x21, 0x40, 0x4D, 0xB1, 0x15, 0x83, 0x85, 0x3B, 0x88, 0xD6, 0x7E, 0xA4,
+    0x8A, 0x62, 0x3B, 0xAE, 0xBD, 0x45, 0x65, 0x8A, 0x16, 0x50, 0x53, 0x6C, 0xC5, 0x60, 0xE1, 0x1D,
+    0xA2, 0xB5, 0x2F, 0xA6, 0xA2, 0xD8, 0x8A, 0xC1, 0x52, 0x53, 0x71, 0xE5, 0xA3, 0xA0, 0x76, 0x81,
+    0xB5, 0x79, 0x1E, 0x23, 0x89, 0xD6, 0xBE, 0x86, 0xCA, 0x05, 0xD6, 0xD5, 0xDA, 0xDF, 0xE7, 0x5E,
+    0x50, 0xBB, 0xC0, 0xDA, 0x3C, 0x8F, 0x49, 0x44, 0x6B, 0xDF, 0x4E, 0xE5, 0x02, 0x2B, 0x5C, 0x7B,
+    0xB9, 0x49, 0x01, 0x6A, 0x17, 0x58, 0x9B, 0xE7, 0x71, 0x1D, 0xD1, 0xDA, 0x0F, 0x56, 0xB9, 0xC0,
+    0x3A, 0xAE, 0xBD, 0x2A, 0xE7, 0x83, 0xDA, 0x05, 0xD6, 0xE6, 0x79, 0xBC, 0x42, 0xB4, 0xF6, 0xD3,
+    0x54, 0x2E, 0xB0, 0x36, 0x83, 0xA5, 0x76, 0x85, 0xB5, 0x7D, 0x1C, 0xB4, 0xD8, 0x54, 0x59, 0x9F,
+    0xC7, 0x10, 0xA2, 0xB5, 0xAF, 0xAA, 0xC1, 0xA6, 0xCA, 0xD5, 0xDA, 0x3B, 0xB9, 0x1F, 0xCC, 0xDE,
+    0x45, 0x2C, 0x3E, 0xBE, 0xC5, 0xFD, 0x4A, 0xF9, 0x97, 0x0D, 0xA8, 0x10, 0x58, 0x31, 0xA8, 0x4A,
+    0x70, 0x48, 0x68, 0x58, 0x78, 0x44, 0xED, 0xBA, 0xF5, 0x23, 0x1B, 0x35, 0x6E, 0xD2, 0xAC, 0x45,
+    0xAB, 0xD6, 0x51, 0x6D, 0xDB, 0x47, 0x77, 0xEA, 0xD2, 0x2D, 0xA6, 0x67, 0xAF, 0xDE, 0xB1, 0xFD,
+    0xE2, 0x06, 0xC4, 0x0F, 0x4A, 0x48, 0x1C, 0x36, 0x62, 0x54, 0xD2, 0xD8, 0x71, 0xE3, 0x27, 0x26,
+    0x4F, 0x49, 0x49, 0x4D, 0x9F, 0x9E, 0x31, 0x2B, 0x73, 0x4E, 0xD6, 0xDC, 0x79, 0xF3, 0xB3, 0x17,
+    0x2E, 0x5E, 0xB2, 0x74, 0xD9, 0xF2, 0x15, 0xAB, 0xD6, 0xAC, 0x5D, 0xB7, 0x7E, 0xC3, 0xC6, 0x4D,
+    0x5B, 0xB6, 0x6D, 0xDF, 0xB1, 0x73, 0xD7, 0xEE, 0xBD, 0xFB, 0x0F, 0x1C, 0x3C, 0x74, 0xF8, 0xC8,
+    0xD1, 0xE3, 0x27, 0x4F, 0x9D, 0x3E, 0x73, 0xF6, 0xDC, 0x85, 0x4B, 0x97, 0xAF, 0x5C, 0xBD, 0x76,
+    0xFD, 0x46, 0xCE, 0xED, 0xDC, 0x3B, 0xE0, 0x61, 0xB2, 0x1F, 0x1F, 0x8B, 0x7B, 0x90, 0x6C, 0x16,
+    0x92, 0xCD, 0xB3, 0x9C, 0x97, 0xFB, 0x5A, 0xDA, 0xBD, 0x26, 0x74, 0xA7, 0xC9, 0xE2, 0xC6, 0x81,
+    0x11, 0xBF, 0x15, 0x8C, 0x82, 0xDA, 0xF9, 0xA4, 0xC2, 0xF6, 0x8C, 0xBC, 0x04, 0xF2, 0x0D, 0x0C,
+    0x82, 0xDA, 0x9D, 0xC8, 0x6B, 0xF6, 0x62, 0x60, 0x14, 0xD4, 0xCE, 0x27, 0x15, 0x4E, 0x67, 0xE4,
+    0x25, 0x90, 0xEF, 0x6E, 0x10, 0xD4, 0xDA, 0x22, 0xEF, 0xA6, 0x45, 0x01, 0x8C, 0x82, 0xDA, 0xF9,
+    0xA4, 0xC2, 0x5D, 0x8C, 0xBC, 0x04, 0xF2, 0xA3, 0x0D, 0x82, 0xDA, 0xF9, 0xA4, 0xFA, 0x37, 0xF2,
+    0x16, 0xA3, 0x87, 0xEF, 0x1F, 0xE4, 0x8D, 0x82, 0xDA, 0xF9, 0xA4, 0x42, 0x0F, 0x46, 0x5E, 0x02,
+    0xF9, 0x12, 0x06, 0x41, 0x9D, 0x46, 0xE6, 0xBD, 0xBC, 0xC4, 0xA4, 0x02, 0xA3, 0x37, 0xAA, 0xF6,
+    0xE3, 0x63, 0x63, 0x46, 0x5E, 0x02, 0xF9, 0x9A, 0x06, 0x6F, 0x54, 0xDD, 0x89, 0xBC, 0xEA, 0x17,
+    0x05, 0xA3, 0x37, 0xAA, 0xF6, 0xE3, 0xE3, 0x38, 0x46, 0x5E, 0x02, 0xF9, 0x0E, 0x06, 0x6F, 0x54,
+    0xB5, 0x45, 0x5E, 0xE7, 0xC5, 0x01, 0x8C, 0xDE, 0xA8, 0xDA, 0x8F, 0x8F, 0x1B, 0x18, 0x79, 0x09,
+    0xE4, 0x87, 0x18, 0xBC, 0x51, 0x95, 0x45, 0xDE, 0xD0, 0xF7, 0xF4, 0x60, 0xF4, 0x46, 0xD5, 0x7E,
+    0x7C, 0xBC, 0xC6, 0xC8, 0x4B, 0x20, 0x3F, 0xC3, 0xE0, 0x8D, 0x6A, 0x1A, 0x99, 0xF7, 0xF2, 0x02,
+    0x93, 0x0A, 0xA8, 0x1C, 0x3E, 0xE5, 0x8D, 0x8F, 0x61, 0x8C, 0xBC, 0x04, 0xF2, 0xD5, 0x88, 0x1C,
+    0x3E, 0xB9, 0x13, 0x79, 0x97, 0x5F, 0x1C, 0xD0, 0xB3, 0x90, 0x57, 0xE1, 0x87, 0x8A, 0x3E, 0x5C,
+    0xAC, 0x44, 0xC9, 0xD2, 0x65, 0xCA, 0x95, 0x7F, 0xE4, 0xD1, 0x4A, 0x95, 0xAB, 0x56, 0xAB, 0xFE,
+    0x58, 0x8D, 0x9A, 0xB5, 0xEA, 0xD4, 0x6B, 0xD0, 0xF0, 0xF1, 0x27, 0x9A, 0x36, 0x6F, 0xF9, 0x64,
+    0x9B, 0xA7, 0xDA, 0x75, 0xE8, 0xD8, 0xB9, 0x6B, 0xF7, 0x1E, 0x4F, 0x3F, 0xD3, 0xA7, 0x6F, 0xFF,
+    0x67, 0x07, 0x3E, 0x37, 0x78, 0xC8, 0xD0, 0xE1, 0x23, 0x47, 0x8F, 0x79, 0xFE, 0x85, 0x09, 0x93,
+    0x26, 0xBF, 0x38, 0x35, 0x6D, 0xDA, 0x8C, 0x99, 0xB3, 0x5F, 0x7A, 0xF9, 0x95, 0x57, 0x5F, 0x7B,
+    0x7D, 0xC1, 0xA2, 0x37, 0xDE, 0x7C, 0xEB, 0xED, 0x77, 0x56, 0xAE, 0x7E, 0xF7, 0xBD, 0xF7, 0x3F,
+    0xF8, 0xF0, 0xA3, 0xCD, 0x5B, 0x3F, 0xFE, 0xE4, 0xD3, 0xCF, 0x3E, 0xDF, 0xB3, 0xEF, 0x8B, 0x2F,
+    0xBF, 0xFA, 0xFA, 0x9B, 0x6F, 0x8F, 0x9D, 0xF8, 0xEE, 0xFB, 0x1F, 0x7E, 0xFC, 0xE9, 0xFC, 0xC5,
+    0x9F, 0x7F, 0xF9, 0xF5, 0xB7, 0xDF, 0xFF, 0xB8, 0x79, 0xEB, 0xCF, 0xBF, 0xEE, 0xDA, 0x8F, 0x8F,
+    0x5E, 0x34, 0x91, 0x37, 0x93, 0x6C, 0x9E, 0x45, 0x4D, 0xC6, 0xB4, 0x94, 0x14, 0xA7, 0x97, 0xCD,
+    0x06, 0x0D, 0xD2, 0x7D, 0x90, 0x27, 0xC2, 0xB8, 0x22, 0x3E, 0x56, 0x66, 0xE4, 0x25, 0x90, 0x0F,
+    0x20, 0xC2, 0xB8, 0x41, 0xC8, 0xCB, 0xC5, 0x01, 0x22, 0x8C, 0x2B, 0xE2, 0x63, 0x73, 0x46, 0x5E,
+    0x02, 0xF9, 0xEA, 0x44, 0x18, 0x77, 0x17, 0xF2, 0xAA, 0x5E, 0x18, 0x88, 0x30, 0xAE, 0x88, 0x8F,
+    0x7D, 0x19, 0x79, 0x09, 0xE4, 0x23, 0x89, 0x30, 0xAE, 0x1B, 0xF2, 0x5A, 0x4E, 0x1E, 0x20, 0xC2,
+    0xB8, 0x22, 0x3E, 0x4E, 0x62, 0xE4, 0x25, 0x90, 0x6F, 0x43, 0x84, 0x71, 0xED, 0x90, 0xD7, 0xF1,
+    0x3D, 0x11, 0x10, 0x61, 0x5C, 0x11, 0x1F, 0x17, 0x30, 0xF2, 0x12, 0xC8, 0xC7, 0x10, 0x61, 0x5C,
+    0x05, 0xF2, 0xEE, 0xDB, 0xEA, 0x02, 0x11, 0xC6, 0x15, 0xF1, 0x71, 0x33, 0x23, 0x2F, 0x81, 0xFC,
+    0x40, 0x22, 0x8C, 0xCB, 0x20, 0x6F, 0x36, 0x6A, 0x0C, 0x81, 0x08, 0xE3, 0x8A, 0xF8, 0x78, 0x8C,
+    0x91, 0x97, 0x40, 0x3E, 0x89, 0x08, 0xE3, 0x8A, 0xF8, 0x66, 0x1A, 0x8C, 0x2B, 0xE2, 0x03, 0x11,
+    0xC6, 0x15, 0xF1, 0xF1, 0x26, 0x23, 0x2F, 0x81, 0xFC, 0x54, 0x22, 0x8C, 0xD3, 0xF8, 0x5C, 0xFE,
+    0x3E, 0x73, 0x0C, 0x88, 0x9D, 0x41, 0x59, 0xE3, 0x63, 0x49, 0x46, 0x5E, 0x02, 0x79, 0x3F, 0x22,
+    0x8C, 0x1B, 0x8C, 0xBC, 0x58, 0x3C, 0x20, 0x76, 0x06, 0x65, 0x8D, 0x8F, 0xB5, 0x18, 0x79, 0x09,
+    0xE4, 0x2B, 0x11, 0x3B, 0x83, 0x72, 0x17, 0xF2, 0x2E, 0x05, 0x00, 0x62, 0x67, 0x50, 0xD6, 0xF8,
+    0xD8, 0x91, 0x91, 0x97, 0x40, 0x3E, 0x82, 0xD8, 0x19, 0x94, 0x6E, 0xC8, 0x6B, 0xF1, 0x8A, 0x40,
+    0xEC, 0x0C, 0xCA, 0x1A, 0x1F, 0x87, 0x32, 0xF2, 0x12, 0xC8, 0x37, 0x25, 0x76, 0x06, 0xA5, 0x1D,
+    0xF2, 0x3A, 0x2C, 0x14, 0x40, 0xEC, 0x0C, 0xCA, 0x1A, 0x1F, 0x67, 0x32, 0xF2, 0x12, 0xC8, 0x47,
+    0x13, 0x3B, 0x83, 0x52, 0x81, 0xBC, 0xFE, 0xEF, 0xFF, 0x81, 0xD8, 0x19, 0x94, 0x35, 0x3E, 0xAE,
+    0x64, 0xE4, 0x25, 0x90, 0xEF, 0x43, 0xEC, 0x0C, 0x4A, 0x06, 0x79, 0xB7, 0x7F, 0xAC, 0x03, 0xC4,
+    0xCE, 0xA0, 0xAC, 0xF1, 0x71, 0x0F, 0x23, 0x2F, 0x81, 0x7C, 0x22, 0xB1, 0x33, 0x28, 0xA7, 0xC8,
+    0x1B, 0xFD, 0xF9, 0x3C, 0x10, 0x3B, 0x83, 0xB2, 0xC6, 0xC7, 0xF3, 0x8C, 0xBC, 0x04, 0xF2, 0x13,
+    0x88, 0x9D, 0x41, 0xE5, 0x45, 0x9E, 0xCA, 0x19, 0xD4, 0x7F, 0x91, 0xBF, 0x4B, 0xF2, 0x37, 0x22,
+    0x58, 0x88, 0x91, 0x97, 0x40, 0xDE, 0x42, 0x84, 0x71, 0x22, 0x47, 0x51, 0xCE, 0xE3, 0x42, 0x79,
+    0x92, 0xBF, 0x11, 0xC1, 0x4A, 0x8C, 0xBC, 0x04, 0xF2, 0xE5, 0x88, 0x9D, 0x41, 0xB9, 0x1B, 0x79,
+    0xA9, 0x40, 0xD0, 0x90, 0xE4, 0x6F, 0x44, 0xB0, 0x29, 0x23, 0x2F, 0x81, 0x7C, 0x08, 0x11, 0xC6,
+    0xDD, 0x86, 0xBC, 0x9A, 0x57, 0x06, 0x4F, 0x53, 0x21, 0xB3, 0x97, 0x77, 0xE1, 0x22, 0x0F, 0x59,
+    0x8A, 0xFA, 0x3C, 0xEC, 0x5B, 0xAC, 0x78, 0x09, 0xBF, 0x92, 0xA5, 0x4A, 0xFB, 0x97, 0x29, 0x5B,
+    0x2E, 0xA0, 0x7C, 0x85, 0x47, 0x02, 0x1F, 0xAD, 0x58, 0x29, 0xA8, 0x72, 0x95, 0xAA, 0xC1, 0xD5,
+    0x42, 0xAA, 0x87, 0x3E, 0x16, 0x56, 0x23, 0xBC, 0x66, 0x44, 0xAD, 0xDA, 0x75, 0xEA, 0xD6, 0xAB,
+    0xDF, 0x20, 0xB2, 0x61, 0xA3, 0xC7, 0x1B, 0x3F, 0xD1, 0xA4, 0x69, 0xB3, 0xE6, 0x2D, 0x5A, 0xB6,
+    0x7A, 0xB2, 0x75, 0x9B, 0xA8, 0xA7, 0xDA, 0xB6, 0x6B, 0xDF, 0x21, 0xBA, 0x63, 0xA7, 0xCE, 0x5D,
+    0xBA, 0x76, 0xEB, 0x1E, 0xD3, 0xA3, 0xE7, 0xD3, 0xBD, 0x9E, 0xE9, 0xDD, 0x27, 0xB6, 0x6F, 0xBF,
+    0xFE, 0x71, 0xCF, 0x0E, 0x18, 0x18, 0xFF, 0xDC, 0xA0, 0xC1, 0x09, 0x43, 0x12, 0x87, 0x0E, 0x1B,
+    0x3E, 0x62, 0xE4, 0xA8, 0xD1, 0x49, 0x63, 0xC6, 0x3E, 0x3F, 0xEE, 0x85, 0xF1, 0x13, 0x26, 0x4E,
+    0x4A, 0x9E, 0x3C, 0xE5, 0xC5, 0x94, 0xA9, 0xA9, 0x69, 0xE9, 0xD3, 0xA6, 0xCF, 0xC8, 0x98, 0x39,
+    0x6B, 0x76, 0xE6, 0x4B, 0x73, 0x5E, 0xCE, 0x7A, 0x65, 0xEE, 0xAB, 0xF3, 0x5E, 0x9B, 0xFF, 0x7A,
+    0xF6, 0x82, 0x85, 0x8B, 0x16, 0xBF, 0xB1, 0xE4, 0xCD, 0xA5, 0x6F, 0x2D, 0x7B, 0x7B, 0xF9, 0x3B,
+    0x2B, 0x56, 0xAE, 0x5A, 0xBD, 0xE6, 0xDD, 0xB5, 0xEF, 0xAD, 0x7B, 0x7F, 0xFD, 0x07, 0x1B, 0x3E,
+    0xDC, 0xF8, 0xD1, 0xA6, 0xCD, 0x5B, 0xB6, 0x6E, 0xFB, 0x78, 0xFB, 0x27, 0x3B, 0x3E, 0xDD, 0xF9,
+    0xD9, 0xAE, 0xCF, 0x77, 0xEF, 0xD9, 0xBB, 0x6F, 0xFF, 0x17, 0x07, 0xBE, 0x3C, 0xF8, 0xD5, 0xA1,
+    0xAF, 0x0F, 0x7F, 0x73, 0xE4, 0xDB, 0xA3, 0xC7, 0x8E, 0x9F, 0x38, 0xF9, 0xDD, 0xA9, 0xEF, 0x4F,
+    0xFF, 0x70, 0xE6, 0xC7, 0xB3, 0x3F, 0x9D, 0x3B, 0x7F, 0xE1, 0xE2, 0xA5, 0x9F, 0x2F, 0xFF, 0x72,
+    0xE5, 0xD7, 0xAB, 0xBF, 0x5D, 0xFB, 0xFD, 0xFA, 0x1F, 0x37, 0x6E, 0xE6, 0xDC, 0xBA, 0xFD, 0x67,
+    0xEE, 0x5F, 0x77, 0xEE, 0x02, 0x7A, 0xC8, 0xE4, 0x8F, 0x85, 0x91, 0x9B, 0x68, 0x23, 0xAA, 0x07,
+    0xA2, 0xD2, 0xF2, 0x31, 0x15, 0x9C, 0x96, 0x72, 0xAF, 0xA9, 0xFA, 0x58, 0xA4, 0xE0, 0xCC, 0x22,
+    0xD5, 0xA9, 0x02, 0x2B, 0x5C, 0x3C, 0x7F, 0xAC, 0xCA, 0xDE, 0x66, 0xC1, 0xEB, 0x22, 0xF8, 0xF2,
+    0xAC, 0xF0, 0x02, 0x2A, 0x78, 0x9D, 0x93, 0x01, 0x56, 0xB8, 0x78, 0xFE, 0xD8, 0x92, 0xBD, 0xCD,
+    0x82, 0xD7, 0x45, 0xF0, 0xA1, 0xAC, 0xF0, 0x7C, 0x2B, 0x78, 0x43, 0xBB, 0x0B, 0xAC, 0x70, 0xF1,
+    0xFC, 0xB1, 0x3F, 0x7B, 0x9B, 0x05, 0xAF, 0x8B, 0xE0, 0x1B, 0xB2, 0xC2, 0x1F, 0x60, 0xC1, 0x13,
+    0x5E, 0x71, 0x80, 0x15, 0x2E, 0x9E, 0x3F, 0x4E, 0x66, 0x6F, 0xB3, 0xE0, 0x75, 0x11, 0x7C, 0x14,
+    0x2B, 0x9C, 0xB4, 0xE0, 0x1F, 0xD8, 0x4F, 0x85, 0x80, 0x15, 0x2E, 0x9E, 0x3F, 0x2E, 0x62, 0x6F,
+    0xB3, 0xE0, 0x75, 0x11, 0x7C, 0x0F, 0x56, 0xB8, 0xC1, 0x82, 0xCF, 0xA7, 0x27, 0xB7, 0xC0, 0x0A,
+    0x17, 0xCF, 0x1F, 0xB7, 0xB2, 0xB7, 0x59, 0xF0, 0xBA, 0x08, 0x3E, 0x9E, 0x15, 0xAE, 0xBB, 0xE0,
+    0xCD, 0x05, 0x71, 0x1A, 0x02, 0x2B, 0x5C, 0x22, 0xFF, 0x13, 0xEC, 0x6D, 0x16, 0xBC, 0x2E, 0x82,
+    0x1F, 0xC3, 0x0A, 0x17, 0xCF, 0xDF, 0xCC, 0x0A, 0x17, 0xCE, 0x1F, 0x58, 0xE1, 0xE2, 0xF9, 0xE3,
+    0x2D, 0xF6, 0x36, 0x0B, 0x5E, 0x17, 0xC1, 0xA7, 0xB2, 0xC2, 0xF9, 0x7B, 0xF0, 0x7A, 0xEC, 0x42,
+    0x80, 0x15, 0x2E, 0x9E, 0x3F, 0x96, 0x66, 0x6F, 0xB3, 0xE0, 0x75, 0x11, 0x7C, 0x49, 0x56, 0x38,
+    0x0B, 0x5E, 0x8F, 0x5D, 0x08, 0xB0, 0xC2, 0xC5, 0xF3, 0xC7, 0x3A, 0xEC, 0x6D, 0x16, 0xBC, 0x2E,
+    0x82, 0x0F, 0x62, 0x85, 0x17, 0x18, 0xC1, 0xBB, 0xB5, 0xFB, 0xC0, 0x0A, 0x17, 0xCF, 0x1F, 0x3B,
+    0xB3, 0xB7, 0x59, 0xF0, 0xBA, 0x08, 0xBE, 0x16, 0x2B, 0x3C, 0x1F, 0x09, 0x9E, 0x50, 0x07, 0x81,
+    0x15, 0x2E, 0x9E, 0x3F, 0x0E, 0x67, 0x6F, 0xB3, 0xE0, 0x75, 0x11, 0x7C, 0x33, 0x56, 0xF8, 0x03,
+    0x25, 0xF8, 0x07, 0x66, 0x13, 0x01, 0xAC, 0x70, 0xF1, 0xFC, 0x71, 0x36, 0x7B, 0x9B, 0x05, 0xAF,
+    0x8B, 0xE0, 0x3B, 0xB2, 0xC2, 0x89, 0x09, 0x3E, 0x9F, 0x7C, 0xD0, 0x0F, 0xAC, 0x70, 0xF1, 0xFC,
+    0x71, 0x35, 0x7B, 0x9B, 0x05, 0xAF, 0x8B, 0xE0, 0x63, 0x59, 0xE1, 0x6E, 0x17, 0x7C, 0x81, 0xF8,
+    0x32, 0x0E, 0xB0, 0xC2, 0xC5, 0xF3, 0xC7, 0x7D, 0xEC, 0x6D, 0x16, 0xBC, 0x2E, 0x82, 0x1F, 0xCA,
+    0x0A, 0x17, 0xCE, 0x5F, 0x5C, 0xF0, 0xFC, 0xBD, 0x78, 0x04, 0x56, 0xB8, 0x78, 0xFE, 0x78, 0x91,
+    0xBD, 0xCD, 0x82, 0xD7, 0x45, 0xF0, 0x13, 0x59, 0xE1, 0xE2, 0xF9, 0x9B, 0x59, 0xE1, 0xC2, 0xF9,
+    0xB3, 0xC2, 0x25, 0xF2, 0x47, 0x2F, 0xF6, 0x36, 0x0B, 0x5E, 0x17, 0xC1, 0x17, 0x65, 0x85, 0xF3,
+    0xF7, 0xE0, 0xF5, 0xD8, 0x85, 0x00, 0x2B, 0x5C, 0x3C, 0x7F, 0xAC, 0xCC, 0xDE, 0x66, 0xC1, 0xEB,
+    0x22, 0xF8, 0x00, 0x56, 0x78, 0x81, 0x15, 0xBC, 0xAE, 0xE9, 0x00, 0x2B, 0x5C, 0x3C, 0x7F, 0x6C,
+    0xCE, 0xDE, 0x66, 0xC1, 0xEB, 0x22, 0xF8, 0xEA, 0xAC, 0xF0, 0x7C, 0x2C, 0x78, 0x03, 0x3B, 0xFC,
+    0x37, 0x32, 0x22, 0xF5, 0xF0, 0xC9, 0x61, 0x8D, 0xA5, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E,
+    0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+
+// 8x8
+static const uint8_t NOT_INTERLACED[] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A, 0x00, 0x00, 0x00, 0x0D, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0xE1, 0x64, 0xE1,
+    0x57, 0x00, 0x00, 0x00, 0x0F, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6F, 0x6D, 0x6D, 0x65, 0x6E, 0x74,
+    0x00, 0x73, 0x6B, 0x69, 0x70, 0x70, 0x65, 0x64, 0x49, 0x8C, 0x8B, 0xB4, 0x00, 0x00, 0x00, 0x21,
+    0x49, 0x44, 0x41, 0x54, 0x78, 0xDA, 0x63, 0x60, 0x60, 0x64, 0x62, 0x66, 0x61, 0x65, 0x63, 0x67,
+    0x64, 0x60, 0x84, 0x00, 0x26, 0x06, 0x28, 0x60, 0x86, 0x89, 0xB0, 0x30, 0xC0, 0x01, 0x4E, 0xC5,
+    0x00, 0x0E, 0xBB, 0x00, 0x5B, 0x1D, 0x41, 0xD3, 0x51, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4E,
+    0x44, 0xAE, 0x42, 0x60, 0x82,
+};
+
+#endif
@@ -0,0 +1,224 @@
+/*****************************************************************************
+* | File        :   test_png_adam7.cpp
+* | Function    :   Progressive decoding of interlaced PNGs (PNG_Adam7)
+* | Info        :
+*   pio test -e native -f test_png_adam7
+*   Each fixture (png_fixtures.h, from make_fixtures.py) is written to a
+*   temporary file and decoded through the SD reader. The expected frames
+*   are built independently from the golden pixels, placed by
+*   Frame_Transform: the preview from pass 1 alone, every 8th pixel spread
+*   over its 8x8 block, and the final frame from every pixel.
+******************************************************************************/
+#include <unity.h>
+#include "PNG_Adam7.h"
+#include "PNG_Loader.h"
+#include "Frame_Transform.h"
+#include "png_fixtures.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FRAME_PIXELS (LCD_WIDTH * LCD_HEIGHT)
+#define RAMP_WIDTH   300    // GRAY8_DOWNSCALED
+#define RAMP_HEIGHT  200
+
+static SD_READER reader;
+static uint16_t frame[FRAME_PIXELS];
+static uint16_t previewed[FRAME_PIXELS];
+static uint16_t expected[FRAME_PIXELS];
+static uint16_t line[PNG_LOADER_MAX_WIDTH];
+static uint16_t ramp[RAMP_WIDTH * RAMP_HEIGHT];
+static int previews = 0;
+static char path[] = "/tmp/adam7XXXXXX";
+
+static void capturePreview(const uint16_t *shown)
+{
+    TEST_ASSERT_EQUAL_PTR(frame, shown);
+    memcpy(previewed, shown, sizeof(previewed));
+    previews++;
+}
+
+static void writeFixture(const uint8_t *data, uint32_t len)
+{
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    TEST_ASSERT_EQUAL(len, write(fd, data, len));
+    close(fd);
+}
+
+// The image as the golden pixels, or its pass 1 with each pixel over its 8x8 block
+static void buildExpected(uint32_t width, uint32_t height, const uint16_t *pixels, bool pass1)
+{
+    FRAME_TRANSFORM transform;
+
+    Transform_Init(&transform, width, height);
+    memset(expected, 0, sizeof(expected));
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            line[x] = pass1 ? pixels[(y / ADAM7_SCALE * ADAM7_SCALE) * width + x / ADAM7_SCALE * ADAM7_SCALE]
+                            : pixels[y * width + x];
+        }
+        Transform_PutRow(&transform, expected, y, line);
+    }
+}
+
+static void assertDecode(const uint8_t *data, uint32_t len, uint32_t width, uint32_t height, const uint16_t *pixels)
+{
+    writeFixture(data, len);
+    bool ok = Adam7_DecodeToFrame(&reader, path, frame, line, capturePreview);
+    TEST_ASSERT_TRUE_MESSAGE(ok, Adam7_LastError());
+    TEST_ASSERT_EQUAL_INT(1, previews);
+    buildExpected(width, height, pixels, true);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, previewed, FRAME_PIXELS);
+    buildExpected(width, height, pixels, false);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, frame, FRAME_PIXELS);
+}
+
+void setUp(void)
+{
+    strcpy(path, "/tmp/adam7XXXXXX");
+    previews = 0;
+}
+
+void tearDown(void)
+{
+    unlink(path);
+}
+
+static void test_rgba8_dynamic_across_idat_chunks(void)
+{
+    assertDecode(RGBA8_DYNAMIC, sizeof(RGBA8_DYNAMIC), 24, 17, RGBA8_DYNAMIC_PIXELS);
+}
+
+static void test_palette4_with_trns_fixed_blocks(void)
+{
+    assertDecode(PALETTE4_FIXED, sizeof(PALETTE4_FIXED), 37, 21, PALETTE4_FIXED_PIXELS);
+}
+
+static void test_gray16_key_stored_blocks(void)
+{
+    assertDecode(GRAY16_STORED_KEY, sizeof(GRAY16_STORED_KEY), 9, 17, GRAY16_STORED_KEY_PIXELS);
+}
+
+static void test_gray1(void)
+{
+    assertDecode(GRAY1, sizeof(GRAY1), 20, 9, GRAY1_PIXELS);
+}
+
+static void test_rgb16_key(void)
+{
+    assertDecode(RGB16_KEY, sizeof(RGB16_KEY), 16, 9, RGB16_KEY_PIXELS);
+}
+
+static void test_gray_alpha8(void)
+{
+    assertDecode(GRAY_ALPHA8, sizeof(GRAY_ALPHA8), 9, 9, GRAY_ALPHA8_PIXELS);
+}
+
+// Fitted down to the panel: every pass has rows and columns no display pixel samples
+static void test_larger_than_the_panel(void)
+{
+    for (uint32_t y = 0; y < RAMP_HEIGHT; y++) {
+        for (uint32_t x = 0; x < RAMP_WIDTH; x++) {
+            uint8_t v = (x + 3 * y) & 255;
+            ramp[y * RAMP_WIDTH + x] = ((v & 0xF8) << 8) | ((v & 0xFC) << 3) | (v >> 3);
+        }
+    }
+    assertDecode(GRAY8_DOWNSCALED, sizeof(GRAY8_DOWNSCALED), RAMP_WIDTH, RAMP_HEIGHT, ramp);
+}
+
+// Pass 1 is placed like every other pass when nobody is shown the preview
+static void test_without_a_preview(void)
+{
+    writeFixture(PALETTE4_FIXED, sizeof(PALETTE4_FIXED));
+    TEST_ASSERT_TRUE_MESSAGE(Adam7_DecodeToFrame(&reader, path, frame, line, NULL), Adam7_LastError());
+    buildExpected(37, 21, PALETTE4_FIXED_PIXELS, false);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, frame, FRAME_PIXELS);
+}
+
+static void test_workspace_is_kept_between_files(void)
+{
+    assertDecode(GRAY1, sizeof(GRAY1), 20, 9, GRAY1_PIXELS);
+    uint32_t memory = Adam7_WorkingMemory();
+    TEST_ASSERT_GREATER_OR_EQUAL(ADAM7_INFLATE_MEMORY, memory);
+    unlink(path);
+    setUp();
+    assertDecode(GRAY_ALPHA8, sizeof(GRAY_ALPHA8), 9, 9, GRAY_ALPHA8_PIXELS);
+    TEST_ASSERT_EQUAL_UINT32(memory, Adam7_WorkingMemory());
+}
+
+// Pass 1 of RGBA8_DYNAMIC ends in its second IDAT chunk, which ends at byte 206
+static void test_preview_is_shown_before_the_data_runs_out(void)
+{
+    writeFixture(RGBA8_DYNAMIC, 206);
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, capturePreview));
+    TEST_ASSERT_EQUAL_STRING("truncated image data", Adam7_LastError());
+    TEST_ASSERT_EQUAL_INT(1, previews);
+    buildExpected(24, 17, RGBA8_DYNAMIC_PIXELS, true);
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expected, previewed, FRAME_PIXELS);
+}
+
+static void test_data_cut_inside_the_first_pass_fails(void)
+{
+    writeFixture(RGBA8_DYNAMIC, 180);
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, capturePreview));
+    TEST_ASSERT_EQUAL_STRING("truncated image data", Adam7_LastError());
+    TEST_ASSERT_EQUAL_INT(0, previews);
+}
+
+static void test_corrupt_data_fails(void)
+{
+    uint8_t data[sizeof(GRAY_ALPHA8)];
+    memcpy(data, GRAY_ALPHA8, sizeof(data));
+    uint32_t idat = 8 + 25 + 27; // Signature, IHDR, tEXt
+    TEST_ASSERT_EQUAL_MEMORY("IDAT", data + idat + 4, 4);
+    data[idat + 8] = 0x79; // zlib CMF with a bad check value
+    writeFixture(data, sizeof(data));
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, capturePreview));
+    TEST_ASSERT_EQUAL_STRING("incorrect header check", Adam7_LastError());
+}
+
+static void test_header_errors_are_reported(void)
+{
+    writeFixture(NOT_INTERLACED, sizeof(NOT_INTERLACED));
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, NULL));
+    TEST_ASSERT_EQUAL_STRING("unsupported PNG header", Adam7_LastError());
+    unlink(path);
+
+    uint8_t wide[sizeof(GRAY1)];
+    memcpy(wide, GRAY1, sizeof(wide));
+    wide[8 + 8 + 2] = (PNG_LOADER_MAX_WIDTH + 1) >> 8; // IHDR width, CRC left stale
+    wide[8 + 8 + 3] = (PNG_LOADER_MAX_WIDTH + 1) & 0xFF;
+    setUp();
+    writeFixture(wide, sizeof(wide));
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, NULL));
+    TEST_ASSERT_EQUAL_STRING("image wider than PNG_LOADER_MAX_WIDTH", Adam7_LastError());
+    unlink(path);
+
+    setUp();
+    writeFixture(GRAY1, 8);
+    TEST_ASSERT_FALSE(Adam7_DecodeToFrame(&reader, path, frame, line, NULL));
+    TEST_ASSERT_EQUAL_STRING("not a PNG or unreadable", Adam7_LastError());
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_rgba8_dynamic_across_idat_chunks);
+    RUN_TEST(test_palette4_with_trns_fixed_blocks);
+    RUN_TEST(test_gray16_key_stored_blocks);
+    RUN_TEST(test_gray1);
+    RUN_TEST(test_rgb16_key);
+    RUN_TEST(test_gray_alpha8);
+    RUN_TEST(test_larger_than_the_panel);
+    RUN_TEST(test_without_a_preview);
+    RUN_TEST(test_workspace_is_kept_between_files);
+    RUN_TEST(test_preview_is_shown_before_the_data_runs_out);
+    RUN_TEST(test_data_cut_inside_the_first_pass_fails);
+    RUN_TEST(test_corrupt_data_fails);
+    RUN_TEST(test_header_errors_are_reported);
+    SDReader_Free(&reader);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/*****************************************************************************
+* | File        :   test_power_manager.cpp
+* | Function    :   Light sleep decision and residency statistics
+* | Info        :
+*   pio test -e native -f test_power_manager
+*   Power_Decide() is fed loop() states one condition at a time; the
+*   statistics are fed the sleeps and skips a session would report.
+******************************************************************************/
+#include <unity.h>
+#include "Power_Manager.h"
+
+static POWER_CONFIG config;
+static POWER_INPUT input;
+
+void setUp(void)
+{
+    Power_Init(&config);
+    Power_ResetStats();
+    input.UntilNextMs = 1000;
+    input.Busy = false;
+    input.UsbConnected = false;
+    input.ButtonPressed = false;
+    input.DisplayHoldable = true;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_idle_gap_sleeps_until_the_margin(void)
+{
+    uint32_t sleepMs = 123;
+    TEST_ASSERT_EQUAL(POWER_SLEEP, Power_Decide(&config, &input, &sleepMs));
+    TEST_ASSERT_EQUAL_UINT32(1000 - POWER_WAKE_MARGIN_MS, sleepMs);
+}
+
+static void test_short_gaps_stay_awake(void)
+{
+    uint32_t sleepMs = 123;
+    input.UntilNextMs = POWER_MIN_SLEEP_MS + POWER_WAKE_MARGIN_MS - 1;
+    TEST_ASSERT_EQUAL(POWER_SKIP_SHORT, Power_Decide(&config, &input, &sleepMs));
+    TEST_ASSERT_EQUAL_UINT32(0, sleepMs);
+
+    input.UntilNextMs = POWER_MIN_SLEEP_MS + POWER_WAKE_MARGIN_MS;
+    TEST_ASSERT_EQUAL(POWER_SLEEP, Power_Decide(&config, &input, &sleepMs));
+    TEST_ASSERT_EQUAL_UINT32(POWER_MIN_SLEEP_MS, sleepMs);
+
+    input.UntilNextMs = 0;   // Overdue
+    TEST_ASSERT_EQUAL(POWER_SKIP_SHORT, Power_Decide(&config, &input, &sleepMs));
+}
+
+static void test_long_gaps_are_capped(void)
+{
+    uint32_t sleepMs;
+    input.UntilNextMs = 0xFFFFFFFFu;   // Nothing scheduled
+    TEST_ASSERT_EQUAL(POWER_SLEEP, Power_Decide(&config, &input, &sleepMs));
+    TEST_ASSERT_EQUAL_UINT32(POWER_MAX_SLEEP_MS - POWER_WAKE_MARGIN_MS, sleepMs);
+
+    config.MaxSleepMs = 500;
+    config.WakeMarginMs = 10;
+    TEST_ASSERT_EQUAL(POWER_SLEEP, Power_Decide(&config, &input, &sleepMs));
+    TEST_ASSERT_EQUAL_UINT32(490, sleepMs);
+}
+
+// Each blocker alone keeps the device awake, reported in priority order
+static void test_blockers_in_priority_order(void)
+{
+    uint32_t sleepMs = 123;
+    config.Enabled = false;
+    input.Busy = true;
+    input.UsbConnected = true;
+    input.ButtonPressed = true;
+    input.DisplayHoldable = false;
+    input.UntilNextMs = 1;
+
+    static const POWER_DECISION order[] = {POWER_SKIP_DISABLED, POWER_SKIP_BUSY, POWER_SKIP_USB,
+                                           POWER_SKIP_BUTTON, POWER_SKIP_DISPLAY, POWER_SKIP_SHORT};
+    for (unsigned i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        POWER_DECISION decision = Power_Decide(&config, &input, &sleepMs);
+        TEST_ASSERT_EQUAL_STRING(Power_DecisionName(order[i]), Power_DecisionName(decision));
+        TEST_ASSERT_EQUAL_UINT32(0, sleepMs);
+        switch (decision) {
+        case POWER_SKIP_DISABLED: config.Enabled = true; break;
+        case POWER_SKIP_BUSY:     input.Busy = false; break;
+        case POWER_SKIP_USB:      input.UsbConnected = false; break;
+        case POWER_SKIP_BUTTON:   input.ButtonPressed = false; break;
+        case POWER_SKIP_DISPLAY:  input.DisplayHoldable = true; break;
+        default:                  input.UntilNextMs = 1000; break;
+        }
+    }
+    TEST_ASSERT_EQUAL(POWER_SLEEP, Power_Decide(&config, &input, &sleepMs));
+}
+
+static void test_residency_statistics(void)
+{
+    Power_AccountActive(4000);
+    Power_AccountSleep(998, 998000, POWER_WAKE_TIMER);
+    Power_AccountSleep(998, 996000, POWER_WAKE_TIMER);  // Within the margin: on time
+    Power_AccountSleep(998, 300000, POWER_WAKE_BUTTON); // Woken by a press
+    Power_AccountSkip(POWER_SKIP_SHORT);
+    Power_AccountSkip(POWER_SKIP_SHORT);
+    Power_AccountSkip(POWER_SKIP_USB);
+    Power_AccountSkip(POWER_DECISION_COUNT);            // Out of range, ignored
+    Power_AccountSleep(10, 10000, POWER_WAKE_COUNT);    // Counted, wake cause ignored
+
+    POWER_STATS stats;
+    Power_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.Sleeps);
+    TEST_ASSERT_EQUAL_UINT64(998000 + 996000 + 300000 + 10000, stats.SleepUs);
+    TEST_ASSERT_EQUAL_UINT64(4000, stats.ActiveUs);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.Wakes[POWER_WAKE_TIMER]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.Wakes[POWER_WAKE_BUTTON]);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.Wakes[POWER_WAKE_OTHER]);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.Skips[POWER_SKIP_SHORT]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.Skips[POWER_SKIP_USB]);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.EarlyWakes);
+
+    Power_ResetStats();
+    Power_GetStats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.Sleeps);
+    TEST_ASSERT_EQUAL_UINT64(0, stats.SleepUs);
+}
+
+static void test_names(void)
+{
+    TEST_ASSERT_EQUAL_STRING("sleep", Power_DecisionName(POWER_SLEEP));
+    TEST_ASSERT_EQUAL_STRING("too short", Power_DecisionName(POWER_SKIP_SHORT));
+    TEST_ASSERT_EQUAL_STRING("?", Power_DecisionName(POWER_DECISION_COUNT));
+    TEST_ASSERT_EQUAL_STRING("button", Power_WakeName(POWER_WAKE_BUTTON));
+    TEST_ASSERT_EQUAL_STRING("other", Power_WakeName(POWER_WAKE_COUNT));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_gap_sleeps_until_the_margin);
+    RUN_TEST(test_short_gaps_stay_awake);
+    RUN_TEST(test_long_gaps_are_capped);
+    RUN_TEST(test_blockers_in_priority_order);
+    RUN_TEST(test_residency_statistics);
+    RUN_TEST(test_names);
+    return UNITY_END();
+}
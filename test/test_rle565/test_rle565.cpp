@@ -0,0 +1,181 @@
+/*****************************************************************************
+* | File        :   test_rle565.cpp
+* | Function    :   RLE565 decoder round trips onto the virtual panel
+* | Info        :
+*   pio test -e native -f test_rle565
+*   Frames are packed by a small encoder here (same packets as
+*   scripts/rle565.py), decoded through the LCD burst path and read back
+*   from DEV_Native's panel.
+******************************************************************************/
+#include <unity.h>
+#include "RLE565.h"
+#include "DEV_Config.h"
+#include <string.h>
+
+#define FRAME_PIXELS (LCD_WIDTH * LCD_HEIGHT)
+
+static uint16_t frame[FRAME_PIXELS];
+static uint8_t stream[FRAME_PIXELS * 3];
+static RLE565_DECODER decoder;
+
+// Greedy packing: repeats of 2 or more become runs, the rest literals
+static uint32_t encode(const uint16_t *pixels, uint32_t count, bool littleEndian)
+{
+    uint32_t out = 0;
+    uint32_t i = 0;
+    while (i < count) {
+        uint32_t run = 1;
+        while (i + run < count && run < RLE565_MAX_PACKET && pixels[i + run] == pixels[i]) {
+            run++;
+        }
+        uint32_t n = run;
+        if (run < 2) {
+            n = 1;
+            while (i + n < count && n < RLE565_MAX_PACKET &&
+                   (i + n + 1 >= count || pixels[i + n + 1] != pixels[i + n])) {
+                n++;
+            }
+        }
+        stream[out++] = (run >= 2 ? 0x80 : 0x00) | (n - 1);
+        for (uint32_t k = 0; k < (run >= 2 ? 1 : n); k++) {
+            uint16_t p = pixels[i + k];
+            stream[out++] = littleEndian ? p & 0xFF : p >> 8;
+            stream[out++] = littleEndian ? p >> 8 : p & 0xFF;
+        }
+        i += n;
+    }
+    return out;
+}
+
+// Flat bands, a gradient and noise, so runs cross rows and literals split bursts
+static void fillFrame(void)
+{
+    uint32_t seed = 565;
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            uint16_t p;
+            if (y < 60) {
+                p = (y / 20) == 1 ? RED : BLACK;
+            } else if (y < 150) {
+                p = ((x * 31 / LCD_WIDTH) << 11) | ((y & 63) << 5);
+            } else {
+                seed = seed * 1103515245 + 12345;
+                p = (seed >> 16) & 0x3 ? (uint16_t)(seed >> 8) : BLUE;
+            }
+            frame[y * LCD_WIDTH + x] = p;
+        }
+    }
+}
+
+static void assertPanelShowsFrame(void)
+{
+    for (int y = 0; y < LCD_HEIGHT; y++) {
+        for (int x = 0; x < LCD_WIDTH; x++) {
+            TEST_ASSERT_EQUAL_HEX16(frame[y * LCD_WIDTH + x], Native_PanelPixel(x, y));
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(FRAME_PIXELS, (uint32_t)Native_Stats()->Pixels);
+    TEST_ASSERT_EQUAL_UINT32(0, Native_Stats()->Overflows);
+}
+
+void setUp(void)
+{
+    Native_Reset();
+    LCD_Init();
+    LCD_Clear(BLACK);
+    Native_ResetStats();
+    fillFrame();
+}
+
+void tearDown(void)
+{
+}
+
+static void test_stream_from_rle565_py_decodes(void)
+{
+    // scripts/rle565.py: encode([0xF800] * 5 + [0x0001, 0x0203, 0x0405] + [0x07E0] * 130)
+    static const uint8_t golden[] = {0x84, 0xF8, 0x00, 0x02, 0x00, 0x01, 0x02, 0x03,
+                                     0x04, 0x05, 0xFF, 0x07, 0xE0, 0x81, 0x07, 0xE0};
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, 1);
+    RLE565_Begin(&decoder, 138, false);
+    TEST_ASSERT_TRUE(RLE565_Feed(&decoder, golden, sizeof(golden)));
+    TEST_ASSERT_TRUE(RLE565_Finish(&decoder));
+    TEST_ASSERT_EQUAL_HEX16(0xF800, Native_PanelPixel(4, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x0001, Native_PanelPixel(5, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x0405, Native_PanelPixel(7, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x07E0, Native_PanelPixel(8, 0));
+    TEST_ASSERT_EQUAL_HEX16(0x07E0, Native_PanelPixel(2, 1)); // Run carried into the next row
+    TEST_ASSERT_EQUAL_UINT32(138, (uint32_t)Native_Stats()->Pixels);
+}
+
+static void test_full_frame_round_trip(void)
+{
+    uint32_t len = encode(frame, FRAME_PIXELS, false);
+    TEST_ASSERT_LESS_THAN(FRAME_PIXELS * 2, len);
+    TEST_ASSERT_TRUE(RLE565_DrawImage(stream, len, 0, 0, LCD_WIDTH, LCD_HEIGHT));
+    assertPanelShowsFrame();
+    // Whole bursts of RLE565_BURST_ROWS rows after the window setup
+    TEST_ASSERT_EQUAL_UINT32(7 + LCD_HEIGHT / RLE565_BURST_ROWS, Native_Stats()->Transactions);
+}
+
+static void test_slices_split_packets_anywhere(void)
+{
+    uint32_t len = encode(frame, FRAME_PIXELS, false);
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    RLE565_Begin(&decoder, FRAME_PIXELS, false);
+    uint32_t pos = 0;
+    for (uint32_t slice = 1; pos < len; slice = slice % 7 + 1) {
+        uint32_t n = len - pos < slice ? len - pos : slice;
+        TEST_ASSERT_TRUE(RLE565_Feed(&decoder, stream + pos, n));
+        pos += n;
+    }
+    TEST_ASSERT_TRUE(RLE565_Finish(&decoder));
+    assertPanelShowsFrame();
+}
+
+static void test_little_endian_stream(void)
+{
+    uint32_t len = encode(frame, FRAME_PIXELS, true);
+    LCD_SetCursor(0, 0, LCD_WIDTH - 1, LCD_HEIGHT - 1);
+    RLE565_Begin(&decoder, FRAME_PIXELS, true);
+    TEST_ASSERT_TRUE(RLE565_Feed(&decoder, stream, len));
+    TEST_ASSERT_TRUE(RLE565_Finish(&decoder));
+    assertPanelShowsFrame();
+}
+
+static void test_malformed_streams_are_reported(void)
+{
+    // Run of 4 into a 3-pixel image
+    static const uint8_t overrun[] = {0x83, 0x12, 0x34};
+    RLE565_Begin(&decoder, 3, false);
+    TEST_ASSERT_FALSE(RLE565_Feed(&decoder, overrun, sizeof(overrun)));
+
+    // Literal packet cut short
+    static const uint8_t truncated[] = {0x02, 0x00, 0x01, 0x00};
+    RLE565_Begin(&decoder, 3, false);
+    TEST_ASSERT_TRUE(RLE565_Feed(&decoder, truncated, sizeof(truncated)));
+    TEST_ASSERT_FALSE(RLE565_Finish(&decoder));
+
+    // Bytes after the last pixel are ignored
+    static const uint8_t trailing[] = {0x81, 0xAB, 0xCD, 0x85, 0xFF};
+    LCD_SetCursor(0, 0, 1, 0);
+    Native_ResetStats();
+    RLE565_Begin(&decoder, 2, false);
+    TEST_ASSERT_TRUE(RLE565_Feed(&decoder, trailing, sizeof(trailing)));
+    TEST_ASSERT_TRUE(RLE565_Finish(&decoder));
+    TEST_ASSERT_EQUAL_UINT32(2, (uint32_t)Native_Stats()->Pixels);
+    TEST_ASSERT_EQUAL_HEX16(0xABCD, Native_PanelPixel(1, 0));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_stream_from_rle565_py_decodes);
+    RUN_TEST(test_full_frame_round_trip);
+    RUN_TEST(test_slices_split_packets_anywhere);
+    RUN_TEST(test_little_endian_stream);
+    RUN_TEST(test_malformed_streams_are_reported);
+    return UNITY_END();
+}
@@ -0,0 +1,168 @@
+/*****************************************************************************
+* | File        :   test_sd_reader.cpp
+* | Function    :   Buffered reader over a generated host file
+* | Info        :
+*   pio test -e native -f test_sd_reader
+*   The file is 3 chunks and a partial one of a position-derived pattern,
+*   so every byte read back says where it came from. Card accesses are
+*   counted through the reader's own statistics.
+******************************************************************************/
+#include <unity.h>
+#include "SD_Reader.h"
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define CHUNK SD_READER_CHUNK_SIZE
+#define FILE_SIZE (3 * CHUNK + 1234)
+
+static SD_READER reader;
+static uint8_t out[FILE_SIZE + 64];
+static char path[] = "/tmp/sdreaderXXXXXX";
+
+static uint8_t patternAt(uint32_t position)
+{
+    return (uint8_t)(position * 7 + (position >> 8) + (position >> 16));
+}
+
+static void assertPattern(const uint8_t *data, uint32_t position, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        if (data[i] != patternAt(position + i)) {
+            char message[64];
+            snprintf(message, sizeof(message), "byte at %u", (unsigned)(position + i));
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+}
+
+static void readAt(uint32_t position, uint32_t len)
+{
+    TEST_ASSERT_TRUE(SDReader_Seek(&reader, position));
+    TEST_ASSERT_EQUAL_INT32(len, SDReader_Read(&reader, out, len));
+    assertPattern(out, position, len);
+    TEST_ASSERT_EQUAL_UINT32(position + len, SDReader_Position(&reader));
+}
+
+void setUp(void)
+{
+    static bool written = false;
+    if (!written) {
+        int fd = mkstemp(path);
+        TEST_ASSERT_TRUE(fd >= 0);
+        for (uint32_t i = 0; i < FILE_SIZE; i++) {
+            out[i] = patternAt(i);
+        }
+        TEST_ASSERT_EQUAL(FILE_SIZE, write(fd, out, FILE_SIZE));
+        close(fd);
+        written = true;
+    }
+    memset(out, 0, sizeof(out));
+    TEST_ASSERT_TRUE(SDReader_Open(&reader, path));
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, SDReader_Size(&reader));
+}
+
+void tearDown(void)
+{
+    SDReader_Close(&reader);
+}
+
+static void test_reads_straddling_chunk_edges(void)
+{
+    readAt(CHUNK - 5, 10);
+    readAt(2 * CHUNK - 1, 2);
+    readAt(CHUNK - 1, CHUNK + 2);     // Both edges of chunk 1 in one call
+    readAt(3 * CHUNK - 3, 3);         // Ends exactly on an edge
+    readAt(3 * CHUNK, 1);
+}
+
+// Odd-sized sequential reads touch each chunk once, read ahead of use
+static void test_sequential_reads_fetch_each_chunk_once(void)
+{
+    uint32_t position = 0;
+    for (uint32_t len = 1; position < FILE_SIZE; len = len % 97 + 1) {
+        int32_t got = SDReader_Read(&reader, out + position, len);
+        TEST_ASSERT_TRUE(got > 0);
+        position += got;
+    }
+    assertPattern(out, 0, FILE_SIZE);
+    TEST_ASSERT_EQUAL_UINT32(4, reader.Stats.Reads);
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, reader.Stats.BytesRead);
+}
+
+static void test_whole_chunks_are_read_directly(void)
+{
+    TEST_ASSERT_EQUAL_INT32(2 * CHUNK + 100, SDReader_Read(&reader, out, 2 * CHUNK + 100));
+    assertPattern(out, 0, 2 * CHUNK + 100);
+    // One read for both whole chunks, then chunk 2 and its read-ahead
+    TEST_ASSERT_EQUAL_UINT32(3, reader.Stats.Reads);
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, reader.Stats.BytesRead);
+
+    // Not on a chunk start: buffered even though it is long
+    TEST_ASSERT_TRUE(SDReader_Seek(&reader, 1));
+    TEST_ASSERT_EQUAL_INT32(CHUNK, SDReader_Read(&reader, out, CHUNK));
+    assertPattern(out, 1, CHUNK);
+}
+
+static void test_seek_into_and_out_of_the_buffers(void)
+{
+    readAt(100, 10);                 // Chunk 0, with chunk 1 read ahead
+    TEST_ASSERT_EQUAL_UINT32(2, reader.Stats.Reads);
+    readAt(50, 10);                  // Back inside the front buffer
+    TEST_ASSERT_EQUAL_UINT32(2, reader.Stats.Reads);
+    readAt(CHUNK + 300, 10);         // Into the read-ahead: only chunk 2 is fetched
+    TEST_ASSERT_EQUAL_UINT32(3, reader.Stats.Reads);
+    readAt(CHUNK + 20, 10);
+    TEST_ASSERT_EQUAL_UINT32(3, reader.Stats.Reads);
+    readAt(3 * CHUNK + 5, 10);       // Past both buffers
+    TEST_ASSERT_EQUAL_UINT32(4, reader.Stats.Reads);
+    readAt(7, 10);                   // Chunk 0 again, and chunk 1 after it
+    TEST_ASSERT_EQUAL_UINT32(6, reader.Stats.Reads);
+}
+
+static void test_short_reads_at_end_of_file(void)
+{
+    TEST_ASSERT_TRUE(SDReader_Seek(&reader, FILE_SIZE - 10));
+    TEST_ASSERT_EQUAL_INT32(10, SDReader_Read(&reader, out, 100));
+    assertPattern(out, FILE_SIZE - 10, 10);
+    TEST_ASSERT_EQUAL_INT32(0, SDReader_Read(&reader, out, 100));
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, SDReader_Position(&reader));
+
+    TEST_ASSERT_TRUE(SDReader_Seek(&reader, 3 * CHUNK));   // Direct path cut short by the end
+    TEST_ASSERT_EQUAL_INT32(1234, SDReader_Read(&reader, out, 2 * CHUNK));
+    assertPattern(out, 3 * CHUNK, 1234);
+
+    TEST_ASSERT_TRUE(SDReader_Seek(&reader, FILE_SIZE));
+    TEST_ASSERT_FALSE(SDReader_Seek(&reader, FILE_SIZE + 1));
+    TEST_ASSERT_EQUAL_INT32(0, SDReader_Read(&reader, out, 0));
+}
+
+static void test_open_failures_and_reuse(void)
+{
+    SDReader_Close(&reader);
+    TEST_ASSERT_EQUAL_INT32(0, SDReader_Read(&reader, out, 10));   // Closed
+    TEST_ASSERT_FALSE(SDReader_Seek(&reader, 0));
+    TEST_ASSERT_FALSE(SDReader_Open(&reader, "/tmp/no such dir/none.bin"));
+
+    uint8_t *buffers[2] = {reader.Buffer[0].Data, reader.Buffer[1].Data};
+    TEST_ASSERT_TRUE(SDReader_Open(&reader, path));                // Buffers kept
+    TEST_ASSERT_EQUAL_PTR(buffers[0], reader.Buffer[0].Data);
+    TEST_ASSERT_EQUAL_PTR(buffers[1], reader.Buffer[1].Data);
+    readAt(CHUNK - 2, 4);
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_straddling_chunk_edges);
+    RUN_TEST(test_sequential_reads_fetch_each_chunk_once);
+    RUN_TEST(test_whole_chunks_are_read_directly);
+    RUN_TEST(test_seek_into_and_out_of_the_buffers);
+    RUN_TEST(test_short_reads_at_end_of_file);
+    RUN_TEST(test_open_failures_and_reuse);
+    SDReader_Free(&reader);
+    unlink(path);
+    return UNITY_END();
+}
@@ -0,0 +1,164 @@
+/*****************************************************************************
+* | File        :   test_slideshow_clock.cpp
+* | Function    :   Slideshow timeline, prepare lead and jitter on a virtual clock
+* | Info        :
+*   pio test -e native -f test_slideshow_clock
+*   A scripted loop() waits for the prepare deadline, spends a varying
+*   decode time, waits for the flip deadline and swaps; the flips must stay
+*   on the ideal timeline however the decode times fall, and a late one
+*   must not shift the ones after it.
+******************************************************************************/
+#include <unity.h>
+#include "Slideshow_Clock.h"
+#include <string.h>
+
+#define SWAP_US 150     // Buffer swap at the flip
+
+static SLIDE_CLOCK slide;
+
+static uint32_t later(uint32_t now, uint32_t due)
+{
+    return (int32_t)(due - now) > 0 ? due : now;
+}
+
+void setUp(void)
+{
+    memset(&slide, 0, sizeof(slide));
+}
+
+void tearDown(void)
+{
+}
+
+static void test_timeline_does_not_drift(void)
+{
+    const uint32_t start = 1234567;
+    const uint32_t period = 3000000;
+    uint32_t now = start;
+    uint32_t seed = 44;
+
+    Slide_Start(&slide, now, period);
+    Slide_RecordPrepare(&slide, 700000);                // The first slide's decode
+    for (uint32_t k = 1; k <= 200; k++) {
+        now = later(now, Slide_PrepareDueUs(&slide));
+        seed = seed * 1103515245 + 12345;
+        uint32_t cost = 600000 + (seed >> 8) % 200000;   // 0.6 - 0.8 s decode
+        if (k % 50 == 0) {
+            cost = 1500000;                             // An unexpectedly big file
+        }
+        now += cost;
+        Slide_RecordPrepare(&slide, cost);
+        now = later(now, Slide_FlipDueUs(&slide));
+        if (k % 50 != 0) {
+            TEST_ASSERT_EQUAL_UINT32(start + k * period, now);
+        }
+        Slide_Flipped(&slide, now);
+        now += SWAP_US;
+    }
+    TEST_ASSERT_EQUAL_UINT32(start + 201 * period, Slide_FlipDueUs(&slide));
+    TEST_ASSERT_EQUAL_UINT32(200, slide.Flips);
+    TEST_ASSERT_EQUAL_UINT32(4, slide.Late);            // Only the big files
+    TEST_ASSERT_EQUAL_UINT32(0, slide.Skipped);
+    TEST_ASSERT_EQUAL_INT32(0, slide.MinErrorUs);
+}
+
+static void test_missed_periods_are_skipped_in_phase(void)
+{
+    Slide_Start(&slide, 0, 1000);
+    Slide_Flipped(&slide, 3500);     // 2.5 periods late
+    TEST_ASSERT_EQUAL_UINT32(2, slide.Skipped);
+    TEST_ASSERT_EQUAL_UINT32(1, slide.Late);
+    TEST_ASSERT_EQUAL_UINT32(4000, Slide_FlipDueUs(&slide));
+
+    Slide_Flipped(&slide, 5000);     // Exactly on the following deadline
+    TEST_ASSERT_EQUAL_UINT32(3, slide.Skipped);
+    TEST_ASSERT_EQUAL_UINT32(6000, Slide_FlipDueUs(&slide));
+}
+
+static void test_prepare_estimate_rises_at_once_and_decays(void)
+{
+    Slide_Start(&slide, 0, 3000000);
+    TEST_ASSERT_EQUAL_UINT32(3000000 - SLIDE_PREPARE_MARGIN_US, Slide_PrepareDueUs(&slide));
+    Slide_RecordPrepare(&slide, 1600);
+    TEST_ASSERT_EQUAL_UINT32(1600, slide.PrepareUs);
+    Slide_RecordPrepare(&slide, 0);
+    TEST_ASSERT_EQUAL_UINT32(1500, slide.PrepareUs);
+    Slide_RecordPrepare(&slide, 400000);
+    TEST_ASSERT_EQUAL_UINT32(400000, slide.PrepareUs);
+    TEST_ASSERT_EQUAL_UINT32(3000000 - 500000 - SLIDE_PREPARE_MARGIN_US, Slide_PrepareDueUs(&slide));
+    for (int i = 0; i < 16; i++) {
+        Slide_RecordPrepare(&slide, 100000);
+    }
+    TEST_ASSERT_TRUE(slide.PrepareUs > 100000 && slide.PrepareUs < 400000);
+}
+
+// A prepare longer than a period starts no earlier than the previous flip
+static void test_prepare_lead_is_capped(void)
+{
+    Slide_Start(&slide, 5000, 100000);
+    Slide_RecordPrepare(&slide, 90000);
+    TEST_ASSERT_EQUAL_UINT32(5000, Slide_PrepareDueUs(&slide));
+}
+
+static void test_jitter_statistics(void)
+{
+    static const int32_t errors[] = {-200, 0, 600, 1500};
+    Slide_Start(&slide, 0, 10000);
+    for (int i = 0; i < 4; i++) {
+        Slide_Flipped(&slide, Slide_FlipDueUs(&slide) + errors[i]);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, slide.Flips);
+    TEST_ASSERT_EQUAL_UINT32(1, slide.Late);
+    TEST_ASSERT_EQUAL_INT32(-200, slide.MinErrorUs);
+    TEST_ASSERT_EQUAL_INT32(1500, slide.MaxErrorUs);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 475.0f, Slide_MeanErrorUs(&slide));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 660.97f, Slide_StdDevUs(&slide));
+    TEST_ASSERT_EQUAL_UINT32(50000, Slide_FlipDueUs(&slide));
+
+    Slide_ResetStats(&slide);
+    TEST_ASSERT_EQUAL_UINT32(0, slide.Flips);
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, Slide_MeanErrorUs(&slide));
+    TEST_ASSERT_FLOAT_WITHIN(0.0f, 0.0f, Slide_StdDevUs(&slide));
+    TEST_ASSERT_EQUAL_UINT32(50000, Slide_FlipDueUs(&slide));   // Timeline kept
+}
+
+static void test_timeline_across_the_micros_wrap(void)
+{
+    const uint32_t start = 0xFFFFFFFFu - 1500;
+    Slide_Start(&slide, start, 1000);
+    Slide_Flipped(&slide, start + 1000 + 20);
+    Slide_Flipped(&slide, start + 2000 - 30);           // After the wrap, slightly early
+    TEST_ASSERT_EQUAL_INT32(-30, slide.MinErrorUs);
+    TEST_ASSERT_EQUAL_INT32(20, slide.MaxErrorUs);
+    TEST_ASSERT_EQUAL_UINT32(0, slide.Skipped);
+    TEST_ASSERT_EQUAL_UINT32(start + 3000, Slide_FlipDueUs(&slide));
+    Slide_Flipped(&slide, start + 5100);
+    TEST_ASSERT_EQUAL_UINT32(2, slide.Skipped);
+    TEST_ASSERT_EQUAL_UINT32(start + 6000, Slide_FlipDueUs(&slide));
+}
+
+static void test_restart_on_speed_change(void)
+{
+    Slide_Start(&slide, 0, 3000000);
+    Slide_Flipped(&slide, 3000000);
+    Slide_Start(&slide, 4000000, 1000000);
+    TEST_ASSERT_EQUAL_UINT32(5000000, Slide_FlipDueUs(&slide));
+    Slide_Start(&slide, 7, 0);
+    TEST_ASSERT_EQUAL_UINT32(1, slide.PeriodUs);
+    TEST_ASSERT_EQUAL_UINT32(8, Slide_FlipDueUs(&slide));
+}
+
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_timeline_does_not_drift);
+    RUN_TEST(test_missed_periods_are_skipped_in_phase);
+    RUN_TEST(test_prepare_estimate_rises_at_once_and_decays);
+    RUN_TEST(test_prepare_lead_is_capped);
+    RUN_TEST(test_jitter_statistics);
+    RUN_TEST(test_timeline_across_the_micros_wrap);
+    RUN_TEST(test_restart_on_speed_change);
+    return UNITY_END();
+}